@@ -49,6 +49,8 @@ static uint32_t adxl355_accel_array_conv(struct adxl355_dev *dev,
 		uint8_t *raw_array);
 static int64_t adxl355_accel_conv(struct adxl355_dev *dev, uint32_t raw_accel);
 static int64_t adxl355_temp_conv(struct adxl355_dev *dev, uint16_t raw_temp);
+static uint16_t adxl355_fifo_decode(struct adxl355_dev *dev, uint8_t *data,
+				    uint16_t nb_entries, int32_t *scans);
 
 /***************************************************************************//**
  * @brief Reads from the device.
@@ -293,6 +295,9 @@ int adxl355_soft_reset(struct adxl355_dev *dev)
 	if (ret)
 		return ret;
 
+	// The FIFO is cleared by the reset
+	dev->fifo_scan_idx = 0;
+
 	// After soft reset, the data in the shadow registers will be valid only after NVM is not busy anymore
 	ret = adxl355_get_sts_reg(dev, &flags);
 	while (flags.fields.NVM_BUSY && nb_of_retries) {
@@ -699,6 +704,51 @@ int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value)
 	return ret;
 }
 
+/***************************************************************************//**
+ * @brief Reads the FIFO and decodes it into interleaved X, Y, Z scans. The
+ *        entries of a scan split between two reads are kept in the device
+ *        structure, so no scan is lost when the FIFO is read while a scan is
+ *        being written. Entries before the first X-axis entry are skipped.
+ *
+ * @param dev       - The device structure.
+ * @param scans     - Sign extended X, Y, Z values, 3 for each scan.
+ * @param max_scans - Maximum number of scans to be returned. Only the FIFO
+ *                    entries needed for max_scans scans are read.
+ * @param nb_scans  - Number of scans returned.
+ *
+ * @return ret      - Result of the reading procedure.
+*******************************************************************************/
+int adxl355_read_fifo_scans(struct adxl355_dev *dev, int32_t *scans,
+			    uint16_t max_scans, uint16_t *nb_scans)
+{
+	uint8_t entries;
+	int ret;
+
+	*nb_scans = 0;
+	if (!max_scans)
+		return 0;
+
+	ret = adxl355_get_nb_of_fifo_entries(dev, &entries);
+	if (ret)
+		return ret;
+
+	// Don't read more entries than needed to complete max_scans scans
+	entries = no_os_min(entries, ADXL355_MAX_FIFO_SAMPLES_VAL);
+	if (max_scans * 3 - dev->fifo_scan_idx < entries)
+		entries = max_scans * 3 - dev->fifo_scan_idx;
+	if (!entries)
+		return 0;
+
+	ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_FIFO_DATA),
+				       entries * 3, dev->comm_buff);
+	if (ret)
+		return ret;
+
+	*nb_scans = adxl355_fifo_decode(dev, dev->comm_buff, entries, scans);
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Reads fifo data and returns the raw values.
  *
@@ -713,34 +763,24 @@ int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value)
 int adxl355_get_raw_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			      uint32_t *raw_x, uint32_t *raw_y, uint32_t *raw_z)
 {
+	int32_t *scans = dev->fifo_scans;
+	uint16_t nb_scans;
 	int ret;
 
-	ret = adxl355_get_nb_of_fifo_entries(dev, fifo_entries);
+	ret = adxl355_read_fifo_scans(dev, scans, ADXL355_FIFO_MAX_SCANS,
+				      &nb_scans);
 	if (ret)
 		return ret;
 
-	*fifo_entries = (*fifo_entries / 3) * 3;
-
-	if (*fifo_entries > 0) {
-
-		ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_FIFO_DATA),
-					       *fifo_entries * 3, dev->comm_buff);
-		if (ret)
-			return ret;
-
-		for (uint16_t idx = 0; idx < *fifo_entries * 3; idx = idx + 9) {
-			if (((dev->comm_buff[idx + 2] & 1) == 1)
-			    && ((dev->comm_buff[idx + 2] & 2) == 0)) {
-				// This is x-axis
-				// Process data
-				raw_x[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx]);
-				raw_y[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 3]);
-				raw_z[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 6]);
-			}
-		}
+	for (uint16_t idx = 0; idx < nb_scans; idx++) {
+		raw_x[idx] = scans[idx * 3] & ~ADXL355_NEG_ACC_MSK;
+		raw_y[idx] = scans[idx * 3 + 1] & ~ADXL355_NEG_ACC_MSK;
+		raw_z[idx] = scans[idx * 3 + 2] & ~ADXL355_NEG_ACC_MSK;
 	}
 
-	return ret;
+	*fifo_entries = nb_scans * 3;
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -910,6 +950,51 @@ static uint32_t adxl355_accel_array_conv(struct adxl355_dev *dev,
 	return (raw_accel >> 4);
 }
 
+/***************************************************************************//**
+ * @brief Decodes FIFO entries into X, Y, Z scans in a single pass.
+ *
+ * @param dev        - The device structure.
+ * @param data       - FIFO entries, 3 bytes each.
+ * @param nb_entries - Number of FIFO entries.
+ * @param scans      - Decoded scans.
+ *
+ * @return ret       - Number of decoded scans.
+*******************************************************************************/
+static uint16_t adxl355_fifo_decode(struct adxl355_dev *dev, uint8_t *data,
+				    uint16_t nb_entries, int32_t *scans)
+{
+	uint8_t idx = dev->fifo_scan_idx;
+	int32_t *scan = scans;
+
+	// The scan started by the previous read is completed in place
+	memcpy(scans, dev->fifo_scan, idx * sizeof(*scans));
+
+	for (uint16_t i = 0; i < nb_entries; i++, data += 3) {
+		// The FIFO was emptied before all the entries were read
+		if (data[2] & ADXL355_FIFO_EMPTY_MSK)
+			break;
+
+		// An X-axis entry always starts a new scan
+		if (data[2] & ADXL355_FIFO_X_MARKER_MSK)
+			idx = 0;
+		else if (!idx)
+			continue;
+
+		// 20-bit two's complement value in bits [23:4]
+		scan[idx++] = no_os_sign_extend32(no_os_get_unaligned_be24(data) >> 4,
+						  19);
+		if (idx == 3) {
+			scan += 3;
+			idx = 0;
+		}
+	}
+
+	memcpy(dev->fifo_scan, scan, idx * sizeof(*scans));
+	dev->fifo_scan_idx = idx;
+
+	return (scan - scans) / 3;
+}
+
 /***************************************************************************//**
  * @brief Converts raw acceleration value to m/s^2 value.
  *
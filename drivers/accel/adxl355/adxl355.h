@@ -78,6 +78,8 @@
 
 #define ADXL355_SHADOW_REGISTER_BASE_ADDR (ADXL355_ADDR(0x50) | SET_ADXL355_TRANSF_LEN(5))
 #define ADXL355_MAX_FIFO_SAMPLES_VAL  0x60
+/* Maximum number of X, Y, Z scans decoded from one FIFO read */
+#define ADXL355_FIFO_MAX_SCANS        (ADXL355_MAX_FIFO_SAMPLES_VAL / 3)
 #define ADXL355_SELF_TEST_TRIGGER_VAL 0x03
 #define ADXL355_RESET_CODE            0x52
 
@@ -142,6 +144,8 @@
 #define ADXL355_ODR_LPF_FIELD_MSK  NO_OS_GENMASK( 3,  0)
 #define ADXL355_HPF_FIELD_MSK      NO_OS_GENMASK( 6,  4)
 #define ADXL355_INT_POL_FIELD_MSK  NO_OS_BIT(6)
+#define ADXL355_FIFO_X_MARKER_MSK  NO_OS_BIT(0)
+#define ADXL355_FIFO_EMPTY_MSK     NO_OS_BIT(1)
 
 enum adxl355_type {
 	ID_ADXL355,
@@ -300,6 +304,12 @@ struct adxl355_dev {
 	uint8_t act_cnt;
 	uint16_t act_thr;
 	uint8_t comm_buff[289];
+	/** FIFO scan being decoded, completed by the next FIFO read */
+	int32_t fifo_scan[3];
+	/** Number of axes in fifo_scan, 0 while waiting for an X-axis entry */
+	uint8_t fifo_scan_idx;
+	/** Scans decoded from the FIFO, kept off the stack of the readers */
+	int32_t fifo_scans[ADXL355_FIFO_MAX_SCANS * 3];
 };
 
 /*! Init. the comm. peripheral and checks if the ADXL355 part is present. */
@@ -365,6 +375,10 @@ int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value);
 int adxl355_get_raw_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			      uint32_t *raw_x, uint32_t *raw_y, uint32_t *raw_z);
 
+/*! Reads the FIFO and decodes it into interleaved X, Y, Z scans. */
+int adxl355_read_fifo_scans(struct adxl355_dev *dev, int32_t *scans,
+			    uint16_t max_scans, uint16_t *nb_scans);
+
 /*! Reads fifo data and returns the values converted in g. */
 int adxl355_get_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			  struct adxl355_frac_repr *x, struct adxl355_frac_repr *y,
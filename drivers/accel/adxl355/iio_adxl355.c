@@ -110,6 +110,8 @@ static int adxl355_iio_read_samp_freq_avail(void *dev, char *buf,
 static int adxl355_iio_read_samples(void* dev, int* buff, uint32_t samples);
 static int adxl355_iio_update_channels(void* dev, uint32_t mask);
 static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data);
+static int32_t adxl355_trigger_batch_handler(struct iio_device_data *dev_data,
+		uint32_t nb_events);
 static struct iio_attribute adxl355_iio_temp_attrs[] = {
 	{
 		.name = "offset",
@@ -203,6 +205,7 @@ static struct iio_device adxl355_iio_dev = {
 	.channels = adxl355_channels,
 	.pre_enable = (int32_t (*)())adxl355_iio_update_channels,
 	.trigger_handler = (int32_t (*)())adxl355_trigger_handler,
+	.trigger_batch_handler = (int32_t (*)())adxl355_trigger_batch_handler,
 	.read_dev = (int32_t (*)())adxl355_iio_read_samples,
 	.debug_reg_read = (int32_t (*)())adxl355_iio_read_reg,
 	.debug_reg_write = (int32_t (*)())adxl355_iio_write_reg
@@ -964,21 +967,22 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 }
 
 /***************************************************************************//**
- * @brief Handles trigger: reads one data-set and writes it to the buffer.
+ * @brief Handles trigger: reads the FIFO and writes all the complete data-sets
+ * 		  to the buffer with a single write.
  *
  * @param dev_data  - The iio device data structure.
  *
- * @return ret - Result of the handling procedure. In case of success, the size
- * 				 of the written data is returned.
+ * @return ret - Result of the handling procedure.
 *******************************************************************************/
 static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 {
-	int32_t data_buff[3];
-	uint32_t x, y, z;
-	uint8_t i = 0;
-
 	struct adxl355_iio_dev *iio_adxl355;
-	struct adxl355_dev *adxl355;
+	int32_t *scans;
+	uint32_t mask;
+	uint16_t nb_scans;
+	uint16_t i, j;
+	uint8_t axis;
+	int ret;
 
 	if (!dev_data)
 		return -EINVAL;
@@ -988,24 +992,37 @@ static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 	if (!iio_adxl355->adxl355_dev)
 		return -EINVAL;
 
-	adxl355 = iio_adxl355->adxl355_dev;
-
-	adxl355_get_raw_xyz(adxl355, &x, &y, &z);
+	scans = iio_adxl355->adxl355_dev->fifo_scans;
+	ret = adxl355_read_fifo_scans(iio_adxl355->adxl355_dev, scans,
+				      ADXL355_FIFO_MAX_SCANS, &nb_scans);
+	if (ret)
+		return ret;
 
-	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
-		data_buff[0] = no_os_sign_extend32(x, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
-		data_buff[i] = no_os_sign_extend32(y, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
-		data_buff[i] = no_os_sign_extend32(z, 19);
-		i++;
+	// Keep only the enabled axes, in place
+	mask = dev_data->buffer->active_mask;
+	if ((mask & NO_OS_GENMASK(2, 0)) != NO_OS_GENMASK(2, 0)) {
+		for (i = 0, j = 0; i < nb_scans; i++)
+			for (axis = 0; axis < 3; axis++)
+				if (mask & NO_OS_BIT(axis))
+					scans[j++] = scans[i * 3 + axis];
 	}
 
-	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+	return iio_buffer_push_scans(dev_data->buffer, scans, nb_scans);
+}
+
+/***************************************************************************//**
+ * @brief Handles the trigger events received since the last call. The samples
+ * 		  of all the events are in the FIFO, so it is read once.
+ *
+ * @param dev_data  - The iio device data structure.
+ * @param nb_events - Number of trigger events.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl355_trigger_batch_handler(struct iio_device_data *dev_data,
+		uint32_t nb_events)
+{
+	return adxl355_trigger_handler(dev_data);
 }
 
 /***************************************************************************//**
@@ -1022,6 +1039,9 @@ int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
 {
 	int ret;
 	struct adxl355_iio_dev *desc;
+	union adxl355_int_mask int_map = {
+		.fields.FULL_EN1 = 1
+	};
 
 	desc = (struct adxl355_iio_dev *)no_os_calloc(1, sizeof(*desc));
 	if (!desc)
@@ -1051,6 +1071,17 @@ int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	if (init_param->fifo_watermark) {
+		ret = adxl355_set_fifo_samples(desc->adxl355_dev,
+					       init_param->fifo_watermark);
+		if (ret)
+			goto error_config;
+
+		ret = adxl355_config_int_pins(desc->adxl355_dev, int_map);
+		if (ret)
+			goto error_config;
+	}
+
 	*iio_dev = desc;
 
 	return 0;
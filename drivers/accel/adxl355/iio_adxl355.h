@@ -48,6 +48,12 @@ struct adxl355_iio_dev {
 
 struct adxl355_iio_dev_init_param {
 	struct adxl355_init_param *adxl355_dev_init;
+	/*
+	 * Optional. Number of FIFO entries (3 for each data-set) that assert the
+	 * FIFO watermark interrupt on INT1, in order to be used as trigger.
+	 * The interrupt map is left unchanged if 0.
+	 */
+	uint8_t fifo_watermark;
 };
 
 int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
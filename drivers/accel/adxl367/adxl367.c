@@ -32,6 +32,7 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "adxl367.h"
 #include "no_os_delay.h"
 #include "no_os_error.h"
@@ -41,6 +42,35 @@
 
 static const uint8_t adxl367_scale_mul[3] = {1, 2, 4};
 static uint8_t samples_per_set = 0;
+/* Channel IDs stored in the FIFO for each enum adxl367_fifo_format */
+static const uint8_t adxl367_fifo_channels[] = {
+	[ADXL367_FIFO_FORMAT_XYZ] = NO_OS_BIT(ADXL367_FIFO_X_ID) |
+				    NO_OS_BIT(ADXL367_FIFO_Y_ID) |
+				    NO_OS_BIT(ADXL367_FIFO_Z_ID),
+	[ADXL367_FIFO_FORMAT_X] = NO_OS_BIT(ADXL367_FIFO_X_ID),
+	[ADXL367_FIFO_FORMAT_Y] = NO_OS_BIT(ADXL367_FIFO_Y_ID),
+	[ADXL367_FIFO_FORMAT_Z] = NO_OS_BIT(ADXL367_FIFO_Z_ID),
+	[ADXL367_FIFO_FORMAT_XYZT] = NO_OS_BIT(ADXL367_FIFO_X_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_Y_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_Z_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_XT] = NO_OS_BIT(ADXL367_FIFO_X_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_YT] = NO_OS_BIT(ADXL367_FIFO_Y_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_ZT] = NO_OS_BIT(ADXL367_FIFO_Z_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_XYZA] = NO_OS_BIT(ADXL367_FIFO_X_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_Y_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_Z_ID) |
+				     NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_XA] = NO_OS_BIT(ADXL367_FIFO_X_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_YA] = NO_OS_BIT(ADXL367_FIFO_Y_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+	[ADXL367_FIFO_FORMAT_ZA] = NO_OS_BIT(ADXL367_FIFO_Z_ID) |
+				   NO_OS_BIT(ADXL367_FIFO_TEMP_ADC_ID),
+};
 
 /***************************************************************************//**
  * @brief Initializes communication with the device and checks if the part is
@@ -399,6 +429,7 @@ int adxl367_software_reset(struct adxl367_dev *dev)
 	dev->fifo_format = ADXL367_FIFO_FORMAT_XYZ;
 	// FIFO Read Mode : 14 bits + CH ID (reset default).
 	dev->fifo_read_mode = ADXL367_14B_CHID;
+	dev->fifo_scan_idx = 0;
 	//Axis offset = 0 (reset default)
 	dev->x_offset = 0;
 	dev->y_offset = 0;
@@ -883,6 +914,7 @@ int adxl367_set_fifo_mode(struct adxl367_dev *dev,
 		return ret;
 
 	dev->fifo_mode = mode;
+	dev->fifo_scan_idx = 0;
 
 	return 0;
 }
@@ -949,6 +981,7 @@ int adxl367_set_fifo_format(struct adxl367_dev *dev,
 		return ret;
 
 	dev->fifo_format = format;
+	dev->fifo_scan_idx = 0;
 
 	switch (dev->fifo_format) {
 	case ADXL367_FIFO_FORMAT_XYZ:
@@ -1027,10 +1060,92 @@ int adxl367_fifo_setup(struct adxl367_dev *dev,
 	return adxl367_set_fifo_read_mode(dev, ADXL367_14B_CHID);
 }
 
+/***************************************************************************//**
+ * @brief Reads the FIFO and decodes it into interleaved sample sets, in the
+ *        channel order of the selected FIFO format (X, Y, Z, temperature or
+ *        ADC). The channel ID of each entry is used to keep the sets aligned:
+ *        the entries of a set split between two reads are kept in the device
+ *        structure and entries that don't continue the current set are
+ *        skipped until the first channel of a set is found. Requires a read
+ *        mode with channel ID, ADXL367_14B_CHID is used by default.
+ *
+ * @param dev       - The device structure.
+ * @param scans     - Sign extended values, one for each channel of the set.
+ * @param max_scans - Maximum number of sets to be returned. Only the FIFO
+ * 		      entries needed for max_scans sets are read.
+ * @param nb_scans  - Number of sets returned.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl367_read_fifo_scans(struct adxl367_dev *dev, int16_t *scans,
+			    uint16_t max_scans, uint16_t *nb_scans)
+{
+	uint8_t channels = adxl367_fifo_channels[dev->fifo_format];
+	uint8_t idx = dev->fifo_scan_idx;
+	uint8_t set_len = 0;
+	uint16_t i, entries;
+	int16_t *scan = scans;
+	int8_t set_pos[4];
+	uint8_t *entry;
+	int8_t pos;
+	int ret;
+
+	// Position of each channel ID in the set, -1 if not stored in the FIFO
+	for (i = 0; i < NO_OS_ARRAY_SIZE(set_pos); i++)
+		set_pos[i] = (channels & NO_OS_BIT(i)) ? set_len++ : -1;
+
+	*nb_scans = 0;
+	if (!max_scans)
+		return 0;
+
+	ret = adxl367_get_nb_of_fifo_entries(dev, &entries);
+	if (ret)
+		return ret;
+
+	// Don't read more entries than needed to complete max_scans sets
+	entries = no_os_min(entries, ADXL367_FIFO_MAX_ENTRIES);
+	if ((uint32_t)max_scans * set_len - idx < entries)
+		entries = max_scans * set_len - idx;
+	if (!entries)
+		return 0;
+
+	ret = adxl367_get_fifo_value(dev, dev->fifo_buffer, entries * 2);
+	if (ret)
+		return ret;
+
+	// The set started by the previous read is completed in place
+	memcpy(scans, dev->fifo_scan, idx * sizeof(*scans));
+
+	// MSB = 2 bits for CH ID + 6 data bits
+	for (i = 0, entry = dev->fifo_buffer; i < entries; i++, entry += 2) {
+		pos = set_pos[entry[0] >> 6];
+		if (pos != idx) {
+			idx = 0;
+			// Only the first channel can start a new set
+			if (pos)
+				continue;
+		}
+
+		// 14-bit two's complement value
+		scan[idx++] = (int16_t)(no_os_get_unaligned_be16(entry) << 2) >> 2;
+		if (idx == set_len) {
+			scan += set_len;
+			idx = 0;
+		}
+	}
+
+	*nb_scans = (scan - scans) / set_len;
+	memcpy(dev->fifo_scan, scan, idx * sizeof(*scans));
+	dev->fifo_scan_idx = idx;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Reads all available raw values from FIFO. If, after setting FIFO mode,
  * 		any of x, y, z, temp or adc aren't selected, assign NULL pointer.
- * 		Uses ADXL367_14B_CHID read mode as default.
+ * 		Uses ADXL367_14B_CHID read mode as default. Only complete sample
+ * 		sets are returned, see adxl367_read_fifo_scans().
  *
  * @param dev       - The device structure.
  * @param x  	    - X axis raw data buffer. If not used, assign NULL.
@@ -1045,72 +1160,29 @@ int adxl367_fifo_setup(struct adxl367_dev *dev,
 int adxl367_read_raw_fifo(struct adxl367_dev *dev, int16_t *x, int16_t *y,
 			  int16_t *z, int16_t *temp_adc, uint16_t *entries)
 {
-	int ret;
-	uint16_t i, stored_entr = 0;
+	int16_t *bufs[] = {x, y, z, temp_adc};
+	uint8_t channels = adxl367_fifo_channels[dev->fifo_format];
+	uint8_t set_len = no_os_hweight8(channels);
+	int16_t *val = dev->fifo_scans;
+	uint16_t i, nb_scans;
 	uint8_t id;
+	int ret;
 
-	ret = adxl367_get_nb_of_fifo_entries(dev, &stored_entr);
-	if (ret)
-		return ret;
-
-	*entries = stored_entr;
+	for (id = 0; id < NO_OS_ARRAY_SIZE(bufs); id++)
+		if ((channels & NO_OS_BIT(id)) && !bufs[id])
+			return -EINVAL;
 
-	ret = adxl367_get_fifo_value(dev, dev->fifo_buffer, stored_entr * 2);
+	ret = adxl367_read_fifo_scans(dev, dev->fifo_scans,
+				      ADXL367_FIFO_MAX_ENTRIES / set_len, &nb_scans);
 	if (ret)
-		return -1;
-
-	// MSB = 6 data bits + 2 bits for CH ID
-	for (i = 0; i < (stored_entr * 2); i += 2) {
-		id = dev->fifo_buffer[i] >> 6;
-
-		switch (id) {
-		case (ADXL367_FIFO_X_ID) :
-			if (x == NULL)
-				return -1;
-			*x = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*x & NO_OS_BIT(13))
-				*x |= NO_OS_GENMASK(15, 14);
-			x++;
-			break;
-
-		case (ADXL367_FIFO_Y_ID) :
-			if (y == NULL)
-				return -1;
-			*y = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*y & NO_OS_BIT(13))
-				*y |= NO_OS_GENMASK(15, 14);
-			y++;
-			break;
-
-		case (ADXL367_FIFO_Z_ID) :
-			if (z == NULL)
-				return -1;
-			*z = ((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i + 1];
-			//extend sign
-			if (*z & NO_OS_BIT(13))
-				*z |= NO_OS_GENMASK(15, 14);
-			z++;
-			break;
-
-		case (ADXL367_FIFO_TEMP_ADC_ID) :
-			if (temp_adc == NULL)
-				return -1;
-			*temp_adc = (int16_t)((dev->fifo_buffer[i] & 0x3F) << 8) + dev->fifo_buffer[i
-					+ 1];
-			//extend sign
-			if (*temp_adc & NO_OS_BIT(13))
-				*temp_adc |= NO_OS_GENMASK(15, 14);
-			temp_adc++;
-			break;
+		return ret;
 
-		default :
-			pr_err("%s: FIFO read invalid channel ID.\n", __func__);
-			return -1;
-		}
+	for (i = 0; i < nb_scans; i++)
+		for (id = 0; id < NO_OS_ARRAY_SIZE(bufs); id++)
+			if (channels & NO_OS_BIT(id))
+				bufs[id][i] = *val++;
 
-	}
+	*entries = nb_scans * set_len;
 
 	return 0;
 }
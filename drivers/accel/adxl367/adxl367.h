@@ -250,6 +250,9 @@
 #define ADXL367_FIFO_Z_ID		0x02
 #define ADXL367_FIFO_TEMP_ADC_ID	0x03
 
+/* FIFO size in entries */
+#define ADXL367_FIFO_MAX_ENTRIES	512
+
 #define ADXL367_ABSOLUTE		0x00
 #define ADXL367_REFERENCED 		0x01
 
@@ -431,6 +434,12 @@ struct adxl367_dev {
 	uint16_t 			x_offset;
 	uint16_t 			y_offset;
 	uint16_t 			z_offset;
+	/** FIFO scan being decoded, completed by the next FIFO read */
+	int16_t 			fifo_scan[4];
+	/** Number of entries in fifo_scan */
+	uint8_t 			fifo_scan_idx;
+	/** Scans decoded from the FIFO, kept off the stack of the readers */
+	int16_t 			fifo_scans[ADXL367_FIFO_MAX_ENTRIES];
 };
 
 /**
@@ -552,6 +561,10 @@ int adxl367_fifo_setup(struct adxl367_dev *dev,
 int adxl367_read_raw_fifo(struct adxl367_dev *dev, int16_t *x, int16_t *y,
 			  int16_t *z, int16_t *temp_adc, uint16_t *entries);
 
+/* Reads the FIFO and decodes it into interleaved sample sets. */
+int adxl367_read_fifo_scans(struct adxl367_dev *dev, int16_t *scans,
+			    uint16_t max_scans, uint16_t *nb_scans);
+
 /* Reads converted values from FIFO. */
 int adxl367_read_converted_fifo(struct adxl367_dev *dev,
 				struct adxl367_fractional_val *x, struct adxl367_fractional_val *y,
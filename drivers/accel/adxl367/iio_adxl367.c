@@ -55,6 +55,32 @@ static const int adxl367_iio_scale_table[3][2] = {
 	{0, 9577975}
 };
 
+/*
+ * FIFO format used for each mask of active channels and the channels it
+ * stores. Channel combinations without a FIFO format use a superset.
+ */
+static const struct {
+	enum adxl367_fifo_format format;
+	uint8_t channels;
+} adxl367_iio_fifo_formats[] = {
+	{ADXL367_FIFO_FORMAT_XYZ, 0x07},
+	{ADXL367_FIFO_FORMAT_X, 0x01},
+	{ADXL367_FIFO_FORMAT_Y, 0x02},
+	{ADXL367_FIFO_FORMAT_XYZ, 0x07},
+	{ADXL367_FIFO_FORMAT_Z, 0x04},
+	{ADXL367_FIFO_FORMAT_XYZ, 0x07},
+	{ADXL367_FIFO_FORMAT_XYZ, 0x07},
+	{ADXL367_FIFO_FORMAT_XYZ, 0x07},
+	{ADXL367_FIFO_FORMAT_XYZT, 0x0F},
+	{ADXL367_FIFO_FORMAT_XT, 0x09},
+	{ADXL367_FIFO_FORMAT_YT, 0x0A},
+	{ADXL367_FIFO_FORMAT_XYZT, 0x0F},
+	{ADXL367_FIFO_FORMAT_ZT, 0x0C},
+	{ADXL367_FIFO_FORMAT_XYZT, 0x0F},
+	{ADXL367_FIFO_FORMAT_XYZT, 0x0F},
+	{ADXL367_FIFO_FORMAT_XYZT, 0x0F},
+};
+
 static struct iio_device adxl367_iio_dev;
 
 /***************************************************************************//**
@@ -610,6 +636,47 @@ static int adxl367_iio_read_scale_avail(void *dev, char *buf,
 	}
 }
 
+/***************************************************************************//**
+ * @brief Configures the FIFO in stream mode, storing the active channels.
+ *
+ * @param iio_adxl367 - The iio device structure.
+ *
+ * @return ret        - Result of the configuration procedure.
+*******************************************************************************/
+static int adxl367_iio_fifo_setup(struct adxl367_iio_dev *iio_adxl367)
+{
+	struct adxl367_dev *adxl367 = iio_adxl367->adxl367_dev;
+	uint8_t idx = iio_adxl367->active_channels & 0x0F;
+	int ret;
+
+	iio_adxl367->fifo_channels = adxl367_iio_fifo_formats[idx].channels;
+
+	// The FIFO can only be configured in standby mode
+	ret = adxl367_set_power_mode(adxl367, ADXL367_OP_STANDBY);
+	if (ret)
+		return ret;
+
+	ret = adxl367_set_fifo_format(adxl367, adxl367_iio_fifo_formats[idx].format);
+	if (ret)
+		return ret;
+
+	ret = adxl367_set_fifo_read_mode(adxl367, ADXL367_14B_CHID);
+	if (ret)
+		return ret;
+
+	if (iio_adxl367->fifo_watermark) {
+		ret = adxl367_set_fifo_sample_sets_nb(adxl367, iio_adxl367->fifo_watermark);
+		if (ret)
+			return ret;
+	}
+
+	ret = adxl367_set_fifo_mode(adxl367, ADXL367_STREAM_MODE);
+	if (ret)
+		return ret;
+
+	return adxl367_set_power_mode(adxl367, ADXL367_OP_MEASURE);
+}
+
 /***************************************************************************//**
  * @brief Updates the number of active channels and the total number of
  * 		  active channels
@@ -645,6 +712,131 @@ static int adxl367_iio_update_channels(void* dev, uint32_t mask)
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Updates the active channels when the buffer is enabled. The FIFO is
+ * 		  only set up when a trigger fills the buffer, read_dev reads the
+ * 		  data registers and leaves the device configuration unchanged.
+ *
+ * @param dev_data - The iio device data structure.
+ *
+ * @return ret     - Result of the enabling procedure.
+*******************************************************************************/
+static int32_t adxl367_iio_pre_enable_buffer(struct iio_device_data *dev_data)
+{
+	struct adxl367_iio_dev *iio_adxl367;
+	int ret;
+
+	if (!dev_data)
+		return -EINVAL;
+
+	iio_adxl367 = (struct adxl367_iio_dev *)dev_data->dev;
+
+	ret = adxl367_iio_update_channels(iio_adxl367,
+					  dev_data->buffer->active_mask);
+	if (ret || !dev_data->triggered)
+		return ret;
+
+	return adxl367_iio_fifo_setup(iio_adxl367);
+}
+
+/***************************************************************************//**
+ * @brief Disables the FIFO when the buffer is closed, if it was set up.
+ *
+ * @param dev  - The iio device structure.
+ *
+ * @return ret - Result of the disabling procedure.
+*******************************************************************************/
+static int adxl367_iio_post_disable(void *dev)
+{
+	struct adxl367_iio_dev *iio_adxl367;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	iio_adxl367 = (struct adxl367_iio_dev *)dev;
+
+	if (!iio_adxl367->fifo_channels)
+		return 0;
+
+	ret = adxl367_set_power_mode(iio_adxl367->adxl367_dev, ADXL367_OP_STANDBY);
+	if (ret)
+		return ret;
+
+	ret = adxl367_set_fifo_mode(iio_adxl367->adxl367_dev, ADXL367_FIFO_DISABLED);
+	if (ret)
+		return ret;
+
+	iio_adxl367->fifo_channels = 0;
+
+	return adxl367_set_power_mode(iio_adxl367->adxl367_dev, ADXL367_OP_MEASURE);
+}
+
+/***************************************************************************//**
+ * @brief Handles trigger: reads the FIFO and writes all the complete data-sets
+ * 		  to the buffer with a single write.
+ *
+ * @param dev_data  - The iio device data structure.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl367_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct adxl367_iio_dev *iio_adxl367;
+	int16_t *scans;
+	uint32_t mask;
+	uint16_t nb_scans;
+	uint16_t i, j, k;
+	uint8_t set_len;
+	uint8_t ch;
+	int ret;
+
+	if (!dev_data)
+		return -EINVAL;
+
+	iio_adxl367 = (struct adxl367_iio_dev *)dev_data->dev;
+
+	if (!iio_adxl367->adxl367_dev || !iio_adxl367->fifo_channels)
+		return -EINVAL;
+
+	scans = iio_adxl367->adxl367_dev->fifo_scans;
+	set_len = no_os_hweight8(iio_adxl367->fifo_channels);
+	ret = adxl367_read_fifo_scans(iio_adxl367->adxl367_dev, scans,
+				      ADXL367_FIFO_MAX_ENTRIES / set_len, &nb_scans);
+	if (ret)
+		return ret;
+
+	// Drop the channels stored in the FIFO but not enabled, in place
+	mask = dev_data->buffer->active_mask;
+	if (mask != iio_adxl367->fifo_channels) {
+		for (i = 0, j = 0, k = 0; i < nb_scans; i++)
+			for (ch = 0; ch < 4; ch++) {
+				if (!(iio_adxl367->fifo_channels & NO_OS_BIT(ch)))
+					continue;
+				if (mask & NO_OS_BIT(ch))
+					scans[j++] = scans[k];
+				k++;
+			}
+	}
+
+	return iio_buffer_push_scans(dev_data->buffer, scans, nb_scans);
+}
+
+/***************************************************************************//**
+ * @brief Handles the trigger events received since the last call. The samples
+ * 		  of all the events are in the FIFO, so it is read once.
+ *
+ * @param dev_data  - The iio device data structure.
+ * @param nb_events - Number of trigger events.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl367_trigger_batch_handler(struct iio_device_data *dev_data,
+		uint32_t nb_events)
+{
+	return adxl367_trigger_handler(dev_data);
+}
+
 /***************************************************************************//**
  * @brief Reads the number of given samples for the selected channels
  *
@@ -713,6 +905,9 @@ int adxl367_iio_init(struct adxl367_iio_dev **iio_dev,
 {
 	int ret;
 	struct adxl367_iio_dev *desc;
+	struct adxl367_int_map int_map = {
+		.fifo_watermark = 1
+	};
 
 	desc = (struct adxl367_iio_dev *)no_os_calloc(1, sizeof(*desc));
 	if (!desc)
@@ -730,6 +925,14 @@ int adxl367_iio_init(struct adxl367_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	if (init_param->fifo_watermark) {
+		ret = adxl367_int_map(desc->adxl367_dev, &int_map, 1);
+		if (ret)
+			goto error_config;
+
+		desc->fifo_watermark = init_param->fifo_watermark;
+	}
+
 	// Set ODR to 400Hz for iio live data feed
 	ret = adxl367_set_output_rate(desc->adxl367_dev, ADXL367_ODR_400HZ);
 	if (ret)
@@ -872,7 +1075,10 @@ static struct iio_device adxl367_iio_dev = {
 	.attributes = adxl367_iio_global_attributes,
 	.num_ch = NO_OS_ARRAY_SIZE(adxl367_channels),
 	.channels = adxl367_channels,
-	.pre_enable = (int32_t (*)())adxl367_iio_update_channels,
+	.pre_enable_buffer = adxl367_iio_pre_enable_buffer,
+	.post_disable = (int32_t (*)())adxl367_iio_post_disable,
+	.trigger_handler = (int32_t (*)())adxl367_trigger_handler,
+	.trigger_batch_handler = (int32_t (*)())adxl367_trigger_batch_handler,
 	.read_dev = (int32_t (*)())adxl367_iio_read_samples,
 	.debug_reg_read = (int32_t (*)())adxl367_iio_read_reg,
 	.debug_reg_write = (int32_t (*)())adxl367_iio_write_reg
@@ -35,15 +35,30 @@
 
 #include "iio.h"
 
+extern struct iio_trigger adxl367_iio_trig_desc;
+
 struct adxl367_iio_dev {
 	struct adxl367_dev *adxl367_dev;
 	struct iio_device *iio_dev;
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	/* FIFO watermark in sample sets, 0 if not used */
+	uint16_t fifo_watermark;
+	/*
+	 * Channels stored in the FIFO, a superset of active_channels.
+	 * 0 while the FIFO is not set up by a triggered buffer.
+	 */
+	uint8_t fifo_channels;
 };
 
 struct adxl367_iio_init_param {
 	struct adxl367_init_param *adxl367_initial_param;
+	/*
+	 * Optional. Number of FIFO sample sets that assert the FIFO watermark
+	 * interrupt on INT1, in order to be used as trigger.
+	 * The interrupt map is left unchanged if 0.
+	 */
+	uint16_t fifo_watermark;
 };
 
 int adxl367_iio_init(struct adxl367_iio_dev **iio_dev,
@@ -45,6 +45,9 @@
  */
 #define AD7124_POST_RESET_DELAY	4
 
+/* Conversion result and status byte read in continuous read mode */
+#define AD7124_CONT_READ_BYTES	4
+
 /***************************************************************************//**
  * @brief Reads the value of the specified register without checking if the
  *        device is ready to accept user requests.
@@ -66,6 +69,10 @@ int32_t ad7124_no_check_read_register(struct ad7124_dev *dev,
 	if (!dev || !p_reg)
 		return -EINVAL;
 
+	/* The device only outputs conversion results in continuous read mode */
+	if (dev->cont_read)
+		return -EBUSY;
+
 	/* Build the Command word */
 	buffer[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
 		    AD7124_COMM_REG_RA(p_reg->addr);
@@ -117,22 +124,18 @@ int32_t ad7124_no_check_read_register(struct ad7124_dev *dev,
 }
 
 /***************************************************************************//**
- * @brief Writes the value of the specified register without checking if the
- *        device is ready to accept user requests.
- * @param dev - The handler of the instance of the driver.
- * @param reg - Register structure holding info about the register to be written
- * @return Returns 0 for success or negative error code otherwise.
+ * @brief Build the SPI frame writing a register.
+ * @param dev    - The handler of the instance of the driver.
+ * @param reg    - Register structure holding info about the register to be
+ *                 written.
+ * @param wr_buf - Where to build the frame, 8 bytes.
+ * @return Returns the length of the frame.
 *******************************************************************************/
-int32_t ad7124_no_check_write_register(struct ad7124_dev *dev,
-				       struct ad7124_st_reg reg)
+static uint32_t ad7124_build_write(struct ad7124_dev *dev,
+				   struct ad7124_st_reg reg, uint8_t *wr_buf)
 {
-	int32_t reg_value = 0;
-	uint8_t wr_buf[8] = { 0 };
-	uint8_t i = 0;
-	uint8_t crc8 = 0;
-
-	if (!dev)
-		return -EINVAL;
+	int32_t reg_value;
+	uint8_t i;
 
 	/* Build the Command word */
 	wr_buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_WR |
@@ -147,14 +150,33 @@ int32_t ad7124_no_check_write_register(struct ad7124_dev *dev,
 
 	/* Compute the CRC */
 	if (dev->use_crc != AD7124_DISABLE_CRC) {
-		crc8 = ad7124_compute_crc8(wr_buf, reg.size + 1);
-		wr_buf[reg.size + 1] = crc8;
+		wr_buf[reg.size + 1] = ad7124_compute_crc8(wr_buf, reg.size + 1);
+		return reg.size + 2;
 	}
 
-	return no_os_spi_write_and_read(dev->spi_desc,
-					wr_buf,
-					(dev->use_crc != AD7124_DISABLE_CRC) ? reg.size + 2
-					: reg.size + 1);
+	return reg.size + 1;
+}
+
+/***************************************************************************//**
+ * @brief Writes the value of the specified register without checking if the
+ *        device is ready to accept user requests.
+ * @param dev - The handler of the instance of the driver.
+ * @param reg - Register structure holding info about the register to be written
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int32_t ad7124_no_check_write_register(struct ad7124_dev *dev,
+				       struct ad7124_st_reg reg)
+{
+	uint8_t wr_buf[8] = { 0 };
+
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->cont_read)
+		return -EBUSY;
+
+	return no_os_spi_write_and_read(dev->spi_desc, wr_buf,
+					ad7124_build_write(dev, reg, wr_buf));
 }
 
 /***************************************************************************//**
@@ -1027,6 +1049,319 @@ int ad7124_set_power_mode(struct ad7124_dev *device,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief SPI transfer of the continuous read mode, optionally leaving the
+ *        chip select asserted after it.
+ * @param dev        - The device structure.
+ * @param buf        - Data to send, replaced by the received data.
+ * @param len        - Number of bytes.
+ * @param release_cs - Deassert the chip select at the end of the transfer.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7124_cont_read_xfer(struct ad7124_dev *dev, uint8_t *buf,
+				     uint32_t len, bool release_cs)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = buf,
+		.rx_buff = buf,
+		.bytes_number = len,
+		.cs_change = release_cs,
+	};
+
+	return no_os_spi_transfer(dev->spi_desc, &msg, 1);
+}
+
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler, reads the conversion result and its
+ *        status byte in continuous read mode and adds them to the ring.
+ * @param ctx - The device structure.
+*******************************************************************************/
+static void ad7124_irq_handler(void *ctx)
+{
+	struct ad7124_dev *dev = ctx;
+	uint8_t buf[AD7124_CONT_READ_BYTES + 2] = { 0 };
+	uint32_t len = AD7124_CONT_READ_BYTES;
+	uint32_t head;
+	int32_t ret;
+
+	if (!dev->cont_read)
+		return;
+
+	if (dev->use_crc != AD7124_DISABLE_CRC)
+		len++;
+
+	/*
+	 * DOUT/RDY is also the MISO line, the interrupt has to be disabled
+	 * while the data is clocked out.
+	 */
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		return;
+
+	/* The chip select stays asserted for DOUT/RDY to signal the next one */
+	ret = ad7124_cont_read_xfer(dev, &buf[1], len, false);
+
+	if (dev->cont_read)
+		no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+
+	if (ret) {
+		dev->cont_read_errors++;
+		return;
+	}
+
+	/* The CRC is computed as for a read of the data register */
+	if (dev->use_crc == AD7124_USE_CRC) {
+		buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
+			 AD7124_COMM_REG_RA(AD7124_DATA_REG);
+		if (ad7124_compute_crc8(buf, len + 1)) {
+			dev->cont_read_errors++;
+			return;
+		}
+	}
+
+	head = dev->ring_head;
+	if (head - dev->ring_tail == dev->ring_size) {
+		dev->cont_read_overruns++;
+		return;
+	}
+
+	dev->ring[head & (dev->ring_size - 1)] = no_os_get_unaligned_be32(&buf[1]);
+	dev->ring_head = head + 1;
+}
+
+/***************************************************************************//**
+ * @brief Allocate the continuous read ring and register the DOUT/RDY
+ *        interrupt handler.
+ * @param dev        - The device structure.
+ * @param init_param - The structure that contains the device initial
+ *                     parameters.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7124_cont_read_init(struct ad7124_dev *dev,
+				     struct ad7124_init_param *init_param)
+{
+	int32_t ret;
+
+	dev->ring_size = init_param->ring_size ? init_param->ring_size :
+			 AD7124_CONT_READ_RING_SIZE;
+	if (dev->ring_size & (dev->ring_size - 1))
+		return -EINVAL;
+
+	ret = no_os_gpio_direction_input(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
+	dev->ring = no_os_calloc(dev->ring_size, sizeof(*dev->ring));
+	if (!dev->ring)
+		return -ENOMEM;
+
+	dev->irq_cb.callback = ad7124_irq_handler;
+	dev->irq_cb.ctx = dev;
+	dev->irq_cb.event = NO_OS_EVT_GPIO;
+	dev->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_rdy->number, &dev->irq_cb);
+	if (ret)
+		goto error_ring;
+
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl, dev->gpio_rdy->number,
+				      &dev->irq_cb);
+error_ring:
+	no_os_free(dev->ring);
+	dev->ring = NULL;
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Free the resources allocated by ad7124_cont_read_init().
+ * @param dev - The device structure.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7124_cont_read_remove(struct ad7124_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev->ring)
+		return 0;
+
+	ret = no_os_irq_unregister_callback(dev->irq_ctrl, dev->gpio_rdy->number,
+					    &dev->irq_cb);
+	if (ret)
+		return ret;
+
+	no_os_free(dev->ring);
+	dev->ring = NULL;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Start the continuous read mode. The conversion results of the
+ *        enabled channels are read on the DOUT/RDY falling edge, tagged with
+ *        the status byte and stored in a ring, so no status polling is done.
+ *        Register accesses return -EBUSY until ad7124_cont_read_stop() is
+ *        called. DOUT/RDY only signals the conversions while the chip select
+ *        is asserted, so it is kept asserted from the write entering the mode
+ *        until ad7124_cont_read_stop(). This needs a SPI platform honouring
+ *        cs_change and a bus not shared with other devices meanwhile.
+ * @param dev - The device structure.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_cont_read_start(struct ad7124_dev *dev)
+{
+	uint8_t wr_buf[8] = { 0 };
+	uint32_t reg_val;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	if (dev->cont_read)
+		return -EBUSY;
+
+	ret = ad7124_set_adc_mode(dev, AD7124_CONTINUOUS);
+	if (ret)
+		return ret;
+
+	dev->ring_head = 0;
+	dev->ring_tail = 0;
+
+	ret = ad7124_read_register2(dev, AD7124_ADC_CTRL_REG, &reg_val);
+	if (ret)
+		return ret;
+
+	if (dev->check_ready) {
+		ret = ad7124_wait_for_spi_ready(dev, dev->spi_rdy_poll_cnt);
+		if (ret)
+			return ret;
+	}
+
+	dev->regs[AD7124_ADC_Control].value = reg_val |
+					      AD7124_ADC_CTRL_REG_CONT_READ |
+					      AD7124_ADC_CTRL_REG_DATA_STATUS;
+	ret = ad7124_cont_read_xfer(dev, wr_buf,
+				    ad7124_build_write(dev,
+						    dev->regs[AD7124_ADC_Control],
+						    wr_buf), false);
+	if (ret)
+		return ret;
+
+	dev->cont_read = true;
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		goto error;
+
+	return 0;
+
+error:
+	ad7124_cont_read_stop(dev);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Stop the continuous read mode. The samples in the ring can still be
+ *        retrieved until the next ad7124_cont_read_start() call.
+ * @param dev - The device structure.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_cont_read_stop(struct ad7124_dev *dev)
+{
+	uint8_t buf[AD7124_CONT_READ_BYTES + 2] = { 0 };
+	uint32_t timeout;
+	uint8_t rdy = NO_OS_GPIO_HIGH;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->cont_read)
+		return 0;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		return ret;
+
+	dev->cont_read = false;
+
+	/* Continuous read is left by a data register read while RDY is low */
+	timeout = dev->spi_rdy_poll_cnt;
+	while (rdy != NO_OS_GPIO_LOW && timeout--) {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+	}
+
+	if (rdy != NO_OS_GPIO_LOW)
+		return -ETIMEDOUT;
+
+	buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
+		 AD7124_COMM_REG_RA(AD7124_DATA_REG);
+	ret = no_os_spi_write_and_read(dev->spi_desc, buf,
+				       (dev->use_crc != AD7124_DISABLE_CRC) ?
+				       AD7124_CONT_READ_BYTES + 2 :
+				       AD7124_CONT_READ_BYTES + 1);
+	if (ret)
+		return ret;
+
+	return ad7124_reg_write_msk(dev, AD7124_ADC_CTRL_REG, 0,
+				    AD7124_ADC_CTRL_REG_CONT_READ |
+				    AD7124_ADC_CTRL_REG_DATA_STATUS);
+}
+
+/***************************************************************************//**
+ * @brief Get the next sample read in continuous read mode, waiting for it up
+ *        to AD7124_CONT_READ_TIMEOUT_US.
+ * @param dev  - The device structure.
+ * @param data - Conversion result.
+ * @param ch   - Channel of the conversion, from the status byte.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_cont_read_sample(struct ad7124_dev *dev, uint32_t *data,
+			    uint8_t *ch)
+{
+	uint32_t timeout = AD7124_CONT_READ_TIMEOUT_US;
+	uint32_t tail;
+	uint32_t val;
+
+	if (!dev || !data || !ch || !dev->ring)
+		return -EINVAL;
+
+	tail = dev->ring_tail;
+	while (dev->ring_head == tail) {
+		if (!dev->cont_read)
+			return -EAGAIN;
+		if (!timeout--)
+			return -ETIMEDOUT;
+		no_os_udelay(1);
+	}
+
+	val = dev->ring[tail & (dev->ring_size - 1)];
+	dev->ring_tail = tail + 1;
+
+	*data = val >> 8;
+	*ch = AD7124_STATUS_REG_CH_ACTIVE(val);
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Initializes the AD7124.
  * @param device     - The device structure.
@@ -1042,7 +1377,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	uint8_t setup_index;
 	uint8_t ch_index;
 
-	dev = (struct ad7124_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad7124_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
 
@@ -1054,18 +1389,28 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	if (ret)
 		goto error_dev;
 
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		goto error_spi;
+
+	if (dev->gpio_rdy && init_param->irq_ctrl) {
+		ret = ad7124_cont_read_init(dev, init_param);
+		if (ret)
+			goto error_gpio;
+	}
+
 	/* Update the device structure with power-on/reset settings. */
 	dev->check_ready = init_param->check_ready;
 
 	/*  Reset the device interface.*/
 	ret = ad7124_reset(dev);
 	if (ret)
-		goto error_spi;
+		goto error_cont;
 
 	/* Initialize ADC mode register. */
 	ret = ad7124_write_register(dev, dev->regs[AD7124_ADC_CTRL_REG]);
 	if (ret)
-		goto error_spi;
+		goto error_cont;
 
 	/* Get CRC State. */
 	ad7124_update_crcsetting(dev);
@@ -1076,7 +1421,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	/* Read ID register to identify the part. */
 	ret = ad7124_read_register(dev, &dev->regs[AD7124_ID_REG]);
 	if (ret)
-		goto error_spi;
+		goto error_cont;
 
 	if (dev->active_device == ID_AD7124_4) {
 		switch (dev->regs[AD7124_ID_REG].value) {
@@ -1086,7 +1431,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 			break;
 
 		default:
-			goto error_spi;
+			goto error_cont;
 		}
 	}
 
@@ -1098,7 +1443,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 			break;
 
 		default:
-			goto error_spi;
+			goto error_cont;
 		}
 	}
 
@@ -1107,74 +1452,78 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 					  init_param->setups[setup_index].bi_unipolar,
 					  setup_index);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_set_burnout(dev,
 					 init_param->setups[setup_index].burnout,
 					 setup_index);
 
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_set_reference_source(dev,
 						  init_param->setups[setup_index].ref_source,
 						  setup_index,
 						  init_param->ref_en);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_enable_buffers(dev,
 					    init_param->setups[setup_index].ain_buff,
 					    init_param->setups[setup_index].ref_buff,
 					    setup_index);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_set_pga(dev,
 				     init_param->setups[setup_index].pga,
 				     setup_index);
 
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 	}
 
 	ret = ad7124_set_adc_mode(dev, init_param->mode);
 	if (ret)
-		goto error_spi;
+		goto error_cont;
 
 	ret = ad7124_set_power_mode(dev,
 				    init_param->power_mode);
 	if (ret)
-		goto error_spi;
+		goto error_cont;
 
 	for (ch_index = 0; ch_index < AD7124_MAX_CHANNELS; ch_index++) {
 		ret = ad7124_connect_analog_input(dev,
 						  ch_index,
 						  init_param->chan_map[ch_index].ain);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_assign_setup(dev,
 					  ch_index,
 					  init_param->chan_map[ch_index].setup_sel);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 
 		ret = ad7124_set_channel_status(dev,
 						ch_index,
 						init_param->chan_map[ch_index].channel_enable);
 		if (ret)
-			goto error_spi;
+			goto error_cont;
 	}
 
 	*device = dev;
 
 	return 0;
 
+error_cont:
+	ad7124_cont_read_remove(dev);
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
 error_spi:
 	no_os_spi_remove(dev->spi_desc);
 error_dev:
-	free(dev);
+	no_os_free(dev);
 
 	return ret;
 }
@@ -1188,6 +1537,18 @@ int32_t ad7124_remove(struct ad7124_dev *dev)
 {
 	int32_t ret;
 
+	ret = ad7124_cont_read_stop(dev);
+	if (ret)
+		return ret;
+
+	ret = ad7124_cont_read_remove(dev);
+	if (ret)
+		return ret;
+
+	ret = no_os_gpio_remove(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
@@ -36,6 +36,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
 
@@ -48,6 +50,11 @@
 /* Maximum number of channels */
 #define AD7124_MAX_CHANNELS	16
 
+/* Default number of samples buffered in continuous read mode */
+#define AD7124_CONT_READ_RING_SIZE	256
+/* Time ad7124_cont_read_sample() waits for a sample */
+#define AD7124_CONT_READ_TIMEOUT_US	1000000
+
 /* AD7124-4 Standard Device ID */
 #define AD7124_4_STD_ID  0x04
 /* AD7124-4 B Grade Device ID */
@@ -522,6 +529,23 @@ struct ad7124_dev {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* DOUT/RDY GPIO, continuous read is available when it is set */
+	struct no_os_gpio_desc	*gpio_rdy;
+	/* Interrupt controller of the DOUT/RDY GPIO */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	struct no_os_callback_desc	irq_cb;
+	/* Continuous read mode is enabled */
+	volatile bool cont_read;
+	/* Samples read in continuous read mode, (data << 8) | status */
+	uint32_t *ring;
+	/* Number of entries of the ring, a power of 2 */
+	uint32_t ring_size;
+	volatile uint32_t ring_head;
+	volatile uint32_t ring_tail;
+	/* Samples dropped because the ring was full */
+	uint32_t cont_read_overruns;
+	/* Samples dropped because of a SPI or CRC error */
+	uint32_t cont_read_errors;
 };
 
 struct ad7124_init_param {
@@ -543,6 +567,12 @@ struct ad7124_init_param {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* DOUT/RDY GPIO, optional, it enables the continuous read mode */
+	struct no_os_gpio_init_param	*gpio_rdy;
+	/* Interrupt controller of the DOUT/RDY GPIO */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	/* Continuous read ring size, AD7124_CONT_READ_RING_SIZE if 0 */
+	uint32_t ring_size;
 };
 
 /* Reads the value of the specified register without a device state check. */
@@ -685,5 +715,15 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 /* Free the resources allocated by ad7124_setup(). */
 int32_t ad7124_remove(struct ad7124_dev *dev);
 
+/* Start the interrupt driven continuous read mode. */
+int ad7124_cont_read_start(struct ad7124_dev *dev);
+
+/* Stop the continuous read mode. */
+int ad7124_cont_read_stop(struct ad7124_dev *dev);
+
+/* Get the next sample read in continuous read mode. */
+int ad7124_cont_read_sample(struct ad7124_dev *dev, uint32_t *data,
+			    uint8_t *ch);
+
 #endif /* __AD7124_H__ */
 
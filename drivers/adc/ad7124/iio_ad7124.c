@@ -584,6 +584,10 @@ static int32_t iio_ad7124_update_active_channels(void *dev, uint32_t mask)
 			return ret;
 	}
 
+	/* Samples are read on the DOUT/RDY interrupt when it is available */
+	if (desc->ring)
+		return ad7124_cont_read_start(desc);
+
 	return 0;
 }
 
@@ -599,6 +603,10 @@ static int32_t iio_ad7124_close_channels(void *dev)
 	int32_t ret;
 	uint32_t reg_temp;
 
+	ret = ad7124_cont_read_stop(desc);
+	if (ret != 0)
+		return ret;
+
 	for (ch_idx = 0; ch_idx < 16; ch_idx++) {
 		ret = ad7124_read_register2(desc,
 					    (AD7124_CH0_MAP_REG + ch_idx),
@@ -642,6 +650,57 @@ static int32_t iio_ad7124_get_active_channels(struct ad7124_dev * desc,
 	return 0;
 }
 
+/**
+ * @brief Get a number of samples from all the active channels in continuous
+ * read mode. The channel tag of each sample keeps the scans aligned, a scan
+ * missing a sample is restarted.
+ * @param [in] desc - Device descriptor.
+ * @param [out] buff - Sample buffer.
+ * @param [in] nb_samples - Number of samples to get.
+ * @return Number of samples read.
+ */
+static int32_t iio_ad7124_read_scans(struct ad7124_dev *desc, int32_t *buff,
+				     uint32_t nb_samples)
+{
+	uint32_t ch_id, first, i = 0, k = 0;
+	uint32_t mask = 0, nb_ch;
+	uint32_t value;
+	uint8_t ch;
+	int32_t ret;
+
+	/* The registers can't be read, the enabled channels are cached */
+	for (ch_id = 0; ch_id < AD7124_MAX_CHANNELS; ch_id++)
+		if (desc->regs[AD7124_Channel_0 + ch_id].value &
+		    AD7124_CH_MAP_REG_CH_ENABLE)
+			mask |= NO_OS_BIT(ch_id);
+
+	if (!get_next_ch_idx(mask, -1, &first))
+		return -EINVAL;
+	nb_ch = no_os_hweight32(mask);
+
+	ch_id = first;
+	while (k < nb_samples) {
+		ret = ad7124_cont_read_sample(desc, &value, &ch);
+		if (ret != 0)
+			return ret;
+
+		if (ch != ch_id) {
+			i = k * nb_ch;
+			ch_id = first;
+			if (ch != first)
+				continue;
+		}
+
+		buff[i++] = value;
+		if (!get_next_ch_idx(mask, ch_id, &ch_id)) {
+			ch_id = first;
+			k++;
+		}
+	}
+
+	return nb_samples;
+}
+
 /**
  * @brief Get a number of samples from all the active channels.
  * @param [in] dev - Device descriptor.
@@ -658,6 +717,9 @@ static int32_t iio_ad7124_read_samples(void *dev, int32_t *buff,
 	uint32_t ch_id = -1, test;
 	uint32_t mask;
 
+	if (desc->cont_read)
+		return iio_ad7124_read_scans(desc, buff, nb_samples);
+
 	ret = iio_ad7124_get_active_channels(desc, &mask);
 	if (ret != 0)
 		return ret;
@@ -79,6 +79,7 @@ int32_t adc_demo_init(struct adc_demo_desc **desc,
 	for (int i = 0; i < TOTAL_ADC_CHANNELS; i++)
 		adesc->adc_ch_attr[i] = param->dev_ch_attr[i];
 	adesc->adc_global_attr = param->dev_global_attr;
+	adesc->sample_rate = param->sample_rate;
 	*desc = adesc;
 
 	return 0;
@@ -115,6 +116,7 @@ int32_t update_adc_channels(void *dev, uint32_t mask)
 	desc = dev;
 
 	desc->active_ch = mask;
+	desc->sample_count = 0;
 	/* If a real device. Here needs to be selected the channels to be read*/
 
 	return 0;
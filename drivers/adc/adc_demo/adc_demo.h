@@ -43,6 +43,10 @@
 #ifndef TOTAL_ADC_CHANNELS
 #define TOTAL_ADC_CHANNELS 2
 #endif
+/* Index of the sample counter channel, after the voltage channels */
+#define ADC_DEMO_COUNT_CHANNEL	TOTAL_ADC_CHANNELS
+/* Index of the timestamp channel, filled by the IIO core */
+#define ADC_DEMO_TIMESTAMP_CHANNEL	(TOTAL_ADC_CHANNELS + 1)
 
 /**
  * @struct iio_demo_adc_desc
@@ -61,6 +65,10 @@ struct adc_demo_desc {
 	uint32_t ext_buff_len;
 	/** Array of buffers for each channel*/
 	uint16_t **ext_buff;
+	/** Sample rate used to pace adc_submit_samples(). 0 for no pacing */
+	uint32_t sample_rate;
+	/** Number of samples generated since the buffer was enabled */
+	uint32_t sample_count;
 };
 
 /**
@@ -76,11 +84,14 @@ struct adc_demo_init_param {
 	uint32_t ext_buff_len;
 	/**Array of buffers for each channel*/
 	uint16_t **ext_buff;
+	/** Sample rate in Hz of the generated data. 0 for no pacing */
+	uint32_t sample_rate;
 };
 
 enum iio_adc_demo_attributes {
 	ADC_CHANNEL_ATTR,
 	ADC_GLOBAL_ATTR,
+	ADC_SAMPLE_RATE_ATTR,
 };
 
 extern const uint16_t sine_lut[128];
@@ -36,34 +36,10 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_util.h"
+#include "no_os_delay.h"
 #include "iio_adc_demo.h"
 #include "iio.h"
 
-/**
- * @brief utility function for computing next upcoming channel
- * @param ch_mask - active channels .
- * @param last_idx -  previous index.
- * @param new_idx - upcoming channel index, return param.
- * @return 1 if there are more channels, 0 if done.
- */
-static bool get_next_ch_idx(uint32_t ch_mask, uint32_t last_idx,
-			    uint32_t *new_idx)
-{
-	last_idx++;
-	ch_mask >>= last_idx;
-	if (!ch_mask) {
-		*new_idx = -1;
-		return 0;
-	}
-	while (!(ch_mask & 1)) {
-		last_idx++;
-		ch_mask >>= 1;
-	}
-	*new_idx = last_idx;
-
-	return 1;
-}
-
 /**
  * @brief get attributes for adc.
  * @param device- Physical instance of a iio_demo_device.
@@ -88,6 +64,8 @@ int get_adc_demo_attr(void *device, char *buf, uint32_t len,
 		return snprintf(buf, len, "%"PRIu32"", desc->adc_global_attr);
 	case ADC_CHANNEL_ATTR:
 		return snprintf(buf, len, "%"PRIu32"", desc->adc_ch_attr[channel->ch_num]);
+	case ADC_SAMPLE_RATE_ATTR:
+		return snprintf(buf, len, "%"PRIu32"", desc->sample_rate);
 	default:
 		return -EINVAL;
 	}
@@ -122,6 +100,9 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 	case ADC_CHANNEL_ATTR:
 		desc->adc_ch_attr[channel->ch_num] = value;
 		return len;
+	case ADC_SAMPLE_RATE_ATTR:
+		desc->sample_rate = value;
+		return len;
 	default:
 		return -EINVAL;
 	}
@@ -130,46 +111,95 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 }
 
 /**
- * @brief function for reading samples from the device.
+ * @brief Generate consecutive scans. The voltage channels come first, 16 bits
+ * each, followed by the 32 bit sample counter aligned to 4 bytes. The place
+ * of the timestamp is left to the IIO core.
+ * @param desc - descriptor for the adc
+ * @param mask - active channels mask
+ * @param buf - where to write the scans
+ * @param bytes_per_scan - size of a scan in bytes
+ * @param nb_scans - number of scans to generate
+ */
+static void adc_demo_fill_scans(struct adc_demo_desc *desc, uint32_t mask,
+				uint8_t *buf, uint32_t bytes_per_scan,
+				uint32_t nb_scans)
+{
+	const uint32_t lut_mask = NO_OS_ARRAY_SIZE(sine_lut) - 1;
+	uint32_t offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
+	uint16_t *ext_buff = (uint16_t *)desc->ext_buff;
+	uint32_t offset[TOTAL_ADC_CHANNELS];
+	uint32_t n = desc->sample_count;
+	uint32_t nb_ch = 0;
+	uint32_t count_pos;
+	uint16_t *scan;
+	uint32_t i, j;
+
+	/* Sine phase or external buffer offset of each active channel */
+	for (i = 0; i < TOTAL_ADC_CHANNELS; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+		if (ext_buff)
+			offset[nb_ch++] = i * desc->ext_buff_len;
+		else
+			offset[nb_ch++] = i * offset_per_ch;
+	}
+	count_pos = no_os_align(nb_ch * sizeof(*scan), sizeof(uint32_t));
+
+	for (i = 0; i < nb_scans; i++, n++, buf += bytes_per_scan) {
+		scan = (uint16_t *)buf;
+		if (ext_buff)
+			for (j = 0; j < nb_ch; j++)
+				scan[j] = ext_buff[offset[j] + n % desc->ext_buff_len];
+		else
+			for (j = 0; j < nb_ch; j++)
+				scan[j] = sine_lut[(n + offset[j]) & lut_mask];
+
+		if (mask & NO_OS_BIT(ADC_DEMO_COUNT_CHANNEL))
+			*(uint32_t *)(buf + count_pos) = n;
+	}
+
+	desc->sample_count = n;
+}
+
+/**
+ * @brief function for reading samples from the device. A whole buffer is
+ * generated in place and, if a sample rate is set, the function waits for the
+ * time it would take to acquire it.
  * @param dev_data  - The iio device data structure.
  * @return the number of read samples.
  */
 int32_t adc_submit_samples(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
-	uint32_t i;
-	uint16_t *ch_buf_ptr;
+	struct iio_buffer *buffer;
+	void *buff;
+	int32_t ret;
 
 	if (!dev_data)
 		return -ENODEV;
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
+	buffer = dev_data->buffer;
 
-	if (desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		for (i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-		     i++) {
-			while (get_next_ch_idx(desc->active_ch, ch, &ch))
-				buff[k++] = sine_lut[(i + ch * offset_per_ch) % NO_OS_ARRAY_SIZE(sine_lut)];
-			k = 0;
-			iio_buffer_push_scan(dev_data->buffer, buff);
-		}
-		return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-	}
+	if (desc->ext_buff && !desc->ext_buff_len)
+		return -EINVAL;
 
-	for (i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-	     i++) {
-		while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-			buff[k++] = ch_buf_ptr[i];
-		}
-		k = 0;
-		iio_buffer_push_scan(dev_data->buffer, buff);
-	}
-	return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (ret)
+		return ret;
+
+	adc_demo_fill_scans(desc, buffer->active_mask, buff,
+			    buffer->bytes_per_scan, buffer->samples);
+
+	ret = iio_buffer_block_done(buffer);
+	if (ret)
+		return ret;
+
+	if (desc->sample_rate)
+		no_os_udelay(no_os_div_u64((uint64_t)buffer->samples * 1000000,
+					   desc->sample_rate));
+
+	return buffer->samples;
 }
 
 
@@ -184,37 +214,19 @@ int32_t adc_submit_samples(struct iio_device_data *dev_data)
 int32_t adc_demo_trigger_handler(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
-	static uint32_t i = 0;
-	uint16_t *ch_buf_ptr;
+	/* Voltage channels, the sample counter and the timestamp */
+	uint64_t buff[NO_OS_DIV_ROUND_UP(TOTAL_ADC_CHANNELS, 4) + 2];
 
 	if (!dev_data)
 		return -EINVAL;
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
 
-	if (desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		while (get_next_ch_idx(desc->active_ch, ch, &ch))
-			buff[k++] = sine_lut[(i + ch * offset_per_ch) % NO_OS_ARRAY_SIZE(sine_lut)];
-		if (i == NO_OS_ARRAY_SIZE(sine_lut))
-			i = 0;
-		else
-			i++;
-
-		return iio_buffer_push_scan(dev_data->buffer, buff);
-	}
+	if (desc->ext_buff && !desc->ext_buff_len)
+		return -EINVAL;
 
-	while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-		ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-		buff[k++] = ch_buf_ptr[i];
-	}
-	if (i == (desc->ext_buff_len - 1))
-		i = 0;
-	else
-		i++;
+	adc_demo_fill_scans(desc, dev_data->buffer->active_mask, (uint8_t *)buff,
+			    dev_data->buffer->bytes_per_scan, 1);
 
 	return iio_buffer_push_scan(dev_data->buffer, buff);
 }
@@ -234,6 +246,14 @@ struct scan_type adc_scan_type = {
 	.is_big_endian = false
 };
 
+struct scan_type adc_count_scan_type = {
+	.sign = 'u',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false
+};
+
 struct iio_attribute adc_channel_attributes[] = {
 	ADC_DEMO_ATTR("adc_channel_attr", ADC_CHANNEL_ATTR),
 	END_ATTRIBUTES_ARRAY,
@@ -241,6 +261,7 @@ struct iio_attribute adc_channel_attributes[] = {
 
 struct iio_attribute iio_adc_global_attributes[] = {
 	ADC_DEMO_ATTR("adc_global_attr", ADC_GLOBAL_ATTR),
+	ADC_DEMO_ATTR("sampling_frequency", ADC_SAMPLE_RATE_ATTR),
 	END_ATTRIBUTES_ARRAY,
 };
 
@@ -255,27 +276,70 @@ struct iio_attribute iio_adc_global_attributes[] = {
 	.ch_out = false,\
 }
 
+/* Number of generated samples, wraps at 2^32 */
+#define IIO_DEMO_ADC_COUNT_CHANNEL {\
+	.name = "sample_count",\
+	.ch_type = IIO_COUNT,\
+	.scan_index = ADC_DEMO_COUNT_CHANNEL,\
+	.indexed = false,\
+	.scan_type = &adc_count_scan_type,\
+	.ch_out = false,\
+}
+
 static struct iio_channel iio_adc_channels[] = {
 	IIO_DEMO_ADC_CHANNEL(0),
+#if TOTAL_ADC_CHANNELS > 1
 	IIO_DEMO_ADC_CHANNEL(1),
+#endif
+#if TOTAL_ADC_CHANNELS > 2
 	IIO_DEMO_ADC_CHANNEL(2),
+#endif
+#if TOTAL_ADC_CHANNELS > 3
 	IIO_DEMO_ADC_CHANNEL(3),
+#endif
+#if TOTAL_ADC_CHANNELS > 4
 	IIO_DEMO_ADC_CHANNEL(4),
+#endif
+#if TOTAL_ADC_CHANNELS > 5
 	IIO_DEMO_ADC_CHANNEL(5),
+#endif
+#if TOTAL_ADC_CHANNELS > 6
 	IIO_DEMO_ADC_CHANNEL(6),
+#endif
+#if TOTAL_ADC_CHANNELS > 7
 	IIO_DEMO_ADC_CHANNEL(7),
+#endif
+#if TOTAL_ADC_CHANNELS > 8
 	IIO_DEMO_ADC_CHANNEL(8),
+#endif
+#if TOTAL_ADC_CHANNELS > 9
 	IIO_DEMO_ADC_CHANNEL(9),
+#endif
+#if TOTAL_ADC_CHANNELS > 10
 	IIO_DEMO_ADC_CHANNEL(10),
+#endif
+#if TOTAL_ADC_CHANNELS > 11
 	IIO_DEMO_ADC_CHANNEL(11),
+#endif
+#if TOTAL_ADC_CHANNELS > 12
 	IIO_DEMO_ADC_CHANNEL(12),
+#endif
+#if TOTAL_ADC_CHANNELS > 13
 	IIO_DEMO_ADC_CHANNEL(13),
+#endif
+#if TOTAL_ADC_CHANNELS > 14
 	IIO_DEMO_ADC_CHANNEL(14),
+#endif
+#if TOTAL_ADC_CHANNELS > 15
 	IIO_DEMO_ADC_CHANNEL(15),
+#endif
+	/* Index of the sample counter, ADC_DEMO_COUNT_CHANNEL */
+	IIO_DEMO_ADC_COUNT_CHANNEL,
+	IIO_TIMESTAMP_CHANNEL(ADC_DEMO_TIMESTAMP_CHANNEL),
 };
 
 struct iio_device adc_demo_iio_descriptor = {
-	.num_ch = TOTAL_ADC_CHANNELS,
+	.num_ch = TOTAL_ADC_CHANNELS + 2,
 	.channels = iio_adc_channels,
 	.attributes = iio_adc_global_attributes,
 	.debug_attributes = NULL,
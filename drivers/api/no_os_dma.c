@@ -90,9 +90,13 @@ static void default_sg_callback(void *context)
 int no_os_dma_init(struct no_os_dma_desc **desc,
 		   struct no_os_dma_init_param *param)
 {
+	struct no_os_list_init_param sg_list_param = {
+		.type = NO_OS_LIST_QUEUE,
+		.storage = NO_OS_LIST_STORAGE_ARRAY,
+	};
 	int ret;
 	uint32_t i, j;
-	void *mutex;
+	void *mutex = NULL;
 
 	if (!param || !param->platform_ops)
 		return -EINVAL;
@@ -112,7 +116,9 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 	(*desc)->platform_ops = param->platform_ops;
 
 	for (i = 0; i < param->num_ch; i++) {
-		ret = no_os_list_init(&(*desc)->channels[i].sg_list, NO_OS_LIST_QUEUE, NULL);
+		/* No allocation when transfers are queued or completed */
+		ret = no_os_list_init_ext(&(*desc)->channels[i].sg_list,
+					  &sg_list_param);
 		if (ret)
 			goto list_err;
 
@@ -121,16 +127,18 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 
 	(*desc)->ref++;
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return 0;
 
 list_err:
 	for (j = 0; j < i; j++)
-		no_os_list_remove((*desc)->channels[i].sg_list);
+		no_os_list_remove((*desc)->channels[j].sg_list);
 
 	no_os_dma_remove(*desc);
 unlock:
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return ret;
 }
@@ -37,6 +37,10 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 
 /**
  * @brief i2c_table contains the pointers towards the i2c buses
@@ -170,8 +174,12 @@ int32_t no_os_i2c_write(struct no_os_i2c_desc *desc,
 		return -ENOSYS;
 
 	no_os_mutex_lock(desc->bus->mutex);
+	NO_OS_TRACE_BEGIN();
 	ret = desc->platform_ops->i2c_ops_write(desc, data, bytes_number,
 						stop_bit);
+	NO_OS_TRACE_END(NO_OS_TRACE_I2C, desc->bus->device_id,
+			desc->slave_address, NO_OS_TRACE_WRITE,
+			bytes_number, ret);
 	no_os_mutex_unlock(desc->bus->mutex);
 
 	return ret;
@@ -201,8 +209,12 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 		return -ENOSYS;
 
 	no_os_mutex_lock(desc->bus->mutex);
+	NO_OS_TRACE_BEGIN();
 	ret = desc->platform_ops->i2c_ops_read(desc, data, bytes_number,
 					       stop_bit);
+	NO_OS_TRACE_END(NO_OS_TRACE_I2C, desc->bus->device_id,
+			desc->slave_address, NO_OS_TRACE_READ,
+			bytes_number, ret);
 	no_os_mutex_unlock(desc->bus->mutex);
 
 	return ret;
@@ -33,8 +33,10 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include "no_os_irq.h"
 #include "no_os_error.h"
+#include "no_os_alloc.h"
 
 /**
  * @brief Initialize the IRQ interrupts.
@@ -263,3 +265,256 @@ int no_os_irq_clear_pending(struct no_os_irq_ctrl_desc* desc,
 
 	return desc->platform_ops->clear_pending(desc, irq_id);
 }
+
+/**
+ * @struct no_os_irq_action_node
+ * @brief Overflow list entry, used once the dispatch table is full.
+ */
+struct no_os_irq_action_node {
+	struct no_os_irq_action action;
+	struct no_os_irq_action_node *next;
+};
+
+/* Callback dispatch table, open addressing with linear probing */
+static struct no_os_irq_action no_os_irq_actions[NO_OS_IRQ_ACTIONS_SIZE];
+/* Entries of the dispatch table which are not free, tombstones included */
+static uint32_t no_os_irq_actions_used;
+/* Actions that did not fit in the dispatch table */
+static struct no_os_irq_action_node *no_os_irq_actions_overflow;
+
+/**
+ * @brief Callback of the removed dispatch table entries (tombstones). The
+ * entries are not moved on removal, so the probe sequences of the other
+ * entries stay valid while an interrupt is dispatched.
+ * @param context - Unused.
+ * @return None.
+ */
+static void no_os_irq_action_removed(void *context)
+{
+}
+
+/**
+ * @brief Get the preferred dispatch table index of an (event, handle) pair.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @return Index in the dispatch table.
+ */
+static uint32_t no_os_irq_action_slot(enum no_os_irq_event event,
+				      void *handle)
+{
+	uint64_t key = (uint64_t)(uintptr_t)handle;
+	uint32_t hash;
+
+	hash = (uint32_t)key ^ (uint32_t)(key >> 32) ^ ((uint32_t)event << 24);
+
+	/* Fibonacci hashing, the upper bits are the best mixed */
+	return (hash * 2654435761u) >> (32 - NO_OS_IRQ_ACTIONS_ORDER);
+}
+
+/**
+ * @brief Find the dispatch table index of an (event, handle) pair.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @param idx - Index of the entry if found. Otherwise, index of the first
+ * 		tombstone or free entry of the probe sequence. May be NULL.
+ * @return true if the entry was found, false otherwise.
+ */
+static bool no_os_irq_action_find(enum no_os_irq_event event, void *handle,
+				  uint32_t *idx)
+{
+	struct no_os_irq_action *a;
+	uint32_t i, n, reuse;
+
+	i = no_os_irq_action_slot(event, handle);
+	reuse = NO_OS_IRQ_ACTIONS_SIZE;
+	/* At least one entry is always kept free, so the search ends */
+	for (n = 0; n < NO_OS_IRQ_ACTIONS_SIZE; n++) {
+		a = &no_os_irq_actions[i];
+		if (!a->callback)
+			break;
+		if (a->callback == no_os_irq_action_removed) {
+			if (reuse == NO_OS_IRQ_ACTIONS_SIZE)
+				reuse = i;
+		} else if (a->handle == handle && a->event == event) {
+			if (idx)
+				*idx = i;
+			return true;
+		}
+		i = (i + 1) & (NO_OS_IRQ_ACTIONS_SIZE - 1);
+	}
+
+	if (idx)
+		*idx = reuse != NO_OS_IRQ_ACTIONS_SIZE ? reuse : i;
+
+	return false;
+}
+
+/**
+ * @brief Find an (event, handle) pair in the overflow list.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @param prev - Set to the link pointing to the entry if found. May be NULL.
+ * @return The overflow list entry, NULL if not found.
+ */
+static struct no_os_irq_action_node *
+no_os_irq_action_overflow_find(enum no_os_irq_event event, void *handle,
+			       struct no_os_irq_action_node ***prev)
+{
+	struct no_os_irq_action_node **link = &no_os_irq_actions_overflow;
+
+	while (*link) {
+		if ((*link)->action.handle == handle &&
+		    (*link)->action.event == event) {
+			if (prev)
+				*prev = link;
+			return *link;
+		}
+		link = &(*link)->next;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Add or update the callback of an (event, handle) pair in the dispatch
+ * table. Once the table is full, the entry is allocated in an overflow list
+ * which is searched linearly. An (event, handle) pair is kept in a single
+ * place: a pair already in the overflow list is updated there. The entries of
+ * the other events are not modified, so their interrupts may be dispatched
+ * meanwhile. Must not be called concurrently with the interrupt dispatching the
+ * same event, nor with another no_os_irq_action_set/clear call.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @param callback - Callback to be called when the event occurs.
+ * @param ctx - Parameter to be passed when the callback is called.
+ * @return 0 in case of success, negative errno error codes.
+ */
+int no_os_irq_action_set(enum no_os_irq_event event, void *handle,
+			 void (*callback)(void *context), void *ctx)
+{
+	struct no_os_irq_action_node *node;
+	struct no_os_irq_action *a;
+	uint32_t idx;
+
+	if (!callback)
+		return no_os_irq_action_clear(event, handle);
+
+	if (no_os_irq_action_find(event, handle, &idx)) {
+		a = &no_os_irq_actions[idx];
+	} else if ((node = no_os_irq_action_overflow_find(event, handle, NULL))) {
+		a = &node->action;
+	} else if (no_os_irq_actions[idx].callback) {
+		/* Reuse a tombstone, it stays one until callback is set */
+		a = &no_os_irq_actions[idx];
+	} else if (no_os_irq_actions_used < NO_OS_IRQ_ACTIONS_SIZE - 1) {
+		a = &no_os_irq_actions[idx];
+		no_os_irq_actions_used++;
+	} else {
+		/* The table is full, keep the entry in the overflow list */
+		node = no_os_calloc(1, sizeof(*node));
+		if (!node)
+			return -ENOMEM;
+
+		node->action.handle = handle;
+		node->action.event = event;
+		node->action.ctx = ctx;
+		node->action.callback = callback;
+		/* Link last, the entry is valid once reachable */
+		node->next = no_os_irq_actions_overflow;
+		no_os_irq_actions_overflow = node;
+
+		return 0;
+	}
+
+	a->handle = handle;
+	a->event = event;
+	a->ctx = ctx;
+	/* Set last, the entry is valid once callback is set */
+	a->callback = callback;
+
+	return 0;
+}
+
+/**
+ * @brief Remove the callback of an (event, handle) pair from the dispatch
+ * table. The entry is turned into a tombstone with a single store and no other
+ * entry is moved, so the interrupts of the other events may be dispatched
+ * meanwhile. Must not be called concurrently with the interrupt dispatching the
+ * same event, nor with another no_os_irq_action_set/clear call.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @return 0 in case of success, -ENOENT if the callback was not found.
+ */
+int no_os_irq_action_clear(enum no_os_irq_event event, void *handle)
+{
+	struct no_os_irq_action_node *node, **prev;
+	uint32_t i;
+
+	if (!no_os_irq_action_find(event, handle, &i)) {
+		node = no_os_irq_action_overflow_find(event, handle, &prev);
+		if (!node)
+			return -ENOENT;
+
+		*prev = node->next;
+		no_os_free(node);
+
+		return 0;
+	}
+
+	no_os_irq_actions[i].callback = no_os_irq_action_removed;
+
+	/*
+	 * Tombstones followed by a free entry end every probe sequence going
+	 * through them, so they can be freed without affecting any search.
+	 */
+	while (no_os_irq_actions[i].callback == no_os_irq_action_removed &&
+	       !no_os_irq_actions[(i + 1) & (NO_OS_IRQ_ACTIONS_SIZE - 1)].callback) {
+		no_os_irq_actions[i].callback = NULL;
+		no_os_irq_actions_used--;
+		i = (i - 1) & (NO_OS_IRQ_ACTIONS_SIZE - 1);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Find the callback of an (event, handle) pair.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @return The dispatch table entry, NULL if not found.
+ */
+struct no_os_irq_action *no_os_irq_action_get(enum no_os_irq_event event,
+		void *handle)
+{
+	struct no_os_irq_action_node *node;
+	uint32_t idx;
+
+	if (!no_os_irq_action_find(event, handle, &idx)) {
+		node = no_os_irq_action_overflow_find(event, handle, NULL);
+
+		return node ? &node->action : NULL;
+	}
+
+	return &no_os_irq_actions[idx];
+}
+
+/**
+ * @brief Call the callback of an (event, handle) pair. The entry is usually
+ * found at its preferred index, so the cost does not depend on the number of
+ * registered callbacks as long as they fit in the dispatch table.
+ * @param event - Interrupt event.
+ * @param handle - Platform specific identifier of the interrupt source.
+ * @return 0 in case of success, -ENOENT if no callback is registered.
+ */
+int no_os_irq_action_dispatch(enum no_os_irq_event event, void *handle)
+{
+	struct no_os_irq_action *a;
+
+	a = no_os_irq_action_get(event, handle);
+	if (!a)
+		return -ENOENT;
+
+	a->callback(a->ctx);
+
+	return 0;
+}
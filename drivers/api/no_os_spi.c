@@ -37,12 +37,32 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 
 /**
  * @brief spi_table contains the pointers towards the SPI buses
 */
 static void *spi_table[SPI_MAX_BUS_NUMBER + 1];
 
+static void no_os_spi_queue_run(struct no_os_spibus_desc *bus,
+				struct no_os_spi_xfer *xfer);
+
+/* Number of bytes of a list of messages, for the trace. */
+static inline uint32_t no_os_spi_msgs_bytes(const struct no_os_spi_msg *msgs,
+		uint32_t len)
+{
+	uint32_t bytes = 0;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		bytes += msgs[i].bytes_number;
+
+	return bytes;
+}
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -76,6 +96,7 @@ int32_t no_os_spi_init(struct no_os_spi_desc **desc,
 	(*desc)->platform_ops = param->platform_ops;
 	(*desc)->parent = param->parent;
 	(*desc)->platform_delays = param->platform_delays;
+	(*desc)->queue_dma = param->queue_dma;
 
 	return 0;
 }
@@ -94,6 +115,7 @@ int32_t no_os_spibus_init(const struct no_os_spi_init_param *param)
 		return -ENOMEM;
 
 	no_os_mutex_init(&(bus->mutex));
+	no_os_mutex_init(&(bus->queue_mutex));
 
 	bus->slave_number = 0;
 	bus->device_id = param->device_id;
@@ -140,6 +162,7 @@ void no_os_spibus_remove(uint32_t bus_number)
 
 	if (bus->slave_number == 0) {
 		no_os_mutex_remove(bus->mutex);
+		no_os_mutex_remove(bus->queue_mutex);
 
 		if (bus) {
 			no_os_free(bus);
@@ -169,7 +192,11 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 		return -ENOSYS;
 
 	no_os_mutex_lock(desc->bus->mutex);
+	NO_OS_TRACE_BEGIN();
 	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
+	NO_OS_TRACE_END(NO_OS_TRACE_SPI, desc->bus->device_id,
+			desc->chip_select, NO_OS_TRACE_WRITE_AND_READ,
+			bytes_number, ret);
 	no_os_mutex_unlock(desc->bus->mutex);
 
 	return ret;
@@ -192,8 +219,15 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer)
-		return desc->platform_ops->transfer(desc, msgs, len);
+	if (!desc->platform_ops->transfer && !desc->platform_ops->write_and_read)
+		return -ENOSYS;
+
+	NO_OS_TRACE_BEGIN();
+
+	if (desc->platform_ops->transfer) {
+		ret = desc->platform_ops->transfer(desc, msgs, len);
+		goto trace;
+	}
 
 	no_os_mutex_lock(desc->bus->mutex);
 
@@ -202,8 +236,9 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 			ret = -EINVAL;
 			goto out;
 		}
-		ret = no_os_spi_write_and_read(desc, msgs[i].rx_buff,
-					       msgs[i].bytes_number);
+		// The bus is already locked
+		ret = desc->platform_ops->write_and_read(desc, msgs[i].rx_buff,
+				msgs[i].bytes_number);
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			goto out;
 		}
@@ -211,6 +246,10 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 
 out:
 	no_os_mutex_unlock(desc->bus->mutex);
+trace:
+	NO_OS_TRACE_END(NO_OS_TRACE_SPI, desc->bus->device_id,
+			desc->chip_select, NO_OS_TRACE_TRANSFER,
+			no_os_spi_msgs_bytes(msgs, len), ret);
 	return ret;
 }
 
@@ -225,13 +264,21 @@ int32_t no_os_spi_transfer_dma(struct no_os_spi_desc *desc,
 			       struct no_os_spi_msg *msgs,
 			       uint32_t len)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer_dma)
-		return desc->platform_ops->transfer_dma(desc, msgs, len);
+	if (!desc->platform_ops->transfer_dma)
+		return -ENOSYS;
 
-	return -ENOSYS;
+	NO_OS_TRACE_BEGIN();
+	ret = desc->platform_ops->transfer_dma(desc, msgs, len);
+	NO_OS_TRACE_END(NO_OS_TRACE_SPI, desc->bus->device_id,
+			desc->chip_select, NO_OS_TRACE_TRANSFER_DMA,
+			no_os_spi_msgs_bytes(msgs, len), ret);
+
+	return ret;
 }
 
 /**
@@ -276,3 +323,188 @@ int32_t no_os_spi_transfer_abort(struct no_os_spi_desc *desc)
 
 	return desc->platform_ops->transfer_abort(desc);
 }
+
+/**
+ * @brief Complete a transaction of the bus queue and select the next one.
+ * A chained transaction is started before the queued ones. If the
+ * transaction failed, the rest of its chain is cancelled.
+ * @param bus - The SPI bus descriptor.
+ * @param xfer - The completed transaction.
+ * @param ret - The result of the transaction.
+ * @return the next transaction, NULL if the queue is empty.
+ */
+static struct no_os_spi_xfer *no_os_spi_queue_complete(
+	struct no_os_spibus_desc *bus, struct no_os_spi_xfer *xfer, int32_t ret)
+{
+	struct no_os_spi_xfer *next = xfer->chain;
+	struct no_os_spi_xfer *chain;
+	uint32_t irq_state;
+
+	// The callbacks may submit the transactions again
+	if (xfer->callback)
+		xfer->callback(xfer, ret);
+
+	if (ret) {
+		while (next) {
+			chain = next->chain;
+			if (next->callback)
+				next->callback(next, -ECANCELED);
+			next = chain;
+		}
+	}
+
+	irq_state = no_os_critical_enter(bus->queue_mutex);
+	if (!next) {
+		next = bus->queue;
+		if (next)
+			bus->queue = next->next;
+	}
+	bus->queue_active = next;
+	no_os_critical_exit(bus->queue_mutex, irq_state);
+
+	return next;
+}
+
+/**
+ * @brief Completion callback of the transactions started with
+ * transfer_async.
+ * @param ctx - The transaction.
+ * @param ret - The result of the transaction.
+ */
+static void no_os_spi_queue_done(void *ctx, int32_t ret)
+{
+	struct no_os_spi_xfer *xfer = ctx;
+	struct no_os_spibus_desc *bus = xfer->desc->bus;
+
+	no_os_spi_queue_run(bus, no_os_spi_queue_complete(bus, xfer, ret));
+}
+
+/**
+ * @brief Completion callback of the transactions started with
+ * transfer_dma_async.
+ * @param ctx - The transaction.
+ */
+static void no_os_spi_queue_dma_done(void *ctx)
+{
+	no_os_spi_queue_done(ctx, 0);
+}
+
+/**
+ * @brief Run the bus queue, starting with the given transaction. Returns once
+ * the queue is empty or a transaction was started asynchronously.
+ * @param bus - The SPI bus descriptor.
+ * @param xfer - The transaction to start.
+ */
+static void no_os_spi_queue_run(struct no_os_spibus_desc *bus,
+				struct no_os_spi_xfer *xfer)
+{
+	const struct no_os_spi_platform_ops *ops;
+	int32_t ret;
+
+	while (xfer) {
+		ops = xfer->desc->platform_ops;
+
+		if (ops->transfer_async) {
+			ret = ops->transfer_async(xfer->desc, xfer->msgs, xfer->len,
+						  no_os_spi_queue_done, xfer);
+			if (!ret)
+				return;
+		} else if (xfer->desc->queue_dma && ops->transfer_dma_async) {
+			ret = ops->transfer_dma_async(xfer->desc, xfer->msgs,
+						      xfer->len,
+						      no_os_spi_queue_dma_done,
+						      xfer);
+			if (!ret)
+				return;
+		} else {
+			ret = no_os_spi_transfer(xfer->desc, xfer->msgs, xfer->len);
+		}
+
+		xfer = no_os_spi_queue_complete(bus, xfer, ret);
+	}
+}
+
+/**
+ * @brief Queue a transaction on the SPI bus of its device. The transactions
+ * of all the devices on a bus are started one at a time, by priority.
+ *
+ * If the bus is idle, the transaction is started right away. If the platform
+ * implements transfer_async (or transfer_dma_async and queue_dma is set),
+ * the function returns once the transfer is started and the queue is run from
+ * the completion callbacks. Otherwise the queue is run to completion by the
+ * caller, using the synchronous transfer ops.
+ * @param xfer - The transaction.
+ * @return 0 in case of success, negative error code otherwise. The result of
+ * the transfer is passed to the callback.
+ */
+int32_t no_os_spi_queue_submit(struct no_os_spi_xfer *xfer)
+{
+	struct no_os_spibus_desc *bus;
+	struct no_os_spi_xfer *chain;
+	struct no_os_spi_xfer **pos;
+	uint32_t irq_state;
+
+	if (!xfer || !xfer->desc || !xfer->desc->bus || !xfer->msgs || !xfer->len)
+		return -EINVAL;
+
+	bus = xfer->desc->bus;
+	for (chain = xfer->chain; chain; chain = chain->chain)
+		if (!chain->desc || chain->desc->bus != bus || !chain->msgs ||
+		    !chain->len)
+			return -EINVAL;
+
+	irq_state = no_os_critical_enter(bus->queue_mutex);
+	if (bus->queue_active) {
+		pos = &bus->queue;
+		while (*pos && (*pos)->priority >= xfer->priority)
+			pos = &(*pos)->next;
+
+		xfer->next = *pos;
+		*pos = xfer;
+		no_os_critical_exit(bus->queue_mutex, irq_state);
+
+		return 0;
+	}
+	bus->queue_active = xfer;
+	no_os_critical_exit(bus->queue_mutex, irq_state);
+
+	no_os_spi_queue_run(bus, xfer);
+
+	return 0;
+}
+
+/**
+ * @brief Remove a transaction that wasn't started yet from the SPI bus queue.
+ * The callback is not invoked.
+ * @param xfer - The transaction.
+ * @return 0 in case of success, -EBUSY if the transaction is in progress,
+ * -ENOENT if it is not queued.
+ */
+int32_t no_os_spi_queue_cancel(struct no_os_spi_xfer *xfer)
+{
+	struct no_os_spibus_desc *bus;
+	struct no_os_spi_xfer **pos;
+	int32_t ret = -ENOENT;
+	uint32_t irq_state;
+
+	if (!xfer || !xfer->desc || !xfer->desc->bus)
+		return -EINVAL;
+
+	bus = xfer->desc->bus;
+
+	irq_state = no_os_critical_enter(bus->queue_mutex);
+	if (bus->queue_active == xfer) {
+		ret = -EBUSY;
+	} else {
+		for (pos = &bus->queue; *pos; pos = &(*pos)->next) {
+			if (*pos == xfer) {
+				*pos = xfer->next;
+				ret = 0;
+				break;
+			}
+		}
+	}
+	no_os_critical_exit(bus->queue_mutex, irq_state);
+
+	return ret;
+}
@@ -104,11 +104,8 @@ int get_dac_demo_attr(void *device, char *buf, uint32_t len,
 int32_t dac_submit_samples(struct iio_device_data *dev_data)
 {
 	struct dac_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t data[TOTAL_DAC_CHANNELS] = {0};
-	int ret;
-	uint32_t i = 0;
+	void *planes[TOTAL_DAC_CHANNELS];
+	uint32_t ch;
 
 	if (!dev_data)
 		return -ENODEV;
@@ -118,23 +115,14 @@ int32_t dac_submit_samples(struct iio_device_data *dev_data)
 	if (!desc->loopback_buffers)
 		return -EINVAL;
 
-	for (i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-	     i++) {
-		ret = iio_buffer_pop_scan(dev_data->buffer, data);
-		if (ret)
-			return ret;
+	/* The loopback buffers are stored one channel after the other */
+	for (ch = 0; ch < TOTAL_DAC_CHANNELS; ch++)
+		planes[ch] = (uint16_t *)desc->loopback_buffers +
+			     ch * desc->loopback_buffer_len;
 
-		while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			uint16_t* ch_buffer = (uint16_t*)(desc->loopback_buffers +
-							  (ch * desc->loopback_buffer_len *
-							   sizeof(uint16_t) / sizeof(ch_buffer)));
-			ch_buffer[i] = data[k++];
-		}
-
-		k = 0;
-	}
-
-	return 0;
+	return iio_buffer_pop_planar(dev_data->buffer, planes,
+				     dev_data->buffer->size /
+				     dev_data->buffer->bytes_per_scan);
 }
 
 /**
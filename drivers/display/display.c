@@ -38,6 +38,122 @@
 #include "no_os_alloc.h"
 #include <string.h>
 
+extern const uint8_t no_os_chr_8x8[128][8];
+
+/***************************************************************************//**
+ * @brief Marks pixel columns of a framebuffer page as dirty.
+ *
+ * @param device - The device structure.
+ * @param page   - page
+ * @param start  - first pixel column
+ * @param end    - pixel column after the last one
+*******************************************************************************/
+static void display_fb_mark(struct display_dev *device, uint8_t page,
+			    uint16_t start, uint16_t end)
+{
+	if (device->dirty_end[page] == 0) {
+		device->dirty_start[page] = start;
+		device->dirty_end[page] = end;
+		return;
+	}
+
+	if (start < device->dirty_start[page])
+		device->dirty_start[page] = start;
+	if (end > device->dirty_end[page])
+		device->dirty_end[page] = end;
+}
+
+/***************************************************************************//**
+ * @brief Draws a character in the framebuffer.
+ *
+ * Only the columns whose content changes are marked as dirty, characters
+ * outside of the display are dropped.
+ *
+ * @param device - The device structure.
+ * @param chr    - char to be drawn
+ * @param row    - row
+ * @param column - column
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+static int32_t display_fb_put(struct display_dev *device, uint8_t chr,
+			      uint8_t row, uint8_t column)
+{
+	uint16_t col;
+	uint8_t *cell;
+
+	if (row >= device->rows_nb || column >= device->cols_nb)
+		return 0;
+
+	col = column * DISPLAY_CHAR_WIDTH;
+	cell = device->fb + row * device->cols_nb * DISPLAY_CHAR_WIDTH + col;
+	if (!memcmp(cell, no_os_chr_8x8[chr & 0x7F], DISPLAY_CHAR_WIDTH))
+		return 0;
+
+	memcpy(cell, no_os_chr_8x8[chr & 0x7F], DISPLAY_CHAR_WIDTH);
+	display_fb_mark(device, row, col, col + DISPLAY_CHAR_WIDTH);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Prints a character directly or in the framebuffer.
+ *
+ * @param device - The device structure.
+ * @param chr    - char to be printed
+ * @param row    - row
+ * @param column - column
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+static int32_t display_put_char(struct display_dev *device, uint8_t chr,
+				uint8_t row, uint8_t column)
+{
+	if (device->fb)
+		return display_fb_put(device, chr, row, column);
+
+	return device->controller_ops->print_char(device, chr, row, column);
+}
+
+/***************************************************************************//**
+ * @brief Allocates the framebuffer and marks the whole display as dirty.
+ *
+ * @param device - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+static int32_t display_fb_init(struct display_dev *device)
+{
+	uint16_t width = device->cols_nb * DISPLAY_CHAR_WIDTH;
+	uint8_t i;
+
+	if (!device->controller_ops->write_page)
+		return -ENOTSUP;
+
+	device->fb = no_os_calloc(device->rows_nb, width);
+	device->dirty_start = no_os_calloc(device->rows_nb,
+					   sizeof(*device->dirty_start));
+	device->dirty_end = no_os_calloc(device->rows_nb,
+					 sizeof(*device->dirty_end));
+	if (!device->fb || !device->dirty_start || !device->dirty_end)
+		return -ENOMEM;
+
+	for (i = 0; i < device->rows_nb; i++)
+		display_fb_mark(device, i, 0, width);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Frees the framebuffer.
+ *
+ * @param device - The device structure.
+*******************************************************************************/
+static void display_fb_remove(struct display_dev *device)
+{
+	no_os_free(device->fb);
+	no_os_free(device->dirty_start);
+	no_os_free(device->dirty_end);
+	device->fb = NULL;
+}
+
 /***************************************************************************//**
  * @brief Initializes the display peripheral.
  *
@@ -55,16 +171,27 @@ int32_t display_init(struct display_dev **device,
 	if (!device || !param)
 		return -EINVAL;
 
-	dev = (struct display_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct display_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 	dev->cols_nb = param->cols_nb;
 	dev->rows_nb = param->rows_nb;
 	dev->controller_ops = param->controller_ops;
 	dev->extra = param->extra;
+	dev->refresh_interval_ms = param->refresh_interval_ms;
+
+	if (param->framebuffer) {
+		ret = display_fb_init(dev);
+		if (ret != 0) {
+			display_fb_remove(dev);
+			no_os_free(dev);
+			return ret;
+		}
+	}
 
 	ret = dev->controller_ops->init(dev);
 	if (ret != 0) {
+		display_fb_remove(dev);
 		no_os_free(dev);
 		return -1;
 	}
@@ -90,6 +217,7 @@ int32_t display_remove(struct display_dev *device)
 	ret = device->controller_ops->remove(device);
 	if (ret != 0)
 		return -1;
+	display_fb_remove(device);
 	no_os_free(device);
 
 	return ret;
@@ -156,7 +284,7 @@ int32_t display_clear(struct display_dev *device)
 
 	for (i = 0; i < device->rows_nb; i++)
 		for (j = 0; j < device->cols_nb; j++) {
-			ret = device->controller_ops->print_char(device, ' ', i, j);
+			ret = display_put_char(device, ' ', i, j);
 			if (ret != 0)
 				return -1;
 		}
@@ -188,14 +316,14 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 	for (i = 0; i < len; i++) {
 		if (r < device->rows_nb) {
 			if (c < device->cols_nb) {
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
 			} else {
 				c = 0U;
 				r++;
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
@@ -221,5 +349,78 @@ int32_t display_print_char(struct display_dev *device, char chr,
 	if (!device)
 		return -EINVAL;
 
-	return device->controller_ops->print_char(device, chr, row, column);
+	return display_put_char(device, chr, row, column);
+}
+
+/***************************************************************************//**
+ * @brief Sends the dirty part of the framebuffer to the display.
+ *
+ * Each dirty page is sent as a single burst covering the columns that
+ * changed since the previous flush.
+ *
+ * @param device - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_flush(struct display_dev *device)
+{
+	uint16_t width, start, end;
+	int32_t ret;
+	uint8_t i;
+
+	if (!device)
+		return -EINVAL;
+
+	if (!device->fb)
+		return -ENOTSUP;
+
+	width = device->cols_nb * DISPLAY_CHAR_WIDTH;
+	for (i = 0; i < device->rows_nb; i++) {
+		start = device->dirty_start[i];
+		end = device->dirty_end[i];
+		if (end == 0)
+			continue;
+
+		ret = device->controller_ops->write_page(device, i, start,
+				device->fb + i * width + start,
+				end - start);
+		if (ret != 0)
+			return ret;
+
+		device->dirty_end[i] = 0;
+	}
+
+	device->last_flush = no_os_get_time();
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Flushes the framebuffer if the refresh interval elapsed.
+ *
+ * Meant to be called after every update, it limits the bus traffic to one
+ * flush per refresh interval. Updates made in between are kept and sent on
+ * the next flush.
+ *
+ * @param device - The device structure.
+ * @return Returns 0 in case of success, -EAGAIN if the refresh interval
+ *         didn't elapse or negative error code otherwise.
+*******************************************************************************/
+int32_t display_refresh(struct display_dev *device)
+{
+	struct no_os_time now;
+	int32_t elapsed_ms;
+
+	if (!device)
+		return -EINVAL;
+
+	if (!device->fb)
+		return -ENOTSUP;
+
+	now = no_os_get_time();
+	elapsed_ms = (int32_t)(now.s - device->last_flush.s) * 1000 +
+		     ((int32_t)now.us - (int32_t)device->last_flush.us) / 1000;
+	if (elapsed_ms >= 0 && (uint32_t)elapsed_ms < device->refresh_interval_ms)
+		return -EAGAIN;
+
+	return display_flush(device);
 }
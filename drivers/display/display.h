@@ -35,8 +35,13 @@
 #define DISPLAY_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
+#include "no_os_delay.h"
+
+/** Width in pixels of a character cell and height in pixels of a page */
+#define DISPLAY_CHAR_WIDTH	8U
 
 /**
  * @struct display_dev
@@ -51,6 +56,16 @@ struct display_dev {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/** RAM copy of the display, one page of cols_nb * 8 bytes per row */
+	uint8_t                    *fb;
+	/** First dirty pixel column of each page */
+	uint16_t                   *dirty_start;
+	/** End of the dirty pixel columns of each page, 0 when clean */
+	uint16_t                   *dirty_end;
+	/** Minimum time between two display_refresh() flushes */
+	uint32_t                   refresh_interval_ms;
+	/** Time of the last flush */
+	struct no_os_time          last_flush;
 };
 
 /**
@@ -66,6 +81,13 @@ struct display_init_param {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/**
+	 * Draw in a RAM framebuffer and send only the dirty part of it on
+	 * display_flush() or display_refresh(). Needs the write_page op.
+	 */
+	bool                       framebuffer;
+	/** Minimum time between two display_refresh() flushes */
+	uint32_t                   refresh_interval_ms;
 };
 
 /**
@@ -85,6 +107,12 @@ struct display_controller_ops {
 			      uint8_t);
 	/** Removes resources allocated by device */
 	int32_t (*remove)(struct display_dev *);
+	/**
+	 * Write len bytes of a page starting at a pixel column in a single
+	 * burst. Optional, needed by the framebuffer.
+	 */
+	int32_t (*write_page)(struct display_dev *, uint8_t, uint16_t,
+			      uint8_t *, uint16_t);
 };
 
 /** Initializes the display peripheral. */
@@ -115,4 +143,10 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 int32_t display_print_char(struct display_dev *device, char chr,
 			   uint8_t row, uint8_t column);
 
+/** Sends the dirty part of the framebuffer to the display. */
+int32_t display_flush(struct display_dev *device);
+
+/** Flushes the framebuffer if the refresh interval elapsed. */
+int32_t display_refresh(struct display_dev *device);
+
 #endif
@@ -37,6 +37,7 @@
 #include "no_os_spi.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include <string.h>
 
 static const uint8_t ASC16[256][8] = {
@@ -339,80 +340,65 @@ int nhd_c12832a1z_write_data(struct nhd_c12832a1z_dev *dev, uint8_t data)
 }
 
 /**
- * @brief nhd_c12832a1z print string on LCD.
+ * @brief nhd_c12832a1z write a data buffer in a single transaction.
  * @param dev - The device structure.
- * @param msg - Message to be printed.
+ * @param data - Data to be written, left unchanged.
+ * @param len - Number of bytes to write.
  * @return Returns 0 in case of success or negative error code otherwise.
  */
-int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg)
+int nhd_c12832a1z_write_buf(struct nhd_c12832a1z_dev *dev, uint8_t *data,
+			    uint32_t len)
 {
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.bytes_number = len,
+		.cs_change = 1,
+	};
+	uint8_t buff[NR_COLUMNS];
 	int ret;
-	unsigned int i, j;
-	uint8_t framebuffer_memory[NR_PAGES][NR_COLUMNS] = { 0 };
-	uint8_t page = PAGE_START_ADDR;
-	int32_t count = strlen(msg);
-	int32_t t_cursor = 0;
-
-	if ((t_cursor + count) > NR_COLUMNS)
-		count = NR_COLUMNS - t_cursor;
 
-	for (j = 0; j < count; ++j) {
-		int cursor = (t_cursor + j) % NR_CHAR;
-		int y = cursor >> 4; // page
-		int x = (cursor & 0xf) << 3; // segment
-
-		for (i = 0; i < 8; i++)
-			framebuffer_memory[y][x + i] = ASC16[msg[cursor]][i];
-	}
+	if (!dev->spi_desc || !dev->dc_pin)
+		return -EINVAL;
 
-	ret = nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_OFF);
+	ret = no_os_gpio_set_value(dev->dc_pin, NHD_C12832A1Z_DC_DATA);
 	if (ret)
 		return ret;
 
-	ret = nhd_c12832a1z_write_cmd(dev,
-				      DISPLAY_START_OFFSET); // Display start address + 0x40
-	if (ret)
+	ret = no_os_spi_transfer_dma(dev->spi_desc, &msg, 1);
+	if (ret != -ENOSYS)
 		return ret;
 
-	for (i = 0; i < 4; i++) {
-		// 32pixel display / 8 pixels per page = 4 pages
-		ret = nhd_c12832a1z_write_cmd(dev, page); // send page address
-		if (ret)
-			return ret;
-
-		// Sets the most significant 4 bits of the display RAM column address.
-		ret = nhd_c12832a1z_write_cmd(dev, 0x10); // column address upper 4 bits + 0x10
-		// Sets the least significant 4 bits of the display RAM column address.
-		if (ret)
-			return ret;
-
-		ret = nhd_c12832a1z_write_cmd(dev, 0x00); // column address lower 4 bits + 0x00
+	/* write_and_read() overwrites the buffer, send a copy */
+	while (len) {
+		msg.bytes_number = no_os_min_t(uint32_t, len, NR_COLUMNS);
+		memcpy(buff, data, msg.bytes_number);
+		ret = no_os_spi_write_and_read(dev->spi_desc, buff,
+					       msg.bytes_number);
 		if (ret)
 			return ret;
 
-		for (j = 0; j < 128; j++) {
-			// 128 columns wide
-			ret = nhd_c12832a1z_write_data(dev,
-						       framebuffer_memory[i][j]); // send picture data
-			if (ret)
-				return ret;
-		}
-		page++; // after 128 columns, go to next page
+		data += msg.bytes_number;
+		len -= msg.bytes_number;
 	}
 
-	return nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_ON);
+	return 0;
 }
 
 /**
- * @brief nhd_c12832a1z clear LCD.
+ * @brief nhd_c12832a1z write the dirty pages of the framebuffer.
+ *
+ * Each page is written with a single data transaction.
+ *
  * @param dev - The device structure.
  * @return Returns 0 in case of success or negative error code otherwise.
  */
-int nhd_c12832a1z_clear_lcd(struct nhd_c12832a1z_dev *dev)
+int nhd_c12832a1z_flush(struct nhd_c12832a1z_dev *dev)
 {
 	int ret;
 	unsigned int i;
-	uint8_t page = PAGE_START_ADDR;
+
+	if (!dev->dirty)
+		return 0;
 
 	ret = nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_OFF);
 	if (ret)
@@ -422,31 +408,89 @@ int nhd_c12832a1z_clear_lcd(struct nhd_c12832a1z_dev *dev)
 				      DISPLAY_START_OFFSET); // Display start address + 0x40
 	if (ret)
 		return ret;
+
 	for (i = 0; i < NR_PAGES; i++) {
+		if (!(dev->dirty & NO_OS_BIT(i)))
+			continue;
+
 		// 32pixel display / 8 pixels per page = 4 pages
-		ret = nhd_c12832a1z_write_cmd(dev, page); // send page address
+		ret = nhd_c12832a1z_write_cmd(dev, PAGE_START_ADDR + i); // send page address
 		if (ret)
 			return ret;
+
 		// Sets the most significant 4 bits of the display RAM column address.
 		ret = nhd_c12832a1z_write_cmd(dev, 0x10); // column address upper 4 bits + 0x10
 		// Sets the least significant 4 bits of the display RAM column address.
 		if (ret)
 			return ret;
+
 		ret = nhd_c12832a1z_write_cmd(dev, 0x00); // column address lower 4 bits + 0x00
 		if (ret)
 			return ret;
-		for (unsigned int j = 0; j < NR_COLUMNS; j++) {
-			// 128 columns wide
-			ret = nhd_c12832a1z_write_data(dev, 0x00); // send picture data
-			if (ret)
-				return ret;
-		}
-		page++; // after 128 columns, go to next page
+
+		// 128 columns wide
+		ret = nhd_c12832a1z_write_buf(dev, dev->fb[i], NR_COLUMNS);
+		if (ret)
+			return ret;
+
+		dev->dirty &= ~NO_OS_BIT(i);
 	}
 
 	return nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_ON);
 }
 
+/**
+ * @brief nhd_c12832a1z print string on LCD.
+ *
+ * Only the pages whose content changes are written to the display.
+ *
+ * @param dev - The device structure.
+ * @param msg - Message to be printed.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg)
+{
+	unsigned int i, j;
+	uint8_t framebuffer_memory[NR_PAGES][NR_COLUMNS] = { 0 };
+	int32_t count = strlen(msg);
+	int32_t t_cursor = 0;
+
+	if ((t_cursor + count) > NR_COLUMNS)
+		count = NR_COLUMNS - t_cursor;
+
+	for (j = 0; j < count; ++j) {
+		int cursor = (t_cursor + j) % NR_CHAR;
+		int y = cursor >> 4; // page
+		int x = (cursor & 0xf) << 3; // segment
+
+		for (i = 0; i < 8; i++)
+			framebuffer_memory[y][x + i] = ASC16[(uint8_t)msg[cursor]][i];
+	}
+
+	for (i = 0; i < NR_PAGES; i++) {
+		if (!memcmp(dev->fb[i], framebuffer_memory[i], NR_COLUMNS))
+			continue;
+
+		memcpy(dev->fb[i], framebuffer_memory[i], NR_COLUMNS);
+		dev->dirty |= NO_OS_BIT(i);
+	}
+
+	return nhd_c12832a1z_flush(dev);
+}
+
+/**
+ * @brief nhd_c12832a1z clear LCD.
+ * @param dev - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int nhd_c12832a1z_clear_lcd(struct nhd_c12832a1z_dev *dev)
+{
+	memset(dev->fb, 0, sizeof(dev->fb));
+	dev->dirty = NO_OS_GENMASK(NR_PAGES - 1, 0);
+
+	return nhd_c12832a1z_flush(dev);
+}
+
 /**
  * @brief Initializes nhd_c12832a1z for display screening.
  * @param device - The device structure.
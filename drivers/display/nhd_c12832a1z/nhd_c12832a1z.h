@@ -78,6 +78,10 @@ struct nhd_c12832a1z_dev {
 	struct no_os_gpio_desc     	*reset_pin;
 	/* SPI descriptor*/
 	struct no_os_spi_desc		*spi_desc;
+	/** Content of the display RAM */
+	uint8_t				fb[NR_PAGES][NR_COLUMNS];
+	/** Pages of fb not yet written to the display, one bit per page */
+	uint8_t				dirty;
 };
 
 /**
@@ -99,6 +103,13 @@ int nhd_c12832a1z_write_cmd(struct nhd_c12832a1z_dev *dev, uint8_t cmd);
 /* nhd_c12832a1z write data */
 int nhd_c12832a1z_write_data(struct nhd_c12832a1z_dev *dev, uint8_t data);
 
+/* nhd_c12832a1z write a data buffer in a single transaction */
+int nhd_c12832a1z_write_buf(struct nhd_c12832a1z_dev *dev, uint8_t *data,
+			    uint32_t len);
+
+/* nhd_c12832a1z write the dirty pages of the framebuffer */
+int nhd_c12832a1z_flush(struct nhd_c12832a1z_dev *dev);
+
 /* nhd_c12832a1z print string on LCD */
 int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg);
 
@@ -53,7 +53,8 @@ const struct display_controller_ops ssd1306_ops = {
 	.display_on_off = &ssd_1306_display_on_off,
 	.move_cursor = &ssd_1306_move_cursor,
 	.print_char = &ssd_1306_print_ascii,
-	.remove = &ssd_1306_remove
+	.remove = &ssd_1306_remove,
+	.write_page = &ssd_1306_write_page
 };
 
 extern const uint8_t no_os_chr_8x8[128][8];
@@ -158,7 +159,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 			return -1;
 	}
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xA8;
 	command[1] = 0x3F;
@@ -166,7 +166,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xD3;
 	command[1] = 0x00;
@@ -174,28 +173,24 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0x40;
 	ret = ssd1306_buffer_transmit(extra, command, 1U, SSD1306_CMD);
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xA0;
 	ret = ssd1306_buffer_transmit(extra, command, 1U, SSD1306_CMD);
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xC0;
 	ret = ssd1306_buffer_transmit(extra, command, 1U, SSD1306_CMD);
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xDA;
 	command[1] = 0x02;
@@ -203,7 +198,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0x81;
 	command[1] = 0x7F;
@@ -211,14 +205,12 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xA4;
 	ret = ssd1306_buffer_transmit(extra, command, 1U, SSD1306_CMD);
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xD5;
 	command[1] = 0x80;
@@ -226,7 +218,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0x8D;
 	command[1] = 0x14;
@@ -234,7 +225,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 	if (ret != 0)
 		return -1;
 
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0xAF;
 	ret = ssd1306_buffer_transmit(extra, command, 1U, SSD1306_CMD);
@@ -242,7 +232,6 @@ int32_t ssd_1306_init(struct display_dev *device)
 		return -1;
 
 	// set addressing mode
-	printf("Line: %d\n\r", __LINE__);
 	no_os_udelay(3U);
 	command[0] = 0x20;
 	command[1] = 0x00;
@@ -322,6 +311,65 @@ int32_t ssd_1306_print_ascii(struct display_dev *device, uint8_t ascii,
 	return ssd1306_buffer_transmit(extra, ch, SSD1306_CHARSZ, SSD1306_DATA);
 }
 
+/***************************************************************************//**
+ * @brief Writes a run of columns of a page in a single data burst.
+ *
+ * On SPI the data is sent over DMA when the platform supports it.
+ *
+ * @param device - The device structure.
+ * @param page   - page
+ * @param column - first pixel column
+ * @param data   - column bytes
+ * @param len    - number of columns
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t ssd_1306_write_page(struct display_dev *device, uint8_t page,
+			    uint16_t column, uint8_t *data, uint16_t len)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.bytes_number = len,
+		.cs_change = 1,
+	};
+	int32_t ret;
+	uint8_t command[6];
+	ssd_1306_extra *extra;
+
+	if (!len || column + len > device->cols_nb * SSD1306_CHARSZ)
+		return -EINVAL;
+
+	extra = device->extra;
+
+	command[0] = 0x21;
+	command[1] = column;
+	command[2] = column + len - 1U;
+	command[3] = 0x22;
+	command[4] = page;
+	command[5] = page;
+	ret = ssd1306_buffer_transmit(extra, command, 6U, SSD1306_CMD);
+	if (ret != 0)
+		return ret;
+
+	if (extra->comm_type != SSD1306_SPI)
+		return ssd1306_buffer_transmit(extra, data, len, SSD1306_DATA);
+
+	if (extra->dc_pin) {
+		ret = no_os_gpio_set_value(extra->dc_pin, SSD1306_DC_DATA);
+		if (ret != 0)
+			return ret;
+	}
+
+	ret = no_os_spi_transfer_dma(extra->spi_desc, &msg, 1);
+	if (ret != -ENOSYS)
+		return ret;
+
+	/* write_and_read() overwrites the buffer, send a copy */
+	uint8_t buff_tmp[len];
+	memcpy(buff_tmp, data, len);
+
+	return no_os_spi_write_and_read(extra->spi_desc, buff_tmp, len);
+}
+
 /***************************************************************************//**
  * @brief Removes resources allocated by device.
  *
@@ -156,6 +156,7 @@ void adis_remove(struct adis_dev *adis)
 	if (adis->spi_desc)
 		no_os_spi_remove(adis->spi_desc);
 
+	adis_fifo_buffers_free(adis);
 	no_os_free(adis);
 }
 
@@ -4074,6 +4075,119 @@ int adis_read_burst_data(struct adis_dev *adis, struct adis_burst_data *data,
 	return 0;
 }
 
+/**
+ * @brief Read multiple FIFO burst data samples in a single SPI transfer.
+ * @param adis       - The adis device.
+ * @param data       - Array of at least nb_samples burst read data structures
+ *		       to be populated.
+ * @param nb_samples - Number of burst reads to be performed, all of them
+ *		       popping the FIFO except the last one. At most the
+ *		       number passed to adis_fifo_buffers_alloc(). Updated
+ *		       with the number of valid samples stored in data.
+ * @param burst32    - True if 32-bit data is requested for accel
+ *		       and gyro (or delta angle and delta velocity)
+ *		       measurements, false if 16-bit data is requested.
+ * @param burst_sel  - 0 if accel and gyro data is requested, 1
+ *		       if delta angle and delta velocity is requested.
+ * @param crc_check  - If true samples with invalid CRC are dropped.
+ * @return 0 in case of success, error code otherwise.
+ * -EAGAIN in case the request has to be sent again due to data being unavailable
+ * at the time of the request.
+ */
+int adis_read_burst_data_fifo(struct adis_dev *adis,
+			      struct adis_burst_data *data, uint32_t *nb_samples,
+			      bool burst32, uint8_t burst_sel, bool crc_check)
+{
+	int ret = 0;
+
+	if (!data || !nb_samples || !*nb_samples)
+		return -EINVAL;
+
+	if (*nb_samples > adis->fifo_max_reads)
+		return -EINVAL;
+
+	/* Device does not support multiple FIFO readings in one transfer */
+	if (!(adis->info->flags & ADIS_HAS_FIFO) || !adis->info->read_fifo_burst_data)
+		return -EINVAL;
+
+	/* Device does not support delta data readings with burst method */
+	if (!(adis->info->flags & ADIS_HAS_BURST_DELTA_DATA) && burst_sel)
+		return -EINVAL;
+
+	/* Device does not support burst32 readings with burst method */
+	if (!(adis->info->flags & ADIS_HAS_BURST32) && burst32)
+		return -EINVAL;
+
+	if (adis->info->flags & ADIS_HAS_BURST32) {
+		if (adis->burst32 != burst32) {
+			ret = adis_write_burst32(adis, burst32);
+			if (ret)
+				return ret;
+			ret = -EAGAIN;
+		}
+		if (adis->burst_sel != burst_sel) {
+			ret = adis_write_burst_sel(adis, burst_sel);
+			if (ret)
+				return ret;
+			ret = -EAGAIN;
+		}
+	}
+
+	/* Data in the new format is available only after the next data ready. */
+	if (ret == -EAGAIN)
+		return ret;
+
+	return adis->info->read_fifo_burst_data(adis, data, nb_samples, burst32,
+						crc_check);
+}
+
+/**
+ * @brief Allocate the SPI messages and frames used by
+ *	  adis_read_burst_data_fifo(), so that no allocation is done per read.
+ * @param adis      - The adis device.
+ * @param max_reads - Maximum number of burst reads of one FIFO read.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_fifo_buffers_alloc(struct adis_dev *adis, uint32_t max_reads)
+{
+	if (!max_reads)
+		return -EINVAL;
+
+	/* Device does not support multiple FIFO readings in one transfer */
+	if (!adis->info->fifo_frame_size)
+		return -EINVAL;
+
+	adis_fifo_buffers_free(adis);
+
+	adis->fifo_msgs = no_os_calloc(max_reads, sizeof(*adis->fifo_msgs));
+	if (!adis->fifo_msgs)
+		return -ENOMEM;
+
+	adis->fifo_frames = no_os_calloc(max_reads, adis->info->fifo_frame_size);
+	if (!adis->fifo_frames) {
+		no_os_free(adis->fifo_msgs);
+		adis->fifo_msgs = NULL;
+		return -ENOMEM;
+	}
+
+	adis->fifo_max_reads = max_reads;
+
+	return 0;
+}
+
+/**
+ * @brief Free the buffers allocated by adis_fifo_buffers_alloc().
+ * @param adis - The adis device.
+ */
+void adis_fifo_buffers_free(struct adis_dev *adis)
+{
+	no_os_free(adis->fifo_frames);
+	no_os_free(adis->fifo_msgs);
+	adis->fifo_frames = NULL;
+	adis->fifo_msgs = NULL;
+	adis->fifo_max_reads = 0;
+}
+
 /**
  * @brief Update external clock frequency.
  * @param adis     - The adis device.
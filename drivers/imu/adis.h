@@ -286,6 +286,12 @@ struct adis_dev {
 	uint8_t				burst_sel;
 	/** Device is locked, only data readings are allowed, no configuration allowed. */
 	bool				is_locked;
+	/** SPI messages of a FIFO read, allocated by adis_fifo_buffers_alloc(). */
+	struct no_os_spi_msg		*fifo_msgs;
+	/** Frames of a FIFO read, allocated by adis_fifo_buffers_alloc(). */
+	uint8_t				*fifo_frames;
+	/** Number of burst reads fifo_msgs and fifo_frames can hold. */
+	uint32_t			fifo_max_reads;
 };
 
 /** @struct adis_init_param
@@ -891,6 +897,14 @@ int adis_write_fir_coef(struct adis_dev *adis, uint8_t coef_idx, uint32_t coef);
 /*! Read burst data */
 int adis_read_burst_data(struct adis_dev *adis, struct adis_burst_data *data,
 			 bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check);
+/*! Read multiple FIFO burst data samples in a single SPI transfer. */
+int adis_read_burst_data_fifo(struct adis_dev *adis,
+			      struct adis_burst_data *data, uint32_t *nb_samples,
+			      bool burst32, uint8_t burst_sel, bool crc_check);
+/*! Allocate the buffers of adis_read_burst_data_fifo(). */
+int adis_fifo_buffers_alloc(struct adis_dev *adis, uint32_t max_reads);
+/*! Free the buffers of adis_read_burst_data_fifo(). */
+void adis_fifo_buffers_free(struct adis_dev *adis);
 
 /*! Update external clock frequency. */
 int adis_update_ext_clk_freq(struct adis_dev *adis, uint32_t clk_freq);
@@ -35,12 +35,15 @@
 #include "adis_internals.h"
 #include "adis1657x.h"
 #include "no_os_units.h"
+#include "no_os_alloc.h"
 #include <string.h>
 
 #define ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO	20 /* in bytes */
 #define ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO	34 /* in bytes */
 #define ADIS1657X_READ_BURST_DATA_NO_POP	0x00
 #define ADIS1657X_CHECKSUM_BUF_IDX_FIFO		2
+/* From data-sheet, minimum time between burst reads in us */
+#define ADIS1657X_FIFO_READ_DELAY		10
 
 static const struct adis_data_field_map_def adis1657x_def = {
 	.x_gyro 		 = {.reg_addr = 0x04, .reg_size = 0x04, .field_mask = 0xFFFFFFFF},
@@ -239,67 +242,25 @@ static int adis1657x_get_scale(struct adis_dev *adis,
 }
 
 /**
- * @brief Read burst data.
+ * @brief Decode one burst read frame.
  * @param adis      - The adis device.
+ * @param buffer    - Burst frame, including the command bytes.
  * @param data      - The burst read data structure to be populated.
- * @param burst32   - True if 32-bit data is requested for accel
- *		      and gyro (or delta angle and delta velocity)
- *		      measurements, false if 16-bit data is requested.
- * @param burst_sel - 0 if accel and gyro data is requested, 1
- *		      if delta angle and delta velocity is requested.
- * @param fifo_pop  - In case FIFO is present, will pop the fifo if
- * 		      true. Unused if FIFO is not present.
+ * @param burst32   - True if the frame holds 32-bit data.
  * @param crc_check - If true CRC will be checked, if false check will be skipped.
  * @return 0 in case of success, error code otherwise.
- * -EAGAIN in case the request has to be sent again due to data being unavailable
- * at the time of the request.
+ * -EAGAIN in case the frame holds no data.
  */
-int adis1657x_read_burst_data(struct adis_dev *adis,
-			      struct adis_burst_data *data,
-			      bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check)
+static int adis1657x_decode_burst_data(struct adis_dev *adis, uint8_t *buffer,
+				       struct adis_burst_data *data,
+				       bool burst32, bool crc_check)
 {
-	int ret = 0;
 	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
 	uint8_t idx;
 
-	if (adis->info->flags & ADIS_HAS_BURST32) {
-		if (adis->burst32 != burst32) {
-			ret = adis_write_burst32(adis, burst32);
-			if (ret)
-				return ret;
-			ret = -EAGAIN;
-		}
-		if (adis->burst_sel != burst_sel) {
-			ret = adis_write_burst_sel(adis, burst_sel);
-			if (ret)
-				return ret;
-			ret = -EAGAIN;
-		}
-	}
-
-	/* If burst32 or burst select has changed, wait for the next reading
-	   request to actually read the data, because the according data will be available
-	   only after the next data ready impulse. */
-	if (ret == -EAGAIN)
-		return ret;
-
 	if (burst32)
 		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
 
-	uint8_t buffer[msg_size + ADIS_READ_BURST_DATA_CMD_SIZE];
-
-	if (!fifo_pop)
-		buffer[0] = ADIS1657X_READ_BURST_DATA_NO_POP;
-	else
-		buffer[0] = ADIS_READ_BURST_DATA_CMD_MSB;
-
-	buffer[1] = ADIS_READ_BURST_DATA_CMD_LSB;
-
-	ret = no_os_spi_write_and_read(adis->spi_desc, buffer,
-				       msg_size + ADIS_READ_BURST_DATA_CMD_SIZE);
-	if (ret)
-		return ret;
-
 	for (idx = ADIS_READ_BURST_DATA_CMD_SIZE; idx < msg_size; idx++)
 		if (buffer[idx] != 0)
 			break;
@@ -358,7 +319,7 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 	/* Temp data */
 	memcpy(&data->temp_lsb, &buffer[temp_offset], 2);
 	/* Counter data - aligned */
-	data->data_cntr_lsb = no_os_get_unaligned_be16(&buffer[data_cntr_offset]);;
+	data->data_cntr_lsb = no_os_get_unaligned_be16(&buffer[data_cntr_offset]);
 	data->data_cntr_msb = 0;
 	/* Update diagnosis flags at each reading */
 	adis_update_diag_flags(adis, buffer[ADIS_READ_BURST_DATA_CMD_SIZE]);
@@ -366,6 +327,135 @@ int adis1657x_read_burst_data(struct adis_dev *adis,
 	return 0;
 }
 
+/**
+ * @brief Read burst data.
+ * @param adis      - The adis device.
+ * @param data      - The burst read data structure to be populated.
+ * @param burst32   - True if 32-bit data is requested for accel
+ *		      and gyro (or delta angle and delta velocity)
+ *		      measurements, false if 16-bit data is requested.
+ * @param burst_sel - 0 if accel and gyro data is requested, 1
+ *		      if delta angle and delta velocity is requested.
+ * @param fifo_pop  - In case FIFO is present, will pop the fifo if
+ * 		      true. Unused if FIFO is not present.
+ * @param crc_check - If true CRC will be checked, if false check will be skipped.
+ * @return 0 in case of success, error code otherwise.
+ * -EAGAIN in case the request has to be sent again due to data being unavailable
+ * at the time of the request.
+ */
+int adis1657x_read_burst_data(struct adis_dev *adis,
+			      struct adis_burst_data *data,
+			      bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check)
+{
+	int ret = 0;
+	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
+
+	if (adis->info->flags & ADIS_HAS_BURST32) {
+		if (adis->burst32 != burst32) {
+			ret = adis_write_burst32(adis, burst32);
+			if (ret)
+				return ret;
+			ret = -EAGAIN;
+		}
+		if (adis->burst_sel != burst_sel) {
+			ret = adis_write_burst_sel(adis, burst_sel);
+			if (ret)
+				return ret;
+			ret = -EAGAIN;
+		}
+	}
+
+	/* If burst32 or burst select has changed, wait for the next reading
+	   request to actually read the data, because the according data will be available
+	   only after the next data ready impulse. */
+	if (ret == -EAGAIN)
+		return ret;
+
+	if (burst32)
+		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
+
+	uint8_t buffer[msg_size + ADIS_READ_BURST_DATA_CMD_SIZE];
+
+	if (!fifo_pop)
+		buffer[0] = ADIS1657X_READ_BURST_DATA_NO_POP;
+	else
+		buffer[0] = ADIS_READ_BURST_DATA_CMD_MSB;
+
+	buffer[1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+	ret = no_os_spi_write_and_read(adis->spi_desc, buffer,
+				       msg_size + ADIS_READ_BURST_DATA_CMD_SIZE);
+	if (ret)
+		return ret;
+
+	return adis1657x_decode_burst_data(adis, buffer, data, burst32, crc_check);
+}
+
+/**
+ * @brief Read multiple FIFO burst data samples in a single SPI transfer.
+ * The minimum time between two burst reads is inserted as chip select change
+ * delay between the messages of one blocking no_os_spi_transfer() call. The
+ * messages and frames are the ones allocated by adis_fifo_buffers_alloc().
+ * @param adis       - The adis device.
+ * @param data       - Array of burst read data structures to be populated.
+ * @param nb_samples - Number of burst reads to be performed, all of them
+ *		       popping the FIFO except the last one. Updated with the
+ *		       number of valid samples stored in data.
+ * @param burst32    - True if 32-bit data is requested.
+ * @param crc_check  - If true samples with invalid CRC are dropped.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis1657x_read_fifo_burst_data(struct adis_dev *adis,
+				   struct adis_burst_data *data,
+				   uint32_t *nb_samples, bool burst32, bool crc_check)
+{
+	uint8_t msg_size = ADIS1657X_MSG_SIZE_16_BIT_BURST_FIFO;
+	struct no_os_spi_msg *msgs = adis->fifo_msgs;
+	uint8_t *buffer = adis->fifo_frames;
+	bool checksum_err = false;
+	uint32_t valid = 0;
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	if (burst32)
+		msg_size = ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO;
+
+	for (i = 0; i < *nb_samples; i++) {
+		frame = &buffer[i * (msg_size + ADIS_READ_BURST_DATA_CMD_SIZE)];
+		if (i == *nb_samples - 1)
+			frame[0] = ADIS1657X_READ_BURST_DATA_NO_POP;
+		else
+			frame[0] = ADIS_READ_BURST_DATA_CMD_MSB;
+		frame[1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+		msgs[i].tx_buff = frame;
+		msgs[i].rx_buff = frame;
+		msgs[i].bytes_number = msg_size + ADIS_READ_BURST_DATA_CMD_SIZE;
+		msgs[i].cs_change = 1;
+		msgs[i].cs_change_delay = ADIS1657X_FIFO_READ_DELAY;
+	}
+
+	ret = no_os_spi_transfer(adis->spi_desc, msgs, *nb_samples);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < *nb_samples; i++) {
+		frame = &buffer[i * (msg_size + ADIS_READ_BURST_DATA_CMD_SIZE)];
+		ret = adis1657x_decode_burst_data(adis, frame, &data[valid],
+						  burst32, crc_check);
+		if (ret == -EINVAL)
+			checksum_err = true;
+		if (!ret)
+			valid++;
+	}
+
+	adis->diag_flags.checksum_err = checksum_err;
+	*nb_samples = valid;
+
+	return valid ? 0 : -EAGAIN;
+}
+
 const struct adis_chip_info adis1657x_chip_info = {
 	.field_map		= &adis1657x_def,
 	.sync_clk_freq_limits	= adis1657x_sync_clk_freq_limits,
@@ -374,6 +464,8 @@ const struct adis_chip_info adis1657x_chip_info = {
 	.read_delay 		= 5,
 	.write_delay 		= 0,
 	.cs_change_delay 	= 5,
+	.fifo_frame_size	= ADIS1657X_MSG_SIZE_32_BIT_BURST_FIFO +
+				  ADIS_READ_BURST_DATA_CMD_SIZE,
 	.filt_size_var_b_max 	= 6,
 	.dec_rate_max 		= 1999,
 	.sync_mode_max 		= ADIS_SYNC_OUTPUT,
@@ -383,4 +475,5 @@ const struct adis_chip_info adis1657x_chip_info = {
 	.flags			= ADIS_HAS_BURST32 | ADIS_HAS_BURST_DELTA_DATA | ADIS_HAS_FIFO,
 	.get_scale		= &adis1657x_get_scale,
 	.read_burst_data	= &adis1657x_read_burst_data,
+	.read_fifo_burst_data	= &adis1657x_read_fifo_burst_data,
 };
@@ -438,6 +438,11 @@ struct adis_chip_info {
 	uint32_t 				write_delay;
 	/** Chip specific chip select change delay for SPI transactions. */
 	uint32_t 				cs_change_delay;
+	/** Chip specific size of the largest FIFO burst read frame, including
+	 *  the command bytes. 0 if reading the FIFO in one transfer is not
+	 *  supported.
+	 */
+	uint32_t 				fifo_frame_size;
 	/** Chip specific flag to specify whether the SPI transaction addressing
 	 *  supports paging.
 	 */
@@ -473,6 +478,13 @@ struct adis_chip_info {
 	/** Chip specifc implementation for reading burst data. */
 	int (*read_burst_data)(struct adis_dev *adis, struct adis_burst_data *data,
 			       bool burst32, uint8_t burst_sel, bool fifo_pop, bool crc_check);
+	/** Chip specific implementation for reading multiple FIFO samples in a
+	 *  single SPI transfer.
+	 */
+	int (*read_fifo_burst_data)(struct adis_dev *adis,
+				    struct adis_burst_data *data,
+				    uint32_t *nb_samples, bool burst32,
+				    bool crc_check);
 	/** Chip specific implementation for reading channel offset. */
 	int (*get_offset)(struct adis_dev *adis,
 			  int *offset,
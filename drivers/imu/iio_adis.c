@@ -34,6 +34,7 @@
 #include "iio_adis_internals.h"
 #include "no_os_delay.h"
 #include "no_os_units.h"
+#include "no_os_alloc.h"
 #include <stdio.h>
 #include <string.h>
 #include "adis.h"
@@ -1448,6 +1449,57 @@ int adis_iio_pre_enable(void* dev, uint32_t mask)
 	return adis_read_sync_mode(adis, &iio_adis->sync_mode);
 }
 
+/**
+ * @brief API to be called before trigger is enabled, for devices reading the
+ * FIFO. Allocates the FIFO read buffers, sized by the number of samples of the
+ * buffer, so that the trigger handler does not allocate memory.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_iio_pre_enable_buffer(struct iio_device_data *dev_data)
+{
+	struct adis_iio_dev *iio_adis;
+	uint32_t max_reads;
+	int ret;
+
+	if (!dev_data || !dev_data->dev || !dev_data->buffer)
+		return -EINVAL;
+
+	iio_adis = (struct adis_iio_dev *)dev_data->dev;
+
+	if (!iio_adis->adis_dev)
+		return -EINVAL;
+
+	if (iio_adis->has_fifo) {
+		/* Burst request, one read per FIFO sample and a last one without pop */
+		max_reads = dev_data->buffer->samples + 1;
+		ret = adis_fifo_buffers_alloc(iio_adis->adis_dev, max_reads);
+		if (ret)
+			return ret;
+
+		no_os_free(iio_adis->fifo_data);
+		iio_adis->fifo_data = no_os_calloc(max_reads,
+						   sizeof(*iio_adis->fifo_data));
+		if (!iio_adis->fifo_data) {
+			ret = -ENOMEM;
+			goto free_fifo;
+		}
+	}
+
+	ret = adis_iio_pre_enable(iio_adis, dev_data->buffer->active_mask);
+	if (ret)
+		goto free_fifo;
+
+	return 0;
+
+free_fifo:
+	no_os_free(iio_adis->fifo_data);
+	iio_adis->fifo_data = NULL;
+	adis_fifo_buffers_free(iio_adis->adis_dev);
+
+	return ret;
+}
+
 /**
  * @brief API to be called after trigger is disabled.
  * @param dev  - The iio device structure.
@@ -1469,44 +1521,35 @@ int adis_iio_post_disable(void* dev, uint32_t mask)
 
 	adis = iio_adis->adis_dev;
 
-	if (iio_adis->has_fifo)
+	if (iio_adis->has_fifo) {
+		no_os_free(iio_adis->fifo_data);
+		iio_adis->fifo_data = NULL;
+		adis_fifo_buffers_free(adis);
+
 		return adis_write_fifo_en(adis, 0);
+	}
 
 	return 0;
 }
 
 /**
- * @brief API to be called to get one single sample-set based on the given mask.
+ * @brief Account lost samples and push one sample-set based on the given mask.
  * @param iio_adis - The iio adis structure.
+ * @param data     - The burst data read from the device.
  * @param mask     - The active channels mask.
  * @param buffer   - IIO buffer to push the sample set to.
  * @return 0 in case of success, error code otherwise.
  */
-static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
-		uint32_t mask, struct iio_buffer *buffer, bool pop)
+static int adis_iio_push_burst_data(struct adis_iio_dev *iio_adis,
+				    struct adis_burst_data *data,
+				    uint32_t mask, struct iio_buffer *buffer)
 {
-	struct adis_dev *adis;
-	int ret;
-	struct adis_burst_data data;
 	uint8_t i = 0;
 	uint32_t res1;
 	uint32_t res2;
 	uint8_t chan;
 
-	adis = iio_adis->adis_dev;
-
-	ret = adis_read_burst_data(adis, &data, iio_adis->burst_size,
-				   iio_adis->burst_sel, pop, false);
-
-	/* If ret ==  EAGAIN then no data is available to read (will happen
-	for a burst request or in case burst32 or burst select has been changed) */
-	if (ret == -EAGAIN)
-		return 0;
-
-	if (ret)
-		return ret;
-
-	uint32_t current_data_cntr = data.data_cntr_lsb | data.data_cntr_msb << 16;
+	uint32_t current_data_cntr = data->data_cntr_lsb | data->data_cntr_msb << 16;
 
 	if (iio_adis->data_cntr) {
 		if (current_data_cntr > iio_adis->data_cntr) {
@@ -1543,9 +1586,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 			case ADIS_TEMP:
 
 				if (iio_adis->iio_dev->channels[chan].scan_type->storagebits == 32)
-					iio_adis->data[i++] = data.temp_msb;
+					iio_adis->data[i++] = data->temp_msb;
 
-				iio_adis->data[i++] = data.temp_lsb;
+				iio_adis->data[i++] = data->temp_lsb;
 				/*
 				 * The temperature channel has 16-bit storage size.
 				 * We need to perform the padding to have the buffer
@@ -1564,9 +1607,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_gyro_msb;
+					iio_adis->data[i++] = data->x_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_gyro_lsb;
+					iio_adis->data[i++] =  data->x_gyro_lsb;
 				}
 				break;
 			case ADIS_GYRO_Y:
@@ -1575,9 +1618,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_gyro_msb;
+					iio_adis->data[i++] = data->y_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_gyro_lsb;
+					iio_adis->data[i++] =  data->y_gyro_lsb;
 				}
 				break;
 			case ADIS_GYRO_Z:
@@ -1586,9 +1629,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_gyro_msb;
+					iio_adis->data[i++] = data->z_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_gyro_lsb;
+					iio_adis->data[i++] =  data->z_gyro_lsb;
 				}
 				break;
 			case ADIS_ACCEL_X:
@@ -1597,9 +1640,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_accel_msb;
+					iio_adis->data[i++] = data->x_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_accel_lsb;
+					iio_adis->data[i++] =  data->x_accel_lsb;
 				}
 				break;
 			case ADIS_ACCEL_Y:
@@ -1608,9 +1651,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_accel_msb;
+					iio_adis->data[i++] = data->y_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_accel_lsb;
+					iio_adis->data[i++] =  data->y_accel_lsb;
 				}
 				break;
 			case ADIS_ACCEL_Z:
@@ -1619,9 +1662,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_accel_msb;
+					iio_adis->data[i++] = data->z_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_accel_lsb;
+					iio_adis->data[i++] =  data->z_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_X:
@@ -1630,9 +1673,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_gyro_msb;
+					iio_adis->data[i++] = data->x_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_gyro_lsb;
+					iio_adis->data[i++] =  data->x_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_Y:
@@ -1641,9 +1684,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_gyro_msb;
+					iio_adis->data[i++] = data->y_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_gyro_lsb;
+					iio_adis->data[i++] =  data->y_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_ANGL_Z:
@@ -1652,9 +1695,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_gyro_msb;
+					iio_adis->data[i++] = data->z_gyro_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_gyro_lsb;
+					iio_adis->data[i++] =  data->z_gyro_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_X:
@@ -1663,9 +1706,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.x_accel_msb;
+					iio_adis->data[i++] = data->x_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.x_accel_lsb;
+					iio_adis->data[i++] =  data->x_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_Y:
@@ -1674,9 +1717,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.y_accel_msb;
+					iio_adis->data[i++] = data->y_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.y_accel_lsb;
+					iio_adis->data[i++] =  data->y_accel_lsb;
 				}
 				break;
 			case ADIS_DELTA_VEL_Z:
@@ -1685,9 +1728,9 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 					iio_adis->data[i++] = 0;
 				} else {
 					/* upper 16 */
-					iio_adis->data[i++] = data.z_accel_msb;
+					iio_adis->data[i++] = data->z_accel_msb;
 					/* lower 16 */
-					iio_adis->data[i++] =  data.z_accel_lsb;
+					iio_adis->data[i++] =  data->z_accel_lsb;
 				}
 				break;
 			default:
@@ -1699,6 +1742,36 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 	return iio_buffer_push_scan(buffer, &iio_adis->data[0]);
 }
 
+/**
+ * @brief API to be called to get one single sample-set based on the given mask.
+ * @param iio_adis - The iio adis structure.
+ * @param mask     - The active channels mask.
+ * @param buffer   - IIO buffer to push the sample set to.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
+		uint32_t mask, struct iio_buffer *buffer, bool pop)
+{
+	struct adis_dev *adis;
+	int ret;
+	struct adis_burst_data data;
+
+	adis = iio_adis->adis_dev;
+
+	ret = adis_read_burst_data(adis, &data, iio_adis->burst_size,
+				   iio_adis->burst_sel, pop, false);
+
+	/* If ret ==  EAGAIN then no data is available to read (will happen
+	for a burst request or in case burst32 or burst select has been changed) */
+	if (ret == -EAGAIN)
+		return 0;
+
+	if (ret)
+		return ret;
+
+	return adis_iio_push_burst_data(iio_adis, &data, mask, buffer);
+}
+
 /**
  * @brief Handles trigger: reads one data-set and writes it to the buffer.
  * @param dev_data  - The iio device data structure.
@@ -1730,16 +1803,18 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 {
 	struct adis_iio_dev *iio_adis;
 	struct adis_dev *adis;
-	int ret;
+	uint32_t nb_samples;
 	uint32_t fifo_cnt;
-	uint16_t j;
+	uint32_t j;
+	int ret;
 
 	if (!dev_data)
 		return -EINVAL;
 
 	iio_adis = (struct adis_iio_dev *)dev_data->dev;
 
-	if (!iio_adis->adis_dev)
+	/* The FIFO read buffers are allocated by adis_iio_pre_enable_buffer() */
+	if (!iio_adis->adis_dev || !iio_adis->fifo_data)
 		return -EINVAL;
 
 	iio_trig_disable(iio_adis->hw_trig_desc);
@@ -1756,28 +1831,27 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 		fifo_cnt = dev_data->buffer->samples;
 
 	if (fifo_cnt > 2) {
-		/* Burst request */
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, true);
-		if (ret)
-			goto trig_enable;
-
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
-
-		for (j = 0; j < fifo_cnt - 1; j++) {
-			ret = adis_iio_trigger_push_single_sample(iio_adis,
-					dev_data->buffer->active_mask, dev_data->buffer, true);
-			if (ret)
-				goto trig_enable;
-
-			/* From data-sheet, minimum time between reads */
-			no_os_udelay(10);
-		}
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, false);
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
+		/*
+		 * Burst request, fifo_cnt - 1 burst reads popping the FIFO and a
+		 * last one without pop, all in a single transfer.
+		 */
+		nb_samples = fifo_cnt + 1;
+		ret = adis_read_burst_data_fifo(adis, iio_adis->fifo_data,
+						&nb_samples,
+						iio_adis->burst_size,
+						iio_adis->burst_sel, true);
+		/* No data available or burst32/burst select has been changed */
+		if (ret == -EAGAIN)
+			ret = 0;
+		else if (!ret)
+			for (j = 0; j < nb_samples; j++) {
+				ret = adis_iio_push_burst_data(iio_adis,
+							       &iio_adis->fifo_data[j],
+							       dev_data->buffer->active_mask,
+							       dev_data->buffer);
+				if (ret)
+					break;
+			}
 	}
 
 trig_enable:
@@ -458,7 +458,7 @@ static struct iio_device adis1657x_iio_dev = {
 	.channels 		= adis1657x_channels,
 	.debug_attributes 	= adis1657x_debug_attrs,
 	.attributes		= adis_dev_attrs,
-	.pre_enable 		= (int32_t (*)())adis_iio_pre_enable,
+	.pre_enable_buffer 	= (int32_t (*)())adis_iio_pre_enable_buffer,
 	.post_disable 		= (int32_t (*)())adis_iio_post_disable,
 	.trigger_handler 	= (int32_t (*)())adis_iio_trigger_handler_with_fifo,
 	.debug_reg_read 	= (int32_t (*)())adis_iio_read_reg,
@@ -513,5 +513,6 @@ void adis1657x_iio_remove(struct adis_iio_dev *desc)
 	if (!desc)
 		return;
 	adis_remove(desc->adis_dev);
+	no_os_free(desc->fifo_data);
 	no_os_free(desc);
 }
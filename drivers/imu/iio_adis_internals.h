@@ -228,6 +228,8 @@ struct adis_iio_dev {
 	uint16_t data[26];
 	/** True if iio device offers FIFO support for buffer reading. */
 	bool has_fifo;
+	/** Samples of a FIFO read, allocated while the buffer is enabled. */
+	struct adis_burst_data *fifo_data;
 	/** Gyroscope measurement range value in text. */
 	const char *rang_mdl_txt;
 	struct iio_hw_trig *hw_trig_desc;
@@ -309,6 +311,8 @@ extern struct iio_trigger adis_iio_trig_desc;
 
 /*! API to be called before trigger is enabled. */
 int adis_iio_pre_enable(void* dev, uint32_t mask);
+/*! API to be called before trigger is enabled, for devices with FIFO. */
+int adis_iio_pre_enable_buffer(struct iio_device_data *dev_data);
 /*! API to be called before trigger is disabled. */
 int adis_iio_post_disable(void* dev, uint32_t mask);
 /*! Read adis iio samples for the active channels. */
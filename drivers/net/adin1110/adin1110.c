@@ -53,6 +53,9 @@ struct _adin1110_priv {
 	uint32_t num_ports;
 };
 
+/* Sent as the padding and alignment bytes of the TX frames */
+static uint8_t adin1110_tx_pad[ADIN1110_TX_PAD_MAX];
+
 static struct _adin1110_priv driver_data[2] = {
 	[ADIN1110] = {
 		.phy_id = ADIN1110_PHY_ID,
@@ -65,40 +68,58 @@ static struct _adin1110_priv driver_data[2] = {
 };
 
 /**
- * @brief Write a register's value
+ * @brief Build the SPI command which writes a register's value
  * @param desc - the device descriptor
  * @param addr - register's address
  * @param data - register's value
- * @return 0 in case of success, negative error code otherwise
+ * @param buff - where to store the command
+ * @return the length of the command
  */
-static int adin1110_standard_spi_reg_write(struct adin1110_desc *desc,
-		uint16_t addr, uint32_t data)
+static uint32_t adin1110_reg_write_cmd(struct adin1110_desc *desc,
+				       uint16_t addr, uint32_t data,
+				       uint8_t *buff)
 {
 	uint32_t header_len = ADIN1110_WR_HDR_SIZE;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_WR_FRAME_SIZE,
-		.cs_change = 1,
-	};
+	uint32_t len = ADIN1110_WR_FRAME_SIZE;
 
 	addr &= ADIN1110_ADDR_MASK;
 	addr |= ADIN1110_CD_MASK | ADIN1110_RW_MASK;
-	no_os_put_unaligned_be16(addr, desc->data);
+	no_os_put_unaligned_be16(addr, buff);
 
 	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
 		header_len++;
-		xfer.bytes_number++;
+		len++;
 	}
 
-	no_os_put_unaligned_be32(data, &desc->data[header_len]);
+	no_os_put_unaligned_be32(data, &buff[header_len]);
 	if (desc->append_crc) {
-		desc->data[header_len + ADIN1110_REG_LEN] =
-			no_os_crc8(_crc_table, &desc->data[header_len], ADIN1110_REG_LEN, 0);
-		xfer.bytes_number++;
+		buff[header_len + ADIN1110_REG_LEN] =
+			no_os_crc8(_crc_table, &buff[header_len], ADIN1110_REG_LEN, 0);
+		len++;
 	}
 
+	return len;
+}
+
+/**
+ * @brief Write a register's value
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_standard_spi_reg_write(struct adin1110_desc *desc,
+		uint16_t addr, uint32_t data)
+{
+	struct no_os_spi_msg xfer = {
+		.tx_buff = desc->data,
+		.rx_buff = desc->data,
+		.cs_change = 1,
+	};
+
+	xfer.bytes_number = adin1110_reg_write_cmd(desc, addr, data, desc->data);
+
 	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 }
 
@@ -123,6 +144,60 @@ int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
 	return adin1110_standard_spi_reg_write(desc, addr, data);
 }
 
+/**
+ * @brief Build the SPI command which reads a register's value
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param buff - where to store the command. The value is received in place.
+ * @return the length of the command
+ */
+static uint32_t adin1110_reg_read_cmd(struct adin1110_desc *desc,
+				      uint16_t addr, uint8_t *buff)
+{
+	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	uint32_t data_len = ADIN1110_REG_LEN;
+
+	no_os_put_unaligned_be16(addr, &buff[0]);
+	buff[0] |= ADIN1110_SPI_CD;
+	buff[2] = 0x0;
+
+	if (desc->append_crc) {
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
+		header_len++;
+		data_len += ADIN1110_CRC_LEN;
+	}
+
+	/* The value is received while sending zeros */
+	memset(&buff[header_len - 1], 0, data_len + 1);
+
+	return header_len + data_len;
+}
+
+/**
+ * @brief Get the register's value received by a read command
+ * @param desc - the device descriptor
+ * @param buff - the command, built by adin1110_reg_read_cmd()
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_reg_read_parse(struct adin1110_desc *desc, uint8_t *buff,
+				   uint32_t *data)
+{
+	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	uint8_t crc;
+
+	if (desc->append_crc) {
+		header_len++;
+		crc = no_os_crc8(_crc_table, &buff[header_len], 4, 0);
+		if (crc != buff[header_len + ADIN1110_REG_LEN])
+			return -EINVAL;
+	}
+
+	*data = no_os_get_unaligned_be32(&buff[header_len]);
+
+	return 0;
+}
+
 /**
  * @brief Read a register's value
  * @param desc - the device descriptor
@@ -133,44 +208,19 @@ int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
 static int adin1110_standard_spi_reg_read(struct adin1110_desc *desc,
 		uint16_t addr, uint32_t *data)
 {
-	uint8_t crc;
-	uint8_t recv_crc;
-	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
 	struct no_os_spi_msg xfer = {
 		.tx_buff = desc->data,
 		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_REG_LEN,
 		.cs_change = 1,
 	};
 	int ret;
 
-	no_os_put_unaligned_be16(addr, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
-
-	if (desc->append_crc) {
-		xfer.bytes_number += ADIN1110_CRC_LEN;
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		header_len++;
-	}
-
-	xfer.bytes_number += header_len;
+	xfer.bytes_number = adin1110_reg_read_cmd(desc, addr, desc->data);
 	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 	if (ret)
 		return ret;
 
-	if (desc->append_crc) {
-		crc = no_os_crc8(_crc_table, &desc->data[header_len], 4, 0);
-		recv_crc = desc->data[header_len + ADIN1110_REG_LEN];
-
-		if (crc != recv_crc)
-			return -EINVAL;
-	}
-
-	*data = no_os_get_unaligned_be32(&desc->data[header_len]);
-
-	return 0;
+	return adin1110_reg_read_parse(desc, desc->data, data);
 }
 
 /**
@@ -527,24 +577,184 @@ int adin1110_broadcast_filter(struct adin1110_desc *desc, bool enabled)
 }
 
 /**
- * @brief Write a frame to the TX FIFO.
+ * @brief Build the SPI messages which write a frame to the TX FIFO. The frame
+ * size is written first, then the header is sent from buff and the payload
+ * straight from the frame buffer.
  * @param desc - the device descriptor
  * @param port - the port for the frame to be transmitted on.
  * @param eth_buff - the frame to be transmitted.
- * @return 0 in case of success, negative error code otherwise
+ * @param buff - scratch buffer for the commands, ADIN1110_TX_CMD_LEN bytes.
+ * @param msgs - where to store the messages, ADIN1110_TX_MSGS at most.
+ * @param space - TX FIFO space used by the frame in bytes.
+ * @return the number of messages
  */
-int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
-			struct adin1110_eth_buff *eth_buff)
+static uint32_t adin1110_tx_frame_msgs(struct adin1110_desc *desc,
+				       uint32_t port,
+				       struct adin1110_eth_buff *eth_buff,
+				       uint8_t *buff, struct no_os_spi_msg *msgs,
+				       uint32_t *space)
 {
 	uint32_t header_len = ADIN1110_WR_HEADER_LEN;
-	uint32_t frame_offset;
-	uint32_t padding = 0;
+	uint32_t payload_len;
 	uint32_t padded_len;
+	uint32_t padding = 0;
 	uint32_t round_len;
+	uint32_t nb_msgs;
+	uint8_t *cmd;
+
+	/* The minimum frame length is 64 bytes */
+	if (eth_buff->len + ADIN1110_FCS_LEN < 64)
+		padding = 64 - (eth_buff->len + ADIN1110_FCS_LEN);
+
+	padded_len = eth_buff->len + padding + ADIN1110_FRAME_HEADER_LEN;
+
+	/** Align the frame length to 4 bytes */
+	round_len = no_os_align(padded_len, 4);
+
+	msgs[0].tx_buff = buff;
+	msgs[0].rx_buff = buff;
+	msgs[0].cs_change = 1;
+	msgs[0].bytes_number = adin1110_reg_write_cmd(desc, ADIN1110_TX_FSIZE_REG,
+			       padded_len, buff);
+
+	cmd = &buff[ADIN1110_WR_FRAME_SIZE + 2];
+	no_os_put_unaligned_be16(ADIN1110_TX_REG, &cmd[0]);
+	cmd[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
+
+	if (desc->append_crc) {
+		cmd[2] = no_os_crc8(_crc_table, cmd, 2, 0);
+		header_len++;
+	}
+
+	/* Set the port on which to send the frame */
+	no_os_put_unaligned_be16(port, &cmd[header_len]);
+	memcpy(&cmd[header_len + ADIN1110_FRAME_HEADER_LEN],
+	       (void *)&eth_buff->mac_dest[0], ADIN1110_ETH_HDR_LEN);
+
+	msgs[1].tx_buff = cmd;
+	msgs[1].rx_buff = cmd;
+	msgs[1].bytes_number = header_len + ADIN1110_FRAME_HEADER_LEN +
+			       ADIN1110_ETH_HDR_LEN;
+	nb_msgs = 2;
+
+	/* The CS stays asserted until the end of the frame */
+	payload_len = eth_buff->len - ADIN1110_ETH_HDR_LEN;
+	if (payload_len) {
+		msgs[nb_msgs].tx_buff = eth_buff->payload;
+		msgs[nb_msgs].bytes_number = payload_len;
+		nb_msgs++;
+	}
+
+	/* Padding and alignment bytes are sent as 0 */
+	if (round_len > padded_len - padding) {
+		msgs[nb_msgs].tx_buff = adin1110_tx_pad;
+		msgs[nb_msgs].bytes_number = round_len - (padded_len - padding);
+		nb_msgs++;
+	}
+
+	msgs[nb_msgs - 1].cs_change = 1;
+	*space = round_len + 2 * ADIN1110_FRAME_HEADER_LEN;
+
+	return nb_msgs;
+}
+
+/**
+ * @brief Write frames to the TX FIFO, using a single SPI transfer.
+ *
+ * The free TX FIFO space is tracked by the driver and is only read from the
+ * device when it is not enough for the next frame.
+ * @param desc - the device descriptor
+ * @param port - the port for the frames to be transmitted on.
+ * @param eth_buff - the frames to be transmitted.
+ * @param nb_frames - number of frames, at most ADIN1110_TX_BATCH_MAX are
+ * written.
+ * @return the number of frames written (0 if the TX FIFO is full) in case of
+ * success, negative error code otherwise
+ */
+int adin1110_write_fifo_batch(struct adin1110_desc *desc, uint32_t port,
+			      struct adin1110_eth_buff *eth_buff,
+			      uint32_t nb_frames)
+{
+	struct no_os_spi_msg msgs[ADIN1110_TX_BATCH_MAX * ADIN1110_TX_MSGS];
+	uint32_t nb_msgs = 0;
 	uint32_t tx_space;
+	uint32_t space;
+	uint32_t i;
 	int ret;
 
-	struct no_os_spi_msg xfer = {0};
+	if (!desc || !eth_buff || port >= driver_data[desc->chip_type].num_ports)
+		return -EINVAL;
+
+	if (desc->oa_tc6_spi) {
+		for (i = 0; i < nb_frames; i++) {
+			ret = adin1110_write_fifo(desc, port, &eth_buff[i]);
+			if (ret)
+				return i ? (int)i : ret;
+		}
+
+		return nb_frames;
+	}
+
+	nb_frames = no_os_min(nb_frames, ADIN1110_TX_BATCH_MAX);
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0; i < nb_frames; i++) {
+		if (eth_buff[i].len < ADIN1110_ETH_HDR_LEN ||
+		    eth_buff[i].len + ADIN1110_FRAME_HEADER_LEN > ADIN1110_BUFF_LEN)
+			return -EINVAL;
+
+		ret = adin1110_tx_frame_msgs(desc, port, &eth_buff[i],
+					     &desc->data[i * ADIN1110_TX_CMD_LEN],
+					     &msgs[nb_msgs], &space);
+		if (space > desc->tx_space) {
+			/*
+			 * Only refresh before the first frame, the space used
+			 * by the others is not yet known by the device.
+			 */
+			if (i)
+				break;
+
+			ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG,
+						&tx_space);
+			if (ret)
+				return ret;
+
+			/* The tx_space value is expressed in 16 bit words */
+			desc->tx_space = 2 * tx_space;
+			if (space > desc->tx_space)
+				return 0;
+
+			/* The register read used the scratch buffer */
+			ret = adin1110_tx_frame_msgs(desc, port, &eth_buff[i],
+						     desc->data, msgs, &space);
+		}
+
+		desc->tx_space -= space;
+		nb_msgs += ret;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, msgs, nb_msgs);
+	if (ret) {
+		/* The frames might have been partially written */
+		desc->tx_space = 0;
+		return ret;
+	}
+
+	return i;
+}
+
+/**
+ * @brief Write a frame to the TX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port for the frame to be transmitted on.
+ * @param eth_buff - the frame to be transmitted.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
+			struct adin1110_eth_buff *eth_buff)
+{
+	uint32_t frame_offset;
+	int ret;
 
 	if (port >= driver_data[desc->chip_type].num_ports)
 		return -EINVAL;
@@ -575,54 +785,153 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 		return oa_tc6_thread(desc->oa_desc);
 	}
 
-	/* The minimum frame length is 64 bytes */
-	if (eth_buff->len + ADIN1110_FCS_LEN < 64)
-		padding = 64 - (eth_buff->len + ADIN1110_FCS_LEN);
+	ret = adin1110_write_fifo_batch(desc, port, eth_buff, 1);
+	if (ret < 0)
+		return ret;
 
-	xfer.tx_buff = desc->data;
-	xfer.rx_buff = desc->data;
-	xfer.cs_change = 1;
+	return ret ? 0 : -EAGAIN;
+}
 
-	padded_len = eth_buff->len + padding + ADIN1110_FRAME_HEADER_LEN;
+/**
+ * @brief Read frames from the RX FIFO, one SPI transfer per frame.
+ *
+ * The frame is received straight in the payload buffer. The size of the next
+ * frame is read in the same transfer, so the RX FIFO size register is only
+ * read once the FIFO was found empty. Meant to drain the FIFO once the
+ * RX_RDY interrupt fires.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frames shall be received.
+ * @param eth_buff - where to store the frames.
+ * @param nb_frames - maximum number of frames to be received.
+ * @return the number of frames received (0 if the RX FIFO is empty) in case of
+ * success, negative error code otherwise
+ */
+int adin1110_read_fifo_batch(struct adin1110_desc *desc, uint32_t port,
+			     struct adin1110_eth_buff *eth_buff,
+			     uint32_t nb_frames)
+{
+	struct no_os_spi_msg msgs[ADIN1110_RX_MSGS] = {0};
+	uint32_t field_offset;
+	uint32_t payload_len;
+	uint32_t fifo_fsize_reg;
+	uint32_t rounded_len;
+	uint32_t frame_size;
+	uint32_t fifo_reg;
+	uint32_t hdr_len;
+	uint32_t nb_msgs;
+	uint8_t *fsize_cmd;
+	uint32_t i;
+	int ret;
 
-	/** Align the frame length to 4 bytes */
-	round_len = no_os_align(padded_len, 4);
+	if (!desc || !eth_buff || port >= driver_data[desc->chip_type].num_ports)
+		return -EINVAL;
 
-	ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &tx_space);
-	if (ret)
-		return ret;
+	if (desc->oa_tc6_spi) {
+		for (i = 0; i < nb_frames; i++) {
+			ret = adin1110_read_fifo(desc, port, &eth_buff[i]);
+			if (ret == -ENOENT)
+				break;
+			if (ret)
+				return i ? (int)i : ret;
+		}
 
-	/*
-	 * Check if there is enough space for the frame in the TX FIFO.
-	 * The tx_space value is expressed in 16 bit words.
-	 */
-	if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN))
-		return -EAGAIN;
+		return i;
+	}
 
-	ret = adin1110_reg_write(desc, ADIN1110_TX_FSIZE_REG, padded_len);
-	if (ret)
-		return ret;
+	if (!port) {
+		fifo_reg = ADIN1110_RX_REG;
+		fifo_fsize_reg = ADIN1110_RX_FSIZE_REG;
+	} else {
+		fifo_reg = ADIN2111_RX_P2_REG;
+		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
+	}
 
-	no_os_put_unaligned_be16(ADIN1110_TX_REG, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
+	fsize_cmd = &desc->data[ADIN1110_RX_FSIZE_OFFSET];
 
-	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		header_len++;
-	}
+	for (i = 0; i < nb_frames; i++) {
+		frame_size = desc->rx_fsize[port];
+		desc->rx_fsize[port] = 0;
+		if (!frame_size) {
+			ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
+			if (ret)
+				return ret;
+		}
 
-	/* Set the port on which to send the frame */
-	no_os_put_unaligned_be16(port, &desc->data[header_len]);
-	xfer.bytes_number = round_len + header_len;
-	frame_offset = header_len + ADIN1110_FRAME_HEADER_LEN;
+		if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN)
+			break;
 
-	memcpy(&desc->data[frame_offset], (void *)&eth_buff->mac_dest[0],
-	       ADIN1110_ETH_HDR_LEN);
-	frame_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(&desc->data[frame_offset], eth_buff->payload,
-	       eth_buff->len - ADIN1110_ETH_HDR_LEN);
+		field_offset = ADIN1110_RD_HEADER_LEN;
+		memset(desc->data, 0, ADIN1110_RX_FSIZE_OFFSET);
+		no_os_put_unaligned_be16(fifo_reg, &desc->data[0]);
+		desc->data[0] |= ADIN1110_SPI_CD;
+		desc->data[2] = 0x0;
 
-	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		if (desc->append_crc) {
+			desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+			desc->data[3] = 0x0;
+			field_offset++;
+		}
+
+		/* Set the port from which to receive the frame */
+		no_os_put_unaligned_be16(port, &desc->data[field_offset]);
+		rounded_len = no_os_align(frame_size, 4);
+
+		/*
+		 * Can only read multiples of 4 bytes (the last bytes might be 0).
+		 * The frame and Ethernet headers are received in desc->data,
+		 * the payload in eth_buff.
+		 */
+		hdr_len = no_os_min(rounded_len,
+				    ADIN1110_FRAME_HEADER_LEN + ADIN1110_ETH_HDR_LEN);
+		payload_len = frame_size > hdr_len ? frame_size - hdr_len : 0;
+
+		msgs[0].tx_buff = desc->data;
+		msgs[0].rx_buff = desc->data;
+		msgs[0].bytes_number = field_offset + hdr_len;
+		nb_msgs = 1;
+
+		if (payload_len) {
+			msgs[nb_msgs].tx_buff = NULL;
+			msgs[nb_msgs].rx_buff = eth_buff[i].payload;
+			msgs[nb_msgs].bytes_number = payload_len;
+			msgs[nb_msgs].cs_change = 0;
+			nb_msgs++;
+		}
+
+		if (rounded_len > hdr_len + payload_len) {
+			msgs[nb_msgs].tx_buff = NULL;
+			msgs[nb_msgs].rx_buff = &desc->data[ADIN1110_RX_PAD_OFFSET];
+			msgs[nb_msgs].bytes_number = rounded_len - hdr_len -
+						     payload_len;
+			msgs[nb_msgs].cs_change = 0;
+			nb_msgs++;
+		}
+		msgs[nb_msgs - 1].cs_change = 1;
+
+		/* Read the size of the next frame */
+		msgs[nb_msgs].tx_buff = fsize_cmd;
+		msgs[nb_msgs].rx_buff = fsize_cmd;
+		msgs[nb_msgs].bytes_number = adin1110_reg_read_cmd(desc,
+					     fifo_fsize_reg, fsize_cmd);
+		msgs[nb_msgs].cs_change = 1;
+		nb_msgs++;
+
+		/** Burst read the whole frame */
+		ret = no_os_spi_transfer(desc->comm_desc, msgs, nb_msgs);
+		if (ret)
+			return i ? (int)i : ret;
+
+		field_offset += ADIN1110_FRAME_HEADER_LEN;
+		memcpy((void *)&eth_buff[i].mac_dest[0], &desc->data[field_offset],
+		       hdr_len - ADIN1110_FRAME_HEADER_LEN);
+		eth_buff[i].len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+
+		ret = adin1110_reg_read_parse(desc, fsize_cmd, &frame_size);
+		if (!ret)
+			desc->rx_fsize[port] = frame_size;
+	}
+
+	return i;
 }
 
 /**
@@ -635,13 +944,7 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 		       struct adin1110_eth_buff *eth_buff)
 {
-	uint32_t field_offset = ADIN1110_RD_HEADER_LEN;
-	uint32_t payload_length;
-	uint32_t fifo_fsize_reg;
-	uint32_t rounded_len;
-	uint32_t frame_size;
-	uint32_t fifo_reg;
-	struct no_os_spi_msg xfer = {0};
+	uint32_t field_offset;
 	int ret;
 
 	if (port >= driver_data[desc->chip_type].num_ports)
@@ -668,56 +971,10 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 		return 0;
 	}
 
-	xfer.tx_buff = desc->data;
-	xfer.rx_buff = desc->data;
-	xfer.cs_change = 1;
-
-	if (!port) {
-		fifo_reg = ADIN1110_RX_REG;
-		fifo_fsize_reg = ADIN1110_RX_FSIZE_REG;
-	} else {
-		fifo_reg = ADIN2111_RX_P2_REG;
-		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
-	}
-
-	ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
-	if (ret)
+	ret = adin1110_read_fifo_batch(desc, port, eth_buff, 1);
+	if (ret < 0)
 		return ret;
 
-	if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN)
-		return 0;
-
-	memset(desc->data, 0, ADIN1110_BUFF_LEN);
-	no_os_put_unaligned_be16(fifo_reg, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
-
-	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		field_offset++;
-	}
-
-	/* Set the port from which to receive the frame */
-	no_os_put_unaligned_be16(port, &desc->data[field_offset]);
-	rounded_len = no_os_align(frame_size, 4);
-
-	/* Can only read multiples of 4 bytes (the last bytes might be 0) */
-	xfer.bytes_number = rounded_len + field_offset;
-	field_offset += ADIN1110_FRAME_HEADER_LEN;
-
-	/** Burst read the whole frame */
-	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
-	if (ret)
-		return ret;
-
-	payload_length = frame_size - ADIN1110_FRAME_HEADER_LEN - ADIN1110_ETH_HDR_LEN;
-	memcpy((void *)&eth_buff->mac_dest[0], &desc->data[field_offset],
-	       ADIN1110_ETH_HDR_LEN);
-	field_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(eth_buff->payload, &desc->data[field_offset], payload_length);
-	eth_buff->len = frame_size - ADIN1110_FRAME_HEADER_LEN;
-
 	return 0;
 }
 
@@ -731,6 +988,10 @@ int adin1110_mac_reset(struct adin1110_desc *desc)
 	uint32_t val;
 	int ret;
 
+	/* The FIFOs are flushed by the reset */
+	desc->tx_space = 0;
+	memset(desc->rx_fsize, 0, sizeof(desc->rx_fsize));
+
 	ret = adin1110_reg_write(desc, ADIN1110_SOFT_RST_REG, ADIN1110_SWRESET_KEY1);
 	if (ret)
 		return ret;
@@ -822,6 +1083,9 @@ int adin1110_phy_reset(struct adin1110_desc *desc)
  */
 int adin1110_sw_reset(struct adin1110_desc *desc)
 {
+	desc->tx_space = 0;
+	memset(desc->rx_fsize, 0, sizeof(desc->rx_fsize));
+
 	return adin1110_reg_write(desc, ADIN1110_RESET_REG, 0x1);
 }
 
@@ -943,7 +1207,7 @@ static int adin1110_setup_mac(struct adin1110_desc *desc)
 int adin1110_init(struct adin1110_desc **desc,
 		  struct adin1110_init_param *param)
 {
-	struct oa_tc6_init_param oa_param;
+	struct oa_tc6_init_param oa_param = {0};
 	struct adin1110_desc *descriptor;
 	int ret;
 
@@ -1002,6 +1266,8 @@ int adin1110_init(struct adin1110_desc **desc,
 
 	if (descriptor->oa_tc6_spi) {
 		oa_param.comm_desc = descriptor->comm_desc;
+		oa_param.irq_ctrl = param->irq_ctrl;
+		oa_param.irq_num = param->int_param.number;
 		ret = oa_tc6_init(&descriptor->oa_desc, &oa_param);
 		if (ret)
 			goto free_spi;
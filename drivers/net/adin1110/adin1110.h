@@ -184,6 +184,21 @@
 #define ADIN1110_CRC_LEN			1
 #define ADIN1110_FEC_LEN			4
 
+/* Maximum number of frames written in a single SPI transfer */
+#define ADIN1110_TX_BATCH_MAX			4
+/* SPI messages used for a TX frame: size, header, payload and padding */
+#define ADIN1110_TX_MSGS			4
+/* SPI messages used for a RX frame: header, payload, tail and next size */
+#define ADIN1110_RX_MSGS			4
+/* Scratch space used for the commands of a TX frame */
+#define ADIN1110_TX_CMD_LEN			32
+/* Scratch offset of the next RX frame size read */
+#define ADIN1110_RX_FSIZE_OFFSET		32
+/* Scratch offset of the discarded RX alignment bytes */
+#define ADIN1110_RX_PAD_OFFSET			48
+/* Largest number of padding and alignment bytes of a TX frame */
+#define ADIN1110_TX_PAD_MAX			64
+
 #define ADIN_MAC_MULTICAST_ADDR_SLOT		0
 #define ADIN_MAC_BROADCAST_ADDR_SLOT		1
 #define ADIN_MAC_P1_ADDR_SLOT			2
@@ -210,6 +225,10 @@ struct adin1110_desc {
 	struct no_os_gpio_desc *int_gpio;
 	bool oa_tc6_spi;
 	bool append_crc;
+	/* TX FIFO space (bytes) known to be free, refreshed when exhausted */
+	uint32_t tx_space;
+	/* Size of the next frame in each RX FIFO, 0 if unknown */
+	uint32_t rx_fsize[ADIN2111_PORTS];
 
 	struct oa_tc6_desc *oa_desc;
 };
@@ -222,6 +241,8 @@ struct adin1110_init_param {
 	struct no_os_spi_init_param comm_param;
 	struct no_os_gpio_init_param reset_param;
 	struct no_os_gpio_init_param int_param;
+	/* Optional, services the OA TC6 SPI on the INT pin interrupt */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 	uint8_t mac_address[ADIN1110_ETH_ALEN];
 	bool append_crc;
 	bool oa_tc6_spi;
@@ -258,6 +279,14 @@ int adin1110_write_fifo(struct adin1110_desc *, uint32_t,
 int adin1110_read_fifo(struct adin1110_desc *, uint32_t,
 		       struct adin1110_eth_buff *);
 
+/* Write multiple frames to the TX FIFO */
+int adin1110_write_fifo_batch(struct adin1110_desc *, uint32_t,
+			      struct adin1110_eth_buff *, uint32_t);
+
+/* Read the available frames from the RX FIFO */
+int adin1110_read_fifo_batch(struct adin1110_desc *, uint32_t,
+			     struct adin1110_eth_buff *, uint32_t);
+
 /* Write a PHY register using clause 22 */
 int adin1110_mdio_write(struct adin1110_desc *, uint32_t, uint32_t, uint16_t);
 
@@ -187,6 +187,8 @@ int oa_tc6_get_tx_frame(struct oa_tc6_desc *desc,
 		if (desc->user_tx_frame_buffer[i].state == OA_BUFF_FREE) {
 			*buffer = &desc->user_tx_frame_buffer[i];
 			desc->user_tx_frame_buffer[i].state = OA_BUFF_TX_BUSY;
+			desc->user_tx_frame_buffer[i].index = 0;
+			desc->user_tx_frame_buffer[i].len = 0;
 			memset(desc->user_tx_frame_buffer[i].data, 0,
 			       CONFIG_OA_CHUNK_BUFFER_SIZE);
 
@@ -206,9 +208,10 @@ int oa_tc6_get_tx_frame(struct oa_tc6_desc *desc,
 int oa_tc6_put_tx_frame(struct oa_tc6_desc *desc,
 			struct oa_tc6_frame_buffer *buffer)
 {
-	if (!desc || !buffer)
+	if (!desc || !buffer || buffer->len > CONFIG_OA_CHUNK_BUFFER_SIZE)
 		return -EINVAL;
 
+	buffer->index = 0;
 	buffer->state = OA_BUFF_TX_READY;
 
 	return 0;
@@ -235,38 +238,19 @@ static int oa_tc6_get_first_tx_frame(struct oa_tc6_desc *desc,
 }
 
 /**
- * @brief Get an empty RX buffer.
+ * @brief Get a free RX buffer, in which a new frame can be received.
  * @param desc - the OA TC6 descriptor.
- * @param buffer - buffer to be filled with the frame received.
- * @param new_buffer - if true, get a new buffer, otherwise get
- * the buffer that is currently being written.
- * @return 0 in case of success, negative error code otherwise
+ * @return the buffer, NULL if all of them are in use
  */
-static int oa_tc6_get_empty_rx_buff(struct oa_tc6_desc *desc,
-				    struct oa_tc6_frame_buffer **buffer,
-				    bool new_buffer)
+static struct oa_tc6_frame_buffer *oa_tc6_get_free_rx_buff(
+	struct oa_tc6_desc *desc)
 {
-	if (!new_buffer) {
-		for (int i = 0; i < OA_RX_FRAME_BUFF_NUM; i++) {
-			if (desc->user_rx_frame_buffer[i].state == OA_BUFF_RX_IN_PROGRESS) {
-				*buffer = &desc->user_rx_frame_buffer[i];
-
-				return 0;
-			}
-		}
-	}
-
 	for (int i = 0; i < OA_RX_FRAME_BUFF_NUM; i++) {
-		if (desc->user_rx_frame_buffer[i].state == OA_BUFF_FREE) {
-			*buffer = &desc->user_rx_frame_buffer[i];
-			desc->user_rx_frame_buffer[i].index = 0;
-			desc->user_rx_frame_buffer[i].len = 0;
-
-			return 0;
-		}
+		if (desc->user_rx_frame_buffer[i].state == OA_BUFF_FREE)
+			return &desc->user_rx_frame_buffer[i];
 	}
 
-	return -ENOBUFS;
+	return NULL;
 }
 
 /**
@@ -336,96 +320,159 @@ int oa_tc6_put_rx_frame(struct oa_tc6_desc *desc,
 }
 
 /**
- * @brief Convert frames in the OA_BUFF_TX_READY state to chunks.
- * Configure empty chunks if we need to receive more then transmit.
+ * @brief Get the number of chunks needed to transmit the frames in the
+ * OA_BUFF_TX_READY state.
+ * @param desc - the OA TC6 descriptor
+ * @return the number of chunks
+ */
+static uint32_t oa_tc6_tx_chunks_pending(struct oa_tc6_desc *desc)
+{
+	struct oa_tc6_frame_buffer *frame_buffer;
+	uint32_t nchunks = 0;
+
+	for (int i = 0; i < OA_TX_FRAME_BUFF_NUM; i++) {
+		frame_buffer = &desc->user_tx_frame_buffer[i];
+		if (frame_buffer->state != OA_BUFF_TX_READY)
+			continue;
+
+		nchunks += NO_OS_DIV_ROUND_UP(frame_buffer->len - frame_buffer->index,
+					      OA_CHUNK_SIZE);
+	}
+
+	return nchunks;
+}
+
+/**
+ * @brief Convert frames in the OA_BUFF_TX_READY state to chunks. A frame may
+ * span multiple transfers, the remaining chunks are sent by the next one.
+ * Empty chunks are added if we need to receive more then transmit.
  * @param desc - the OA TC6 descriptor
  * @param tx_buffer - the buffer containing the chunks
  * @param tx_credit - the number of chunks available for transmission
- * @param rx_nchunks - the number of chunks available for reception
- * @param tx_written - the number of chunks written in the buffer
- * @return 0 in case of success, negative error code otherwise
+ * @param nchunks - the total number of chunks in the transfer
+ * @param norx - don't receive frame data in these chunks
  */
-static int oa_tc6_tx_frame_to_chunks(struct oa_tc6_desc *desc,
-				     uint8_t *tx_buffer,
-				     uint32_t tx_credit, uint32_t rx_nchunks,
-				     uint32_t *tx_written)
+static void oa_tc6_tx_frame_to_chunks(struct oa_tc6_desc *desc,
+				      uint8_t *tx_buffer, uint32_t tx_credit,
+				      uint32_t nchunks, bool norx)
 {
-	uint32_t spi_buffer_index = 0;
-	uint32_t tx_frame_num_chunks;
-	uint32_t spi_buff_max_chunks;
-	uint32_t chunks_written = 0;
-	uint32_t frame_offset = 0;
-	uint32_t chunks_limit;
-	uint32_t frame_len;
+	struct oa_tc6_frame_buffer *frame_buffer = desc->tx_frame;
+	uint32_t len;
 	uint32_t header;
 	uint32_t i;
-	int ret;
-
-	struct oa_tc6_frame_buffer *frame_buffer;
-	spi_buff_max_chunks = OA_SPI_BUFF_LEN / (OA_CHUNK_SIZE + OA_HEADER_LEN);
 
-	/* The maximum number of chunks we can potentially send, given the size of our SPI buffer. */
-	chunks_limit = no_os_min(spi_buff_max_chunks, tx_credit);
+	for (i = 0; i < nchunks; i++) {
+		header = no_os_field_prep(OA_DATA_HEADER_DNC_MASK, 1);
+		header |= no_os_field_prep(OA_DATA_HEADER_NORX_MASK, norx);
 
-	do {
-		ret = oa_tc6_get_first_tx_frame(desc, &frame_buffer);
-		if (ret)
-			break;
+		/* Skip the frames with no data */
+		while (!frame_buffer && i < tx_credit &&
+		       !oa_tc6_get_first_tx_frame(desc, &frame_buffer)) {
+			if (frame_buffer->len)
+				break;
 
-		frame_len = frame_buffer->len;
-		tx_frame_num_chunks = NO_OS_DIV_ROUND_UP(frame_len, OA_CHUNK_SIZE);
+			frame_buffer->state = OA_BUFF_FREE;
+			frame_buffer = NULL;
+		}
 
-		/* Check if we can fit the current frame into the SPI buffer (as a whole). */
-		if (!frame_len || ((chunks_written + tx_frame_num_chunks) > chunks_limit))
-			break;
+		if (frame_buffer && i < tx_credit) {
+			len = no_os_min(frame_buffer->len - frame_buffer->index,
+					OA_CHUNK_SIZE);
 
-		frame_offset = 0;
-		for (i = 0; i < tx_frame_num_chunks; i++) {
-			header = no_os_field_prep(OA_DATA_HEADER_DNC_MASK, 1);
 			header |= no_os_field_prep(OA_DATA_HEADER_DV_MASK, 1);
 			header |= no_os_field_prep(OA_DATA_HEADER_VS_MASK, frame_buffer->vs);
 
-			if (!i)
-				header |= no_os_field_prep(OA_DATA_FOOTER_SV_MASK, 1);
+			if (!frame_buffer->index)
+				header |= no_os_field_prep(OA_DATA_HEADER_SV_MASK, 1);
 
-			if (i == tx_frame_num_chunks - 1) {
+			if (frame_buffer->index + len == frame_buffer->len) {
 				header |= no_os_field_prep(OA_DATA_HEADER_EV_MASK, 1);
-				header |= no_os_field_prep(OA_DATA_HEADER_EBO_MASK, frame_len - 1);
+				header |= no_os_field_prep(OA_DATA_HEADER_EBO_MASK, len - 1);
 			}
 
-			header |= oa_tc6_crc1(header);
+			memcpy(&tx_buffer[OA_HEADER_LEN],
+			       &frame_buffer->data[frame_buffer->index], len);
+			frame_buffer->index += len;
 
-			no_os_put_unaligned_be32(header, &tx_buffer[spi_buffer_index]);
-			spi_buffer_index += OA_HEADER_LEN;
-			memcpy(&tx_buffer[spi_buffer_index], &frame_buffer->data[frame_offset],
-			       OA_CHUNK_SIZE);
-			frame_offset += OA_CHUNK_SIZE;
-			spi_buffer_index += OA_CHUNK_SIZE;
-
-			frame_len -= OA_CHUNK_SIZE;
+			if (frame_buffer->index == frame_buffer->len) {
+				frame_buffer->len = 0;
+				frame_buffer->index = 0;
+				frame_buffer->state = OA_BUFF_FREE;
+				frame_buffer = NULL;
+			}
 		}
-		chunks_written += tx_frame_num_chunks;
 
-		frame_buffer->len = 0;
-		frame_buffer->index = 0;
-		frame_buffer->state = OA_BUFF_FREE;
-	} while (1);
+		header |= oa_tc6_crc1(header);
+		no_os_put_unaligned_be32(header, tx_buffer);
+		tx_buffer += OA_CHUNK_SIZE + OA_HEADER_LEN;
+	}
 
-	if (rx_nchunks > chunks_written) {
-		/*
-		 * The TX queue may be empty, there is no space in the SPI buffer, or we're out of tx credits.
-		 * If rx_chunks > tx_chunks, we need to add dummy chunks (DV = 0).
-		 */
-		header = no_os_field_prep(OA_DATA_HEADER_DNC_MASK, 1);
-		for (i = 0; i < rx_nchunks - chunks_written; i++) {
-			no_os_put_unaligned_be32(header, &tx_buffer[spi_buffer_index]);
-			spi_buffer_index += OA_CHUNK_SIZE + OA_HEADER_LEN;
-		}
+	desc->tx_frame = frame_buffer;
+}
+
+/**
+ * @brief Start receiving a new frame. An incomplete frame is discarded.
+ * If there is no free buffer, the new frame is dropped.
+ * @param desc - the OA TC6 descriptor
+ */
+static void oa_tc6_rx_frame_start(struct oa_tc6_desc *desc)
+{
+	if (desc->rx_frame) {
+		desc->rx_frame->state = OA_BUFF_FREE;
+		desc->rx_frame->index = 0;
+		desc->rx_frame->len = 0;
 	}
 
-	*tx_written = spi_buffer_index;
+	desc->rx_frame = oa_tc6_get_free_rx_buff(desc);
+	if (!desc->rx_frame) {
+		desc->rx_dropped++;
+		return;
+	}
 
-	return 0;
+	desc->rx_frame->state = OA_BUFF_RX_IN_PROGRESS;
+	desc->rx_frame->index = 0;
+	desc->rx_frame->len = 0;
+}
+
+/**
+ * @brief Append data to the frame being received.
+ * @param desc - the OA TC6 descriptor
+ * @param data - frame data
+ * @param len - number of bytes
+ */
+static void oa_tc6_rx_frame_append(struct oa_tc6_desc *desc, uint8_t *data,
+				   uint32_t len)
+{
+	struct oa_tc6_frame_buffer *frame_buffer = desc->rx_frame;
+
+	if (!frame_buffer)
+		return;
+
+	if (frame_buffer->index + len > CONFIG_OA_CHUNK_BUFFER_SIZE) {
+		frame_buffer->state = OA_BUFF_FREE;
+		desc->rx_frame = NULL;
+		desc->rx_dropped++;
+		return;
+	}
+
+	memcpy(&frame_buffer->data[frame_buffer->index], data, len);
+	frame_buffer->index += len;
+	frame_buffer->len = frame_buffer->index;
+}
+
+/**
+ * @brief Hand the frame being received over to the user.
+ * @param desc - the OA TC6 descriptor
+ * @param footer - footer of the chunk containing the end of the frame
+ */
+static void oa_tc6_rx_frame_end(struct oa_tc6_desc *desc, uint32_t footer)
+{
+	if (!desc->rx_frame)
+		return;
+
+	desc->rx_frame->vs = no_os_field_get(OA_DATA_FOOTER_VS_MASK, footer);
+	desc->rx_frame->state = OA_BUFF_RX_COMPLETE;
+	desc->rx_frame = NULL;
 }
 
 /**
@@ -433,23 +480,15 @@ static int oa_tc6_tx_frame_to_chunks(struct oa_tc6_desc *desc,
  * @param desc - the OA TC6 descriptor
  * @param chunks - array containing chunks received from the MAC
  * @param len - the number of chunks
- * @return 0 in case of success, negative error code otherwise
  */
-static int oa_tc6_rx_chunk_to_frame(struct oa_tc6_desc *desc, uint8_t *chunks,
-				    uint32_t len)
+static void oa_tc6_rx_chunk_to_frame(struct oa_tc6_desc *desc, uint8_t *chunks,
+				     uint32_t len)
 {
 	uint32_t footer = 0;
 	uint32_t swo;
 	uint32_t ebo;
 	uint32_t ev;
 	uint32_t sv;
-	int ret;
-
-	struct oa_tc6_frame_buffer *frame_buffer;
-
-	ret = oa_tc6_get_empty_rx_buff(desc, &frame_buffer, false);
-	if (ret)
-		return ret;
 
 	for (uint32_t i = 0; i < len; i++) {
 		footer = no_os_get_unaligned_be32(&chunks[OA_CHUNK_SIZE]);
@@ -461,85 +500,39 @@ static int oa_tc6_rx_chunk_to_frame(struct oa_tc6_desc *desc, uint8_t *chunks,
 
 		ev = footer & OA_DATA_FOOTER_EV_MASK;
 		sv = footer & OA_DATA_FOOTER_SV_MASK;
-
-		if (sv && ev) {
-			ebo = no_os_field_get(OA_DATA_FOOTER_EBO_MASK, footer);
-			swo = no_os_field_get(OA_DATA_FOOTER_SWO_MASK, footer);
-
-			if (swo < ebo) {
-				memcpy(&(frame_buffer->data[frame_buffer->index]), chunks, ebo - swo + 1);
-				frame_buffer->index += ebo - swo + 1;
-				frame_buffer->len = frame_buffer->index;
-				frame_buffer->state = OA_BUFF_RX_COMPLETE;
-				frame_buffer->vs = no_os_field_get(OA_DATA_FOOTER_VS_MASK, footer);
-			}
-
-			ret = oa_tc6_get_empty_rx_buff(desc, &frame_buffer, true);
-			if (ret) {
-				printf("No empty buffer\n");
-				return ret;
+		ebo = no_os_field_get(OA_DATA_FOOTER_EBO_MASK, footer);
+		swo = no_os_field_get(OA_DATA_FOOTER_SWO_MASK, footer) * 4;
+
+		if (sv && ev && swo <= ebo) {
+			/* The whole frame is in the current chunk */
+			oa_tc6_rx_frame_start(desc);
+			oa_tc6_rx_frame_append(desc, &chunks[swo], ebo - swo + 1);
+			oa_tc6_rx_frame_end(desc, footer);
+		} else {
+			if (ev) {
+				/* The current chunk contains the end of a frame */
+				oa_tc6_rx_frame_append(desc, chunks, ebo + 1);
+				oa_tc6_rx_frame_end(desc, footer);
+			} else if (!sv) {
+				/* The current chunk doesn't contain either the start or end of a frame */
+				oa_tc6_rx_frame_append(desc, chunks, OA_CHUNK_SIZE);
 			}
 
-			frame_buffer->state = OA_BUFF_RX_IN_PROGRESS;
-			/* There are 2 frames in the current chunk */
-			if (swo > ebo) {
-				memcpy(frame_buffer->data, &chunks[swo], OA_CHUNK_SIZE - swo);
-				frame_buffer->index += OA_CHUNK_SIZE - swo;
+			if (sv) {
+				/* The current chunk contains the start of a frame at offset SWO */
+				oa_tc6_rx_frame_start(desc);
+				oa_tc6_rx_frame_append(desc, &chunks[swo],
+						       OA_CHUNK_SIZE - swo);
 			}
-
-			chunks += OA_CHUNK_SIZE + OA_FOOTER_LEN;
-			continue;
-		}
-
-		if (ev) {
-			ebo = no_os_field_get(OA_DATA_FOOTER_EBO_MASK, footer);
-
-			/* The current chunk may be shorter than chunk_size, since it contains the end of a frame */
-			memcpy(&(frame_buffer->data[frame_buffer->index]), chunks, ebo + 1);
-
-			frame_buffer->len = frame_buffer->index + ebo + 1;
-			frame_buffer->state = OA_BUFF_RX_COMPLETE;
-			frame_buffer->vs = no_os_field_get(OA_DATA_FOOTER_VS_MASK, footer);
-
-			ret = oa_tc6_get_empty_rx_buff(desc, &frame_buffer, true);
-			if (ret)
-				return ret;
-
-			frame_buffer->state = OA_BUFF_RX_IN_PROGRESS;
-
-			chunks += OA_CHUNK_SIZE + OA_FOOTER_LEN;
-			continue;
-		}
-
-		if (sv) {
-			swo = no_os_field_get(OA_DATA_FOOTER_SWO_MASK, footer);
-			/* The current chunk contains the start of a frame at offset SWO */
-			memcpy(&frame_buffer->data[frame_buffer->index], &chunks[swo],
-			       OA_CHUNK_SIZE - swo);
-
-			frame_buffer->index += OA_CHUNK_SIZE - swo;
-			frame_buffer->len = frame_buffer->index;
-
-			chunks += OA_CHUNK_SIZE + OA_FOOTER_LEN;
-			continue;
-		}
-
-		if (!ev && !sv) {
-			/*
-			 * The current chunk does not contain either the start or end of a frame,
-			 * and the contains valid data for each byte
-			 */
-			memcpy(&frame_buffer->data[frame_buffer->index], chunks, OA_CHUNK_SIZE);
-			frame_buffer->index += OA_CHUNK_SIZE;
 		}
 
 		chunks += OA_CHUNK_SIZE + OA_FOOTER_LEN;
 	}
 
-	desc->data_rx_credit = no_os_field_get(OA_DATA_FOOTER_RCA_MASK, footer);
-	desc->data_tx_credit = no_os_field_get(OA_DATA_FOOTER_TXC_MASK, footer);
-
-	return 0;
+	if (len) {
+		desc->data_rx_credit = no_os_field_get(OA_DATA_FOOTER_RCA_MASK, footer);
+		desc->data_tx_credit = no_os_field_get(OA_DATA_FOOTER_TXC_MASK, footer);
+	}
 }
 
 /**
@@ -562,73 +555,103 @@ static int oa_tc6_update_stats(struct oa_tc6_desc *desc)
 	return 0;
 }
 
+/**
+ * @brief IRQn handler. The footer of the next data chunk tells what
+ * happened, so the next oa_tc6_thread() call does a data transfer.
+ * @param ctx - the OA TC6 descriptor
+ */
+static void oa_tc6_irq_handler(void *ctx)
+{
+	struct oa_tc6_desc *desc = ctx;
+
+	desc->irq_pending = true;
+}
+
 /**
  * @brief Transmit all the frames in the OA_BUFF_TX_READY state and receive the
  * frames in the OA_BUFF_RX_COMPLETE state.
+ *
+ * Each data transfer is sized to the credit reported by the last chunk
+ * footer. A pending control transaction is sent in the same SPI transfer as
+ * the first data chunks. If the credit is exhausted, the MAC-PHY is only
+ * accessed after an interrupt (or on each call if no interrupt is used).
  * @param desc - the OA TC6 descriptor
  * @return 0 in case of success, negative error code otherwise
  */
 int oa_tc6_thread(struct oa_tc6_desc *desc)
 {
-	uint32_t tx_chunks_avail = 0;
-	uint32_t rx_limit = 0;
-	uint32_t bytes_total;
+	struct no_os_spi_msg xfer[2] = {0};
+	uint32_t nb_xfer = 0;
+	uint32_t tx_chunks;
+	uint32_t rx_chunks;
+	uint32_t nchunks;
+	bool probe;
+	bool norx;
 	int ret;
 
-	struct oa_tc6_frame_buffer *frame_buffer;
-	struct no_os_spi_msg xfer = {0};
-
 	if (desc->ctrl_rx_credit || desc->ctrl_tx_credit) {
-		xfer.tx_buff = desc->ctrl_chunks;
-		xfer.rx_buff = desc->ctrl_chunks;
-		xfer.cs_change = 1;
-		xfer.bytes_number = 2 * OA_HEADER_LEN + OA_REG_LEN;
-
-		return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		xfer[0].tx_buff = desc->ctrl_chunks;
+		xfer[0].rx_buff = desc->ctrl_chunks;
+		xfer[0].cs_change = 1;
+		xfer[0].bytes_number = 2 * OA_HEADER_LEN + OA_REG_LEN;
+		nb_xfer = 1;
 	}
 
-	ret = oa_tc6_update_stats(desc);
-	if (ret)
-		return ret;
+	/* Register accesses don't poll the MAC-PHY */
+	probe = desc->irq_pending || (!desc->irq_ctrl && !nb_xfer);
+	desc->irq_pending = false;
+
+	for (uint32_t i = 0; i < CONFIG_OA_THREAD_MAX_XFERS; i++) {
+		/* The MAC-PHY keeps the frames until there is room for them */
+		norx = !oa_tc6_get_free_rx_buff(desc) && !desc->rx_frame;
+		rx_chunks = norx ? 0 : desc->data_rx_credit;
+		tx_chunks = no_os_min(oa_tc6_tx_chunks_pending(desc),
+				      desc->data_tx_credit);
+
+		nchunks = no_os_max(rx_chunks, tx_chunks);
+		if (!nchunks) {
+			if (!probe)
+				break;
+
+			probe = false;
+			if (!desc->irq_ctrl) {
+				/* Polling, the status read is shorter than a chunk */
+				ret = oa_tc6_update_stats(desc);
+				if (ret)
+					return ret;
+
+				continue;
+			}
 
-	if (desc->data_tx_credit) {
-		ret = oa_tc6_get_first_tx_frame(desc, &frame_buffer);
-		if (!ret)
-			tx_chunks_avail = frame_buffer->len;
-	}
+			/* After an interrupt, get the credit from the footer */
+			nchunks = 1;
+		}
+		probe = false;
+		nchunks = no_os_min(nchunks, OA_MAX_CHUNKS);
 
-	while (desc->data_rx_credit || tx_chunks_avail) {
-		oa_tc6_tx_frame_to_chunks(desc, desc->data_chunks, desc->data_tx_credit,
-					  desc->data_rx_credit, &bytes_total);
+		oa_tc6_tx_frame_to_chunks(desc, desc->data_chunks, tx_chunks,
+					  nchunks, norx);
 
-		xfer.tx_buff = desc->data_chunks;
-		xfer.rx_buff = desc->data_chunks;
-		xfer.bytes_number = bytes_total;
+		xfer[nb_xfer].tx_buff = desc->data_chunks;
+		xfer[nb_xfer].rx_buff = desc->data_chunks;
+		xfer[nb_xfer].cs_change = 1;
+		xfer[nb_xfer].bytes_number = nchunks * (OA_CHUNK_SIZE + OA_HEADER_LEN);
 
-		ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		ret = no_os_spi_transfer(desc->comm_desc, xfer, nb_xfer + 1);
 		if (ret) {
-			memset(desc->data_chunks, 0, bytes_total);
+			memset(desc->data_chunks, 0, OA_SPI_BUFF_LEN);
+			desc->irq_pending = true;
 
 			return ret;
 		}
+		nb_xfer = 0;
 
-		ret = oa_tc6_rx_chunk_to_frame(desc, desc->data_chunks,
-					       bytes_total / (OA_CHUNK_SIZE + OA_HEADER_LEN));
-		if (ret)
-			return ret;
-
-		ret = oa_tc6_get_first_tx_frame(desc, &frame_buffer);
-		if (!ret)
-			tx_chunks_avail = frame_buffer->len;
-		else
-			tx_chunks_avail = 0;
-
-		rx_limit++;
-
-		if (rx_limit > 5)
-			break;
+		oa_tc6_rx_chunk_to_frame(desc, desc->data_chunks, nchunks);
 	}
 
+	if (nb_xfer)
+		return no_os_spi_transfer(desc->comm_desc, xfer, nb_xfer);
+
 	return 0;
 }
 
@@ -656,10 +679,43 @@ int oa_tc6_init(struct oa_tc6_desc **desc, struct oa_tc6_init_param *param)
 	if (ret)
 		goto error;
 
+	/* The credit is afterwards updated from the chunk footers */
+	ret = oa_tc6_update_stats(descriptor);
+	if (ret)
+		goto error;
+
+	if (param->irq_ctrl) {
+		descriptor->irq_cb.callback = oa_tc6_irq_handler;
+		descriptor->irq_cb.ctx = descriptor;
+		descriptor->irq_cb.event = NO_OS_EVT_GPIO;
+		descriptor->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+		ret = no_os_irq_register_callback(param->irq_ctrl, param->irq_num,
+						  &descriptor->irq_cb);
+		if (ret)
+			goto error;
+
+		/* IRQn is active low */
+		ret = no_os_irq_trigger_level_set(param->irq_ctrl, param->irq_num,
+						  NO_OS_IRQ_EDGE_FALLING);
+		if (ret)
+			goto error_irq;
+
+		descriptor->irq_ctrl = param->irq_ctrl;
+		descriptor->irq_num = param->irq_num;
+
+		ret = no_os_irq_enable(param->irq_ctrl, param->irq_num);
+		if (ret)
+			goto error_irq;
+	}
+
 	*desc = descriptor;
 
 	return 0;
 
+error_irq:
+	no_os_irq_unregister_callback(param->irq_ctrl, param->irq_num,
+				      &descriptor->irq_cb);
 error:
 	no_os_free(descriptor);
 
@@ -676,6 +732,12 @@ int oa_tc6_remove(struct oa_tc6_desc *desc)
 	if (!desc)
 		return -ENODEV;
 
+	if (desc->irq_ctrl) {
+		no_os_irq_disable(desc->irq_ctrl, desc->irq_num);
+		no_os_irq_unregister_callback(desc->irq_ctrl, desc->irq_num,
+					      &desc->irq_cb);
+	}
+
 	no_os_free(desc);
 
 	return 0;
@@ -34,6 +34,7 @@
 #define _NO_OS_OA_TC6_H
 
 #include "no_os_spi.h"
+#include "no_os_irq.h"
 #include "no_os_util.h"
 #include <stdint.h>
 
@@ -49,16 +50,28 @@
 #define CONFIG_OA_CHUNK_BUFFER_SIZE	1514
 #endif
 
+/*
+ * Upper bound for the number of data transfers done by a single
+ * oa_tc6_thread() call, so that a continuous RX stream doesn't starve the
+ * caller. The remaining chunks are read by the next call.
+ */
+#ifndef CONFIG_OA_THREAD_MAX_XFERS
+#define CONFIG_OA_THREAD_MAX_XFERS	8
+#endif
+
 #define OA_TX_FRAME_BUFF_NUM		CONFIG_OA_TX_FRAME_BUFF_NUM
 #define OA_RX_FRAME_BUFF_NUM		CONFIG_OA_RX_FRAME_BUFF_NUM
 
-/* Space for one full frame + 24 chunk headers (68 * 24)*/
-#define OA_SPI_BUFF_LEN		1632
 #define OA_CHUNK_SIZE		64
 #define OA_REG_LEN		4
 #define OA_HEADER_LEN		4
 #define OA_FOOTER_LEN		4
 
+/* The TXC and RCA credit fields are 5 bits wide */
+#define OA_MAX_CHUNKS		31
+/* Space for a transfer using all the available credit (68 * 31) */
+#define OA_SPI_BUFF_LEN		(OA_MAX_CHUNKS * (OA_CHUNK_SIZE + OA_HEADER_LEN))
+
 #define OA_MMS_REG(m, r)	(((m) << 16) | ((r) & NO_OS_GENMASK(15, 0)))
 #define OA_CTRL_ADDR_MMS_MASK	NO_OS_GENMASK(27, 8)
 
@@ -186,11 +199,29 @@ struct oa_tc6_desc {
 	struct oa_tc6_frame_buffer user_rx_frame_buffer[OA_RX_FRAME_BUFF_NUM];
 	struct oa_tc6_frame_buffer user_tx_frame_buffer[OA_TX_FRAME_BUFF_NUM];
 
+	/* Frame being transmitted, it may span multiple transfers. */
+	struct oa_tc6_frame_buffer *tx_frame;
+	/* Frame being received, NULL if the current one is discarded. */
+	struct oa_tc6_frame_buffer *rx_frame;
+
+	/*
+	 * Credit reported by the last chunk footer. The MAC-PHY only changes
+	 * them in our favor between transfers, so they are lower bounds.
+	 */
 	uint32_t data_tx_credit;
 	uint32_t data_rx_credit;
 
 	uint32_t ctrl_tx_credit;
 	uint32_t ctrl_rx_credit;
+
+	/* Number of received frames dropped because of missing RX buffers */
+	uint32_t rx_dropped;
+
+	/* Optional, the data transfers are only started on interrupts */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_num;
+	struct no_os_callback_desc irq_cb;
+	volatile bool irq_pending;
 };
 
 /**
@@ -198,6 +229,13 @@ struct oa_tc6_desc {
  */
 struct oa_tc6_init_param {
 	struct no_os_spi_desc *comm_desc;
+	/*
+	 * Optional. Controller for the IRQn pin interrupt. If NULL, the
+	 * MAC-PHY is polled in each oa_tc6_thread() call.
+	 */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/* Interrupt ID of the IRQn pin */
+	uint32_t irq_num;
 };
 
 /* Read a register from the MAC device */
@@ -228,7 +266,7 @@ int oa_tc6_put_tx_frame(struct oa_tc6_desc *, struct oa_tc6_frame_buffer *);
 
 /*
  * Transmit all the frames in the OA_BUFF_TX_READY state and receive the
- * available chunks.
+ * available chunks. Doesn't access the bus if there is nothing to be done.
  */
 int oa_tc6_thread(struct oa_tc6_desc *);
 
@@ -54,21 +54,17 @@
  */
 static void aducm_gpio_callback(void *ctx, uint32_t event, void *pins)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
 	struct aducm_gpio_irq_ctrl_desc *extra = ctx;
 	uint16_t *pinints = pins;
+	uint32_t pin;
 
 	while (*pinints) {
-		key.irq_id = no_os_find_first_set_bit((uint32_t) * pinints);
-		if (key.irq_id == 32)
+		pin = no_os_find_first_set_bit((uint32_t) * pinints);
+		if (pin == 32)
 			break;
-		*pinints &= ~NO_OS_BIT(key.irq_id);
-		ret = no_os_list_read_find(extra->actions, (void **)&action, &key);
-		if (ret)
-			continue;
-
+		*pinints &= ~NO_OS_BIT(pin);
+		action = extra->isr_actions[pin];
 		if (action)
 			action->callback(action->ctx);
 	}
@@ -82,16 +78,13 @@ static void aducm_gpio_callback(void *ctx, uint32_t event, void *pins)
  */
 static void aducm_xint_callback(void *ctx, uint32_t event, void *buff)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
 	struct aducm_gpio_irq_ctrl_desc *extra = ctx;
 
-	key.irq_id = event;
-	ret = no_os_list_read_find(extra->actions, (void **)&action, &key);
-	if (ret)
+	if (event >= ADUCM_GPIO_IRQ_ISR_ACTIONS)
 		return;
 
+	action = extra->isr_actions[event];
 	if (action)
 		action->callback(action->ctx);
 }
@@ -266,6 +259,9 @@ static int aducm_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		action->callback = callback_desc->callback;
 	}
 
+	if (irq_id < ADUCM_GPIO_IRQ_ISR_ACTIONS)
+		extra->isr_actions[irq_id] = action;
+
 	return 0;
 
 free_action:
@@ -303,6 +299,9 @@ static int aducm_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 	if (ret)
 		return -ENODEV;
 
+	if (irq_id < ADUCM_GPIO_IRQ_ISR_ACTIONS)
+		extra->isr_actions[irq_id] = NULL;
+
 	if (desc->irq_ctrl_id != ADUCM_XINT_SOFT_CTRL) {
 		ret = adi_gpio_GetGroupInterruptPins(gpio_port, id, &gpio_pin);
 		if (ret)
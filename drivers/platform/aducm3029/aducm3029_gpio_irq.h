@@ -36,6 +36,9 @@
 
 #include <drivers/xint/adi_xint.h>
 
+/* Callbacks looked up by irq_id from the interrupt handlers */
+#define ADUCM_GPIO_IRQ_ISR_ACTIONS	16
+
 /**
  * @enum irq_ctrl_id
  * @brief Interrupt controllers ID
@@ -55,6 +58,8 @@ struct aducm_gpio_irq_ctrl_desc {
 	uint8_t irq_memory[ADI_XINT_MEMORY_SIZE];
 	/** List of user callbacks */
 	struct no_os_list_desc *actions;
+	/** User callbacks indexed by irq_id, used by the interrupt handlers */
+	struct irq_action *isr_actions[ADUCM_GPIO_IRQ_ISR_ACTIONS];
 };
 
 /**
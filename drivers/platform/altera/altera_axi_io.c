@@ -34,6 +34,10 @@
 #include <io.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
+#include "no_os_util.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 
 /**
  * @brief AXI IO Altera specific read function.
@@ -44,7 +48,9 @@
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
+	NO_OS_TRACE_BEGIN();
 	*data = IORD_32DIRECT(base, offset);
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_READ, 4, 0);
 
 	return 0;
 }
@@ -58,7 +64,9 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
+	NO_OS_TRACE_BEGIN();
 	IOWR_32DIRECT(base, offset, data);
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_WRITE, 4, 0);
 
 	return 0;
 }
@@ -39,6 +39,10 @@
 #include <sys/mman.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
+#include "no_os_util.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 
 /**
  * @brief AXI IO through UIO read/write function.
@@ -155,11 +159,17 @@ close:
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
+	int32_t ret;
+
+	NO_OS_TRACE_BEGIN();
 #ifdef DEVMEM
-	return devmem_read_write(base, offset, data, NULL);
+	ret = devmem_read_write(base, offset, data, NULL);
 #else
-	return uio_read_write(base, offset, data, NULL);
+	ret = uio_read_write(base, offset, data, NULL);
 #endif
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_READ, 4, ret);
+
+	return ret;
 }
 
 /**
@@ -171,9 +181,15 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
+	int32_t ret;
+
+	NO_OS_TRACE_BEGIN();
 #ifdef DEVMEM
-	return devmem_read_write(base, offset, NULL, &data);
+	ret = devmem_read_write(base, offset, NULL, &data);
 #else
-	return uio_read_write(base, offset, NULL, &data);
+	ret = uio_read_write(base, offset, NULL, &data);
 #endif
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_WRITE, 4, ret);
+
+	return ret;
 }
@@ -37,6 +37,8 @@
 #include "linux_spi.h"
 
 #include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
@@ -52,6 +54,24 @@
 struct linux_spi_desc {
 	/** /dev/spidev"device_id"."chip_select" file descriptor */
 	int spidev_fd;
+	/** Thread running the asynchronous transfers, started on first use */
+	pthread_t worker;
+	/** Set once the worker thread is started */
+	bool worker_started;
+	/** Set to stop the worker thread */
+	bool worker_stop;
+	/** Protects the fields below */
+	pthread_mutex_t lock;
+	/** Signals a new asynchronous transfer to the worker thread */
+	pthread_cond_t cond;
+	/** Messages of the pending asynchronous transfer, NULL if none */
+	struct no_os_spi_msg *msgs;
+	/** Number of messages */
+	uint32_t len;
+	/** Completion callback of the asynchronous transfer */
+	void (*callback)(void *, int32_t);
+	/** Completion callback context */
+	void *ctx;
 };
 
 /**
@@ -73,7 +93,7 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_spi_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_spi_desc*) no_os_calloc(1, sizeof(
 				struct linux_spi_desc));
 	if (!linux_desc)
 		goto free_desc;
@@ -110,6 +130,9 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 		goto free;
 	}
 
+	pthread_mutex_init(&linux_desc->lock, NULL);
+	pthread_cond_init(&linux_desc->cond, NULL);
+
 	*desc = descriptor;
 
 	return 0;
@@ -163,6 +186,18 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 
 	linux_desc = desc->extra;
 
+	if (linux_desc->worker_started) {
+		pthread_mutex_lock(&linux_desc->lock);
+		linux_desc->worker_stop = true;
+		pthread_cond_signal(&linux_desc->cond);
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		pthread_join(linux_desc->worker, NULL);
+	}
+
+	pthread_cond_destroy(&linux_desc->cond);
+	pthread_mutex_destroy(&linux_desc->lock);
+
 	ret = close(linux_desc->spidev_fd);
 	if (ret < 0) {
 		printf("%s: Can't close device\n\r", __func__);
@@ -210,6 +245,107 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 
 	return 0;
 }
+
+/**
+ * @brief Worker thread running the asynchronous transfers of a SPI device.
+ * The callback is invoked from this thread.
+ * @param arg - The SPI descriptor.
+ * @return NULL
+ */
+static void *linux_spi_worker(void *arg)
+{
+	struct no_os_spi_desc *desc = arg;
+	struct linux_spi_desc *linux_desc = desc->extra;
+	void (*callback)(void *, int32_t);
+	struct no_os_spi_msg *msgs;
+	uint32_t len;
+	int32_t ret;
+	void *ctx;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	while (true) {
+		while (!linux_desc->msgs && !linux_desc->worker_stop)
+			pthread_cond_wait(&linux_desc->cond, &linux_desc->lock);
+
+		if (!linux_desc->msgs)
+			break;
+
+		msgs = linux_desc->msgs;
+		len = linux_desc->len;
+		callback = linux_desc->callback;
+		ctx = linux_desc->ctx;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		ret = linux_spi_transfer(desc, msgs, len);
+
+		// The callback may start the next transfer
+		pthread_mutex_lock(&linux_desc->lock);
+		linux_desc->msgs = NULL;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		callback(ctx, ret);
+
+		pthread_mutex_lock(&linux_desc->lock);
+	}
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Hand the messages over to the worker thread of the SPI device and
+ * return. The callback is invoked from the worker thread once the transfer
+ * is done.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages in the array.
+ * @param callback - Function called with the result of the transfer.
+ * @param ctx - User specific data passed to the callback.
+ * @return 0 in case of success, -EBUSY if a transfer is already in progress,
+ * negative error code otherwise.
+ */
+static int32_t linux_spi_transfer_async(struct no_os_spi_desc *desc,
+					struct no_os_spi_msg *msgs,
+					uint32_t len,
+					void (*callback)(void *, int32_t),
+					void *ctx)
+{
+	struct linux_spi_desc *linux_desc;
+	int ret;
+
+	if (!msgs || !len || !callback)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	pthread_mutex_lock(&linux_desc->lock);
+
+	if (!linux_desc->worker_started) {
+		ret = pthread_create(&linux_desc->worker, NULL, linux_spi_worker,
+				     desc);
+		if (ret) {
+			pthread_mutex_unlock(&linux_desc->lock);
+			return -ret;
+		}
+		linux_desc->worker_started = true;
+	}
+
+	if (linux_desc->msgs) {
+		pthread_mutex_unlock(&linux_desc->lock);
+		return -EBUSY;
+	}
+
+	linux_desc->msgs = msgs;
+	linux_desc->len = len;
+	linux_desc->callback = callback;
+	linux_desc->ctx = ctx;
+	pthread_cond_signal(&linux_desc->cond);
+
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return 0;
+}
+
 /**
  * @brief Linux platform specific SPI platform ops structure
  */
@@ -217,5 +353,6 @@ const struct no_os_spi_platform_ops linux_spi_ops = {
 	.init = &linux_spi_init,
 	.write_and_read = &linux_spi_write_and_read,
 	.remove = &linux_spi_remove,
-	.transfer = &linux_spi_transfer
+	.transfer = &linux_spi_transfer,
+	.transfer_async = &linux_spi_transfer_async
 };
@@ -50,20 +50,12 @@ static struct no_os_list_desc *actions[MXC_CFG_GPIO_INSTANCES];
 /**
  * @brief GPIO callback function that sets the event and further calls
  * the user registered callback
- * @param cbdata - Used to pass an action reference
+ * @param cbdata - The action registered for the pin
  */
 static void gpio_irq_callback(void *cbdata)
 {
-	int ret;
-	struct irq_action *action;
-	struct irq_action *key = cbdata;
-
-	/* action->handle is the address of the GPIO port */
-	uint32_t id = MXC_GPIO_GET_IDX(key->handle);
-
-	ret = no_os_list_read_find(actions[id], (void **)&action, key);
-	if (ret)
-		return;
+	/* The HAL passes back the action registered for the pin */
+	struct irq_action *action = cbdata;
 
 	if (action->callback)
 		action->callback(action->ctx);
@@ -225,8 +217,8 @@ static int max_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 	if (!desc || !callback_desc || irq_id >= MXC_CFG_GPIO_PINS_PORT)
 		return -EINVAL;
 
-	ret = no_os_list_read_find(actions[desc->irq_ctrl_id], (void **)&discard_action,
-				   &action_key);
+	ret = no_os_list_get_find(actions[desc->irq_ctrl_id], (void **)&discard_action,
+				  &action_key);
 	if (ret)
 		return -ENODEV;
 
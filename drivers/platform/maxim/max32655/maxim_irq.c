@@ -49,15 +49,19 @@
 			      MXC_F_UART_INT_FL_RX_PAR | \
 			      MXC_F_UART_INT_FL_RX_OV)
 
-static struct event_list _events[] = {
-	[NO_OS_EVT_GPIO] = {.event = NO_OS_EVT_GPIO},
-	[NO_OS_EVT_UART_TX_COMPLETE] = {.event = NO_OS_EVT_UART_TX_COMPLETE},
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE},
-	[NO_OS_EVT_UART_ERROR] = {.event = NO_OS_EVT_UART_ERROR},
-	[NO_OS_EVT_RTC] = {.event = NO_OS_EVT_RTC},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED},
-	[NO_OS_EVT_DMA_RX_COMPLETE] = {.event = NO_OS_EVT_DMA_RX_COMPLETE},
-	[NO_OS_EVT_DMA_TX_COMPLETE] = {.event = NO_OS_EVT_DMA_TX_COMPLETE},
+/* Key of the dispatch table entries, the interrupt vector entry id */
+#define MAX_IRQ_HANDLE(irq_id)	((void *)(uintptr_t)(irq_id))
+
+/* Events of the callbacks registered through this controller */
+static const enum no_os_irq_event max_irq_events[] = {
+	NO_OS_EVT_GPIO,
+	NO_OS_EVT_UART_TX_COMPLETE,
+	NO_OS_EVT_UART_RX_COMPLETE,
+	NO_OS_EVT_UART_ERROR,
+	NO_OS_EVT_RTC,
+	NO_OS_EVT_TIM_ELAPSED,
+	NO_OS_EVT_DMA_RX_COMPLETE,
+	NO_OS_EVT_DMA_TX_COMPLETE,
 };
 
 static struct no_os_irq_ctrl_desc *nvic;
@@ -98,18 +102,13 @@ static bool is_gpio_irq_id(uint32_t irq_id)
  */
 static void _timer_common_callback(mxc_tmr_regs_t *tmr)
 {
+	void *handle = MAX_IRQ_HANDLE(MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr)));
 	int ret;
-	struct irq_action key = {.irq_id = MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr))};
-	struct irq_action *action;
-	struct event_list *evt_list = &_events[NO_OS_EVT_TIM_ELAPSED];
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
+	ret = no_os_irq_action_dispatch(NO_OS_EVT_TIM_ELAPSED, handle);
 	if (ret)
 		return;
 
-	if (action->callback)
-		action->callback(action->ctx);
-
 	MXC_TMR_ClearFlags(tmr);
 }
 
@@ -184,26 +183,13 @@ void TMR2_IRQHandler()
  */
 static void max_dma_handler(uint32_t ch_num)
 {
-	struct event_list *rx_evt_list = &_events[NO_OS_EVT_DMA_RX_COMPLETE];
-	struct event_list *tx_evt_list = &_events[NO_OS_EVT_DMA_TX_COMPLETE];
-	struct irq_action *rx_action, *tx_action;
-	struct irq_action key = {.irq_id = max_dma_get_irq(0, ch_num)};
-	int ret;
+	void *handle = MAX_IRQ_HANDLE(max_dma_get_irq(0, ch_num));
 
 	/* Clear the DMA interrupt flag */
 	MAX_DMA->ch[ch_num].st |= NO_OS_BIT(2);
 
-	if (rx_evt_list->actions) {
-		ret = no_os_list_read_find(rx_evt_list->actions, (void **)&rx_action, &key);
-		if (!ret && rx_action->callback)
-			rx_action->callback(rx_action->ctx);
-	}
-
-	if (tx_evt_list->actions) {
-		ret = no_os_list_read_find(tx_evt_list->actions, (void **)&tx_action, &key);
-		if (!ret && tx_action->callback)
-			tx_action->callback(tx_action->ctx);
-	}
+	no_os_irq_action_dispatch(NO_OS_EVT_DMA_RX_COMPLETE, handle);
+	no_os_irq_action_dispatch(NO_OS_EVT_DMA_TX_COMPLETE, handle);
 }
 
 void DMA0_IRQHandler()
@@ -288,19 +274,11 @@ void DMA15_IRQHandler()
 
 void RTC_IRQHandler()
 {
-	int ret;
 	uint32_t flags = MXC_RTC_GetFlags();
-	struct event_list *evt_list = &_events[NO_OS_EVT_RTC];
-	struct irq_action *action;
 
 	if (flags & MXC_RTC_INT_FL_LONG) {
 		MXC_RTC_ClearFlags(MXC_RTC_INT_FL_LONG);
-		ret = no_os_list_read_first(evt_list->actions, (void **)&action);
-		if (ret < 0)
-			return;
-
-		if (action->callback)
-			action->callback(action->ctx);
+		no_os_irq_action_dispatch(NO_OS_EVT_RTC, MAX_IRQ_HANDLE(RTC_IRQn));
 	}
 }
 
@@ -312,26 +290,25 @@ void RTC_IRQHandler()
  */
 void max_uart_callback(mxc_uart_req_t *req, int result)
 {
-	struct event_list *ee;
-	struct irq_action *a;
+	enum no_os_irq_event event;
+	struct no_os_irq_action *a;
 	uint32_t uart_id = MXC_UART_GET_IDX(req->uart);
-	struct irq_action key = {.irq_id = MXC_UART_GET_IRQ(uart_id)};
-	int ret;
 
 	if (result) {
-		ee = &_events[NO_OS_EVT_UART_ERROR];
+		event = NO_OS_EVT_UART_ERROR;
 		MXC_UART_ClearFlags(MXC_UART_GET_UART(uart_id),
 				    MAX_UART_ERROR_FLAGS);
 	} else if (req->txLen == req->txCnt && req->txLen != 0) {
-		ee = &_events[NO_OS_EVT_UART_TX_COMPLETE];
+		event = NO_OS_EVT_UART_TX_COMPLETE;
 	} else if (req->rxLen == req->rxCnt && req->rxLen != 0) {
-		ee = &_events[NO_OS_EVT_UART_RX_COMPLETE];
+		event = NO_OS_EVT_UART_RX_COMPLETE;
 	} else {
 		return;
 	}
 
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret)
+	a = no_os_irq_action_get(event,
+				 MAX_IRQ_HANDLE(MXC_UART_GET_IRQ(uart_id)));
+	if (!a)
 		return;
 
 	uart_irq_state[uart_id].uart = NULL;
@@ -381,16 +358,16 @@ int max_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
  */
 int max_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	void *discard;
+	uint32_t i, id;
+
 	if (!desc)
 		return -EINVAL;
 
-	for (uint32_t i = 0; i < NO_OS_ARRAY_SIZE(_events); i++) {
-		while (0 == no_os_list_get_first(_events[i].actions, &discard))
-			no_os_free(discard);
-		no_os_list_remove(_events[i].actions);
-		_events[i].actions = NULL;
-	}
+	for (i = 0; i < NO_OS_ARRAY_SIZE(max_irq_events); i++)
+		for (id = 0; id < MXC_IRQ_EXT_COUNT; id++)
+			no_os_irq_action_clear(max_irq_events[i],
+					       MAX_IRQ_HANDLE(id));
+
 	no_os_free(desc);
 	nvic = NULL;
 
@@ -410,50 +387,14 @@ int max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			      struct no_os_callback_desc *callback_desc)
 {
 	int ret;
-	void *discard;
-	bool new_action = false;
-	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
+	void *handle = MAX_IRQ_HANDLE(irq_id);
 
 	if (is_gpio_irq_id(irq_id))
 		return -ENOSYS;
 
-	if (!desc || !callback_desc
-	    || callback_desc->event >= NO_OS_ARRAY_SIZE(_events))
+	if (!desc || !callback_desc)
 		return -EINVAL;
 
-	if (_events[callback_desc->event].actions == NULL) {
-		ret = no_os_list_init(&_events[callback_desc->event].actions,
-				      NO_OS_LIST_PRIORITY_LIST,
-				      irq_action_cmp);
-		if (ret)
-			return ret;
-	}
-
-	ret = no_os_list_read_find(_events[callback_desc->event].actions,
-				   (void **)&action,
-				   &action_key);
-	/*
-	 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
-	 * otherwise update
-	 */
-	if (ret) {
-		action = no_os_calloc(1, sizeof(*action));
-		if (!action)
-			return -ENOMEM;
-
-		action->irq_id = irq_id;
-		action->handle = callback_desc->handle;
-		action->callback = callback_desc->callback;
-		action->ctx = callback_desc->ctx;
-
-		ret = no_os_list_add_last(_events[callback_desc->event].actions, action);
-		if (ret)
-			goto free_action;
-
-		new_action = true;
-	}
-
 	switch (callback_desc->peripheral) {
 	case NO_OS_SPI_DMA_IRQ:
 	case NO_OS_DMA_IRQ:
@@ -465,6 +406,8 @@ int max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		if (ret)
 			return -EBUSY;
 
+		/* There is a single RTC, dispatched by RTC_IRQn */
+		handle = MAX_IRQ_HANDLE(RTC_IRQn);
 		break;
 
 	case NO_OS_TIM_IRQ:
@@ -472,28 +415,11 @@ int max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		break;
 
 	default:
-		if (new_action) {
-			ret = -EINVAL;
-			goto remove_new_action;
-		}
-
 		return -EINVAL;
 	}
 
-	if (!new_action) {
-		action->irq_id = irq_id;
-		action->handle = callback_desc->handle;
-		action->callback = callback_desc->callback;
-		action->ctx = callback_desc->ctx;
-	}
-
-	return 0;
-
-remove_new_action:
-	no_os_list_get_last(_events[callback_desc->event].actions, &discard);
-free_action:
-	no_os_free(action);
-	return ret;
+	return no_os_irq_action_set(callback_desc->event, handle,
+				    callback_desc->callback, callback_desc->ctx);
 }
 
 /**
@@ -507,8 +433,7 @@ int max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				uint32_t irq_id, struct no_os_callback_desc *cb)
 {
 	int ret;
-	void *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = irq_id};
+	void *handle = MAX_IRQ_HANDLE(irq_id);
 
 	if (is_gpio_irq_id(irq_id))
 		return -ENOSYS;
@@ -517,11 +442,8 @@ int max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		return -EINVAL;
 
 	switch (cb->peripheral) {
-	case NO_OS_UART_IRQ:
-		action_key.handle = cb->handle;
-		break;
 	case NO_OS_RTC_IRQ:
-		action_key.handle = MXC_RTC;
+		handle = MAX_IRQ_HANDLE(RTC_IRQn);
 		MXC_RTC_DisableInt(MXC_RTC_INT_EN_LONG);
 		break;
 	case NO_OS_TIM_IRQ:
@@ -531,14 +453,11 @@ int max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		break;
 	}
 
-	ret = no_os_list_get_find(_events[cb->event].actions, &discard_action,
-				  &action_key);
+	ret = no_os_irq_action_clear(cb->event, handle);
 	if (ret)
 		return -ENODEV;
 
-	no_os_free(discard_action);
-
-	return ret;
+	return 0;
 }
 
 /**
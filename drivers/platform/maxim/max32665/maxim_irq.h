@@ -48,14 +48,6 @@ struct irq_action {
 	void *ctx;
 };
 
-/**
- * @brief Struct that stores all the actions for a specific event
- */
-struct event_list {
-	enum no_os_irq_event event;
-	struct no_os_list_desc *actions;
-};
-
 /**
  * @brief maxim platform specific irq platform ops structure
  */
@@ -44,13 +44,17 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
-static struct event_list _events[] = {
-	[NO_OS_EVT_GPIO] = {.event = NO_OS_EVT_GPIO},
-	[NO_OS_EVT_UART_TX_COMPLETE] = {.event = NO_OS_EVT_UART_TX_COMPLETE},
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE},
-	[NO_OS_EVT_UART_ERROR] = {.event = NO_OS_EVT_UART_ERROR},
-	[NO_OS_EVT_RTC] = {.event = NO_OS_EVT_RTC},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED},
+/* Key of the dispatch table entries, the interrupt vector entry id */
+#define MAX_IRQ_HANDLE(irq_id)	((void *)(uintptr_t)(irq_id))
+
+/* Events of the callbacks registered through this controller */
+static const enum no_os_irq_event max_irq_events[] = {
+	NO_OS_EVT_GPIO,
+	NO_OS_EVT_UART_TX_COMPLETE,
+	NO_OS_EVT_UART_RX_COMPLETE,
+	NO_OS_EVT_UART_ERROR,
+	NO_OS_EVT_RTC,
+	NO_OS_EVT_TIM_ELAPSED,
 };
 
 static struct no_os_irq_ctrl_desc *nvic;
@@ -93,18 +97,13 @@ static bool is_gpio_irq_id(uint32_t irq_id)
  */
 static void _timer_common_callback(mxc_tmr_regs_t *tmr)
 {
+	void *handle = MAX_IRQ_HANDLE(MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr)));
 	int ret;
-	struct irq_action key = {.irq_id = MXC_TMR_GET_IRQ(MXC_TMR_GET_IDX(tmr))};
-	struct irq_action *action;
-	struct event_list *evt_list = &_events[NO_OS_EVT_TIM_ELAPSED];
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
+	ret = no_os_irq_action_dispatch(NO_OS_EVT_TIM_ELAPSED, handle);
 	if (ret)
 		return;
 
-	if (action->callback)
-		action->callback(action->ctx);
-
 	MXC_TMR_ClearFlags(tmr);
 }
 
@@ -175,19 +174,11 @@ void TMR2_IRQHandler()
 
 void RTC_IRQHandler()
 {
-	int ret;
 	uint32_t flags = MXC_RTC_GetFlags();
-	struct event_list *evt_list = &_events[NO_OS_EVT_RTC];
-	struct irq_action *action;
 
 	if (flags & MXC_RTC_INT_FL_LONG) {
 		MXC_RTC_ClearFlags(MXC_RTC_INT_FL_LONG);
-		ret = no_os_list_read_first(evt_list->actions, (void **)&action);
-		if (ret < 0)
-			return;
-
-		if (action->callback)
-			action->callback(action->ctx);
+		no_os_irq_action_dispatch(NO_OS_EVT_RTC, MAX_IRQ_HANDLE(RTC_IRQn));
 	}
 }
 
@@ -199,23 +190,22 @@ void RTC_IRQHandler()
  */
 void max_uart_callback(mxc_uart_req_t *req, int result)
 {
-	struct event_list *ee;
-	struct irq_action *a;
+	enum no_os_irq_event event;
+	struct no_os_irq_action *a;
 	uint32_t uart_id = MXC_UART_GET_IDX(req->uart);
-	struct irq_action key = {.irq_id = MXC_UART_GET_IRQ(uart_id)};
-	int ret;
 
 	if (result)
-		ee = &_events[NO_OS_EVT_UART_ERROR];
+		event = NO_OS_EVT_UART_ERROR;
 	else if (req->txLen == req->txCnt && req->txLen != 0)
-		ee = &_events[NO_OS_EVT_UART_TX_COMPLETE];
+		event = NO_OS_EVT_UART_TX_COMPLETE;
 	else if (req->rxLen == req->rxCnt && req->rxLen != 0)
-		ee = &_events[NO_OS_EVT_UART_RX_COMPLETE];
+		event = NO_OS_EVT_UART_RX_COMPLETE;
 	else
 		return;
 
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret)
+	a = no_os_irq_action_get(event,
+				 MAX_IRQ_HANDLE(MXC_UART_GET_IRQ(uart_id)));
+	if (!a)
 		return;
 
 	uart_irq_state[uart_id].uart = NULL;
@@ -265,17 +255,16 @@ int max_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
  */
 int max_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	uint32_t i;
-	void *discard;
+	uint32_t i, id;
+
 	if (!desc)
 		return -EINVAL;
 
-	for (i = 0; i < NO_OS_ARRAY_SIZE(_events); i++) {
-		while (0 == no_os_list_get_first(_events[i].actions, &discard))
-			no_os_free(discard);
-		no_os_list_remove(_events[i].actions);
-		_events[i].actions = NULL;
-	}
+	for (i = 0; i < NO_OS_ARRAY_SIZE(max_irq_events); i++)
+		for (id = 0; id < MXC_IRQ_EXT_COUNT; id++)
+			no_os_irq_action_clear(max_irq_events[i],
+					       MAX_IRQ_HANDLE(id));
+
 	no_os_free(desc);
 	nvic = NULL;
 
@@ -295,8 +284,7 @@ int max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			      struct no_os_callback_desc *callback_desc)
 {
 	int ret;
-	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
+	void *handle = MAX_IRQ_HANDLE(irq_id);
 
 	if (is_gpio_irq_id(irq_id))
 		return -ENOSYS;
@@ -306,125 +294,22 @@ int max_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 
 	switch (callback_desc->peripheral) {
 	case NO_OS_UART_IRQ:
-		if (_events[callback_desc->event].actions == NULL) {
-			ret = no_os_list_init(&_events[callback_desc->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
-		}
-
-		ret = no_os_list_read_find(_events[callback_desc->event].actions,
-					   (void **)&action,
-					   &action_key);
-		/*
-		 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
-		 * otherwise update
-		 */
-		if (ret) {
-			action = no_os_calloc(1, sizeof(*action));
-			if (!action)
-				return -ENOMEM;
-
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-
-			ret = no_os_list_add_last(_events[callback_desc->event].actions, action);
-			if (ret)
-				goto free_action;
-		} else {
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-		}
+	case NO_OS_TIM_IRQ:
 		break;
 	case NO_OS_RTC_IRQ:
-		if (_events[NO_OS_EVT_RTC].actions == NULL) {
-			ret = no_os_list_init(&_events[NO_OS_EVT_RTC].actions, NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
-		}
-
-		/*
-		 * This is a special case for RTC on Maxim platform. Since there is only 1 RTC peripheral, there should
-		 * be only 1 registered callback at a time.
-		 */
-		ret = no_os_list_read_first(_events[NO_OS_EVT_RTC].actions, (void **)&action);
-		if (ret) {
-			action = no_os_calloc(1, sizeof(*action));
-			if (!action)
-				return -ENOMEM;
-
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-
-			ret = no_os_list_add_first(_events[NO_OS_EVT_RTC].actions, action);
-			if (ret)
-				goto free_action;
-
-		} else {
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-		}
-
 		ret = MXC_RTC_EnableInt(MXC_RTC_INT_EN_LONG);
 		if (ret)
 			return -EBUSY;
-		break;
-	case NO_OS_TIM_IRQ:
-		if (_events[NO_OS_EVT_TIM_ELAPSED].actions == NULL) {
-			ret = no_os_list_init(&_events[NO_OS_EVT_TIM_ELAPSED].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret)
-				return ret;
-		}
-
-		ret = no_os_list_read_find(_events[callback_desc->event].actions,
-					   (void **)&action,
-					   &action_key);
-		/*
-		 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
-		 * otherwise update
-		 */
-		if (ret) {
-			action = no_os_calloc(1, sizeof(*action));
-			if (!action)
-				return -ENOMEM;
-
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-
-			ret = no_os_list_add_last(_events[callback_desc->event].actions, action);
-			if (ret)
-				goto free_action;
-
-		} else {
-			action->irq_id = irq_id;
-			action->handle = callback_desc->handle;
-			action->callback = callback_desc->callback;
-			action->ctx = callback_desc->ctx;
-		}
+
+		/* There is a single RTC, dispatched by RTC_IRQn */
+		handle = MAX_IRQ_HANDLE(RTC_IRQn);
 		break;
 	default:
 		return -EINVAL;
 	}
 
-	return 0;
-
-free_action:
-	no_os_free(action);
-	return ret;
+	return no_os_irq_action_set(callback_desc->event, handle,
+				    callback_desc->callback, callback_desc->ctx);
 }
 
 /**
@@ -438,8 +323,7 @@ int max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				uint32_t irq_id, struct no_os_callback_desc *cb)
 {
 	int ret;
-	void *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = irq_id};
+	void *handle = MAX_IRQ_HANDLE(irq_id);
 
 	if (is_gpio_irq_id(irq_id))
 		return -ENOSYS;
@@ -448,25 +332,19 @@ int max_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		return -EINVAL;
 
 	switch (cb->peripheral) {
-	case NO_OS_UART_IRQ:
-		action_key.handle = cb->handle;
-		break;
 	case NO_OS_RTC_IRQ:
-		action_key.handle = MXC_RTC;
+		handle = MAX_IRQ_HANDLE(RTC_IRQn);
 		MXC_RTC_DisableInt(MXC_RTC_INT_EN_LONG);
 		break;
 	default:
 		break;
 	}
 
-	ret = no_os_list_get_find(_events[cb->event].actions, &discard_action,
-				  &action_key);
+	ret = no_os_irq_action_clear(cb->event, handle);
 	if (ret)
 		return -ENODEV;
 
-	no_os_free(discard_action);
-
-	return ret;
+	return 0;
 }
 
 /**
@@ -32,7 +32,6 @@
 *******************************************************************************/
 
 #include "no_os_irq.h"
-#include "no_os_list.h"
 #include "no_os_uart.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
@@ -46,45 +45,19 @@
 
 #define PICO_IRQ_NB 26u
 
-struct irq_action {
-	uint32_t irq_id;
-	void *handle;
-	void (*callback)(void *context);
-	void *ctx;
-};
-
-struct event_list {
-	enum no_os_irq_event event;
-	struct no_os_list_desc *actions;
-};
-
 static bool initialized =  false;
 static uint32_t irq_enabled_mask = 0;
 
-static struct event_list _events[] = {
-	[NO_OS_EVT_UART_RX_COMPLETE] = {.event = NO_OS_EVT_UART_RX_COMPLETE},
-	[NO_OS_EVT_TIM_ELAPSED] = {.event = NO_OS_EVT_TIM_ELAPSED},
-};
-
 /**
  * @brief UART interrupt handler.
  * @param uart - UART instance.
  */
 static void _uart_common_handler(uart_inst_t *uart)
 {
-	int ret;
-	struct event_list *evt_list = &_events[NO_OS_EVT_UART_RX_COMPLETE];
-	struct irq_action *action;
-
-	uint8_t uart_irq_id = (uart == uart0) ? UART0_IRQ : UART1_IRQ;
-	struct irq_action key = {.irq_id = uart_irq_id};
-
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
-	if (ret)
-		return;
+	uint32_t uart_irq_id = (uart == uart0) ? UART0_IRQ : UART1_IRQ;
 
-	if (action->callback)
-		action->callback(action->ctx);
+	no_os_irq_action_dispatch(NO_OS_EVT_UART_RX_COMPLETE,
+				  (void *)(uintptr_t)uart_irq_id);
 }
 
 /**
@@ -94,18 +67,12 @@ static void _uart_common_handler(uart_inst_t *uart)
 static void _alarm_callback(uint alarm_num)
 {
 	int ret;
-	struct event_list *evt_list = &_events[NO_OS_EVT_TIM_ELAPSED];
-	struct irq_action *action;
-
-	struct irq_action key = {.irq_id = alarm_num};
 
-	ret = no_os_list_read_find(evt_list->actions, (void **)&action, &key);
+	ret = no_os_irq_action_dispatch(NO_OS_EVT_TIM_ELAPSED,
+					(void *)(uintptr_t)alarm_num);
 	if (ret)
 		return;
 
-	if (action->callback)
-		action->callback(action->ctx);
-
 	/* Trigger alarm again */
 	no_os_timer_start(pico_alarm_desc[alarm_num]);
 }
@@ -128,18 +95,6 @@ void on_uart1_rx(void)
 		_uart_common_handler(uart1);
 }
 
-/**
- * @brief Action comparator function.
- * @param data1 - List element.
- * @param data2 - Key.
- * @return 0 if the two are equal, any other integer otherwise.
- */
-int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
-}
-
 /**
  * @brief Initialized the controller for pico external interrupts.
  * @param desc  - Pointer where the configured instance is stored.
@@ -210,25 +165,12 @@ int pico_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 			       struct no_os_callback_desc *cb)
 {
 	int ret;
-	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = irq_id};
 
 	switch (cb->peripheral) {
 	case NO_OS_UART_IRQ:
 		/* Set up the interrupt handler */
 		irq_set_exclusive_handler(irq_id,
 					  cb->handle == uart0 ? on_uart0_rx : on_uart1_rx);
-
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret) {
-				irq_remove_handler(irq_id,
-						   cb->handle == uart0 ? on_uart0_rx : on_uart1_rx);
-				return ret;
-			}
-		}
 		break;
 	case NO_OS_TIM_IRQ:
 		/* Set up the interrupt handler */
@@ -236,48 +178,24 @@ int pico_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		/* By default, disable alarm irq.
 		The user shall enable the interrupt when seen fit. */
 		irq_set_enabled(irq_id, false);
-
-		if (_events[cb->event].actions == NULL) {
-			ret = no_os_list_init(&_events[cb->event].actions,
-					      NO_OS_LIST_PRIORITY_LIST,
-					      irq_action_cmp);
-			if (ret) {
-				hardware_alarm_set_callback(irq_id, NULL);
-				return ret;
-			}
-		}
 		break;
 	default:
 		return -EINVAL;
 	}
 
-	ret = no_os_list_read_find(_events[cb->event].actions,
-				   (void **)&action,
-				   &action_key);
 	/*
 	 * If an action with the same irq_id as the function parameter does not exists, insert a new one,
 	 * otherwise update
 	 */
+	ret = no_os_irq_action_set(cb->event, (void *)(uintptr_t)irq_id,
+				   cb->callback, cb->ctx);
 	if (ret) {
-		action = no_os_calloc(1, sizeof(*action));
-		if (!action)
-			return -ENOMEM;
-
-		action->irq_id = irq_id;
-		action->handle = cb->handle;
-		action->callback = cb->callback;
-		action->ctx = cb->ctx;
-
-		ret = no_os_list_add_last(_events[cb->event].actions, action);
-		if (ret) {
-			no_os_free(action);
-			return ret;
-		}
-	} else {
-		action->irq_id = irq_id;
-		action->handle = cb->handle;
-		action->callback = cb->callback;
-		action->ctx = cb->ctx;
+		if (cb->peripheral == NO_OS_UART_IRQ)
+			irq_remove_handler(irq_id,
+					   cb->handle == uart0 ? on_uart0_rx : on_uart1_rx);
+		else
+			hardware_alarm_set_callback(irq_id, NULL);
+		return ret;
 	}
 
 	return 0;
@@ -294,16 +212,12 @@ int pico_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				 uint32_t irq_id, struct no_os_callback_desc *cb)
 {
 	int ret;
-	void *discard;
-	struct irq_action key;
 
-	key.handle = cb->handle;
-	ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
+	ret = no_os_irq_action_clear(cb->event, (void *)(uintptr_t)irq_id);
 	if (ret)
 		return ret;
 
 	irq_remove_handler(irq_id, NULL);
-	no_os_free(discard);
 
 	return 0;
 }
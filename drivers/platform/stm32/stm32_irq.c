@@ -34,22 +34,14 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <errno.h>
-#include "no_os_list.h"
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 #include "stm32_irq.h"
 
-struct irq_action {
-	void *handle;
-	void (*callback)(void *context);
-	void *ctx;
-};
-
 struct event_list {
 	enum no_os_irq_event event;
 	uint32_t hal_event;
-	struct no_os_list_desc *actions;
 };
 
 static bool initialized =  false;
@@ -73,93 +65,36 @@ static struct event_list _events[] = {
 #endif
 };
 
-static int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return (int32_t)((struct irq_action *)data1)->handle -
-	       (int32_t)((struct irq_action *)data2)->handle;
-}
-
 #ifdef HAL_TIM_MODULE_ENABLED
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-	struct event_list *ee = &_events[NO_OS_EVT_TIM_ELAPSED];
-	struct irq_action *a;
-	struct irq_action key = {.handle = htim};
-	int ret;
-
-	/* Find & call callback */
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(NO_OS_EVT_TIM_ELAPSED, htim);
 }
 
 void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
 {
-	struct event_list *ee = &_events[NO_OS_EVT_TIM_PWM_PULSE_FINISHED];
-	struct irq_action *a;
-	struct irq_action key = {.handle = htim};
-	int ret;
-
-	/* Find & call callback */
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(NO_OS_EVT_TIM_PWM_PULSE_FINISHED, htim);
 }
 #endif
 
 #ifdef HAL_LPTIM_MODULE_ENABLED
 void HAL_LPTIM_CompareMatchCallback(LPTIM_HandleTypeDef *hlptim)
 {
-	struct event_list *ee = &_events[NO_OS_EVT_LPTIM_PWM_PULSE_FINISHED];
-	struct irq_action *a;
-	struct irq_action key = {.handle = hlptim};
-	int ret;
-
-	/* Find & call callback */
-	ret = no_os_list_read_find(ee->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(NO_OS_EVT_LPTIM_PWM_PULSE_FINISHED, hlptim);
 }
 #endif
 
 static inline void _common_uart_callback(UART_HandleTypeDef *huart,
 		uint32_t no_os_event)
 {
-	struct event_list *ue = &_events[no_os_event];
-	struct irq_action *a;
-	struct irq_action key = {.handle = huart};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(no_os_event, huart);
 }
 
 #if defined (HAL_SAI_MODULE_ENABLED)
 static inline void _common_sai_dma_callback(SAI_HandleTypeDef *hsai,
 		uint32_t no_os_event)
 {
-	struct event_list *ue = &_events[no_os_event];
-	struct irq_action *a;
-	struct irq_action key = {.handle = hsai};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(no_os_event, hsai);
 }
 #endif
 
@@ -167,16 +102,7 @@ static inline void _common_sai_dma_callback(SAI_HandleTypeDef *hsai,
 static inline void _common_dma_callback(DMA_HandleTypeDef *hdma,
 					uint32_t no_os_event)
 {
-	struct event_list *ue = &_events[no_os_event];
-	struct irq_action *a;
-	struct irq_action key = {.handle = hdma};
-	int ret;
-	ret = no_os_list_read_find(ue->actions, (void **)&a, &key);
-	if (ret < 0)
-		return;
-
-	if (a->callback)
-		a->callback(a->ctx);
+	no_os_irq_action_dispatch(no_os_event, hdma);
 }
 #endif
 
@@ -306,11 +232,9 @@ int stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 #ifdef HAL_LPTIM_MODULE_ENABLED
 	pLPTIM_CallbackTypeDef pLPTimCallback;
 #endif
-	struct irq_action action_key = {.handle = cb->handle};
 #ifdef HAL_DMA_MODULE_ENABLED
 	DMA_HandleTypeDef pDmaCallback;
 #endif
-	struct irq_action *li;
 	uint32_t hal_event = _events[cb->event].hal_event;
 
 	switch (cb->peripheral) {
@@ -436,37 +360,13 @@ int stm32_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		return -EINVAL;
 	}
 
-	if (_events[cb->event].actions == NULL) {
-		ret = no_os_list_init(&_events[cb->event].actions, NO_OS_LIST_PRIORITY_LIST,
-				      irq_action_cmp);
-		if (ret < 0)
-			return ret;
-	}
 	/*
 	 * If an action with the same handle as the function parameter does not exists, insert a new one,
 	 * otherwise update
 	 */
-	ret = no_os_list_read_find(_events[cb->event].actions,
-				   (void**)&li,
-				   &action_key);
-	if (ret) {
-		li = no_os_calloc(1, sizeof(struct irq_action));
-		if (!li)
-			return -ENOMEM;
-
-		li->handle = cb->handle;
-		li->callback = cb->callback;
-		li->ctx = cb->ctx;
-		ret = no_os_list_add_last(_events[cb->event].actions, li);
-		if (ret < 0) {
-			no_os_free(li);
-			return ret;
-		}
-	} else {
-		li->handle = cb->handle;
-		li->callback = cb->callback;
-		li->ctx = cb->ctx;
-	}
+	ret = no_os_irq_action_set(cb->event, cb->handle, cb->callback, cb->ctx);
+	if (ret)
+		return ret;
 
 	return 0;
 }
@@ -482,14 +382,11 @@ int stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 				  uint32_t irq_id, struct no_os_callback_desc *cb)
 {
 	int ret;
-	void *discard  = NULL;
-	struct irq_action key;
 	uint32_t hal_event = _events[cb->event].hal_event;
 
 	switch (cb->peripheral) {
 	case NO_OS_UART_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
+		ret = no_os_irq_action_clear(cb->event, cb->handle);
 		if (ret < 0)
 			break;
 		ret = HAL_UART_UnRegisterCallback(cb->handle, hal_event);
@@ -498,8 +395,7 @@ int stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		break;
 #ifdef HAL_TIM_MODULE_ENABLED
 	case NO_OS_TIM_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
+		ret = no_os_irq_action_clear(cb->event, cb->handle);
 		if (ret < 0)
 			break;
 		ret = HAL_TIM_UnRegisterCallback(cb->handle, hal_event);
@@ -509,8 +405,7 @@ int stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 #endif
 #if defined(HAL_DMA_MODULE_ENABLED) && defined(HAL_SAI_MODULE_ENABLED)
 	case NO_OS_TDM_DMA_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
+		ret = no_os_irq_action_clear(cb->event, cb->handle);
 		if (ret < 0)
 			break;
 		ret = HAL_SAI_UnRegisterCallback(cb->handle, hal_event);
@@ -521,8 +416,7 @@ int stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 #if defined (HAL_TIM_MODULE_ENABLED) && defined(HAL_DMA_MODULE_ENABLED)
 	case NO_OS_TIM_DMA_IRQ:
 	case NO_OS_DMA_IRQ:
-		key.handle = cb->handle;
-		ret = no_os_list_get_find(_events[cb->event].actions, &discard, &key);
+		ret = no_os_irq_action_clear(cb->event, cb->handle);
 		if (ret < 0)
 			break;
 		ret = HAL_DMA_UnRegisterCallback(cb->handle, hal_event);
@@ -535,9 +429,6 @@ int stm32_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		break;
 	}
 
-	if (discard)
-		no_os_free(discard);
-
 	return ret;
 }
 
@@ -34,6 +34,10 @@
 #include <xil_io.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
+#include "no_os_util.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 
 /**
  * @brief AXI IO Xilinx specific read function.
@@ -44,7 +48,9 @@
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
+	NO_OS_TRACE_BEGIN();
 	*data = Xil_In32(base + offset);
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_READ, 4, 0);
 
 	return 0;
 }
@@ -58,7 +64,9 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
+	NO_OS_TRACE_BEGIN();
 	Xil_Out32(base + offset, data);
+	NO_OS_TRACE_END(NO_OS_TRACE_AXI, 0, base, NO_OS_TRACE_WRITE, 4, 0);
 
 	return 0;
 }
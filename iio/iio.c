@@ -35,6 +35,8 @@
 #include "iio.h"
 #include "iio_types.h"
 #include "iiod.h"
+#include "iio_delta.h"
+#include "iio_filter.h"
 #include "ctype.h"
 #include "no_os_util.h"
 #include "no_os_list.h"
@@ -43,7 +45,12 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#ifdef NO_OS_TRACE
+#include "no_os_trace.h"
+#endif
 #include <inttypes.h>
+#include <limits.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -61,8 +68,23 @@
 #define IIOD_PORT		30431
 #define MAX_SOCKET_TO_HANDLE	10
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
+#define BUS_TRACE_ATTRIBUTE	"bus_trace"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
 #define NO_TRIGGER				(uint32_t)-1
+/* Timestamps kept per trigger for the pending events, power of 2 */
+#define IIO_TRIG_TIMESTAMPS		8
+#define COMPRESSION_ATTRIBUTE	"compression"
+#define COMPRESSION_AVAILABLE	"compression_available"
+#define SCAN_SEQUENCE_ATTRIBUTE	"scan_sequence"
+#define SCAN_GAPS_ATTRIBUTE	"scan_gaps"
+#define OVERRUNS_ATTRIBUTE	"overruns"
+#define UNDERRUNS_ATTRIBUTE	"underruns"
+#define FILTER_ATTRIBUTE	"filter"
+#define FILTER_AVAILABLE	"filter_available"
+#define DECIMATION_ATTRIBUTE	"decimation"
+#define FILTER_ORDER_ATTRIBUTE	"filter_order"
+#define FILTER_MASK_ATTRIBUTE	"filter_mask"
+#define FILTER_COEFFS_ATTRIBUTE	"filter_coefficients"
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -112,6 +134,15 @@ static const char * const iio_chan_type_string[] = {
 	[IIO_DELTA_ANGL] = "deltaangl",
 	[IIO_DELTA_VELOCITY] = "deltavelocity",
 	[IIO_WEIGHT] = "weight",
+	[IIO_TIMESTAMP] = "timestamp",
+};
+
+struct scan_type iio_timestamp_scan_type = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false,
 };
 
 static const char * const iio_modifier_names[] = {
@@ -145,6 +176,48 @@ struct iio_buffer_priv {
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Bytes of cb referenced by the connection and not yet released */
+	uint32_t		ref_pending;
+	/* Set when the buffer was closed while ref_pending was not 0 */
+	bool			close_pending;
+	/* Set when the data read from the buffer is delta encoded */
+	bool			compress;
+	/* Encoder state, allocated while a compressed buffer is open */
+	struct iio_delta	*delta;
+	/* Scan being encoded followed by its encoded form */
+	uint8_t			*enc_buf;
+	/* Size of the encoded scan */
+	uint32_t		enc_len;
+	/* Bytes of the encoded scan already read */
+	uint32_t		enc_idx;
+	/* Trigger event sequence number of the first scan since open */
+	uint32_t		first_sequence;
+	/* Set once first_sequence is known */
+	bool			sequence_valid;
+	/* Trigger events without a scan in the buffer since open */
+	uint32_t		gaps;
+	/* Scans lost because the input buffer was full since open */
+	uint32_t		overruns;
+	/* Scans missing when popped from the output buffer since open */
+	uint32_t		underruns;
+	/* Offset of the timestamp in a scan, -1 if the channel is disabled */
+	int32_t			ts_offset;
+	/* Trigger of the events being handled, NULL outside of the handlers */
+	struct iio_trig_priv	*ts_trig;
+	/* Event of the next pushed scan and last pending event of ts_trig */
+	uint32_t		ts_seq;
+	uint32_t		ts_last;
+	/* Clock of the timestamp channel, from iio_init_param */
+	uint64_t		(*get_timestamp)(void);
+	/* Block given by iio_buffer_get_block and its size */
+	uint8_t			*block;
+	uint32_t		block_len;
+	/* Position of the enabled channels in a scan, set on open */
+	struct iio_scan_layout	layout;
+	/* Filter applied to the scans read, from the buffer attributes */
+	struct iio_filter_cfg	filter_cfg;
+	/* Filter state, allocated while a filtered buffer is open */
+	struct iio_filter	*filter;
 };
 
 /**
@@ -169,6 +242,10 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Value of iio_trig_priv.events already processed by the device */
+	uint32_t		trig_events;
+	/* Set while the device counts in iio_trig_priv.nb_enabled */
+	bool			trig_enabled;
 };
 
 /**
@@ -185,16 +262,33 @@ struct iio_trig_priv {
 	void	*instance;
 	/** Trigger descriptor(describes type of trigger and its attributes) */
 	struct iio_trigger *descriptor;
-	/** Set to true when the triggering condition is met */
-	bool	triggered;
+	/**
+	 * Number of times the triggering condition was met. Only incremented
+	 * from interrupt context, pending events are counted against it.
+	 */
+	volatile uint32_t	events;
+	/**
+	 * Timestamps of the last events, 0 if not available. The one of event
+	 * n (the value of events once counted) is at n % IIO_TRIG_TIMESTAMPS.
+	 */
+	volatile uint64_t	timestamps[IIO_TRIG_TIMESTAMPS];
+	/** Number of open buffers using the trigger */
+	uint32_t		nb_enabled;
 };
 
 struct iio_desc {
 	struct iiod_desc	*iiod;
 	struct iiod_ops		iiod_ops;
 	void			*phy_desc;
+	/* Generated xml, NULL if the application provides it */
 	char			*xml_desc;
+	/* xml sent to clients */
+	const char		*xml;
 	uint32_t		xml_size;
+	/* FNV-1a hash of xml, in hex */
+	char			xml_hash[9];
+	/* Clock used when a trigger gives no timestamp, may be NULL */
+	uint64_t		(*get_timestamp)(void);
 	struct iio_ctx_attr	*ctx_attrs;
 	uint32_t		nb_ctx_attr;
 	struct iio_dev_priv	*devs;
@@ -492,6 +586,319 @@ static int iio_rd_wr_attribute(struct attr_fun_params *params,
 	}
 }
 
+static inline bool iio_is_space(char c)
+{
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*
+ * Equivalent of strtol(str, NULL, base) for base 0 or 10, truncated to 32 bits
+ * the same way. It doesn't depend on the locale. The string is considered to
+ * end at the first delim character.
+ */
+static int32_t iio_str_to_int(const char *str, uint32_t base, char delim)
+{
+	unsigned long acc = 0;
+	unsigned long lim;
+	bool neg = false;
+	uint32_t digit;
+	char c;
+
+	while (*str != delim && iio_is_space(*str))
+		str++;
+	if (*str == '-' || *str == '+')
+		neg = *str++ == '-';
+
+	if (!base) {
+		if (str[0] == '0' && (str[1] | 0x20) == 'x' && isxdigit(str[2])) {
+			base = 16;
+			str += 2;
+		} else if (str[0] == '0') {
+			base = 8;
+		} else {
+			base = 10;
+		}
+	}
+
+	lim = neg ? -(unsigned long)LONG_MIN : LONG_MAX;
+	for (;; str++) {
+		c = *str;
+		if (c >= '0' && c <= '9')
+			digit = c - '0';
+		else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f')
+			digit = (c | 0x20) - 'a' + 10;
+		else
+			break;
+		if (digit >= base)
+			break;
+		/* Saturate like strtol */
+		if (acc > (lim - digit) / base) {
+			acc = lim;
+			break;
+		}
+		acc = acc * base + digit;
+	}
+
+	return (int32_t)(neg ? -acc : acc);
+}
+
+/* Names of enum iio_filter_type, as written in the filter attribute */
+static const char * const iio_filter_names[] = {
+	[IIO_FILTER_NONE] = "none",
+	[IIO_FILTER_MOVING_AVERAGE] = "moving_average",
+	[IIO_FILTER_CIC] = "cic",
+	[IIO_FILTER_FIR] = "fir",
+};
+
+/**
+ * @brief Parse the FIR coefficients, integers separated by spaces or commas.
+ * @param cfg - Filter configuration where the coefficients are stored.
+ * @param buf - Null terminated list.
+ * @return 0 in case of success, negative value otherwise.
+ */
+static int iio_filter_parse_taps(struct iio_filter_cfg *cfg, const char *buf)
+{
+	int16_t taps[IIO_FILTER_MAX_TAPS];
+	uint32_t nb_taps = 0;
+	int32_t val;
+
+	while (true) {
+		while (*buf == ',' || iio_is_space(*buf))
+			buf++;
+		if (!*buf)
+			break;
+
+		if (nb_taps == IIO_FILTER_MAX_TAPS)
+			return -EINVAL;
+
+		val = iio_str_to_int(buf, 0, '\0');
+		if (val < INT16_MIN || val > INT16_MAX)
+			return -EINVAL;
+		taps[nb_taps++] = val;
+
+		if (*buf == '-' || *buf == '+')
+			buf++;
+		if (!isalnum((unsigned char)*buf))
+			return -EINVAL;
+		while (isalnum((unsigned char)*buf))
+			buf++;
+	}
+
+	if (!nb_taps)
+		return -EINVAL;
+
+	memcpy(cfg->taps, taps, nb_taps * sizeof(*taps));
+	cfg->nb_taps = nb_taps;
+
+	return 0;
+}
+
+/**
+ * @brief Check if a device has input channels in its scans. The filter only
+ * runs on the data read from input buffers.
+ * @param device - Device descriptor.
+ * @return true if at least one input channel has a scan type.
+ */
+static bool iio_device_has_input_scan(struct iio_device *device)
+{
+	uint32_t i;
+
+	for (i = 0; i < device->num_ch; i++)
+		if (!device->channels[i].ch_out && device->channels[i].scan_type)
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief Read/write the buffer attributes configuring the filter. The filter
+ * is set up when the buffer is opened, so they can't be written while it is.
+ * @param dev - IIO device.
+ * @param attr_name - Attribute name.
+ * @param buf - Value to be written or buffer where the value is read.
+ * @param len - Length of the value or of buf.
+ * @param is_write - If set, writes the attribute, otherwise reads it.
+ * @return Length of chars written/read, -ENOENT if the attribute isn't a
+ * filter attribute or the device has no input buffer, or other negative value
+ * in case of error.
+ */
+static int iio_filter_buffer_attr(struct iio_dev_priv *dev,
+				  const char *attr_name, char *buf,
+				  uint32_t len, bool is_write)
+{
+	struct iio_filter_cfg *cfg = &dev->buffer.filter_cfg;
+	struct iio_filter_cfg new_cfg = *cfg;
+	int32_t val;
+	uint32_t i;
+	int ret;
+
+	if (!iio_device_has_input_scan(dev->dev_descriptor))
+		return -ENOENT;
+
+	if (!strcmp(attr_name, FILTER_AVAILABLE)) {
+		if (is_write)
+			return -EACCES;
+
+		return snprintf(buf, len, "%s %s %s %s",
+				iio_filter_names[IIO_FILTER_NONE],
+				iio_filter_names[IIO_FILTER_MOVING_AVERAGE],
+				iio_filter_names[IIO_FILTER_CIC],
+				iio_filter_names[IIO_FILTER_FIR]);
+	}
+
+	if (!is_write) {
+		if (!strcmp(attr_name, FILTER_ATTRIBUTE))
+			return snprintf(buf, len, "%s",
+					iio_filter_names[cfg->type]);
+		if (!strcmp(attr_name, DECIMATION_ATTRIBUTE))
+			return snprintf(buf, len, "%"PRIu32, cfg->decimation);
+		if (!strcmp(attr_name, FILTER_ORDER_ATTRIBUTE))
+			return snprintf(buf, len, "%"PRIu32, cfg->order);
+		if (!strcmp(attr_name, FILTER_MASK_ATTRIBUTE))
+			return snprintf(buf, len, "0x%"PRIx32, cfg->mask);
+		if (strcmp(attr_name, FILTER_COEFFS_ATTRIBUTE))
+			return -ENOENT;
+
+		ret = 0;
+		for (i = 0; i < cfg->nb_taps; i++)
+			ret += snprintf(buf + ret, no_os_max((int)len - ret, 0),
+					i ? " %"PRIi16 : "%"PRIi16,
+					cfg->taps[i]);
+
+		return ret;
+	}
+
+	if (!strcmp(attr_name, FILTER_ATTRIBUTE)) {
+		for (i = 0; i < NO_OS_ARRAY_SIZE(iio_filter_names); i++)
+			if (!strncmp(buf, iio_filter_names[i],
+				     strlen(iio_filter_names[i])))
+				break;
+		if (i == NO_OS_ARRAY_SIZE(iio_filter_names))
+			return -EINVAL;
+
+		new_cfg.type = i;
+	} else if (!strcmp(attr_name, DECIMATION_ATTRIBUTE)) {
+		val = iio_str_to_int(buf, 0, '\0');
+		if (val < 1)
+			return -EINVAL;
+
+		new_cfg.decimation = val;
+	} else if (!strcmp(attr_name, FILTER_ORDER_ATTRIBUTE)) {
+		val = iio_str_to_int(buf, 0, '\0');
+		if (val < 1 || val > IIO_FILTER_MAX_ORDER)
+			return -EINVAL;
+
+		new_cfg.order = val;
+	} else if (!strcmp(attr_name, FILTER_MASK_ATTRIBUTE)) {
+		new_cfg.mask = iio_str_to_int(buf, 0, '\0');
+	} else if (!strcmp(attr_name, FILTER_COEFFS_ATTRIBUTE)) {
+		ret = iio_filter_parse_taps(&new_cfg, buf);
+		if (ret)
+			return ret;
+	} else {
+		return -ENOENT;
+	}
+
+	if (dev->buffer.public.active_mask)
+		return -EBUSY;
+
+	/* A FIR filter is checked when the buffer is opened, after the taps */
+	if (new_cfg.type != IIO_FILTER_FIR) {
+		ret = iio_filter_cfg_check(&new_cfg);
+		if (ret)
+			return ret;
+	}
+
+	*cfg = new_cfg;
+
+	return len;
+}
+
+/**
+ * @brief Read/write the buffer attributes handled by the IIO core.
+ * @param dev - IIO device.
+ * @param attr_name - Attribute name.
+ * @param buf - Value to be written or buffer where the value is read.
+ * @param len - Length of the value or of buf.
+ * @param is_write - If set, writes the attribute, otherwise reads it.
+ * @return Length of chars written/read, -ENOENT if the attribute isn't
+ * handled by the IIO core or other negative value in case of error.
+ */
+static int iio_core_buffer_attr(struct iio_dev_priv *dev,
+				const char *attr_name, char *buf,
+				uint32_t len, bool is_write)
+{
+	static const char delta_varint[] = "delta_varint";
+	static const char none[] = "none";
+	int ret;
+
+	if (!dev->buffer.initalized)
+		return -ENOENT;
+
+	ret = iio_filter_buffer_attr(dev, attr_name, buf, len, is_write);
+	if (ret != -ENOENT)
+		return ret;
+
+	if (!strcmp(attr_name, SCAN_SEQUENCE_ATTRIBUTE)) {
+		if (is_write)
+			return -EACCES;
+		if (!dev->buffer.sequence_valid)
+			return -EAGAIN;
+
+		return snprintf(buf, len, "%"PRIu32, dev->buffer.first_sequence);
+	}
+
+	if (!strcmp(attr_name, SCAN_GAPS_ATTRIBUTE)) {
+		if (is_write)
+			return -EACCES;
+
+		return snprintf(buf, len, "%"PRIu32, dev->buffer.gaps);
+	}
+
+	if (!strcmp(attr_name, OVERRUNS_ATTRIBUTE)) {
+		if (is_write)
+			return -EACCES;
+
+		return snprintf(buf, len, "%"PRIu32, dev->buffer.overruns);
+	}
+
+	if (!strcmp(attr_name, UNDERRUNS_ATTRIBUTE)) {
+		if (is_write)
+			return -EACCES;
+
+		return snprintf(buf, len, "%"PRIu32, dev->buffer.underruns);
+	}
+
+	if (!strcmp(attr_name, COMPRESSION_AVAILABLE)) {
+		if (is_write)
+			return -EACCES;
+
+		return snprintf(buf, len, "%s %s", none, delta_varint);
+	}
+
+	if (strcmp(attr_name, COMPRESSION_ATTRIBUTE))
+		return -ENOENT;
+
+	if (!is_write)
+		return snprintf(buf, len, "%s",
+				dev->buffer.compress ? delta_varint : none);
+
+	/* The encoder is set up when the buffer is opened */
+	if (dev->buffer.public.active_mask)
+		return -EBUSY;
+
+	if (len >= sizeof(delta_varint) - 1 &&
+	    !strncmp(buf, delta_varint, sizeof(delta_varint) - 1))
+		dev->buffer.compress = true;
+	else if (len >= sizeof(none) - 1 &&
+		 !strncmp(buf, none, sizeof(none) - 1))
+		dev->buffer.compress = false;
+	else
+		return -EINVAL;
+
+	return len;
+}
+
 /* Read a device register. The register address to read is set on
  * in desc->active_reg_addr in the function set_demo_reg_attr
  */
@@ -549,31 +956,40 @@ static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 	return len;
 }
 
+/*
+ * Split "<integer>.<fractional>" without modifying buf. The accepted inputs
+ * and the results are the ones of the previous strtok/strtol based parser.
+ */
 static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
 			       int32_t *_fract_scale, bool scale_db)
 {
-	char *p;
+	char *p = buf;
 
-	p = strtok(buf, ".");
-	if (p == NULL)
+	while (*p == '.')
+		p++;
+	if (*p == '\0')
 		return -EINVAL;
 
-	*integer = strtol(p, NULL, 0);
+	*integer = iio_str_to_int(p, 0, '.');
 
-	if (scale_db) {
-		p = strtok(NULL, "db");
-		if (p == NULL)
-			p = strtok(NULL, " db");
-	} else
-		p = strtok(NULL, "\n");
+	while (*p != '.')
+		if (*p++ == '\0')
+			return -EINVAL;
+	p++;
 
-	if (p == NULL)
+	if (scale_db)
+		while (*p == 'd' || *p == 'b')
+			p++;
+	else
+		while (*p == '\n')
+			p++;
+	if (*p == '\0')
 		return -EINVAL;
 
-	*_fract = strtol(p, NULL, 10);
+	*_fract = iio_str_to_int(p, 10, scale_db ? 'd' : '\n');
 
-	/* Handle leading zeroes */
-	while (*p++ == '0' && *_fract > 0)
+	/* Handle leading zeroes. Past 9 of them the value is 0 anyway. */
+	while (*p++ == '0' && *_fract > 0 && *_fract_scale < 1000000000)
 		*_fract_scale *= 10;
 
 	/* Handle values between -1 and 0 */
@@ -588,6 +1004,10 @@ static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
 	int32_t temp;
 	int32_t mult = 1;
 
+	/* Below the resolution of the subunit */
+	if (subunits <= 0)
+		return 0;
+
 	if (fract < 0) {
 		mult = -1;
 		fract = -fract;
@@ -620,7 +1040,7 @@ int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
 
 	switch (fmt) {
 	case IIO_VAL_INT:
-		integer = strtol(buf, NULL, 0);
+		integer = iio_str_to_int(buf, 0, '\0');
 		break;
 	case IIO_VAL_INT_PLUS_MICRO_DB:
 		ret = __iio_str_parse(buf, &integer, &_fract,
@@ -651,7 +1071,8 @@ int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
 			return ret;
 		break;
 	case IIO_VAL_CHAR:
-		if (sscanf(buf, "%c", &ch) != 1)
+		ch = buf[0];
+		if (ch == '\0')
 			return -EINVAL;
 		integer = ch;
 		break;
@@ -667,62 +1088,125 @@ int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
 	return ret;
 }
 
+/* Write val in decimal, zero padded to width digits. Return the length. */
+static uint32_t iio_fmt_u32(char *buf, uint32_t val, uint32_t width)
+{
+	char tmp[10];
+	uint32_t n = 0;
+	uint32_t i;
+
+	do {
+		tmp[n++] = '0' + val % 10;
+		val /= 10;
+	} while (val);
+	while (n < width)
+		tmp[n++] = '0';
+
+	for (i = 0; i < n; i++)
+		buf[i] = tmp[n - 1 - i];
+
+	return n;
+}
+
+/* Write val in decimal. Return the length. */
+static uint32_t iio_fmt_s32(char *buf, int32_t val)
+{
+	if (val < 0) {
+		buf[0] = '-';
+		return iio_fmt_u32(buf + 1, -(uint32_t)val, 0) + 1;
+	}
+
+	return iio_fmt_u32(buf, val, 0);
+}
+
+/* Copy str to buf, truncating it the way snprintf does. Return n. */
+static int iio_fmt_copy(char *buf, uint32_t len, const char *str, uint32_t n)
+{
+	uint32_t cnt;
+
+	if (len) {
+		cnt = no_os_min(n, len - 1);
+		memcpy(buf, str, cnt);
+		buf[cnt] = '\0';
+	}
+
+	return n;
+}
+
+/*
+ * The values are formatted by hand instead of using snprintf, which is slow
+ * and uses a lot of stack on small targets. The output is identical to
+ * the one of the snprintf formats noted for each case.
+ */
 int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 		     int32_t size, int32_t *vals)
 {
+	/* Longest output: "--2147483648.4294967295 dB" */
+	char str[32];
 	int64_t tmp;
 	int32_t integer, fractional;
-	bool dB = false;
+	uint32_t n = 0;
 	int32_t i = 0;
 	uint32_t l = 0;
 
 	switch (fmt) {
 	case IIO_VAL_INT:
-		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+		/* "%"PRIi32 */
+		n = iio_fmt_s32(str, vals[0]);
+		break;
 	case IIO_VAL_INT_PLUS_MICRO_DB:
-		dB = true;
-	/* intentional fall through */
 	case IIO_VAL_INT_PLUS_MICRO:
-		return snprintf(buf, len, "%s%"PRIi32".%06"PRIu32"%s",
-				vals[1] < 0 ? "-" : "", vals[0],
-				(uint32_t)vals[1], dB ? " dB" : "");
 	case IIO_VAL_INT_PLUS_NANO:
-		return snprintf(buf, len, "%s%"PRIi32".%09"PRIu32"",
-				vals[1] < 0 ? "-" : "", vals[0],
-				(uint32_t)vals[1]);
+		/* "%s%"PRIi32".%06"PRIu32"%s" or "%s%"PRIi32".%09"PRIu32 */
+		if (vals[1] < 0)
+			str[n++] = '-';
+		n += iio_fmt_s32(&str[n], vals[0]);
+		str[n++] = '.';
+		n += iio_fmt_u32(&str[n], vals[1],
+				 fmt == IIO_VAL_INT_PLUS_NANO ? 9 : 6);
+		if (fmt == IIO_VAL_INT_PLUS_MICRO_DB) {
+			memcpy(&str[n], " dB", 3);
+			n += 3;
+		}
+		break;
 	case IIO_VAL_FRACTIONAL:
-		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
-		fractional = vals[1];
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
-
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
 	case IIO_VAL_FRACTIONAL_LOG2:
-		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
+		/* "%"PRIi32".%09u" or "-0.%09u" */
+		if (fmt == IIO_VAL_FRACTIONAL) {
+			tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+			fractional = vals[1];
+		} else {
+			tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL,
+						vals[1]);
+		}
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
 
 		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
-
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
-	case IIO_VAL_INT_MULTIPLE: {
+			str[n++] = '-';
+		n += iio_fmt_s32(&str[n], integer);
+		str[n++] = '.';
+		n += iio_fmt_u32(&str[n], abs(fractional), 9);
+		break;
+	case IIO_VAL_INT_MULTIPLE:
+		/* "%"PRIi32" " for each value */
 		while (i < size) {
-			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
+			n = iio_fmt_s32(str, vals[i]);
+			str[n++] = ' ';
+			l += iio_fmt_copy(&buf[l], len - l, str, n);
 			if (l >= len)
 				break;
 			i++;
 		}
 		return l;
-	}
 	case IIO_VAL_CHAR:
-		return snprintf(buf, len, "%c", (char)vals[0]);
+		/* "%c" */
+		str[n++] = (char)vals[0];
+		break;
 	default:
 		return 0;
 	}
+
+	return iio_fmt_copy(buf, len, str, n);
 }
 
 static struct iio_attribute *get_attributes(enum iio_attr_type type,
@@ -787,6 +1271,7 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 	struct attr_fun_params params;
 	struct iio_attribute *attributes;
 	int8_t ch_out;
+	int ret;
 
 	dev = get_iio_device(ctx->instance, device);
 
@@ -798,6 +1283,11 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 				return debug_reg_read(dev, buf, len);
 			return -ENOENT;
 		}
+#ifdef NO_OS_TRACE
+		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
+		    strcmp(attr->name, BUS_TRACE_ATTRIBUTE) == 0)
+			return no_os_trace_dump(buf, len);
+#endif
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
@@ -815,6 +1305,12 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 			params.ch_info = NULL;
 		}
 
+		if (attr->type == IIO_ATTR_TYPE_BUFFER) {
+			ret = iio_core_buffer_attr(dev, attr->name, buf, len, 0);
+			if (ret != -ENOENT)
+				return ret;
+		}
+
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
@@ -862,6 +1358,7 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 	struct iio_ch_info ch_info;
 	struct iio_channel *ch = NULL;
 	int8_t ch_out;
+	int ret;
 
 	dev = get_iio_device(ctx->instance, device);
 
@@ -874,6 +1371,15 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 				return debug_reg_write(dev, buf, len);
 			return -ENOENT;
 		}
+#ifdef NO_OS_TRACE
+		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
+		    strcmp(attr->name, BUS_TRACE_ATTRIBUTE) == 0) {
+			if (strncmp(buf, "reset", 5))
+				return -EINVAL;
+			no_os_trace_reset();
+			return len;
+		}
+#endif
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
@@ -892,6 +1398,12 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 			params.ch_info = NULL;
 		}
 
+		if (attr->type == IIO_ATTR_TYPE_BUFFER) {
+			ret = iio_core_buffer_attr(dev, attr->name, buf, len, 1);
+			if (ret != -ENOENT)
+				return ret;
+		}
+
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
@@ -1026,6 +1538,10 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 	if (!dev)
 		return -ENODEV;
 
+	/* The trigger is in use until the buffer is closed */
+	if (dev->trig_enabled)
+		return -EBUSY;
+
 	if (trigger[0] == '\0') {
 		dev->trig_idx = NO_TRIGGER;
 		return 0;
@@ -1036,98 +1552,527 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 		return -EINVAL;
 
 	dev->trig_idx = i;
+	/* Events prior to binding the trigger are not for this device */
+	dev->trig_events = desc->trigs[i].events;
 
 	return len;
 }
 
 /**
- * @brief Asynchronous trigger processing routine.
+ * @brief Number of scans that fit in the free space of a device buffer.
+ * @param dev - IIO device.
+ * @return Number of scans, UINT32_MAX if the buffer isn't managed by the core.
+ */
+static uint32_t iio_buffer_free_scans(struct iio_dev_priv *dev)
+{
+	struct iio_buffer *buffer = &dev->buffer.public;
+	uint32_t used;
+
+	if (!buffer->buf || !buffer->bytes_per_scan ||
+	    buffer->dir != IIO_DIRECTION_INPUT)
+		return UINT32_MAX;
+
+	no_os_cb_size(buffer->buf, &used);
+
+	return (buffer->buf->size - used) / buffer->bytes_per_scan;
+}
+
+/**
+ * @brief Get the timestamp of a trigger event. Only the last
+ * IIO_TRIG_TIMESTAMPS events keep theirs, older ones get the oldest one kept.
+ * @param trig     - IIO trigger.
+ * @param sequence - Event number.
+ * @param last     - Last event counted.
+ * @return Timestamp of the event.
+ */
+static uint64_t iio_trig_timestamp(struct iio_trig_priv *trig,
+				   uint32_t sequence, uint32_t last)
+{
+	if (last - sequence >= IIO_TRIG_TIMESTAMPS)
+		sequence = last - IIO_TRIG_TIMESTAMPS + 1;
+
+	return trig->timestamps[sequence % IIO_TRIG_TIMESTAMPS];
+}
+
+/**
+ * @brief Sample a device on consecutive trigger events.
+ *
+ * Scans that don't fit in the buffer are dropped instead of overwriting the
+ * ones not read yet, and counted as gaps along with the failed ones. A gap
+ * shifts the stream of the device relative to the other devices sharing the
+ * trigger and scan_gaps doesn't tell where it happened. Clients that need to
+ * realign the streams should enable the timestamp channel, which carries the
+ * trigger event time of each scan.
+ * @param dev      - IIO device.
+ * @param trig     - Trigger of the events.
+ * @param sequence - Number of the first event.
+ * @param last     - Number of the last event.
+ * @param batch    - Use the batch handler if the device has one.
+ */
+static void iio_trigger_dev(struct iio_dev_priv *dev,
+			    struct iio_trig_priv *trig, uint32_t sequence,
+			    uint32_t last, bool batch)
+{
+	struct iio_device *d = dev->dev_descriptor;
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	uint32_t nb = last - sequence + 1;
+	uint32_t free_scans;
+	int32_t ret;
+
+	free_scans = iio_buffer_free_scans(dev);
+	if (nb > free_scans) {
+		buffer->gaps += nb - free_scans;
+		buffer->overruns += nb - free_scans;
+		nb = free_scans;
+	}
+	if (!nb)
+		return;
+
+	if (!buffer->sequence_valid) {
+		buffer->first_sequence = sequence;
+		buffer->sequence_valid = true;
+	}
+
+	buffer->ts_trig = trig;
+	buffer->ts_last = last;
+	if (batch && d->trigger_batch_handler) {
+		buffer->ts_seq = sequence;
+		dev->dev_data.sequence = sequence;
+		dev->dev_data.timestamp = iio_trig_timestamp(trig,
+					  sequence + nb - 1, last);
+		ret = d->trigger_batch_handler(&dev->dev_data, nb);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			buffer->gaps += nb;
+	} else if (d->trigger_handler) {
+		for (; nb--; sequence++) {
+			buffer->ts_seq = sequence;
+			dev->dev_data.sequence = sequence;
+			dev->dev_data.timestamp = iio_trig_timestamp(trig,
+						  sequence, last);
+			ret = d->trigger_handler(&dev->dev_data);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				buffer->gaps++;
+		}
+	}
+	buffer->ts_trig = NULL;
+}
+
+/**
+ * @brief Asynchronous trigger processing routine. The events of a trigger are
+ * handled in one pass over all the devices bound to it, with the same
+ * timestamps and sequence numbers. The trigger handler of each device is
+ * called once for every pending event, or the batch handler is called once
+ * with the number of pending events.
  * @param desc - IIO descriptor.
  */
 static void iio_process_async_triggers(struct iio_desc *desc)
 {
+	struct iio_trig_priv *trig;
 	struct iio_dev_priv *dev;
-	uint32_t i;
+	uint32_t events;
+	uint32_t i, j;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == NO_TRIGGER)
+	for (i = 0; i < desc->nb_trigs; i++) {
+		trig = &desc->trigs[i];
+		if (trig->descriptor->is_synchronous || !trig->nb_enabled)
 			continue;
 
-		if (!desc->trigs[dev->trig_idx].triggered)
-			continue;
+		/* Events counted after this are handled on the next step */
+		events = trig->events;
+
+		for (j = 0; j < desc->nb_devs; j++) {
+			dev = desc->devs + j;
+			if (dev->trig_idx != i || events == dev->trig_events ||
+			    !dev->buffer.public.active_mask)
+				continue;
 
-		if (dev->dev_descriptor->trigger_handler) {
-			dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			desc->trigs[i].triggered = 0;
+			iio_trigger_dev(dev, trig, dev->trig_events + 1, events,
+					true);
+			dev->trig_events = events;
 		}
 	}
 }
 
 /**
- * @brief Searches for trigger name and processes the trigger based on its
- * type (sync or async with the interrupt).
- * @param desc         - IIO descriptor.
- * @param trigger_name - Trigger name.
+ * @brief Get the index of a trigger, to be used with iio_process_trigger.
+ * @param desc - IIO descriptor.
+ * @param name - Trigger name.
+ * @param idx  - Trigger index.
  *
- * @return ret - Result of the processing procedure.
+ * @return 0 in case of success, negative value otherwise.
  */
-int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+int iio_get_trigger_idx(struct iio_desc *desc, const char *name,
+			uint32_t *idx)
 {
 	uint32_t i;
-	uint32_t trig_id;
-	struct iio_trig_priv *trig;
 
-	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
-
-	if (trig_id == NO_TRIGGER)
+	if (!desc || !idx)
 		return -EINVAL;
 
-	struct iio_dev_priv *dev;
+	i = iio_get_trig_idx_by_name(desc, name);
+	if (i == NO_TRIGGER)
+		return -ENOENT;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == trig_id) {
-			trig = &desc->trigs[trig_id];
-			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
-					dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			} else {
-				trig->triggered = 1;
-			}
-		}
-	}
+	*idx = i;
 
 	return 0;
 }
 
-static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
+/**
+ * @brief Processes the trigger based on its type (sync or async with the
+ * interrupt). Safe to be called from interrupt context, events of
+ * asynchronous triggers are counted until iio_step processes them.
+ * @param desc      - IIO descriptor.
+ * @param trig_idx  - Trigger index, obtained with iio_get_trigger_idx.
+ * @param timestamp - Timestamp of the event, 0 if not available.
+ *
+ * @return ret - Result of the processing procedure.
+ */
+int iio_process_trigger(struct iio_desc *desc, uint32_t trig_idx,
+			uint64_t timestamp)
 {
-	uint32_t cnt, i, length, largest = 1;
+	struct iio_trig_priv *trig;
+	struct iio_dev_priv *dev;
+	uint32_t i;
 
-	cnt = 0;
-	i = 0;
-	while (mask) {
-		if ((mask & 1)) {
-			length = channels[i].scan_type->storagebits / 8;
+	if (!desc || trig_idx >= desc->nb_trigs)
+		return -EINVAL;
 
-			if (length > largest)
-				largest = length;
+	if (!timestamp && desc->get_timestamp)
+		timestamp = desc->get_timestamp();
 
-			if (cnt % length)
-				cnt += 2 * length - (cnt % length);
-			else
-				cnt += length;
-		}
+	trig = &desc->trigs[trig_idx];
+	/* The timestamp is in place before the event is counted */
+	trig->timestamps[(trig->events + 1) % IIO_TRIG_TIMESTAMPS] = timestamp;
+	trig->events++;
+	if (!trig->descriptor->is_synchronous)
+		return 0;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		dev = desc->devs + i;
+		if (dev->trig_idx != trig_idx ||
+		    !dev->buffer.public.active_mask)
+			continue;
 
-		mask >>= 1;
-		++i;
+		iio_trigger_dev(dev, trig, trig->events, trig->events, false);
+		dev->trig_events = trig->events;
 	}
 
-	if (cnt % largest)
+	return 0;
+}
+
+/**
+ * @brief Searches for trigger name and processes the trigger based on its
+ * type (sync or async with the interrupt).
+ * @param desc         - IIO descriptor.
+ * @param trigger_name - Trigger name.
+ *
+ * @return ret - Result of the processing procedure.
+ */
+int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+{
+	uint32_t trig_id;
+
+	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
+	if (trig_id == NO_TRIGGER)
+		return -EINVAL;
+
+	return iio_process_trigger(desc, trig_id, 0);
+}
+
+/**
+ * @brief Compute the position of the enabled channels in a scan.
+ * Each sample is aligned to its storage size and the scan is padded to a
+ * multiple of the largest sample.
+ * @param layout   - Layout to fill.
+ * @param channels - Channels of the device.
+ * @param mask     - Enabled channels, at most IIO_SCAN_MAX_CHANNELS.
+ * @return 0 in case of success, -EINVAL if a channel has no storage size.
+ */
+int iio_scan_layout_init(struct iio_scan_layout *layout,
+			 const struct iio_channel *channels, uint32_t mask)
+{
+	struct iio_scan_channel *ch;
+	uint32_t cnt = 0, largest = 1;
+	uint32_t length, i;
+
+	if (!layout || !channels)
+		return -EINVAL;
+
+	layout->nb_channels = 0;
+	for (i = 0; mask; i++, mask >>= 1) {
+		if (!(mask & 1))
+			continue;
+
+		if (!channels[i].scan_type)
+			return -EINVAL;
+
+		length = channels[i].scan_type->storagebits / 8;
+		if (!length)
+			return -EINVAL;
+
+		if (length > largest)
+			largest = length;
+
+		if (cnt % length)
+			cnt += 2 * length - (cnt % length);
+		else
+			cnt += length;
+
+		ch = &layout->ch[layout->nb_channels++];
+		ch->offset = cnt - length;
+		ch->bytes = length;
+		ch->shift = channels[i].scan_type->shift;
+		ch->index = i;
+		ch->big_endian = channels[i].scan_type->is_big_endian;
+	}
+
+	if (cnt % largest)
 		cnt += largest - (cnt % largest);
 
-	return cnt;
+	layout->bytes_per_scan = cnt;
+
+	return 0;
+}
+
+/*
+ * Copy the samples of one channel between its array and the scans, one store
+ * per sample of the type of the sample.
+ */
+#define IIO_SCAN_COPY(type, dst, dst_step, src, src_step, nb) do {	\
+	uint32_t _i;							\
+	for (_i = 0; _i < (nb); _i++)					\
+		*(type *)((dst) + _i * (dst_step)) =			\
+			*(const type *)((src) + _i * (src_step));	\
+} while (0)
+
+/**
+ * @brief Copy samples between a channel array and consecutive scans.
+ * @param dst      - First destination sample.
+ * @param dst_step - Distance between destination samples.
+ * @param src      - First source sample.
+ * @param src_step - Distance between source samples.
+ * @param bytes    - Size of a sample.
+ * @param nb       - Number of samples.
+ */
+static void iio_scan_copy(uint8_t *dst, uint32_t dst_step, const uint8_t *src,
+			  uint32_t src_step, uint32_t bytes, uint32_t nb)
+{
+	uint32_t i;
+
+	switch (bytes) {
+	case 1:
+		IIO_SCAN_COPY(uint8_t, dst, dst_step, src, src_step, nb);
+		break;
+	case 2:
+		IIO_SCAN_COPY(uint16_t, dst, dst_step, src, src_step, nb);
+		break;
+	case 4:
+		IIO_SCAN_COPY(uint32_t, dst, dst_step, src, src_step, nb);
+		break;
+	case 8:
+		IIO_SCAN_COPY(uint64_t, dst, dst_step, src, src_step, nb);
+		break;
+	default:
+		for (i = 0; i < nb; i++)
+			memcpy(dst + i * dst_step, src + i * src_step, bytes);
+		break;
+	}
+}
+
+/**
+ * @brief Interleave samples from per channel arrays into scans.
+ * Samples are copied as they are, in the endianness of the scan.
+ * @param layout   - Layout of the scans.
+ * @param planes   - Sample arrays, indexed by channel index. Channels with a
+ *		     NULL array are left untouched in the scans.
+ * @param first    - Index of the first sample to copy from each array.
+ * @param scans    - Scans to fill, aligned to their largest sample.
+ * @param nb_scans - Number of scans.
+ */
+void iio_scan_mux(const struct iio_scan_layout *layout,
+		  const void *const *planes, uint32_t first, void *scans,
+		  uint32_t nb_scans)
+{
+	const struct iio_scan_channel *ch;
+	uint32_t i;
+
+	for (i = 0; i < layout->nb_channels; i++) {
+		ch = &layout->ch[i];
+		if (!planes[ch->index])
+			continue;
+
+		iio_scan_copy((uint8_t *)scans + ch->offset,
+			      layout->bytes_per_scan,
+			      (const uint8_t *)planes[ch->index] + first * ch->bytes,
+			      ch->bytes, ch->bytes, nb_scans);
+	}
+}
+
+/**
+ * @brief Split scans into per channel arrays.
+ * @param layout   - Layout of the scans.
+ * @param scans    - Scans to split, aligned to their largest sample.
+ * @param planes   - Sample arrays, indexed by channel index. Channels with a
+ *		     NULL array are skipped.
+ * @param first    - Index in each array where the first sample is stored.
+ * @param nb_scans - Number of scans.
+ */
+void iio_scan_demux(const struct iio_scan_layout *layout, const void *scans,
+		    void *const *planes, uint32_t first, uint32_t nb_scans)
+{
+	const struct iio_scan_channel *ch;
+	uint32_t i;
+
+	for (i = 0; i < layout->nb_channels; i++) {
+		ch = &layout->ch[i];
+		if (!planes[ch->index])
+			continue;
+
+		iio_scan_copy((uint8_t *)planes[ch->index] + first * ch->bytes,
+			      ch->bytes, (const uint8_t *)scans + ch->offset,
+			      layout->bytes_per_scan, ch->bytes, nb_scans);
+	}
+}
+
+/**
+ * @brief Find the timestamp channel in a scan.
+ * @param device - Device descriptor.
+ * @param layout - Layout of the scan.
+ * @return Offset of the timestamp in the scan, -1 if it isn't enabled.
+ */
+static int32_t iio_timestamp_offset(struct iio_device *device,
+				    const struct iio_scan_layout *layout)
+{
+	uint32_t i;
+
+	for (i = 0; i < layout->nb_channels; i++)
+		if (device->channels[layout->ch[i].index].ch_type == IIO_TIMESTAMP)
+			return layout->ch[i].offset;
+
+	return -1;
+}
+
+/**
+ * @brief Free the encoder of a compressed buffer.
+ * @param buffer - Device buffer.
+ */
+static void iio_buffer_delta_free(struct iio_buffer_priv *buffer)
+{
+	no_os_free(buffer->delta);
+	buffer->delta = NULL;
+	buffer->enc_buf = NULL;
+}
+
+/**
+ * @brief Set up the encoder of a compressed buffer for the enabled channels.
+ * @param dev - IIO device.
+ * @return 0 in case of success, negative value otherwise.
+ */
+static int iio_buffer_delta_setup(struct iio_dev_priv *dev)
+{
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	uint32_t bps = buffer->layout.bytes_per_scan;
+	struct iio_scan_channel *ch;
+	uint32_t i;
+	int ret;
+
+	/* The encoder is followed by a scan and its encoded form */
+	buffer->delta = no_os_calloc(1, sizeof(*buffer->delta) + bps +
+				     IIO_DELTA_MAX_ENCODED(bps));
+	if (!buffer->delta)
+		return -ENOMEM;
+
+	buffer->enc_buf = (uint8_t *)(buffer->delta + 1);
+	buffer->enc_len = 0;
+	buffer->enc_idx = 0;
+
+	iio_delta_init(buffer->delta);
+	for (i = 0; i < buffer->layout.nb_channels; i++) {
+		ch = &buffer->layout.ch[i];
+		ret = iio_delta_add_channel(buffer->delta, ch->bytes,
+					    ch->big_endian);
+		if (ret)
+			goto error;
+	}
+
+	if (buffer->delta->bytes_per_scan != bps) {
+		ret = -EINVAL;
+		goto error;
+	}
+
+	return 0;
+
+error:
+	iio_buffer_delta_free(buffer);
+
+	return ret;
+}
+
+/**
+ * @brief Free the filter of a buffer.
+ * @param buffer - Device buffer.
+ */
+static void iio_buffer_filter_free(struct iio_buffer_priv *buffer)
+{
+	no_os_free(buffer->filter);
+	buffer->filter = NULL;
+	if (!buffer->delta)
+		buffer->enc_buf = NULL;
+}
+
+/**
+ * @brief Set up the filter of a buffer for the enabled channels. Without an
+ * encoder, the filter is followed by a scan and a partially read scan.
+ * @param dev - IIO device.
+ * @return 0 in case of success, negative value otherwise.
+ */
+static int iio_buffer_filter_setup(struct iio_dev_priv *dev)
+{
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	struct iio_scan_layout *layout = &buffer->layout;
+	uint32_t bps = layout->bytes_per_scan;
+	struct iio_scan_channel *ch;
+	struct scan_type *type;
+	uint32_t size;
+	uint32_t i;
+	int ret;
+
+	size = IIO_FILTER_SIZE(layout->nb_channels);
+	buffer->filter = no_os_calloc(1, size + (buffer->delta ? 0 : 2 * bps));
+	if (!buffer->filter)
+		return -ENOMEM;
+
+	if (!buffer->delta) {
+		buffer->enc_buf = (uint8_t *)buffer->filter + size;
+		buffer->enc_len = 0;
+		buffer->enc_idx = 0;
+	}
+
+	ret = iio_filter_init(buffer->filter, &buffer->filter_cfg, bps,
+			      layout->nb_channels);
+	if (ret)
+		goto error;
+
+	for (i = 0; i < layout->nb_channels; i++) {
+		ch = &layout->ch[i];
+		type = dev->dev_descriptor->channels[ch->index].scan_type;
+		ret = iio_filter_add_channel(buffer->filter, ch->offset,
+					     ch->bytes, type->realbits,
+					     ch->shift, type->sign == 's',
+					     ch->big_endian,
+					     buffer->filter_cfg.mask &
+					     NO_OS_BIT(ch->index));
+		if (ret)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	iio_buffer_filter_free(buffer);
+
+	return ret;
 }
 
 /**
@@ -1141,6 +2086,7 @@ static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			uint32_t samples, uint32_t mask, bool cyclic)
 {
+	struct iio_device_data dev_data = {0};
 	struct iio_desc *desc;
 	struct iio_dev_priv *dev;
 	struct iio_trig_priv *trig;
@@ -1161,12 +2107,20 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	if (!mask)
 		return -ENOENT;
 
+	/* Data of the previous opening is queued until it is acknowledged */
+	if (dev->buffer.ref_pending)
+		return -EBUSY;
+
 	dev->buffer.public.cyclic_info.is_cyclic = cyclic;
 	dev->buffer.public.cyclic_info.buff_index = 0;
 
+	ret = iio_scan_layout_init(&dev->buffer.layout,
+				   dev->dev_descriptor->channels, mask);
+	if (ret)
+		return ret;
+
 	dev->buffer.public.active_mask = mask;
-	dev->buffer.public.bytes_per_scan =
-		bytes_per_scan(dev->dev_descriptor->channels, mask);
+	dev->buffer.public.bytes_per_scan = dev->buffer.layout.bytes_per_scan;
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
@@ -1199,22 +2153,70 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		return ret;
 	}
 
-	if (dev->dev_descriptor->pre_enable) {
-		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
-		if (NO_OS_IS_ERR_VALUE(ret)) {
-			if (dev->buffer.allocated) {
-				no_os_free(dev->buffer.cb.buff);
-				dev->buffer.allocated = 0;
-			}
-			return ret;
+	iio_buffer_delta_free(&dev->buffer);
+	iio_buffer_filter_free(&dev->buffer);
+	if (dev->buffer.compress) {
+		ret = iio_buffer_delta_setup(dev);
+		if (ret)
+			goto free_buf;
+	}
+
+	if (dev->buffer.filter_cfg.type != IIO_FILTER_NONE ||
+	    dev->buffer.filter_cfg.decimation > 1) {
+		ret = iio_buffer_filter_setup(dev);
+		if (ret) {
+			iio_buffer_delta_free(&dev->buffer);
+			goto free_buf;
 		}
 	}
 
+	ret = 0;
+	if (dev->dev_descriptor->pre_enable_buffer) {
+		dev_data.dev = dev->dev_instance;
+		dev_data.buffer = &dev->buffer.public;
+		dev_data.triggered = dev->trig_idx != NO_TRIGGER;
+		ret = dev->dev_descriptor->pre_enable_buffer(&dev_data);
+	} else if (dev->dev_descriptor->pre_enable) {
+		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
+	}
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		iio_buffer_delta_free(&dev->buffer);
+		iio_buffer_filter_free(&dev->buffer);
+		goto free_buf;
+	}
+
+	dev->buffer.sequence_valid = false;
+	dev->buffer.gaps = 0;
+	dev->buffer.overruns = 0;
+	dev->buffer.underruns = 0;
+	dev->buffer.ts_offset = iio_timestamp_offset(dev->dev_descriptor,
+				&dev->buffer.layout);
+
 	desc = ctx->instance;
 	if (dev->trig_idx != NO_TRIGGER) {
 		trig = &desc->trigs[dev->trig_idx];
-		if (trig->descriptor->enable)
-			ret = trig->descriptor->enable(trig->instance);
+		/* Discard events received while the buffer was disabled */
+		dev->trig_events = trig->events;
+		/*
+		 * The trigger may already run for other devices, or for this
+		 * one if it was opened again without being closed.
+		 */
+		if (!dev->trig_enabled) {
+			if (!trig->nb_enabled && trig->descriptor->enable)
+				ret = trig->descriptor->enable(trig->instance);
+			if (!ret) {
+				trig->nb_enabled++;
+				dev->trig_enabled = true;
+			}
+		}
+	}
+
+	return ret;
+
+free_buf:
+	if (dev->buffer.allocated) {
+		no_os_free(dev->buffer.cb.buff);
+		dev->buffer.allocated = 0;
 	}
 
 	return ret;
@@ -1240,20 +2242,31 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
-	if (dev->buffer.allocated) {
+	if (dev->buffer.ref_pending) {
+		/*
+		 * Data queued on a connection is not acknowledged yet, the
+		 * memory is freed once the connection releases it.
+		 */
+		dev->buffer.close_pending = true;
+	} else if (dev->buffer.allocated) {
 		/* Should something else be used to free internal strucutre */
 		no_os_free(dev->buffer.cb.buff);
 		dev->buffer.allocated = 0;
 	}
+	iio_buffer_delta_free(&dev->buffer);
+	iio_buffer_filter_free(&dev->buffer);
 
 	desc = ctx->instance;
-	if (dev->trig_idx != NO_TRIGGER) {
+	if (dev->trig_idx != NO_TRIGGER && dev->trig_enabled) {
 		trig = &desc->trigs[dev->trig_idx];
-		if (trig->descriptor->disable) {
+		/* Keep the trigger running for the other devices */
+		if (trig->nb_enabled == 1 && trig->descriptor->disable) {
 			ret = trig->descriptor->disable(trig->instance);
 			if (ret)
 				return ret;
 		}
+		trig->nb_enabled--;
+		dev->trig_enabled = false;
 	}
 
 	dev->buffer.public.active_mask = 0;
@@ -1267,11 +2280,25 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 			   enum iio_buffer_direction dir)
 {
 	struct iio_dev_priv *dev;
+	uint32_t size;
+	int32_t ret;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	if (dir == IIO_DIRECTION_INPUT && dev->buffer.ref_pending)
+		/* Don't overwrite data referenced by the connection */
+		return -EAGAIN;
+
+	if (dir == IIO_DIRECTION_INPUT &&
+	    (dev->buffer.delta || dev->buffer.filter)) {
+		/* Encoded or filtered reads take scans until the buffer is empty */
+		ret = no_os_cb_size(&dev->buffer.cb, &size);
+		if (!ret && size >= dev->buffer.public.bytes_per_scan)
+			return 0;
+	}
+
 	dev->buffer.public.dir = dir;
 	if (dev->dev_descriptor->submit && dev->trig_idx == NO_TRIGGER)
 		return dev->dev_descriptor->submit(&dev->dev_data);
@@ -1280,7 +2307,6 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 		 || (dir == IIO_DIRECTION_OUTPUT &&
 		     dev->dev_descriptor->write_dev && dev->trig_idx == NO_TRIGGER)) {
 		/* Code used to don't break devices using read_dev */
-		int32_t ret;
 		void *buff;
 		struct iio_buffer *buffer = &dev->buffer.public;
 
@@ -1313,6 +2339,160 @@ static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
 	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
 }
 
+/**
+ * @brief Take the next scan to send from an input buffer, filtered when the
+ * buffer has a filter. The filter runs in place on the buffer data. The buffer
+ * is refilled when it runs out of scans, but not twice in a row if the scans
+ * of the previous refill didn't get a scan out of the filter.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param buffer - Device buffer.
+ * @param scan - Where the scan is stored.
+ * @param refilled - Set when the buffer was refilled, by this call or by a
+ * previous one.
+ * @return 0 in case of success, -EAGAIN if there is no scan yet or negative
+ * value in case of error.
+ */
+static int iio_buffer_next_scan(struct iiod_ctx *ctx, const char *device,
+				struct iio_buffer_priv *buffer, uint8_t *scan,
+				bool *refilled)
+{
+	uint32_t bps = buffer->public.bytes_per_scan;
+	bool consumed = false;
+	uint32_t size;
+	uint32_t nb;
+	void *data;
+	int32_t ret;
+
+	while (true) {
+		ret = no_os_cb_size(&buffer->cb, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+		if (ret != -NO_OS_EOVERRUN)
+#endif
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+
+		if (size < bps) {
+			if (*refilled && !consumed)
+				return -EAGAIN;
+
+			ret = iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+
+			*refilled = true;
+			consumed = false;
+			continue;
+		}
+
+		if (!buffer->filter) {
+			ret = no_os_cb_read(&buffer->cb, scan, bps);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+			if (ret != -NO_OS_EOVERRUN)
+#endif
+				if (NO_OS_IS_ERR_VALUE(ret))
+					return ret;
+
+			return 0;
+		}
+
+		/* Up to the end of the decimation window */
+		size = 0;
+		ret = no_os_cb_prepare_async_read(&buffer->cb,
+						  iio_filter_pending(buffer->filter) *
+						  bps, &data, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+		if (ret != -NO_OS_EOVERRUN)
+#endif
+			if (NO_OS_IS_ERR_VALUE(ret)) {
+				if (ret == -NO_OS_EOVERRUN)
+					no_os_cb_end_async_read(&buffer->cb);
+
+				return ret;
+			}
+
+		nb = iio_filter_process(buffer->filter, data, size / bps, scan);
+		no_os_cb_end_async_read(&buffer->cb);
+		consumed = true;
+		if (nb)
+			return 0;
+	}
+}
+
+/**
+ * @brief Read filtered or delta encoded data. Whole scans are taken from the
+ * buffer and filtered or encoded directly in buf while there is room for the
+ * worst case, the rest of a scan that doesn't fit is kept for the next read.
+ * The size of the data of a buffer isn't known by the client, so a new buffer
+ * is acquired when the current one runs out of scans.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param dev - IIO device.
+ * @param buf - Buffer where the data is stored.
+ * @param bytes - Number of bytes to read.
+ * @return Number of bytes read or negative value in case of error.
+ */
+static int iio_read_buffer_processed(struct iiod_ctx *ctx, const char *device,
+				     struct iio_dev_priv *dev, char *buf,
+				     uint32_t bytes)
+{
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	uint32_t bps = buffer->public.bytes_per_scan;
+	uint8_t *scan = buffer->enc_buf;
+	uint8_t *enc = buffer->enc_buf + bps;
+	uint8_t *out = (uint8_t *)buf;
+	bool refilled = false;
+	bool direct;
+	uint32_t len;
+	int32_t ret;
+
+	len = no_os_min(buffer->enc_len - buffer->enc_idx, bytes);
+	memcpy(out, enc + buffer->enc_idx, len);
+	buffer->enc_idx += len;
+	out += len;
+	bytes -= len;
+
+	while (bytes) {
+		/* Without an encoder, whole scans are stored directly in buf */
+		direct = !buffer->delta && bytes >= bps;
+		ret = iio_buffer_next_scan(ctx, device, buffer,
+					   direct ? out : buffer->delta ? scan : enc,
+					   &refilled);
+		if (ret == -EAGAIN)
+			break;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (direct) {
+			out += bps;
+			bytes -= bps;
+			continue;
+		}
+
+		if (!buffer->delta) {
+			buffer->enc_len = bps;
+		} else if (bytes >= IIO_DELTA_MAX_ENCODED(bps)) {
+			len = iio_delta_encode(buffer->delta, scan, out);
+			out += len;
+			bytes -= len;
+			continue;
+		} else {
+			buffer->enc_len = iio_delta_encode(buffer->delta, scan,
+							   enc);
+		}
+
+		buffer->enc_idx = no_os_min(buffer->enc_len, bytes);
+		memcpy(out, enc, buffer->enc_idx);
+		out += buffer->enc_idx;
+		bytes -= buffer->enc_idx;
+	}
+
+	if (out == (uint8_t *)buf)
+		return -EAGAIN;
+
+	return out - (uint8_t *)buf;
+}
+
 /**
  * @brief Read chunk of data from RAM to pbuf. Call
  * "iio_transfer_dev_to_mem()" first.
@@ -1333,6 +2513,9 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	if (dev->buffer.delta || dev->buffer.filter)
+		return iio_read_buffer_processed(ctx, device, dev, buf, bytes);
+
 	ret = no_os_cb_size(&dev->buffer.cb, &size);
 #ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
 #warning Buffer overrun error checking is disabled.
@@ -1356,6 +2539,120 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	return bytes;
 }
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+/**
+ * @brief Get a reference to the data of the opened buffer instead of copying
+ * it. The data is released by iio_buffer_ref_done.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param buf - Set to the start of the data.
+ * @param bytes - Maximum number of bytes to reference.
+ * @return Number of contiguous bytes referenced or negative value in case of
+ * error.
+ */
+static int iio_get_buffer_ref(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size;
+	void			*data;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	/* Encoded or filtered data is built by iio_read_buffer */
+	if (dev->buffer.delta || dev->buffer.filter)
+		return -EOPNOTSUPP;
+
+	/* Only one region can be referenced at a time */
+	if (dev->buffer.ref_pending)
+		return -EAGAIN;
+
+	size = 0;
+	ret = no_os_cb_prepare_async_read(&dev->buffer.cb, bytes, &data, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			if (ret == -NO_OS_EOVERRUN)
+				no_os_cb_end_async_read(&dev->buffer.cb);
+
+			return ret;
+		}
+
+	if (!size)
+		return -EAGAIN;
+
+	dev->buffer.ref_pending = size;
+	*buf = data;
+
+	return size;
+}
+
+/**
+ * @brief Release data referenced with iio_get_buffer_ref.
+ * @param ctx - Device the data belongs to.
+ * @param data - Released data.
+ * @param len - Number of released bytes.
+ */
+static void iio_buffer_ref_done(void *ctx, const void *data, uint32_t len)
+{
+	struct iio_dev_priv *dev = ctx;
+
+	dev->buffer.ref_pending -= no_os_min(len, dev->buffer.ref_pending);
+	if (dev->buffer.ref_pending)
+		return;
+
+	no_os_cb_end_async_read(&dev->buffer.cb);
+
+	/* Finish a close that had to keep the memory */
+	if (dev->buffer.close_pending) {
+		dev->buffer.close_pending = false;
+		if (dev->buffer.allocated) {
+			no_os_free(dev->buffer.cb.buff);
+			dev->buffer.allocated = 0;
+		}
+	}
+}
+
+/**
+ * @brief Release data referenced with iio_get_buffer_ref that won't be sent.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param len - Number of released bytes.
+ */
+static void iio_release_buffer_ref(struct iiod_ctx *ctx, const char *device,
+				   uint32_t len)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (dev)
+		iio_buffer_ref_done(dev, NULL, len);
+}
+
+/**
+ * @brief Queue data referenced with iio_get_buffer_ref on the socket.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param buf - Data to be sent.
+ * @param len - Number of bytes to be sent.
+ * @return Number of bytes queued or negative value in case of error.
+ */
+static int iio_send_buffer_ref(struct iiod_ctx *ctx, const char *device,
+			       uint8_t *buf, uint32_t len)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -EINVAL;
+
+	return socket_send_ref(ctx->conn, buf, len, iio_buffer_ref_done, dev);
+}
+#endif
 
 /**
  * @brief Write chunk of data into RAM.
@@ -1390,46 +2687,152 @@ static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
 	return bytes;
 }
 
+/**
+ * @brief Count the scans that don't fit in the free space of an input buffer.
+ * @param priv     - Device buffer.
+ * @param nb_scans - Number of scans about to be written.
+ */
+static void iio_buffer_count_overruns(struct iio_buffer_priv *priv,
+				      uint32_t nb_scans)
+{
+	uint32_t bps = priv->public.bytes_per_scan;
+	uint32_t free_scans;
+	uint32_t used;
+
+	if (!bps)
+		return;
+
+	no_os_cb_size(&priv->cb, &used);
+	free_scans = (priv->cb.size - used) / bps;
+	if (nb_scans > free_scans)
+		priv->overruns += nb_scans - free_scans;
+}
+
+/**
+ * @brief Fill the timestamp channel of consecutive scans, with the timestamps
+ * of the trigger events being handled or with the current time.
+ * @param priv     - Device buffer.
+ * @param data     - Scans.
+ * @param nb_scans - Number of scans.
+ */
+static void iio_buffer_put_timestamp(struct iio_buffer_priv *priv,
+				     uint8_t *data, uint32_t nb_scans)
+{
+	uint32_t bps = priv->public.bytes_per_scan;
+	uint64_t now = 0;
+	uint64_t ts;
+
+	if (priv->ts_offset < 0)
+		return;
+
+	if (!priv->ts_trig && priv->get_timestamp)
+		now = priv->get_timestamp();
+
+	for (data += priv->ts_offset; nb_scans--; data += bps) {
+		ts = now;
+		if (priv->ts_trig)
+			ts = iio_trig_timestamp(priv->ts_trig, priv->ts_seq++,
+						priv->ts_last);
+		memcpy(data, &ts, sizeof(ts));
+	}
+}
+
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
 {
+	struct iio_buffer_priv *priv;
 	uint32_t size;
+	int ret;
 
 	if (!buffer)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
+	if (buffer->dir == IIO_DIRECTION_OUTPUT)
+		return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr,
+						   &size);
+
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	iio_buffer_count_overruns(priv, buffer->samples);
 
-	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
+	ret = no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr,
+					   &size);
+	if (ret)
+		return ret;
+
+	priv->block = *addr;
+	priv->block_len = size;
+
+	return 0;
 }
 
 int iio_buffer_block_done(struct iio_buffer *buffer)
 {
+	struct iio_buffer_priv *priv;
+
 	if (!buffer)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_end_async_write(buffer->buf);
+	if (buffer->dir == IIO_DIRECTION_OUTPUT)
+		return no_os_cb_end_async_read(buffer->buf);
+
+	/* The block is complete, stamp it with the completion time */
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	if (priv->block && buffer->bytes_per_scan)
+		iio_buffer_put_timestamp(priv, priv->block,
+					 priv->block_len / buffer->bytes_per_scan);
+	priv->block = NULL;
 
-	return no_os_cb_end_async_read(buffer->buf);
+	return no_os_cb_end_async_write(buffer->buf);
 }
 
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
 {
+	struct iio_buffer_priv *priv;
+
 	if (!buffer)
 		return -EINVAL;
 
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	iio_buffer_count_overruns(priv, 1);
+	iio_buffer_put_timestamp(priv, data, 1);
+
 	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
 }
 
+/* Write to buffer nb_scans * iio_buffer.bytes_per_scan bytes from data */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data,
+			  uint32_t nb_scans)
+{
+	struct iio_buffer_priv *priv;
+
+	if (!buffer)
+		return -EINVAL;
+
+	if (!nb_scans)
+		return 0;
+
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	iio_buffer_count_overruns(priv, nb_scans);
+	iio_buffer_put_timestamp(priv, data, nb_scans);
+
+	return no_os_cb_write(buffer->buf, data,
+			      nb_scans * buffer->bytes_per_scan);
+}
+
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 {
+	struct iio_buffer_priv *priv;
+	uint32_t used;
+	int ret;
+
 	if (!buffer)
 		return -EINVAL;
 
-	int ret;
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	no_os_cb_size(buffer->buf, &used);
+	if (!buffer->cyclic_info.is_cyclic && used < buffer->bytes_per_scan)
+		priv->underruns++;
 
 	ret = no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
 
@@ -1441,6 +2844,118 @@ int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 	return ret;
 }
 
+/**
+ * @brief Write scans to an input buffer from one array of samples per channel.
+ * The samples are interleaved in place in the buffer, without an intermediate
+ * scan. The timestamp channel is filled by the core, its array may be NULL.
+ * @param buffer   - Device buffer.
+ * @param planes   - Sample arrays, indexed by channel index. Arrays of
+ *		     disabled channels aren't accessed and may be NULL.
+ * @param nb_scans - Number of scans to write.
+ * @return 0 in case of success, negative value otherwise.
+ */
+int iio_buffer_push_planar(struct iio_buffer *buffer,
+			   const void *const *planes, uint32_t nb_scans)
+{
+	struct iio_buffer_priv *priv;
+	uint32_t bps, done, size, nb;
+	void *addr;
+	int ret;
+
+	if (!buffer || !planes || !buffer->layout)
+		return -EINVAL;
+
+	bps = buffer->layout->bytes_per_scan;
+	if (!bps)
+		return -EINVAL;
+
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+	iio_buffer_count_overruns(priv, nb_scans);
+
+	for (done = 0; done < nb_scans; done += nb) {
+		/* Up to the end of the circular buffer */
+		ret = no_os_cb_prepare_async_write(buffer->buf,
+						   (nb_scans - done) * bps,
+						   &addr, &size);
+		if (ret)
+			return ret;
+
+		nb = size / bps;
+		iio_scan_mux(buffer->layout, planes, done, addr, nb);
+		iio_buffer_put_timestamp(priv, addr, nb);
+
+		ret = no_os_cb_end_async_write(buffer->buf);
+		if (ret)
+			return ret;
+
+		if (!nb)
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read scans from an output buffer into one array of samples per
+ * channel, without an intermediate scan.
+ * @param buffer   - Device buffer.
+ * @param planes   - Sample arrays, indexed by channel index. Arrays of
+ *		     disabled channels aren't accessed and may be NULL.
+ * @param nb_scans - Number of scans to read.
+ * @return 0 in case of success, -EAGAIN if the buffer had less than nb_scans
+ * scans, in which case the available ones are read, negative value otherwise.
+ */
+int iio_buffer_pop_planar(struct iio_buffer *buffer, void *const *planes,
+			  uint32_t nb_scans)
+{
+	struct iio_buffer_priv *priv;
+	uint32_t bps, done, size, used, nb;
+	void *addr;
+	int ret;
+
+	if (!buffer || !planes || !buffer->layout)
+		return -EINVAL;
+
+	bps = buffer->layout->bytes_per_scan;
+	if (!bps)
+		return -EINVAL;
+
+	priv = NO_OS_CONTAINER_OF(buffer, struct iio_buffer_priv, public);
+
+	for (done = 0; done < nb_scans; done += nb) {
+		no_os_cb_size(buffer->buf, &used);
+		if (used < bps) {
+			if (!buffer->cyclic_info.is_cyclic)
+				priv->underruns += nb_scans - done;
+			return -EAGAIN;
+		}
+
+		/* Up to the end of the data or of the circular buffer */
+		ret = no_os_cb_prepare_async_read(buffer->buf,
+						  (nb_scans - done) * bps,
+						  &addr, &size);
+		if (ret)
+			return ret;
+
+		nb = size / bps;
+		iio_scan_demux(buffer->layout, addr, planes, done, nb);
+
+		ret = no_os_cb_end_async_read(buffer->buf);
+		if (ret)
+			return ret;
+
+		if (buffer->cyclic_info.is_cyclic) {
+			if (buffer->buf->read.idx == buffer->buf->write.idx)
+				buffer->buf->read.idx = 0;
+		}
+
+		if (!nb)
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 
 static int32_t accept_network_clients(struct iio_desc *desc)
@@ -1572,6 +3087,17 @@ static uint32_t iio_add_ctx_attr_in_xml(struct iio_desc *desc, char *buff,
 	return i;
 }
 
+/**
+ * @brief Check if a device has a buffer.
+ * @param device - Device descriptor.
+ * @return true if the device has a buffer, false otherwise.
+ */
+static bool iio_device_has_buffer(struct iio_device *device)
+{
+	return device->read_dev || device->write_dev || device->submit ||
+	       device->trigger_handler;
+}
+
 /*
  * Generate an xml describing a device and write it to buff.
  * Will return the size of the xml.
@@ -1731,6 +3257,11 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 	if (device->debug_reg_read || device->debug_reg_write)
 		i += snprintf(buff + i, no_os_max(n - i, 0),
 			      "<debug-attribute name=\""REG_ACCESS_ATTRIBUTE"\" />");
+#ifdef NO_OS_TRACE
+	/* Bus access counters of the whole application */
+	i += snprintf(buff + i, no_os_max(n - i, 0),
+		      "<debug-attribute name=\""BUS_TRACE_ATTRIBUTE"\" />");
+#endif
 
 	/* Write buffer attributes */
 	if (device->buffer_attributes)
@@ -1738,6 +3269,24 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 			i += snprintf(buff + i, no_os_max(n - i, 0),
 				      "<buffer-attribute name=\"%s\" />",
 				      device->buffer_attributes[j].name);
+	if (iio_device_has_buffer(device))
+		i += snprintf(buff + i, no_os_max(n - i, 0),
+			      "<buffer-attribute name=\""COMPRESSION_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""COMPRESSION_AVAILABLE"\" />"
+			      "<buffer-attribute name=\""OVERRUNS_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""UNDERRUNS_ATTRIBUTE"\" />");
+	if (iio_device_has_buffer(device) && iio_device_has_input_scan(device))
+		i += snprintf(buff + i, no_os_max(n - i, 0),
+			      "<buffer-attribute name=\""FILTER_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""FILTER_AVAILABLE"\" />"
+			      "<buffer-attribute name=\""DECIMATION_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""FILTER_ORDER_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""FILTER_MASK_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""FILTER_COEFFS_ATTRIBUTE"\" />");
+	if (device->trigger_handler || device->trigger_batch_handler)
+		i += snprintf(buff + i, no_os_max(n - i, 0),
+			      "<buffer-attribute name=\""SCAN_SEQUENCE_ATTRIBUTE"\" />"
+			      "<buffer-attribute name=\""SCAN_GAPS_ATTRIBUTE"\" />");
 
 	i += snprintf(buff + i, no_os_max(n - i, 0), "</device>");
 
@@ -1790,10 +3339,29 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	}
 
 	strcpy(desc->xml_desc + of, header_end);
+	desc->xml = desc->xml_desc;
 
 	return 0;
 }
 
+/**
+ * @brief Compute the hash clients use to tell if their copy of the xml is
+ * up to date.
+ * @param desc - iio descriptor.
+ */
+static void iio_hash_xml(struct iio_desc *desc)
+{
+	uint32_t hash = 0x811C9DC5;
+	uint32_t i;
+
+	for (i = 0; i < desc->xml_size; i++) {
+		hash ^= (uint8_t)desc->xml[i];
+		hash *= 0x01000193;
+	}
+
+	sprintf(desc->xml_hash, "%08"PRIx32, hash);
+}
+
 static int32_t iio_init_devs(struct iio_desc *desc,
 			     struct iio_device_init *devs, uint32_t n)
 {
@@ -1817,13 +3385,16 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		ldev->dev_data.dev = ndev->dev;
 		ldev->dev_data.buffer = &ldev->buffer.public;
 		ldev->name = ndev->name;
-		if (ndev->dev_descriptor->read_dev ||
-		    ndev->dev_descriptor->write_dev ||
-		    ndev->dev_descriptor->submit ||
-		    ndev->dev_descriptor->trigger_handler) {
+		if (iio_device_has_buffer(ndev->dev_descriptor)) {
 			ldev->buffer.raw_buf = ndev->raw_buf;
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
+			ldev->buffer.public.layout = &ldev->buffer.layout;
+			ldev->buffer.ts_offset = -1;
+			ldev->buffer.get_timestamp = desc->get_timestamp;
+			ldev->buffer.filter_cfg.decimation = 1;
+			ldev->buffer.filter_cfg.order = 1;
+			ldev->buffer.filter_cfg.mask = UINT32_MAX;
 			ldev->buffer.initalized = 1;
 		} else {
 			ldev->buffer.initalized = 0;
@@ -1888,6 +3459,7 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ldesc->ctx_attrs = init_param->ctx_attrs;
 	ldesc->nb_ctx_attr = init_param->nb_ctx_attr;
+	ldesc->get_timestamp = init_param->get_timestamp;
 
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1897,9 +3469,16 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_desc;
 
-	ret = iio_init_xml(ldesc);
-	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_trigs;
+	if (init_param->xml) {
+		ldesc->xml = init_param->xml;
+		ldesc->xml_size = init_param->xml_len ? init_param->xml_len :
+				  strlen(init_param->xml);
+	} else {
+		ret = iio_init_xml(ldesc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_trigs;
+	}
+	iio_hash_xml(ldesc);
 
 	/* device operations */
 	ops = &ldesc->iiod_ops;
@@ -1916,11 +3495,27 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->send = iio_send;
 	ops->recv = iio_recv;
 	ops->set_buffers_count = iio_set_buffers_count;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	/* Send buffers without copying them when the network stack allows it */
+	if (init_param->phy_type == USE_NETWORK &&
+	    init_param->tcp_socket_init_param->net->socket_send_ref
+#ifndef DISABLE_SECURE_SOCKET
+	    && !init_param->tcp_socket_init_param->secure_init_param
+#endif
+	   ) {
+		ops->get_buffer_ref = iio_get_buffer_ref;
+		ops->send_buffer_ref = iio_send_buffer_ref;
+		ops->release_buffer_ref = iio_release_buffer_ref;
+	}
+#endif
 
 	iiod_param.instance = ldesc;
 	iiod_param.ops = ops;
-	iiod_param.xml = ldesc->xml_desc;
+	iiod_param.xml = ldesc->xml;
 	iiod_param.xml_len = ldesc->xml_size;
+	iiod_param.xml_zstd = init_param->xml_zstd;
+	iiod_param.xml_zstd_len = init_param->xml_zstd_len;
+	iiod_param.xml_hash = ldesc->xml_hash;
 	iiod_param.phy_type = init_param->phy_type;
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
@@ -2005,6 +3600,33 @@ free_desc:
 	return ret;
 }
 
+/**
+ * @brief Get the context xml sent to clients and its hash.
+ *
+ * The xml can be stored in flash and passed back in iio_init_param.xml, so
+ * it isn't generated and kept in RAM anymore. The hash is what clients get
+ * with the XMLHASH command, a no-OS extension of the IIOD protocol.
+ * @param desc - iio descriptor.
+ * @param xml - Set to the xml, not null terminated if provided by the
+ * application.
+ * @param len - Set to the size of xml in bytes.
+ * @param hash - Optional. Set to the hash of xml.
+ * @return 0 in case of success or negative value otherwise.
+ */
+int iio_get_xml(struct iio_desc *desc, const char **xml, uint32_t *len,
+		const char **hash)
+{
+	if (!desc || !xml || !len)
+		return -EINVAL;
+
+	*xml = desc->xml;
+	*len = desc->xml_size;
+	if (hash)
+		*hash = desc->xml_hash;
+
+	return 0;
+}
+
 /**
  * @brief Free the resources allocated by "iio_init()".
  * @param desc: iio descriptor.
@@ -2019,7 +3641,8 @@ int iio_remove(struct iio_desc *desc)
 		return -EINVAL;
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-	for (int i = 0; i < IIOD_MAX_CONNECTIONS; i++) {
+	/* Only the network connections own their buffer and socket */
+	for (int i = 0; desc->server && i < IIOD_MAX_CONNECTIONS; i++) {
 		ret = iiod_conn_remove(desc->iiod, i, &data);
 		if (!ret) {
 			no_os_free(data.buf);
@@ -2030,6 +3653,10 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	for (uint32_t i = 0; i < desc->nb_devs; i++) {
+		iio_buffer_delta_free(&desc->devs[i].buffer);
+		iio_buffer_filter_free(&desc->devs[i].buffer);
+	}
 	no_os_free(desc->devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
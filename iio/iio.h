@@ -108,20 +108,68 @@ struct iio_init_param {
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/**
+	 * Optional. Context xml generated ahead of time, for example with
+	 * iio_get_xml() or iio_genxml, and kept in flash. It is sent as is
+	 * instead of being generated from devs and trigs, so it must describe
+	 * them exactly.
+	 */
+	const char *xml;
+	/** Size of xml in bytes, strlen(xml) if 0 */
+	uint32_t xml_len;
+	/** Optional. zstd compressed xml, sent to clients supporting it */
+	const uint8_t *xml_zstd;
+	/** Size of xml_zstd in bytes */
+	uint32_t xml_zstd_len;
+	/**
+	 * Optional. High resolution clock in nanoseconds, used to fill the
+	 * timestamp channel when a trigger gives no timestamp or the data
+	 * doesn't come from a trigger.
+	 */
+	uint64_t (*get_timestamp)(void);
 };
 
+/* Scan type of the timestamp channel: signed 64 bit nanoseconds */
+extern struct scan_type iio_timestamp_scan_type;
+
+/*
+ * Timestamp channel, filled by the IIO core. The driver leaves its place in
+ * the scans it pushes, it is set with the trigger event timestamp or read
+ * from iio_init_param.get_timestamp when the scans are written.
+ */
+#define IIO_TIMESTAMP_CHANNEL(_si) {\
+	.name = "timestamp",\
+	.ch_type = IIO_TIMESTAMP,\
+	.channel = -1,\
+	.scan_index = _si,\
+	.scan_type = &iio_timestamp_scan_type,\
+	.indexed = false,\
+	.ch_out = false,\
+}
+
 /* Set communication ops and read/write ops. */
 int iio_init(struct iio_desc **desc, struct iio_init_param *init_param);
 /* Free the resources allocated by iio_init(). */
 int iio_remove(struct iio_desc *desc);
 /* Execut an iio step. */
 int iio_step(struct iio_desc *desc);
+/* Get the context xml and its hash. */
+int iio_get_xml(struct iio_desc *desc, const char **xml, uint32_t *len,
+		const char **hash);
 /* Signal iio that a trigger has been triggered.
  * This will be called in interrupt context. An application callback will be
    called in interrupt context if trigger is synchronous with the interrupt
    (is_synchronous = true) or will be called from iio_step if trigger is
    asynchronous (is_synchronous = false) */
 int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name);
+/* Get the index of a trigger to be used with iio_process_trigger. */
+int iio_get_trigger_idx(struct iio_desc *desc, const char *name,
+			uint32_t *idx);
+/* Same as iio_process_trigger_type, without searching the trigger by name.
+ * Events of asynchronous triggers are counted, so the trigger handler is
+   called from iio_step once for each event. */
+int iio_process_trigger(struct iio_desc *desc, uint32_t trig_idx,
+			uint64_t timestamp);
 
 int32_t iio_parse_value(char *buf, enum iio_val fmt,
 			int32_t *val, int32_t *val2);
@@ -137,7 +185,28 @@ int iio_buffer_block_done(struct iio_buffer *buffer);
 /* Trigger buffer functions. */
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
+/* Write to buffer nb_scans * iio_buffer.bytes_per_scan bytes from data */
+int iio_buffer_push_scans(struct iio_buffer *buffer, void *data,
+			  uint32_t nb_scans);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
+/* Write nb_scans scans to buffer from one array of samples per channel */
+int iio_buffer_push_planar(struct iio_buffer *buffer,
+			   const void *const *planes, uint32_t nb_scans);
+/* Read nb_scans scans from buffer into one array of samples per channel */
+int iio_buffer_pop_planar(struct iio_buffer *buffer, void *const *planes,
+			  uint32_t nb_scans);
+
+/* Scan layout functions. */
+/* Compute the position of the channels enabled in mask in a scan */
+int iio_scan_layout_init(struct iio_scan_layout *layout,
+			 const struct iio_channel *channels, uint32_t mask);
+/* Interleave samples from per channel arrays into scans */
+void iio_scan_mux(const struct iio_scan_layout *layout,
+		  const void *const *planes, uint32_t first, void *scans,
+		  uint32_t nb_scans);
+/* Split scans into per channel arrays */
+void iio_scan_demux(const struct iio_scan_layout *layout, const void *scans,
+		    void *const *planes, uint32_t first, uint32_t nb_scans);
 
 #endif /* IIO_H_ */
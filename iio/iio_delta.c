@@ -0,0 +1,244 @@
+/***************************************************************************//**
+ *   @file   iio_delta.c
+ *   @brief  Scan-to-scan delta encoder and reference decoder.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+
+#include <errno.h>
+#include <string.h>
+#include "iio_delta.h"
+
+/* Bit 7 of an encoded byte is set when more bytes of the integer follow */
+#define IIO_DELTA_CONT		0x80
+
+/**
+ * @brief Read a sample from the scan.
+ * @param buf - Start of the sample.
+ * @param bytes - Storage size of the sample.
+ * @param big_endian - Set when the sample is stored big endian.
+ * @return The sample.
+ */
+static inline uint64_t iio_delta_get(const uint8_t *buf, uint32_t bytes,
+				     bool big_endian)
+{
+	uint64_t val = 0;
+	uint32_t i;
+
+	if (big_endian)
+		for (i = 0; i < bytes; i++)
+			val = (val << 8) | buf[i];
+	else
+		for (i = bytes; i; i--)
+			val = (val << 8) | buf[i - 1];
+
+	return val;
+}
+
+/**
+ * @brief Write a sample in the scan.
+ * @param buf - Start of the sample.
+ * @param bytes - Storage size of the sample.
+ * @param big_endian - Set when the sample is stored big endian.
+ * @param val - The sample.
+ */
+static inline void iio_delta_put(uint8_t *buf, uint32_t bytes,
+				 bool big_endian, uint64_t val)
+{
+	uint32_t i;
+
+	if (big_endian)
+		for (i = bytes; i; i--, val >>= 8)
+			buf[i - 1] = val;
+	else
+		for (i = 0; i < bytes; i++, val >>= 8)
+			buf[i] = val;
+}
+
+/**
+ * @brief Clear the layout and the state.
+ * @param delta - Encoder or decoder.
+ */
+void iio_delta_init(struct iio_delta *delta)
+{
+	memset(delta, 0, sizeof(*delta));
+}
+
+/**
+ * @brief Append a channel to the scan layout. The sample is aligned to its
+ * size and the scan size to the largest sample, like in the IIO core.
+ * @param delta - Encoder or decoder.
+ * @param bytes - Storage size of the sample.
+ * @param big_endian - Set when the sample is stored big endian.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_delta_add_channel(struct iio_delta *delta, uint32_t bytes,
+			  bool big_endian)
+{
+	struct iio_delta_channel *last;
+	uint32_t offset = 0;
+
+	if (!bytes || bytes > IIO_DELTA_MAX_SAMPLE_SIZE ||
+	    delta->nb_channels == IIO_DELTA_MAX_CHANNELS)
+		return -EINVAL;
+
+	if (delta->nb_channels) {
+		last = &delta->ch[delta->nb_channels - 1];
+		offset = last->offset + last->bytes;
+		offset = (offset + bytes - 1) / bytes * bytes;
+	}
+	if (offset > UINT16_MAX)
+		return -EINVAL;
+
+	delta->ch[delta->nb_channels].offset = offset;
+	delta->ch[delta->nb_channels].bytes = bytes;
+	delta->ch[delta->nb_channels].big_endian = big_endian;
+	delta->nb_channels++;
+
+	if (bytes > delta->largest)
+		delta->largest = bytes;
+	offset += bytes;
+	delta->bytes_per_scan = (offset + delta->largest - 1) / delta->largest *
+				delta->largest;
+
+	return 0;
+}
+
+/**
+ * @brief Restart the stream: the previous samples are 0 and no integer is
+ * partially decoded. The layout is kept.
+ * @param delta - Encoder or decoder.
+ */
+void iio_delta_reset(struct iio_delta *delta)
+{
+	memset(delta->prev, 0, sizeof(delta->prev));
+	delta->idx = 0;
+	delta->acc = 0;
+	delta->shift = 0;
+}
+
+/**
+ * @brief Encode one scan.
+ * @param delta - Encoder.
+ * @param scan - bytes_per_scan bytes of samples.
+ * @param out - Encoded scan, at most IIO_DELTA_MAX_ENCODED(bytes_per_scan)
+ * bytes.
+ * @return Size of the encoded scan.
+ */
+uint32_t iio_delta_encode(struct iio_delta *delta, const uint8_t *scan,
+			  uint8_t *out)
+{
+	const struct iio_delta_channel *ch = delta->ch;
+	uint64_t *prev = delta->prev;
+	uint8_t *p = out;
+	uint32_t shift;
+	uint64_t val;
+	uint64_t zz;
+	int64_t diff;
+	uint32_t i;
+
+	for (i = 0; i < delta->nb_channels; i++, ch++) {
+		val = iio_delta_get(scan + ch->offset, ch->bytes,
+				    ch->big_endian);
+
+		/* Difference modulo the storage size, sign extended */
+		shift = 64 - 8 * ch->bytes;
+		diff = (int64_t)((val - prev[i]) << shift) >> shift;
+		prev[i] = val;
+
+		zz = ((uint64_t)diff << 1) ^ (uint64_t)(diff >> 63);
+		while (zz >= IIO_DELTA_CONT) {
+			*p++ = zz | IIO_DELTA_CONT;
+			zz >>= 7;
+		}
+		*p++ = zz;
+	}
+
+	return p - out;
+}
+
+/**
+ * @brief Decode a chunk of the stream. The chunk may start and end anywhere
+ * in a scan, the decoder keeps the partially decoded scan until the next call.
+ * @param delta - Decoder.
+ * @param in - Encoded data.
+ * @param len - Size of the encoded data.
+ * @param scans - Decoded scans.
+ * @param nb_scans - Number of scans that fit in scans. Set to the number of
+ * decoded scans.
+ * @return Number of bytes of in that were consumed or negative error code.
+ * Decoding stops early when scans is full.
+ */
+int32_t iio_delta_decode(struct iio_delta *delta, const uint8_t *in,
+			 uint32_t len, uint8_t *scans, uint32_t *nb_scans)
+{
+	const struct iio_delta_channel *ch;
+	uint32_t max = *nb_scans;
+	uint32_t n = 0;
+	uint32_t i = 0;
+	uint32_t j;
+	uint64_t zz;
+	uint8_t b;
+
+	*nb_scans = 0;
+	if (!delta->nb_channels)
+		return -EINVAL;
+
+	while (i < len && n < max) {
+		b = in[i++];
+		delta->acc |= (uint64_t)(b & ~IIO_DELTA_CONT) << delta->shift;
+		delta->shift += 7;
+		if (b & IIO_DELTA_CONT) {
+			/* A 64 bit integer is at most 10 bytes long */
+			if (delta->shift >= 64)
+				return -EINVAL;
+			continue;
+		}
+
+		zz = delta->acc;
+		delta->prev[delta->idx] += (zz >> 1) ^ -(zz & 1);
+		delta->acc = 0;
+		delta->shift = 0;
+		if (++delta->idx < delta->nb_channels)
+			continue;
+
+		memset(scans, 0, delta->bytes_per_scan);
+		for (j = 0, ch = delta->ch; j < delta->nb_channels; j++, ch++)
+			iio_delta_put(scans + ch->offset, ch->bytes,
+				      ch->big_endian, delta->prev[j]);
+
+		delta->idx = 0;
+		scans += delta->bytes_per_scan;
+		n++;
+	}
+
+	*nb_scans = n;
+
+	return i;
+}
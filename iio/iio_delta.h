@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ *   @file   iio_delta.h
+ *   @brief  Scan-to-scan delta encoding of IIO buffer data.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Stream format, enabled on a buffer by writing "delta_varint" to its
+ * "compression" buffer attribute before opening it:
+ *
+ * Each scan is encoded as one variable-length integer per enabled channel, in
+ * scan order. The integer is the difference between the channel sample and
+ * the same channel sample of the previous scan, computed modulo the storage
+ * size and sign extended from it. The difference is zigzag mapped
+ * (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...) and written 7 bits at a time, least
+ * significant group first, with bit 7 set on every byte but the last one.
+ * The previous samples are 0 when the buffer is opened. Padding bytes of the
+ * scan are not sent and are decoded as 0.
+ *
+ * The encoded stream is continuous: READBUF returns the number of encoded
+ * bytes asked for, which may end inside a scan.
+ *
+ * This file only depends on the C standard library so clients can use the
+ * decoder as is.
+ */
+
+#ifndef IIO_DELTA_H_
+#define IIO_DELTA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum number of channels in a scan */
+#define IIO_DELTA_MAX_CHANNELS		32
+/** Maximum size of the largest sample, in bytes */
+#define IIO_DELTA_MAX_SAMPLE_SIZE	8
+/** Worst case size of an encoded scan */
+#define IIO_DELTA_MAX_ENCODED(bytes_per_scan)	(2 * (bytes_per_scan))
+
+/**
+ * @struct iio_delta_channel
+ * @brief Position of a channel sample in the scan
+ */
+struct iio_delta_channel {
+	/** Offset of the sample in the scan */
+	uint16_t offset;
+	/** Storage size of the sample in bytes */
+	uint8_t bytes;
+	/** Set when the sample is stored big endian */
+	bool big_endian;
+};
+
+/**
+ * @struct iio_delta
+ * @brief Scan layout and encoder or decoder state
+ */
+struct iio_delta {
+	/** Enabled channels, in scan order */
+	struct iio_delta_channel ch[IIO_DELTA_MAX_CHANNELS];
+	/** Number of enabled channels */
+	uint32_t nb_channels;
+	/** Size of a decoded scan, including padding */
+	uint32_t bytes_per_scan;
+	/** Size of the largest sample */
+	uint32_t largest;
+	/** Samples of the previous scan */
+	uint64_t prev[IIO_DELTA_MAX_CHANNELS];
+	/** Decoder: channel of the integer being decoded */
+	uint32_t idx;
+	/** Decoder: bits of the integer being decoded */
+	uint64_t acc;
+	/** Decoder: number of bits in acc */
+	uint32_t shift;
+};
+
+/* Clear the layout and the state. */
+void iio_delta_init(struct iio_delta *delta);
+
+/* Append a channel to the scan layout, aligned as the IIO core aligns it. */
+int iio_delta_add_channel(struct iio_delta *delta, uint32_t bytes,
+			  bool big_endian);
+
+/* Restart the stream, keeping the layout. */
+void iio_delta_reset(struct iio_delta *delta);
+
+/* Encode one scan. */
+uint32_t iio_delta_encode(struct iio_delta *delta, const uint8_t *scan,
+			  uint8_t *out);
+
+/* Decode a chunk of the stream into whole scans. */
+int32_t iio_delta_decode(struct iio_delta *delta, const uint8_t *in,
+			 uint32_t len, uint8_t *scans, uint32_t *nb_scans);
+
+#endif /* IIO_DELTA_H_ */
@@ -0,0 +1,446 @@
+/***************************************************************************//**
+ *   @file   iio_filter.c
+ *   @brief  Decimation filters of IIO buffer data.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "iio_filter.h"
+
+/* Rounding of the Q15 FIR output */
+#define IIO_FILTER_Q15_ROUND	(1 << 14)
+
+/**
+ * @brief Read a sample from the scan.
+ * @param buf - Start of the sample.
+ * @param ch - Channel of the sample.
+ * @return The valid bits of the sample, sign extended for signed channels.
+ */
+static inline int64_t iio_filter_get(const uint8_t *buf,
+				     const struct iio_filter_channel *ch)
+{
+	uint32_t raw = 0;
+	uint16_t raw16;
+	uint32_t i;
+
+	if (ch->big_endian) {
+		for (i = 0; i < ch->bytes; i++)
+			raw = (raw << 8) | buf[i];
+	} else if (ch->bytes == 4) {
+		memcpy(&raw, buf, sizeof(raw));
+	} else if (ch->bytes == 2) {
+		memcpy(&raw16, buf, sizeof(raw16));
+		raw = raw16;
+	} else {
+		for (i = ch->bytes; i; i--)
+			raw = (raw << 8) | buf[i - 1];
+	}
+
+	raw >>= ch->shift;
+	raw <<= 32 - ch->realbits;
+	if (ch->is_signed)
+		return (int32_t)raw >> (32 - ch->realbits);
+
+	return raw >> (32 - ch->realbits);
+}
+
+/**
+ * @brief Write a filtered sample in the scan.
+ * @param buf - Start of the sample.
+ * @param ch - Channel of the sample.
+ * @param val - The filtered value, saturated to the valid bits.
+ */
+static inline void iio_filter_put(uint8_t *buf,
+				  const struct iio_filter_channel *ch,
+				  int64_t val)
+{
+	int64_t max, min;
+	uint32_t raw;
+	uint16_t raw16;
+	uint32_t i;
+
+	if (ch->is_signed) {
+		max = (1ll << (ch->realbits - 1)) - 1;
+		min = -max - 1;
+	} else {
+		max = (1ll << ch->realbits) - 1;
+		min = 0;
+	}
+	if (val > max)
+		val = max;
+	else if (val < min)
+		val = min;
+
+	raw = ((uint32_t)val & (UINT32_MAX >> (32 - ch->realbits))) << ch->shift;
+
+	if (ch->big_endian) {
+		for (i = ch->bytes; i; i--, raw >>= 8)
+			buf[i - 1] = raw;
+	} else if (ch->bytes == 4) {
+		memcpy(buf, &raw, sizeof(raw));
+	} else if (ch->bytes == 2) {
+		raw16 = raw;
+		memcpy(buf, &raw16, sizeof(raw16));
+	} else {
+		for (i = 0; i < ch->bytes; i++, raw >>= 8)
+			buf[i] = raw;
+	}
+}
+
+/**
+ * @brief Keep the last sample of each decimation window.
+ * @param filter - Filter.
+ * @param ch - Channel.
+ * @param in - Input scans.
+ * @param nb_scans - Number of input scans.
+ * @param out - Output scans.
+ */
+static void iio_filter_decimate(const struct iio_filter *filter,
+				const struct iio_filter_channel *ch,
+				const uint8_t *in, uint32_t nb_scans,
+				uint8_t *out)
+{
+	uint32_t bps = filter->bytes_per_scan;
+	uint32_t i;
+
+	for (i = iio_filter_pending(filter) - 1; i < nb_scans;
+	     i += filter->cfg.decimation, out += bps)
+		memcpy(out + ch->offset, in + i * bps + ch->offset, ch->bytes);
+}
+
+/**
+ * @brief Moving average over each decimation window.
+ * @param filter - Filter.
+ * @param ch - Channel.
+ * @param in - Input scans.
+ * @param nb_scans - Number of input scans.
+ * @param out - Output scans.
+ */
+static void iio_filter_moving_average(const struct iio_filter *filter,
+				      struct iio_filter_channel *ch,
+				      const uint8_t *in, uint32_t nb_scans,
+				      uint8_t *out)
+{
+	uint32_t bps = filter->bytes_per_scan;
+	uint32_t dec = filter->cfg.decimation;
+	uint32_t count = filter->count;
+	int64_t sum = ch->integ[0];
+	uint32_t i;
+
+	for (i = 0, in += ch->offset; i < nb_scans; i++, in += bps) {
+		sum += iio_filter_get(in, ch);
+		if (++count < dec)
+			continue;
+
+		iio_filter_put(out + ch->offset, ch, sum / (int64_t)dec);
+		out += bps;
+		sum = 0;
+		count = 0;
+	}
+
+	ch->integ[0] = sum;
+}
+
+/**
+ * @brief Cascaded integrator comb filter. The integrators run at the input
+ * rate, the combs at the output rate.
+ * @param filter - Filter.
+ * @param ch - Channel.
+ * @param in - Input scans.
+ * @param nb_scans - Number of input scans.
+ * @param out - Output scans.
+ */
+static void iio_filter_cic(const struct iio_filter *filter,
+			   struct iio_filter_channel *ch, const uint8_t *in,
+			   uint32_t nb_scans, uint8_t *out)
+{
+	uint32_t bps = filter->bytes_per_scan;
+	uint32_t dec = filter->cfg.decimation;
+	uint32_t order = filter->cfg.order;
+	uint32_t count = filter->count;
+	uint64_t prev;
+	uint64_t val;
+	uint32_t i, j;
+
+	for (i = 0, in += ch->offset; i < nb_scans; i++, in += bps) {
+		ch->integ[0] += (uint64_t)iio_filter_get(in, ch);
+		for (j = 1; j < order; j++)
+			ch->integ[j] += ch->integ[j - 1];
+		if (++count < dec)
+			continue;
+
+		val = ch->integ[order - 1];
+		for (j = 0; j < order; j++) {
+			prev = ch->comb[j];
+			ch->comb[j] = val;
+			val -= prev;
+		}
+
+		iio_filter_put(out + ch->offset, ch,
+			       (int64_t)val / (int64_t)filter->gain);
+		out += bps;
+		count = 0;
+	}
+}
+
+/**
+ * @brief FIR filter, computed only for the last sample of each decimation
+ * window.
+ * @param filter - Filter.
+ * @param ch - Channel.
+ * @param in - Input scans.
+ * @param nb_scans - Number of input scans.
+ * @param out - Output scans.
+ */
+static void iio_filter_fir(const struct iio_filter *filter,
+			   struct iio_filter_channel *ch, const uint8_t *in,
+			   uint32_t nb_scans, uint8_t *out)
+{
+	const int16_t *taps = filter->cfg.taps;
+	uint32_t bps = filter->bytes_per_scan;
+	uint32_t dec = filter->cfg.decimation;
+	uint32_t nb_taps = filter->cfg.nb_taps;
+	uint32_t count = filter->count;
+	uint32_t pos = filter->pos;
+	const int32_t *hist;
+	int64_t acc;
+	int32_t val;
+	uint32_t i, j;
+
+	for (i = 0, in += ch->offset; i < nb_scans; i++, in += bps) {
+		/* The newest sample is at pos, the older ones after it */
+		pos = pos ? pos - 1 : nb_taps - 1;
+		val = iio_filter_get(in, ch);
+		ch->hist[pos] = val;
+		ch->hist[pos + nb_taps] = val;
+		if (++count < dec)
+			continue;
+
+		hist = &ch->hist[pos];
+		acc = 0;
+		for (j = 0; j < nb_taps; j++)
+			acc += (int32_t)taps[j] * (int64_t)hist[j];
+
+		iio_filter_put(out + ch->offset, ch,
+			       (acc + IIO_FILTER_Q15_ROUND) >> 15);
+		out += bps;
+		count = 0;
+	}
+}
+
+/**
+ * @brief Check a configuration.
+ * @param cfg - Configuration.
+ * @return 0 if the filter can be set up with it, -EINVAL otherwise.
+ */
+int iio_filter_cfg_check(const struct iio_filter_cfg *cfg)
+{
+	uint64_t gain = 1;
+	uint32_t order;
+	uint32_t i;
+
+	if (!cfg || !cfg->decimation)
+		return -EINVAL;
+
+	switch (cfg->type) {
+	case IIO_FILTER_NONE:
+		return 0;
+	case IIO_FILTER_MOVING_AVERAGE:
+		order = 1;
+		break;
+	case IIO_FILTER_CIC:
+		if (!cfg->order || cfg->order > IIO_FILTER_MAX_ORDER)
+			return -EINVAL;
+		order = cfg->order;
+		break;
+	case IIO_FILTER_FIR:
+		if (!cfg->nb_taps || cfg->nb_taps > IIO_FILTER_MAX_TAPS)
+			return -EINVAL;
+		return 0;
+	default:
+		return -EINVAL;
+	}
+
+	/* The integrators mustn't overflow the 64 bit result */
+	for (i = 0; i < order; i++) {
+		gain *= cfg->decimation;
+		if (gain > IIO_FILTER_MAX_GAIN)
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Set up a filter with no channels.
+ * @param filter - Filter of IIO_FILTER_SIZE(max_channels) bytes.
+ * @param cfg - Configuration, checked with iio_filter_cfg_check.
+ * @param bytes_per_scan - Size of a scan.
+ * @param max_channels - Maximum number of channels.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_filter_init(struct iio_filter *filter, const struct iio_filter_cfg *cfg,
+		    uint32_t bytes_per_scan, uint32_t max_channels)
+{
+	uint32_t i;
+	int ret;
+
+	ret = iio_filter_cfg_check(cfg);
+	if (ret)
+		return ret;
+
+	if (!bytes_per_scan || max_channels > IIO_FILTER_MAX_CHANNELS)
+		return -EINVAL;
+
+	memset(filter, 0, IIO_FILTER_SIZE(max_channels));
+	filter->cfg = *cfg;
+	filter->bytes_per_scan = bytes_per_scan;
+	filter->max_channels = max_channels;
+
+	filter->gain = 1;
+	if (cfg->type == IIO_FILTER_MOVING_AVERAGE)
+		filter->gain = cfg->decimation;
+	else if (cfg->type == IIO_FILTER_CIC)
+		for (i = 0; i < cfg->order; i++)
+			filter->gain *= cfg->decimation;
+
+	return 0;
+}
+
+/**
+ * @brief Append a channel of the scan.
+ * @param filter - Filter.
+ * @param offset - Offset of the sample in the scan.
+ * @param bytes - Storage size of the sample.
+ * @param realbits - Number of valid bits of the sample.
+ * @param shift - Position of the valid bits in the sample.
+ * @param is_signed - Set for signed samples.
+ * @param big_endian - Set when the sample is stored big endian.
+ * @param filtered - Set to filter the channel. Ignored for samples that
+ * don't fit in 31 bits plus sign.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_filter_add_channel(struct iio_filter *filter, uint32_t offset,
+			   uint32_t bytes, uint32_t realbits, uint32_t shift,
+			   bool is_signed, bool big_endian, bool filtered)
+{
+	struct iio_filter_channel *ch;
+
+	if (filter->nb_channels == filter->max_channels || !bytes ||
+	    offset + bytes > filter->bytes_per_scan)
+		return -EINVAL;
+
+	if (bytes > sizeof(uint32_t) || !realbits ||
+	    realbits + shift > 8 * bytes || (!is_signed && realbits == 32))
+		filtered = false;
+
+	ch = &filter->ch[filter->nb_channels++];
+	ch->offset = offset;
+	ch->bytes = bytes;
+	ch->realbits = realbits;
+	ch->shift = shift;
+	ch->is_signed = is_signed;
+	ch->big_endian = big_endian;
+	ch->filtered = filtered && filter->cfg.type != IIO_FILTER_NONE;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the state: the next input scan starts a decimation window and
+ * the previous samples are 0. The configuration and the channels are kept.
+ * @param filter - Filter.
+ */
+void iio_filter_reset(struct iio_filter *filter)
+{
+	struct iio_filter_channel *ch;
+	uint32_t i;
+
+	filter->count = 0;
+	filter->pos = 0;
+	for (i = 0, ch = filter->ch; i < filter->nb_channels; i++, ch++) {
+		memset(ch->integ, 0, sizeof(ch->integ));
+		memset(ch->comb, 0, sizeof(ch->comb));
+		memset(ch->hist, 0, sizeof(ch->hist));
+	}
+}
+
+/**
+ * @brief Filter consecutive scans. The input may start and end anywhere in a
+ * decimation window, the state is kept until the next call. Each channel is
+ * processed over all the scans before the next one.
+ * @param filter - Filter.
+ * @param in - nb_scans input scans.
+ * @param nb_scans - Number of input scans.
+ * @param out - Output scans, room for
+ * (nb_scans + decimation - 1) / decimation scans.
+ * @return Number of output scans.
+ */
+uint32_t iio_filter_process(struct iio_filter *filter, const uint8_t *in,
+			    uint32_t nb_scans, uint8_t *out)
+{
+	struct iio_filter_channel *ch;
+	uint32_t nb_out;
+	uint32_t i;
+
+	nb_out = (filter->count + nb_scans) / filter->cfg.decimation;
+	/* Padding and bits outside of the filtered samples are 0 */
+	memset(out, 0, nb_out * filter->bytes_per_scan);
+
+	for (i = 0, ch = filter->ch; i < filter->nb_channels; i++, ch++) {
+		if (!ch->filtered) {
+			iio_filter_decimate(filter, ch, in, nb_scans, out);
+			continue;
+		}
+
+		switch (filter->cfg.type) {
+		case IIO_FILTER_MOVING_AVERAGE:
+			iio_filter_moving_average(filter, ch, in, nb_scans, out);
+			break;
+		case IIO_FILTER_CIC:
+			iio_filter_cic(filter, ch, in, nb_scans, out);
+			break;
+		case IIO_FILTER_FIR:
+			iio_filter_fir(filter, ch, in, nb_scans, out);
+			break;
+		default:
+			iio_filter_decimate(filter, ch, in, nb_scans, out);
+			break;
+		}
+	}
+
+	filter->count = (filter->count + nb_scans) % filter->cfg.decimation;
+	if (filter->cfg.type == IIO_FILTER_FIR)
+		filter->pos = (filter->pos + filter->cfg.nb_taps -
+			       nb_scans % filter->cfg.nb_taps) %
+			      filter->cfg.nb_taps;
+
+	return nb_out;
+}
@@ -0,0 +1,179 @@
+/***************************************************************************//**
+ *   @file   iio_filter.h
+ *   @brief  Decimation filters of IIO buffer data.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Decimating filters applied to the scans of an input buffer before they are
+ * read by the client. For every decimation input scans one output scan with
+ * the same layout is produced, so the client sees the same channels at a
+ * lower rate.
+ *
+ * Channels in the filter mask are filtered. Their value is taken as
+ * (sample >> shift) over realbits bits, sign extended for signed channels,
+ * and the output is saturated to realbits bits and stored back shifted, with
+ * the bits outside of it cleared. The other channels, and the ones that
+ * don't fit in 31 bits plus sign like the 64 bit timestamp, keep the last
+ * sample of the decimation window.
+ *
+ * Kernels:
+ * - moving_average: mean of the decimation samples of the window.
+ * - cic: cascaded integrator comb of order 1 to IIO_FILTER_MAX_ORDER,
+ *   differential delay 1, normalized by its gain decimation^order.
+ * - fir: up to IIO_FILTER_MAX_TAPS Q15 coefficients, coefficient 0 applied
+ *   to the newest sample, computed only for the kept samples.
+ *
+ * This file only depends on the C standard library.
+ */
+
+#ifndef IIO_FILTER_H_
+#define IIO_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum number of channels in a scan */
+#define IIO_FILTER_MAX_CHANNELS		32
+/** Maximum number of FIR coefficients */
+#define IIO_FILTER_MAX_TAPS		32
+/** Maximum order of the CIC filter */
+#define IIO_FILTER_MAX_ORDER		4
+/** Maximum gain of the moving average and CIC filters, decimation^order */
+#define IIO_FILTER_MAX_GAIN		(1ull << 31)
+/** Size of a filter for nb_channels channels */
+#define IIO_FILTER_SIZE(nb_channels)	(sizeof(struct iio_filter) + \
+		(nb_channels) * sizeof(struct iio_filter_channel))
+
+/**
+ * @enum iio_filter_type
+ * @brief Filter kernels
+ */
+enum iio_filter_type {
+	IIO_FILTER_NONE,
+	IIO_FILTER_MOVING_AVERAGE,
+	IIO_FILTER_CIC,
+	IIO_FILTER_FIR,
+};
+
+/**
+ * @struct iio_filter_cfg
+ * @brief Filter configuration, set through the buffer attributes
+ */
+struct iio_filter_cfg {
+	/** Kernel */
+	enum iio_filter_type type;
+	/** One output scan for this many input scans */
+	uint32_t decimation;
+	/** Order of the CIC filter */
+	uint32_t order;
+	/** Channels to filter, by channel index */
+	uint32_t mask;
+	/** FIR coefficients, Q15 */
+	int16_t taps[IIO_FILTER_MAX_TAPS];
+	/** Number of FIR coefficients */
+	uint32_t nb_taps;
+};
+
+/**
+ * @struct iio_filter_channel
+ * @brief Position, format and state of a channel
+ */
+struct iio_filter_channel {
+	/** Offset of the sample in the scan */
+	uint16_t offset;
+	/** Storage size of the sample in bytes */
+	uint8_t bytes;
+	/** Number of valid bits of the sample */
+	uint8_t realbits;
+	/** Position of the valid bits in the sample */
+	uint8_t shift;
+	/** Set for signed samples */
+	bool is_signed;
+	/** Set when the sample is stored big endian */
+	bool big_endian;
+	/** Set when the channel is filtered, otherwise decimated only */
+	bool filtered;
+	/** Moving average sum or CIC integrators, modulo 2^64 */
+	uint64_t integ[IIO_FILTER_MAX_ORDER];
+	/** CIC comb delays */
+	uint64_t comb[IIO_FILTER_MAX_ORDER];
+	/** FIR delay line, each sample stored twice to keep it contiguous */
+	int32_t hist[2 * IIO_FILTER_MAX_TAPS];
+};
+
+/**
+ * @struct iio_filter
+ * @brief Filter of the scans of a buffer, IIO_FILTER_SIZE(nb_channels) bytes
+ */
+struct iio_filter {
+	/** Configuration */
+	struct iio_filter_cfg cfg;
+	/** Size of a scan, including padding */
+	uint32_t bytes_per_scan;
+	/** Number of channels added */
+	uint32_t nb_channels;
+	/** Number of channels that fit in ch */
+	uint32_t max_channels;
+	/** Gain of the moving average and CIC filters */
+	uint64_t gain;
+	/** Input scans of the current decimation window */
+	uint32_t count;
+	/** Position of the newest sample in the FIR delay lines */
+	uint32_t pos;
+	/** Enabled channels, in scan order */
+	struct iio_filter_channel ch[];
+};
+
+/* Check a configuration. */
+int iio_filter_cfg_check(const struct iio_filter_cfg *cfg);
+
+/* Set up a filter with no channels. */
+int iio_filter_init(struct iio_filter *filter, const struct iio_filter_cfg *cfg,
+		    uint32_t bytes_per_scan, uint32_t max_channels);
+
+/* Append a channel of the scan. */
+int iio_filter_add_channel(struct iio_filter *filter, uint32_t offset,
+			   uint32_t bytes, uint32_t realbits, uint32_t shift,
+			   bool is_signed, bool big_endian, bool filtered);
+
+/* Clear the state, keeping the configuration and the channels. */
+void iio_filter_reset(struct iio_filter *filter);
+
+/* Input scans left before the next output scan. */
+static inline uint32_t iio_filter_pending(const struct iio_filter *filter)
+{
+	return filter->cfg.decimation - filter->count;
+}
+
+/* Filter consecutive scans. */
+uint32_t iio_filter_process(struct iio_filter *filter, const uint8_t *in,
+			    uint32_t nb_scans, uint8_t *out);
+
+#endif /* IIO_FILTER_H_ */
@@ -65,6 +65,7 @@ int iio_hw_trig_init(struct iio_hw_trig **iio_trig,
 	trig_desc->irq_ctrl = init_param->irq_ctrl;
 	trig_desc->irq_id = init_param->irq_id;
 	trig_desc->irq_trig_lvl = init_param->irq_trig_lvl;
+	trig_desc->get_timestamp = init_param->get_timestamp;
 
 	struct no_os_callback_desc irq_cb = {
 		.callback = iio_hw_trig_handler,
@@ -103,11 +104,23 @@ error:
 */
 int iio_trig_enable(void *trig)
 {
+	int ret;
+
 	if (!trig)
 		return -EINVAL;
 
 	struct iio_hw_trig *desc = trig;
 
+	/* Resolve the trigger once, the interrupt handler uses the index */
+	if (!desc->bound) {
+		ret = iio_get_trigger_idx(desc->iio_desc, desc->name,
+					  &desc->trig_idx);
+		if (ret)
+			return ret;
+
+		desc->bound = true;
+	}
+
 	return no_os_irq_enable(desc->irq_ctrl, desc->irq_id);
 }
 
@@ -140,8 +153,15 @@ void iio_hw_trig_handler(void *trig)
 		return;
 
 	struct iio_hw_trig *desc = trig;
+	uint64_t timestamp = 0;
+
+	if (!desc->bound)
+		return;
+
+	if (desc->get_timestamp)
+		timestamp = desc->get_timestamp();
 
-	iio_process_trigger_type(desc->iio_desc, desc->name);
+	iio_process_trigger(desc->iio_desc, desc->trig_idx, timestamp);
 }
 
 /**
@@ -55,6 +55,12 @@ struct iio_hw_trig {
 	enum no_os_irq_trig_level irq_trig_lvl;
 	/** Device trigger name */
 	char name[TRIG_MAX_NAME_SIZE + 1];
+	/** Trigger index in the IIO descriptor, set by iio_trig_enable */
+	uint32_t trig_idx;
+	/** Set when trig_idx is valid */
+	bool bound;
+	/** Optional timestamp source, called in interrupt context */
+	uint64_t (*get_timestamp)(void);
 };
 
 /**
@@ -87,6 +93,8 @@ struct iio_hw_trig_init_param {
 	struct iio_hw_trig_cb_info cb_info;
 	/** Device trigger name */
 	const char *name;
+	/** Optional timestamp source, called in interrupt context */
+	uint64_t (*get_timestamp)(void);
 };
 
 /**
@@ -70,6 +70,7 @@ enum iio_chan_type {
 	IIO_DELTA_ANGL,
 	IIO_DELTA_VELOCITY,
 	IIO_WEIGHT,
+	IIO_TIMESTAMP,
 };
 
 /**
@@ -197,6 +198,39 @@ struct iio_cyclic_buffer_info {
 	uint32_t buff_index;
 };
 
+/** Maximum number of channels of a device with a buffer */
+#define IIO_SCAN_MAX_CHANNELS	32
+
+/**
+ * @struct iio_scan_channel
+ * @brief Position of an enabled channel sample in a scan
+ */
+struct iio_scan_channel {
+	/** Offset of the sample in the scan */
+	uint16_t offset;
+	/** Storage size of the sample in bytes */
+	uint8_t bytes;
+	/** Shift of the valid bits in the sample, from scan_type */
+	uint8_t shift;
+	/** Index of the channel in iio_device.channels */
+	uint8_t index;
+	/** Set when the sample is stored big endian */
+	bool big_endian;
+};
+
+/**
+ * @struct iio_scan_layout
+ * @brief Layout of the scans of a buffer, computed when it is opened
+ */
+struct iio_scan_layout {
+	/** Number of enabled channels */
+	uint32_t nb_channels;
+	/** Size of a scan, including padding */
+	uint32_t bytes_per_scan;
+	/** Enabled channels, in scan order */
+	struct iio_scan_channel ch[IIO_SCAN_MAX_CHANNELS];
+};
+
 struct iio_buffer {
 	/* Mask with active channels */
 	uint32_t active_mask;
@@ -212,11 +246,22 @@ struct iio_buffer {
 	struct no_os_circular_buffer *buf;
 	/* Stores cyclic buffer specific information */
 	struct iio_cyclic_buffer_info cyclic_info;
+	/* Position of the enabled channels in a scan */
+	const struct iio_scan_layout *layout;
 };
 
 struct iio_device_data {
 	void *dev;
 	struct iio_buffer *buffer;
+	/* Timestamp of the last trigger event, 0 if not available */
+	uint64_t timestamp;
+	/*
+	 * Sequence number of the trigger event being handled, shared by all
+	 * the devices sampled on it. The first of the events for batch handlers
+	 */
+	uint32_t sequence;
+	/* Set in pre_enable_buffer when the buffer is filled by a trigger */
+	bool triggered;
 };
 
 struct iio_trigger {
@@ -263,12 +308,19 @@ struct iio_device {
 	/* Bufer callbacks */
 	/** Called before enabling buffer */
 	int32_t (*pre_enable)(void *dev, uint32_t mask);
+	/** Called instead of pre_enable with the buffer being enabled, for
+	 *  devices sizing their resources by its number of samples */
+	int32_t (*pre_enable_buffer)(struct iio_device_data *dev);
 	/** Called after disabling buffer */
 	int32_t (*post_disable)(void *dev);
 	/** Called when buffer ready to transfer. Write/read to/from dev */
 	int32_t	(*submit)(struct iio_device_data *dev);
 	/** Called after a trigger signal has been received by iio */
 	int32_t (*trigger_handler)(struct iio_device_data *dev);
+	/** Called instead of trigger_handler for asynchronous triggers, once
+	 *  for all the trigger signals received since the previous call */
+	int32_t (*trigger_batch_handler)(struct iio_device_data *dev,
+					 uint32_t nb_events);
 
 	/* Read device register */
 	int32_t (*debug_reg_read)(void *dev, uint32_t reg, uint32_t *readval);
@@ -69,7 +69,9 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_ZPRINT]	= IIOD_STR("ZPRINT"),
+	[IIOD_CMD_XMLHASH]	= IIOD_STR("XMLHASH")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -81,6 +83,8 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_OPEN,
 	IIOD_CMD_CLOSE,
 	IIOD_CMD_PRINT,
+	IIOD_CMD_ZPRINT,
+	IIOD_CMD_XMLHASH,
 	IIOD_CMD_EXIT,
 	IIOD_CMD_TIMEOUT,
 	IIOD_CMD_VERSION,
@@ -239,6 +243,8 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_HELP:
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
+	case IIOD_CMD_ZPRINT:
+	case IIOD_CMD_XMLHASH:
 	case IIOD_CMD_VERSION:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
@@ -340,6 +346,10 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
 					     dummy_close);
+	/* Optional, read_buffer and send are used when missing */
+	ops->get_buffer_ref = new_ops->get_buffer_ref;
+	ops->send_buffer_ref = new_ops->send_buffer_ref;
+	ops->release_buffer_ref = new_ops->release_buffer_ref;
 
 	return 0;
 }
@@ -365,6 +375,9 @@ int32_t iiod_init(struct iiod_desc **desc, struct iiod_init_param *param)
 
 	ldesc->xml = param->xml;
 	ldesc->xml_len = param->xml_len;
+	ldesc->xml_zstd = param->xml_zstd;
+	ldesc->xml_zstd_len = param->xml_zstd_len;
+	ldesc->xml_hash = param->xml_hash;
 	ldesc->app_instance = param->instance;
 	ldesc->phy_type = param->phy_type;
 
@@ -420,6 +433,29 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 	return -EBUSY;
 }
 
+/*
+ * Release the part of the referenced READBUF data that was not queued on the
+ * connection. The queued part is released by the connection itself.
+ */
+static void iiod_release_buffer_ref(struct iiod_desc *desc,
+				    struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (!conn->buf_ref)
+		return;
+
+	if (conn->nb_buf.idx < conn->nb_buf.len &&
+	    desc->ops.release_buffer_ref)
+		desc->ops.release_buffer_ref(&ctx, conn->ref_device,
+					     conn->nb_buf.len -
+					     conn->nb_buf.idx);
+
+	conn->buf_ref = false;
+	conn->nb_buf.len = 0;
+	conn->nb_buf.idx = 0;
+}
+
 int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data)
 {
@@ -428,6 +464,7 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 		return -EINVAL;
 	struct iiod_conn_priv *conn;
 	conn = &desc->conns[conn_id];
+	iiod_release_buffer_ref(desc, conn);
 	data->conn = conn->conn;
 	data->len = conn->payload_buf_len;
 	data->buf = conn->payload_buf;
@@ -527,6 +564,56 @@ static int32_t do_read_buff_delayed(struct iiod_desc *desc,
 
 	conn->nb_buf.len = 0;
 	conn->nb_buf.idx = 0;
+	conn->buf_copy = false;
+
+	return 0;
+}
+
+/*
+ * Send the opened buffer data on the connection without copying it in
+ * payload_buf. The connection releases the data once it was sent.
+ * Falls back to do_read_buff_delayed for the rest of the command when the
+ * data can't be referenced (e.g. it is encoded while read).
+ */
+static int32_t do_read_buff_ref(struct iiod_desc *desc,
+				struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+	char *buf;
+
+	if (conn->nb_buf.idx == conn->nb_buf.len) {
+		ret = desc->ops.get_buffer_ref(&ctx, conn->cmd_data.device,
+					       &buf, conn->cmd_data.bytes_count);
+		if (ret == -EOPNOTSUPP) {
+			conn->buf_copy = true;
+			return do_read_buff_delayed(desc, conn);
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		conn->nb_buf.buf = buf;
+		conn->nb_buf.len = ret;
+		conn->nb_buf.idx = 0;
+		conn->buf_ref = true;
+		strcpy(conn->ref_device, conn->cmd_data.device);
+	}
+
+	ret = desc->ops.send_buffer_ref(&ctx, conn->cmd_data.device,
+					(uint8_t *)conn->nb_buf.buf +
+					conn->nb_buf.idx,
+					conn->nb_buf.len - conn->nb_buf.idx);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->nb_buf.idx += ret;
+	conn->cmd_data.bytes_count -= ret;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
+	conn->buf_ref = false;
+	conn->nb_buf.len = 0;
+	conn->nb_buf.idx = 0;
 
 	return 0;
 }
@@ -540,8 +627,13 @@ static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 	 * When using the network backend wait for a whole buffer to be filled
 	 * before sending in order to reduce the ammount of network traffic.
 	 */
-	if (desc->phy_type == USE_NETWORK)
+	if (desc->phy_type == USE_NETWORK) {
+		if (desc->ops.get_buffer_ref && desc->ops.send_buffer_ref &&
+		    !conn->buf_copy)
+			return do_read_buff_ref(desc, conn);
+
 		return do_read_buff_delayed(desc, conn);
+	}
 
 	ctx = (struct iiod_ctx)IIOD_CTX(desc, conn);
 	if (conn->nb_buf.len == 0) {
@@ -629,9 +721,11 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			if (data->cyclic)
 				conn->is_cyclic_buffer = true;
 		}
-		if (data->cmd == IIOD_CMD_CLOSE)
+		if (data->cmd == IIOD_CMD_CLOSE) {
 			/* Set is_cyclic_buffer to false every time the device is closed */
 			conn->is_cyclic_buffer = false;
+			iiod_release_buffer_ref(desc, conn);
+		}
 		conn->res.val = call_op(&desc->ops, data, &ctx);
 		conn->res.write_val = 1;
 		break;
@@ -643,9 +737,29 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	case IIOD_CMD_PRINT:
 		conn->res.val = desc->xml_len;
 		conn->res.write_val = 1;
-		conn->res.buf.buf = desc->xml;
+		conn->res.buf.buf = (char *)desc->xml;
 		conn->res.buf.len = desc->xml_len;
 		break;
+	case IIOD_CMD_ZPRINT:
+		conn->res.write_val = 1;
+		if (!desc->xml_zstd_len) {
+			conn->res.val = -ENOTSUP;
+			break;
+		}
+		conn->res.val = desc->xml_zstd_len;
+		conn->res.buf.buf = (char *)desc->xml_zstd;
+		conn->res.buf.len = desc->xml_zstd_len;
+		break;
+	case IIOD_CMD_XMLHASH:
+		conn->res.write_val = 1;
+		if (!desc->xml_hash) {
+			conn->res.val = -ENOTSUP;
+			break;
+		}
+		conn->res.val = strlen(desc->xml_hash);
+		conn->res.buf.buf = (char *)desc->xml_hash;
+		conn->res.buf.len = conn->res.val;
+		break;
 	case IIOD_CMD_VERSION:
 		conn->res.buf.buf = IIOD_VERSION;
 		conn->res.buf.len = IIOD_VERSION_LEN;
@@ -679,6 +793,9 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	case IIOD_CMD_READBUF:
 		conn->res.write_val = 1;
 		ret = desc->ops.refill_buffer(&ctx, data->device);
+		if (ret == -EAGAIN)
+			/* Previous data is still used by the connection */
+			return ret;
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			conn->res.val = ret;
 			break;
@@ -916,7 +1033,12 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 		ret = iiod_run_state(desc, conn);
 		if (ret == -EAGAIN)
 			return ret;
-		if (NO_OS_IS_ERR_VALUE(ret) || conn->state == IIOD_LINE_DONE)
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			/* An aborted READBUF won't send the rest of its data */
+			iiod_release_buffer_ref(desc, conn);
+			break;
+		}
+		if (conn->state == IIOD_LINE_DONE)
 			break;
 		//The loop will continue because the state was changed.
 	} while (true);
@@ -117,6 +117,27 @@ struct iiod_ops {
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
 
+	/*
+	 * Optional zero-copy alternative to read_buffer, used together with
+	 * send_buffer_ref.
+	 * get_buffer_ref sets buf to the data of the opened buffer and returns
+	 * the number of contiguous bytes available, at maximum bytes. The data
+	 * must stay valid until it is released by the connection.
+	 * send_buffer_ref queues len bytes from buf on the connection without
+	 * copying them. It returns the number of bytes queued, 0 if none
+	 * could be queued at the moment.
+	 * Both can return -EAGAIN when called too early.
+	 * release_buffer_ref releases the last len bytes returned by
+	 * get_buffer_ref when they won't be queued, because the connection
+	 * was dropped or the command aborted.
+	 */
+	int (*get_buffer_ref)(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes);
+	int (*send_buffer_ref)(struct iiod_ctx *ctx, const char *device,
+			       uint8_t *buf, uint32_t len);
+	void (*release_buffer_ref)(struct iiod_ctx *ctx, const char *device,
+				   uint32_t len);
+
 	/* Write data to opened buffer */
 	int (*write_buffer)(struct iiod_ctx *ctx, const char *device,
 			    const char *buf, uint32_t bytes);
@@ -165,9 +186,22 @@ struct iiod_init_param {
 	 * Xml description of the context and devices. It should exist until
 	 * iiod_remove is called
 	 */
-	char *xml;
+	const char *xml;
 	/* Size of xml in bytes */
 	uint32_t xml_len;
+	/*
+	 * Optional zstd compressed xml, sent on ZPRINT. Clients fall back to
+	 * PRINT when it is missing
+	 */
+	const uint8_t *xml_zstd;
+	/* Size of xml_zstd in bytes */
+	uint32_t xml_zstd_len;
+	/*
+	 * Optional string identifying the xml, sent on XMLHASH so a client can
+	 * skip PRINT when it already has this xml. XMLHASH is a no-OS extension
+	 * of the IIOD protocol, libiio clients don't send it
+	 */
+	const char *xml_hash;
 	/* Backend used by IIOD */
 	enum physical_link_type phy_type;
 };
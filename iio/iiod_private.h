@@ -56,6 +56,12 @@ struct iiod_str {
 /*
  * Commads are the ones documented int the link:
  * https://wiki.analog.com/resources/tools-software/linux-software/libiio_internals#the_network_backend_and_iio_daemon
+ *
+ * XMLHASH is not part of that protocol. It is a no-OS extension that libiio
+ * and the Linux iiod don't implement. It takes no arguments and is answered
+ * with the length of the hash followed by the hash, or with -ENOTSUP when no
+ * hash is set. Clients must not expect it from other IIOD servers and should
+ * fall back to PRINT when it fails.
  */
 enum iiod_cmd {
 	IIOD_CMD_HELP,
@@ -71,7 +77,11 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	/* zstd compressed PRINT, as sent by libiio clients built with zstd */
+	IIOD_CMD_ZPRINT,
+	/* no-OS extension, not in the libiio protocol: hash of the xml */
+	IIOD_CMD_XMLHASH
 };
 
 /*
@@ -157,6 +167,12 @@ struct iiod_conn_priv {
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+	/* True if READBUF data is copied in payload_buf instead of referenced */
+	bool buf_copy;
+	/* True while nb_buf holds data referenced with get_buffer_ref */
+	bool buf_ref;
+	/* Device the referenced data belongs to */
+	char ref_device[MAX_DEV_ID];
 };
 
 /* Private iiod information */
@@ -168,11 +184,20 @@ struct iiod_desc {
 	/* Application instance */
 	void *app_instance;
 	/* Address of xml */
-	char *xml;
+	const char *xml;
 	/* XML length in bytes */
 	uint32_t xml_len;
+	/* Address of the zstd compressed xml */
+	const uint8_t *xml_zstd;
+	/* Compressed XML length in bytes */
+	uint32_t xml_zstd_len;
+	/* Hash of the xml */
+	const char *xml_hash;
 	/* Backend used by IIOD */
 	enum physical_link_type phy_type;
 };
 
+/* Fill res with the command parsed from a line. buf is modified */
+int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx);
+
 #endif //IIOD_PRIVATE_H
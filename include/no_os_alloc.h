@@ -35,6 +35,73 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * Built-in allocator backend, selected at build time:
+ *  - NO_OS_ALLOC_POOL: no_os_malloc/no_os_calloc are served from size-class
+ *    pools carved out of a static heap of NO_OS_ALLOC_POOL_HEAP_SIZE bytes.
+ *    Freed blocks are kept in the free list of their class, so allocation
+ *    and deallocation take a bounded time and the heap does not fragment.
+ *  - NO_OS_ALLOC_STATS: per call-site allocation statistics are recorded.
+ * Without any of them no_os_malloc/no_os_calloc/no_os_free map to libc.
+ * Both are opt-in: the built-in backends serialize the calls on a no_os_mutex,
+ * which is free on bare metal but costs more than the libc fast path on
+ * hosted platforms where the mutex is a real one.
+ * Allocating from interrupt context is not supported by any backend.
+ */
+#if defined(NO_OS_ALLOC_POOL) || defined(NO_OS_ALLOC_STATS)
+#define NO_OS_ALLOC_BUILTIN
+#endif
+
+/* Size of the static heap used by the pool backend */
+#ifndef NO_OS_ALLOC_POOL_HEAP_SIZE
+#define NO_OS_ALLOC_POOL_HEAP_SIZE	16384
+#endif
+
+/*
+ * If set, requests that don't fit in a pool (too large or heap exhausted) are
+ * served by libc. If 0, they fail.
+ */
+#ifndef NO_OS_ALLOC_POOL_LIBC_FALLBACK
+#define NO_OS_ALLOC_POOL_LIBC_FALLBACK	1
+#endif
+
+/* Maximum number of call sites tracked by the statistics */
+#ifndef NO_OS_ALLOC_STATS_SITES
+#define NO_OS_ALLOC_STATS_SITES		64
+#endif
+
+/**
+ * @struct no_os_arena
+ * @brief Bump allocator over a caller provided memory region. Memory is only
+ * given back all at once, by resetting the arena.
+ */
+struct no_os_arena {
+	/** Start of the memory region */
+	uint8_t *buf;
+	/** Size of the memory region in bytes */
+	size_t size;
+	/** Number of bytes already handed out */
+	size_t used;
+};
+
+/**
+ * @struct no_os_alloc_stats
+ * @brief Allocation statistics of a call site.
+ */
+struct no_os_alloc_stats {
+	/** Return address of the no_os_malloc/no_os_calloc call */
+	void *site;
+	/** Number of allocations */
+	uint32_t count;
+	/** Total number of requested bytes */
+	uint32_t bytes;
+	/** Bytes currently allocated */
+	uint32_t in_use;
+	/** Highest value of in_use */
+	uint32_t peak;
+};
 
 /* Allocate memory and return a pointer to it */
 void *no_os_malloc(size_t size);
@@ -46,4 +113,22 @@ void *no_os_calloc(size_t nitems, size_t size);
  * no_os_malloc */
 void no_os_free(void *ptr);
 
+/* Initialize an arena over buf */
+int no_os_arena_init(struct no_os_arena *arena, void *buf, size_t size);
+/* Allocate size bytes from the arena */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size);
+/* Give back all the memory allocated from the arena */
+void no_os_arena_reset(struct no_os_arena *arena);
+
+/*
+ * Serve no_os_malloc/no_os_calloc from arena (e.g. during initialization)
+ * until called with NULL. no_os_free is a no-op for such allocations.
+ */
+int no_os_alloc_set_arena(struct no_os_arena *arena);
+
+/* Copy the statistics of at most max call sites and return their number */
+uint32_t no_os_alloc_get_stats(struct no_os_alloc_stats *stats, uint32_t max);
+/* Clear the allocation statistics */
+void no_os_alloc_reset_stats(void);
+
 #endif // _NO_OS_ALLOC_H_
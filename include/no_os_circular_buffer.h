@@ -36,6 +36,10 @@
 #define _NO_OS_CIRCULAR_BUFFER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/** Asynchronous writes that can be outstanding at once in SPSC mode */
+#define NO_OS_CB_ASYNC_WRITES	4
 
 /**
  * @struct no_os_cb_ptr
@@ -50,6 +54,24 @@ struct no_os_cb_ptr {
 	bool		async_started;
 	/** Number of bytes to update after an async transaction is finished */
 	uint32_t	async_size;
+	/**
+	 * SPSC mode: position in [0, 2 * size), only stored by the side
+	 * owning the pointer and published with release semantics.
+	 */
+	uint32_t	pos;
+};
+
+/**
+ * @struct no_os_cb_stats
+ * @brief Circular buffer statistics, updated by the writer
+ */
+struct no_os_cb_stats {
+	/** Largest number of bytes stored at once */
+	uint32_t	high_watermark;
+	/** Writes that overwrote unread data, or were refused in SPSC mode */
+	uint32_t	overruns;
+	/** Bytes overwritten, or refused in SPSC mode */
+	uint32_t	overrun_bytes;
 };
 
 /**
@@ -65,12 +87,31 @@ struct no_os_circular_buffer {
 	struct no_os_cb_ptr	write;
 	/** Read pointer */
 	struct no_os_cb_ptr	read;
+	/**
+	 * Set by no_os_cb_cfg_spsc. One writer and one reader, for example an
+	 * interrupt and the main loop, may then use the buffer concurrently.
+	 * Unread data is never overwritten.
+	 */
+	bool		spsc;
+	/** SPSC mode: end of the space reserved by asynchronous writes */
+	uint32_t	reserve_pos;
+	/** SPSC mode: sizes of the outstanding asynchronous writes */
+	uint32_t	async_sizes[NO_OS_CB_ASYNC_WRITES];
+	/** SPSC mode: oldest outstanding asynchronous write */
+	uint32_t	async_first;
+	/** SPSC mode: number of outstanding asynchronous writes */
+	uint32_t	async_nb;
+	/** Statistics */
+	struct no_os_cb_stats	stats;
 };
 
 int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t size);
 /* Configure cb structure with given parameters without memory allocation */
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buf,
 		     uint32_t size);
+/* Same as no_os_cb_cfg, for concurrent use by one writer and one reader */
+int32_t no_os_cb_cfg_spsc(struct no_os_circular_buffer *desc, int8_t *buf,
+			  uint32_t size);
 int32_t no_os_cb_remove(struct no_os_circular_buffer *desc);
 int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size);
 
@@ -91,4 +132,8 @@ int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
 				    uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc);
 
+int32_t no_os_cb_get_stats(struct no_os_circular_buffer *desc,
+			   struct no_os_cb_stats *stats);
+int32_t no_os_cb_reset_stats(struct no_os_circular_buffer *desc);
+
 #endif //_NO_OS_CIRCULAR_BUFFER_H_
@@ -94,6 +94,33 @@ enum no_os_irq_peripheral {
  */
 struct no_os_irq_platform_ops ;
 
+/*
+ * Number of entries of the callback dispatch table, as a power of 2. Callbacks
+ * registered after the table is full go to a slower overflow list.
+ */
+#ifndef NO_OS_IRQ_ACTIONS_ORDER
+#define NO_OS_IRQ_ACTIONS_ORDER	5
+#endif
+
+#define NO_OS_IRQ_ACTIONS_SIZE	(1u << NO_OS_IRQ_ACTIONS_ORDER)
+
+/**
+ * @struct no_os_irq_action
+ * @brief Entry of the callback dispatch table used by the platform interrupt
+ * handlers. Entries are looked up by (event, handle), where handle is the
+ * platform specific identifier of the interrupt source.
+ */
+struct no_os_irq_action {
+	/** Platform specific identifier of the interrupt source */
+	void *handle;
+	/** Callback to be called when the event occurs. NULL for free entries */
+	void (*callback)(void *context);
+	/** Parameter to be passed when the callback is called */
+	void *ctx;
+	/** Event that triggers the calling of the callback */
+	enum no_os_irq_event event;
+};
+
 /**
  * @struct no_os_irq_init_param
  * @brief Structure holding the initial parameters for Interrupt Request.
@@ -232,4 +259,18 @@ int no_os_irq_get_priority(struct no_os_irq_ctrl_desc *desc,
 /* Clear the pending interrupts */
 int no_os_irq_clear_pending(struct no_os_irq_ctrl_desc* desc,
 			    uint32_t irq_id);
+
+/* Add or update the callback of an (event, handle) pair */
+int no_os_irq_action_set(enum no_os_irq_event event, void *handle,
+			 void (*callback)(void *context), void *ctx);
+
+/* Remove the callback of an (event, handle) pair */
+int no_os_irq_action_clear(enum no_os_irq_event event, void *handle);
+
+/* Find the callback of an (event, handle) pair */
+struct no_os_irq_action *no_os_irq_action_get(enum no_os_irq_event event,
+		void *handle);
+
+/* Call the callback of an (event, handle) pair. To be used in interrupt context */
+int no_os_irq_action_dispatch(enum no_os_irq_event event, void *handle);
 #endif // _NO_OS_IRQ_H_
@@ -37,6 +37,9 @@
  *   read, get and delete functions. \n
  *   It also can be accesed using it member functions which wrapp function for
  *   usual list types.\n
+ *   The elements are allocated one by one by default. Lists created with
+ *   \ref no_os_list_init_ext can instead use an array of references or an
+ *   element embedded in the user data (\ref no_os_list_storage).\n
  *  @subsection example Sample code
  *   @code{.c}
  *	// -- Use a generic list
@@ -107,6 +110,21 @@ struct no_os_list_desc;
  */
 struct no_os_iterator;
 
+/**
+ * @struct no_os_list_elem
+ * @brief Format of each element of a linked list. With
+ * \ref NO_OS_LIST_STORAGE_INTRUSIVE it is embedded in the user data instead of
+ * being allocated by the list.
+ */
+struct no_os_list_elem {
+	/** User data */
+	void			*data;
+	/** Reference to previous element */
+	struct no_os_list_elem	*prev;
+	/** Reference to next element */
+	struct no_os_list_elem	*next;
+};
+
 /**
  * @brief Prototype of the compare function.
  *
@@ -212,7 +230,60 @@ enum no_os_adapter_type {
 	 *  - \e Back: Read the biggest element
 	 *  - \e Swap: Edit the lowest element
 	 */
-	NO_OS_LIST_PRIORITY_LIST
+	NO_OS_LIST_PRIORITY_LIST,
+	/**
+	 * Functions for a binary heap, ordered using the \ref f_cmp. Only the
+	 * lowest element is kept at index 0, the other indexes follow the
+	 * storage order. All the insertions keep the heap order.
+	 * Uses \ref NO_OS_LIST_STORAGE_ARRAY.
+	 *  - \e Push: Insert element
+	 *  - \e Pop: Get lowest element (Read and remove)
+	 *  - \e Top_next: Read lowest element
+	 *  - \e Back: Read the biggest element
+	 *  - \e Swap: Edit the lowest element
+	 */
+	NO_OS_LIST_PRIORITY_HEAP
+};
+
+/**
+ * @enum no_os_list_storage
+ * @brief Selects how the elements of the list are stored
+ */
+enum no_os_list_storage {
+	/** Double linked list, one element is allocated on each insertion */
+	NO_OS_LIST_STORAGE_NODES,
+	/**
+	 * Double linked list using the \ref no_os_list_elem embedded in the
+	 * inserted data, found at no_os_list_init_param.node_offset. Nothing
+	 * is allocated on insertion. The data can't be NULL and can be part of
+	 * a single list at a time.
+	 */
+	NO_OS_LIST_STORAGE_INTRUSIVE,
+	/**
+	 * Circular array of references, doubled when full. Operations on both
+	 * ends and reads by index are O(1).
+	 */
+	NO_OS_LIST_STORAGE_ARRAY,
+};
+
+/**
+ * @struct no_os_list_init_param
+ * @brief Parameters for \ref no_os_list_init_ext
+ */
+struct no_os_list_init_param {
+	/** Type of adapter to use */
+	enum no_os_adapter_type type;
+	/** Used to compare items. NULL for the default comparator */
+	f_cmp comparator;
+	/** Storage of the elements */
+	enum no_os_list_storage storage;
+	/** For NO_OS_LIST_STORAGE_INTRUSIVE: offset of the no_os_list_elem */
+	uint32_t node_offset;
+	/**
+	 * For NO_OS_LIST_STORAGE_ARRAY: number of elements allocated at
+	 * initialization, rounded up to a power of 2. 0 for the default.
+	 */
+	uint32_t capacity;
 };
 
 struct no_os_list_desc {
@@ -233,6 +304,8 @@ struct no_os_list_desc {
 int32_t no_os_list_init(struct no_os_list_desc **list_desc,
 			enum no_os_adapter_type type,
 			f_cmp comparator);
+int32_t no_os_list_init_ext(struct no_os_list_desc **list_desc,
+			    const struct no_os_list_init_param *param);
 int32_t no_os_list_remove(struct no_os_list_desc *list_desc);
 int32_t no_os_list_get_size(struct no_os_list_desc *list_desc,
 			    uint32_t *out_size);
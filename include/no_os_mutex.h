@@ -33,6 +33,8 @@
 #ifndef _NO_OS_MUTEX_H_
 #define _NO_OS_MUTEX_H_
 
+#include <stdint.h>
+
 /**
 * @brief Function for no-os mutex initialization and thread safety.
 * This function is implemented based on different platforms/OS libraries
@@ -75,4 +77,97 @@ void no_os_mutex_unlock(void *mutex);
 */
 void no_os_mutex_remove(void *mutex);
 
+#if defined(__linux__) || defined(_WIN32) || defined(__APPLE__)
+#define NO_OS_CRITICAL_MUTEX
+#elif defined(__MICROBLAZE__)
+#include "mb_interface.h"
+#elif defined(__nios2__)
+#include "sys/alt_irq.h"
+#elif !defined(__ARM_ARCH_PROFILE) && !defined(__aarch64__)
+#error "no_os_critical_enter() has no interrupt masking for this architecture"
+#endif
+
+/**
+ * @brief Enter a short critical section protecting data that is also used by
+ * completion callbacks, which may run in interrupt context. On bare-metal
+ * targets the interrupts of the CPU are masked, a mutex can't be taken by an
+ * interrupt handler. On hosted targets the completions run in threads and
+ * mutex is locked. The build fails for architectures without support.
+ * @param mutex - Mutex locked on hosted targets.
+ * @return State to pass to no_os_critical_exit().
+ */
+static inline uint32_t no_os_critical_enter(void *mutex)
+{
+#if defined(NO_OS_CRITICAL_MUTEX)
+	no_os_mutex_lock(mutex);
+
+	return 0;
+#elif defined(__MICROBLAZE__)
+	uint32_t msr;
+
+	(void)mutex;
+	msr = mfmsr();
+	microblaze_disable_interrupts();
+
+	return msr;
+#elif defined(__nios2__)
+	(void)mutex;
+
+	return alt_irq_disable_all();
+#elif defined(__aarch64__)
+	uint64_t daif;
+
+	(void)mutex;
+	__asm volatile ("mrs %0, daif\n\tmsr daifset, #2" : "=r" (daif) : :
+			"memory");
+
+	return (uint32_t)daif;
+#elif __ARM_ARCH_PROFILE == 'M'
+	uint32_t primask;
+
+	(void)mutex;
+	__asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) : :
+			"memory");
+
+	return primask;
+#else
+	uint32_t cpsr;
+
+	(void)mutex;
+	__asm volatile ("mrs %0, cpsr\n\tcpsid i" : "=r" (cpsr) : : "memory");
+
+	return cpsr;
+#endif
+}
+
+/**
+ * @brief Leave a critical section entered with no_os_critical_enter().
+ * @param mutex - Mutex passed to no_os_critical_enter().
+ * @param state - Value returned by no_os_critical_enter().
+ */
+static inline void no_os_critical_exit(void *mutex, uint32_t state)
+{
+#if defined(NO_OS_CRITICAL_MUTEX)
+	(void)state;
+	no_os_mutex_unlock(mutex);
+#elif defined(__MICROBLAZE__)
+	(void)mutex;
+	/* MSR[IE] */
+	if (state & 0x2)
+		microblaze_enable_interrupts();
+#elif defined(__nios2__)
+	(void)mutex;
+	alt_irq_enable_all(state);
+#elif defined(__aarch64__)
+	(void)mutex;
+	__asm volatile ("msr daif, %0" : : "r" ((uint64_t)state) : "memory");
+#elif __ARM_ARCH_PROFILE == 'M'
+	(void)mutex;
+	__asm volatile ("msr primask, %0" : : "r" (state) : "memory");
+#else
+	(void)mutex;
+	__asm volatile ("msr cpsr_c, %0" : : "r" (state) : "memory");
+#endif
+}
+
 #endif // _NO_OS_MUTEX_H_
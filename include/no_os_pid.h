@@ -76,4 +76,68 @@ int no_os_pid_hysteresis(struct no_os_pid *pid, unsigned int hyst);
 int no_os_pid_reset(struct no_os_pid *pid);
 int no_os_pid_remove(struct no_os_pid *pid);
 
+/** Default number of fractional bits of the fixed-point PID gains */
+#define NO_OS_PID_Q_DEFAULT	16
+
+/**
+ * @enum no_os_pid_anti_windup
+ * @brief Anti-windup strategy of the fixed-point PID loops
+ */
+enum no_os_pid_anti_windup {
+	/** The integrator is only limited to the i_clip range */
+	NO_OS_PID_ANTI_WINDUP_CLAMP,
+	/**
+	 * The integrator is also frozen while the output is saturated and the
+	 * error would drive it further into saturation
+	 */
+	NO_OS_PID_ANTI_WINDUP_CONDITIONAL,
+};
+
+/**
+ * @struct no_os_pid_bank_config
+ * @brief Configuration of a bank of independent fixed-point PID loops
+ */
+struct no_os_pid_bank_config {
+	/** Number of loops updated by no_os_pid_bank_update() */
+	uint32_t nb_loops;
+	/** Number of fractional bits (Q format) of the gains, 0 for the default */
+	uint8_t q;
+	/** Anti-windup strategy, common to all the loops */
+	enum no_os_pid_anti_windup anti_windup;
+};
+
+/**
+ * @struct no_os_pid_loop_config
+ * @brief Configuration of a single loop of a PID bank. The gains and the
+ * filter coefficient are in the Q format of the bank.
+ */
+struct no_os_pid_loop_config {
+	/** Proportional gain */
+	int32_t Kp;
+	/** Integral gain, applied once per update */
+	int32_t Ki;
+	/** Derivative gain, applied once per update */
+	int32_t Kd;
+	/**
+	 * (Optional) Coefficient of the low-pass filter applied to the derivative
+	 * component, in (0, 1]. 0 disables the filter.
+	 */
+	int32_t d_alpha;
+	/** (Optional) Boundary limits for integral component, in output units */
+	struct no_os_pid_range i_clip;
+	/** (Optional) Boundary limits for the output */
+	struct no_os_pid_range output_clip;
+};
+
+struct no_os_pid_bank;
+
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_bank_config *config);
+int no_os_pid_bank_set(struct no_os_pid_bank *bank, uint32_t loop,
+		       const struct no_os_pid_loop_config *config);
+int no_os_pid_bank_update(struct no_os_pid_bank *bank, const int32_t *SP,
+			  const int32_t *PV, int32_t *output);
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank);
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank);
+
 #endif
@@ -105,6 +105,43 @@ struct no_os_spi_msg {
 	uint32_t		cs_delay_last;
 };
 
+/**
+ * @struct no_os_spi_xfer
+ * @brief SPI transaction queued with no_os_spi_queue_submit(). The structure
+ * and the messages must be valid until the callback is invoked.
+ */
+struct no_os_spi_xfer {
+	/** SPI device the messages are sent to */
+	struct no_os_spi_desc	*desc;
+	/** Messages, transferred as by no_os_spi_transfer() */
+	struct no_os_spi_msg	*msgs;
+	/** Number of messages */
+	uint32_t		len;
+	/**
+	 * Transactions with a higher priority are started first. Transactions
+	 * with the same priority are started in the submission order.
+	 */
+	uint8_t			priority;
+	/**
+	 * Called once the transaction is done, with 0 or a negative error
+	 * code. May be invoked from an interrupt or from another thread,
+	 * depending on the platform. The transaction may be submitted again
+	 * from the callback.
+	 */
+	void			(*callback)(struct no_os_spi_xfer *, int32_t);
+	/** User specific data */
+	void			*ctx;
+	/**
+	 * Transaction started right after this one, before any other queued
+	 * transaction. It must be on the same bus and must not be submitted
+	 * separately. If this transaction fails, the chained ones are
+	 * completed with -ECANCELED.
+	 */
+	struct no_os_spi_xfer	*chain;
+	/** Next transaction in the bus queue. Used by the SPI API only */
+	struct no_os_spi_xfer	*next;
+};
+
 /**
  * @struct no_os_platform_spi_delays
  * @brief Delays resulted from components in the SPI signal path. The values is ns.
@@ -146,6 +183,11 @@ struct no_os_spi_init_param {
 	void		*extra;
 	/** Parent of the device */
 	struct no_os_spi_desc *parent;
+	/**
+	 * Start the queued transactions with transfer_dma_async, if the
+	 * platform has no transfer_async
+	 */
+	uint8_t		queue_dma;
 };
 
 /**
@@ -171,6 +213,12 @@ struct no_os_spibus_desc {
 	const struct no_os_spi_platform_ops *platform_ops;
 	/** SPI bus extra */
 	void		*extra;
+	/** Lock of the transaction queue, see no_os_critical_enter() */
+	void		*queue_mutex;
+	/** Transactions waiting for the bus, sorted by priority */
+	struct no_os_spi_xfer	*queue;
+	/** Transaction in progress, NULL if the queue is idle */
+	struct no_os_spi_xfer	*queue_active;
 };
 
 /**
@@ -200,6 +248,8 @@ struct no_os_spi_desc {
 	void		*extra;
 	/** Parent of the device */
 	struct no_os_spi_desc *parent;
+	/** Start the queued transactions with transfer_dma_async */
+	uint8_t		queue_dma;
 };
 
 /**
@@ -225,6 +275,12 @@ struct no_os_spi_platform_ops {
 	 */
 	int32_t (*transfer_dma_async)(struct no_os_spi_desc *, struct no_os_spi_msg *,
 				      uint32_t, void (*)(void *), void *);
+	/** Iterate over the spi_msg array and send all messages. Returns
+	 * immediately and invokes a callback with the result once all the
+	 * messages have been transfered. Used by the transaction queue.
+	 */
+	int32_t (*transfer_async)(struct no_os_spi_desc *, struct no_os_spi_msg *,
+				  uint32_t, void (*)(void *, int32_t), void *);
 	/** SPI remove function pointer */
 	int32_t (*remove)(struct no_os_spi_desc *);
 	/** SPI abort function pointer */
@@ -265,6 +321,12 @@ int32_t no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
 /* Abort SPI transfers. */
 int32_t no_os_spi_transfer_abort(struct no_os_spi_desc *desc);
 
+/* Queue a transaction on the SPI bus and invoke a callback when it is done. */
+int32_t no_os_spi_queue_submit(struct no_os_spi_xfer *xfer);
+
+/* Remove a transaction that wasn't started yet from the SPI bus queue. */
+int32_t no_os_spi_queue_cancel(struct no_os_spi_xfer *xfer);
+
 /* Initialize SPI bus descriptor*/
 int32_t no_os_spibus_init(const struct no_os_spi_init_param *param);
 
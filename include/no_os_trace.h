@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ *   @file   no_os_trace.h
+ *   @brief  Bus access tracing and latency histograms.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * The tracing layer is compiled in when NO_OS_TRACE is defined, with this
+ * file's source added to the project. The SPI, I2C and AXI IO accessors then
+ * time every synchronous access once tracing is started with a clock, and
+ * record it both in a ring of the latest events and in per-device counters
+ * with a latency histogram. Without NO_OS_TRACE the accessors are unchanged:
+ * NO_OS_TRACE_BEGIN() and NO_OS_TRACE_END() are then defined as no-ops by
+ * no_os_util.h, so the projects don't need this header.
+ *
+ * Recording is lock-free, so accesses may be traced from several threads or
+ * from interrupt context. The ring overwrites the oldest events and is read
+ * by a single consumer.
+ */
+
+#ifndef _NO_OS_TRACE_H_
+#define _NO_OS_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Number of events kept in the ring, power of 2 */
+#ifndef NO_OS_TRACE_EVENTS
+#define NO_OS_TRACE_EVENTS		256
+#endif
+
+/** Number of devices with their own counters */
+#ifndef NO_OS_TRACE_DEVICES
+#define NO_OS_TRACE_DEVICES		16
+#endif
+
+/** Latency histogram buckets: [0, 1us), [1, 2us), [2, 4us) ... [16ms, inf) */
+#define NO_OS_TRACE_HIST_BUCKETS	16
+
+/**
+ * @enum no_os_trace_bus
+ * @brief Bus of a traced access
+ */
+enum no_os_trace_bus {
+	NO_OS_TRACE_SPI,
+	NO_OS_TRACE_I2C,
+	NO_OS_TRACE_AXI,
+};
+
+/**
+ * @enum no_os_trace_op
+ * @brief Accessor of a traced access
+ */
+enum no_os_trace_op {
+	NO_OS_TRACE_WRITE_AND_READ,
+	NO_OS_TRACE_TRANSFER,
+	NO_OS_TRACE_TRANSFER_DMA,
+	NO_OS_TRACE_WRITE,
+	NO_OS_TRACE_READ,
+};
+
+/**
+ * @struct no_os_trace_event
+ * @brief One traced access
+ */
+struct no_os_trace_event {
+	/** Position of the event in the trace, plus one. 0 while written */
+	uint32_t seq;
+	/** Clock value when the access started, in ns */
+	uint64_t start_ns;
+	/** Duration of the access in ns, saturated */
+	uint32_t duration_ns;
+	/** Device on the bus: chip select, slave address or base address */
+	uint32_t dev;
+	/** Number of bytes transferred */
+	uint32_t bytes;
+	/** Value returned by the accessor */
+	int32_t ret;
+	/** Bus type, one of enum no_os_trace_bus */
+	uint8_t bus;
+	/** Bus number */
+	uint8_t bus_id;
+	/** Accessor, one of enum no_os_trace_op */
+	uint8_t op;
+};
+
+/**
+ * @struct no_os_trace_stats
+ * @brief Counters of one device, updated with relaxed atomics
+ */
+struct no_os_trace_stats {
+	/** Bus type, one of enum no_os_trace_bus */
+	uint8_t bus;
+	/** Bus number */
+	uint8_t bus_id;
+	/** Device on the bus */
+	uint32_t dev;
+	/** Number of accesses */
+	uint32_t count;
+	/** Number of accesses that returned an error */
+	uint32_t errors;
+	/** Number of bytes transferred */
+	uint32_t bytes;
+	/** Total time spent in accesses, in us */
+	uint32_t time_us;
+	/** Longest access, in ns */
+	uint32_t max_ns;
+	/** Accesses per latency bucket */
+	uint32_t hist[NO_OS_TRACE_HIST_BUCKETS];
+};
+
+/* Clear the recorded events and counters and start tracing. */
+int no_os_trace_start(uint64_t (*clock_ns)(void));
+
+/* Stop tracing, keeping what was recorded. */
+void no_os_trace_stop(void);
+
+/* Clear the recorded events and counters. */
+void no_os_trace_reset(void);
+
+/* Read the trace clock, 0 when tracing is stopped. */
+uint64_t no_os_trace_now(void);
+
+/* Read the trace clock before an access, false when tracing is stopped. */
+bool no_os_trace_begin(uint64_t *start);
+
+/* Record an access. */
+void no_os_trace_record(uint64_t start, enum no_os_trace_bus bus,
+			uint32_t bus_id, uint32_t dev, enum no_os_trace_op op,
+			uint32_t bytes, int32_t ret);
+
+/* Read the events recorded since the previous call, oldest first. */
+uint32_t no_os_trace_read_events(struct no_os_trace_event *events,
+				 uint32_t max, uint32_t *lost);
+
+/* Get a copy of the counters of a device. */
+int no_os_trace_get_stats(uint32_t idx, struct no_os_trace_stats *stats);
+
+/* Print the counters of all devices as text. */
+int no_os_trace_dump(char *buf, uint32_t len);
+
+#ifdef NO_OS_TRACE
+/*
+ * Time an access in the calling function. NO_OS_TRACE_BEGIN() declares the
+ * start time, so it is used once per function, before the access.
+ * NO_OS_TRACE_END() takes the no_os_trace_record() arguments after start.
+ */
+#define NO_OS_TRACE_BEGIN() \
+	uint64_t no_os_trace_start_ns; \
+	const bool no_os_trace_on = no_os_trace_begin(&no_os_trace_start_ns)
+
+#define NO_OS_TRACE_END(bus, bus_id, dev, op, bytes, ret) \
+	do { \
+		if (no_os_trace_on) \
+			no_os_trace_record(no_os_trace_start_ns, bus, bus_id, \
+					   dev, op, bytes, ret); \
+	} while (0)
+#endif
+
+#endif /* _NO_OS_TRACE_H_ */
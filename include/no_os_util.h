@@ -119,6 +119,12 @@
 
 #define NO_OS_CONTAINER_OF(ptr, type, name) ((type *)((char *)(ptr) - offsetof(type, name)))
 
+/* Access timing hooks, defined by no_os_trace.h when NO_OS_TRACE is set */
+#ifndef NO_OS_TRACE
+#define NO_OS_TRACE_BEGIN()	do {} while (0)
+#define NO_OS_TRACE_END(...)	do {} while (0)
+#endif
+
 /* Check if bit set */
 inline int no_os_test_bit(int pos, const volatile void * addr)
 {
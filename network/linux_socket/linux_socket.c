@@ -241,12 +241,20 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 				   uint32_t *client_socket_id)
 {
 	int32_t ret;
+	int one = 1;
 
 	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
 
 	if (ret < 0)
 		return -errno;
 
+	/*
+	 * Answers are usually sent in several small writes (e.g. IIOD READBUF
+	 * length, mask and data). Don't let Nagle's algorithm hold them back
+	 * until the peer's delayed ACK.
+	 */
+	setsockopt(ret, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
 	*client_socket_id = ret;
 
 	return 0;
@@ -421,6 +421,44 @@ int32_t no_os_lwip_remove(struct lwip_network_desc *desc)
 	return 0;
 }
 
+/**
+ * @brief Call the completion of the zero-copy sends that are no longer used.
+ * @param sock - lwip sockets layer specific descriptor.
+ * @param all - release all of them, not only the acknowledged ones.
+ */
+static void lwip_release_refs(struct lwip_socket_desc *sock, bool all)
+{
+	struct lwip_socket_ref *ref;
+
+	while (sock->ref_cnt) {
+		ref = &sock->refs[sock->ref_idx];
+		/* Wrap safe version of acked >= end */
+		if (!all && (int32_t)(sock->acked - ref->end) < 0)
+			break;
+
+		sock->ref_idx = (sock->ref_idx + 1) % NO_OS_LWIP_REF_QUEUE_SIZE;
+		sock->ref_cnt--;
+		ref->done(ref->ctx, ref->data, ref->len);
+	}
+}
+
+/**
+ * @brief Called when sent data is acknowledged by the remote.
+ * @param arg - lwip sockets layer specific descriptor.
+ * @param tpcb - unused.
+ * @param len - number of acknowledged bytes.
+ * @return ERR_OK
+ */
+static err_t lwip_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	struct lwip_socket_desc *sock = arg;
+
+	sock->acked += len;
+	lwip_release_refs(sock, false);
+
+	return ERR_OK;
+}
+
 /**
  * @brief Called in case of a lwip error. The pcb may have already been freed.
  * @param arg - lwip sockets layer specific descriptor.
@@ -431,6 +469,8 @@ static void lwip_err_callback(void *arg, err_t err)
 	struct lwip_socket_desc *socket = arg;
 
 	socket->state = SOCKET_CLOSED;
+	/* The pcb and the pbufs referencing the data are already freed */
+	lwip_release_refs(socket, true);
 }
 
 /**
@@ -456,9 +496,21 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 		pbuf_free(sock->p);
 	}
 
-	tcp_close(sock->pcb);
-	tcp_recv(sock->pcb, NULL);
-	tcp_err(sock->pcb, NULL);
+	tcp_sent(sock->pcb, NULL);
+	if (sock->ref_cnt) {
+		/*
+		 * A graceful close would keep sending the queued data after
+		 * the caller was told it is released.
+		 */
+		tcp_recv(sock->pcb, NULL);
+		tcp_err(sock->pcb, NULL);
+		tcp_abort(sock->pcb);
+		lwip_release_refs(sock, true);
+	} else {
+		tcp_close(sock->pcb);
+		tcp_recv(sock->pcb, NULL);
+		tcp_err(sock->pcb, NULL);
+	}
 
 	sock->p_idx = 0;
 	sock->pcb = NULL;
@@ -480,15 +532,18 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 				err_t err)
 {
 	struct lwip_socket_desc *sock = arg;
+	bool aborted;
 
 	/* The remote side has closed the connection. */
 	if (!p) {
 		tcp_recv(sock->pcb, NULL);
 		sock->state = SOCKET_CLOSED;
 
+		/* lwip_socket_close() aborts the pcb if data is referenced */
+		aborted = sock->ref_cnt != 0;
 		lwip_socket_close(sock->desc, sock->id);
 
-		return ERR_OK;
+		return aborted ? ERR_ABRT : ERR_OK;
 	}
 
 	if (err != ERR_OK) {
@@ -515,7 +570,13 @@ static void lwip_config_socket(struct lwip_socket_desc *desc)
 {
 	tcp_arg(desc->pcb, desc);
 	tcp_recv(desc->pcb, lwip_recv_callback);
+	tcp_sent(desc->pcb, lwip_sent_callback);
 	tcp_err(desc->pcb, lwip_err_callback);
+
+	desc->queued = 0;
+	desc->acked = 0;
+	desc->ref_idx = 0;
+	desc->ref_cnt = 0;
 }
 
 /**
@@ -598,6 +659,80 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 	err = tcp_write(sock->pcb, data, size, flags);
 	if (err != ERR_OK)
 		return err;
+	sock->queued += size;
+
+	if (!(flags & TCP_WRITE_FLAG_MORE)) {
+		/* Mark data as ready to be sent */
+		err = tcp_output(sock->pcb);
+		if (err != ERR_OK)
+			return err;
+	}
+
+	return size;
+}
+
+/**
+ * @brief Send a TCP packet without copying the data. lwIP references the data
+ * until it is acknowledged, done is called after that.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to send data through.
+ * @param data - pointer to the data array.
+ * @param size - size of data to be sent.
+ * @param done - called when data is no longer referenced.
+ * @param ctx - first parameter of done.
+ * @return number of queued bytes in the case of success, negative error code
+ * otherwise
+ */
+static int32_t lwip_socket_send_ref(void *net, uint32_t sock_id,
+				    const void *data, uint32_t size,
+				    void (*done)(void *ctx, const void *data,
+						 uint32_t size),
+				    void *ctx)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+	struct lwip_socket_ref *ref;
+	uint32_t avail;
+	uint32_t flags;
+	err_t err;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	/* Wait for the remote to acknowledge previous data */
+	if (sock->ref_cnt == NO_OS_LWIP_REF_QUEUE_SIZE)
+		return 0;
+
+	avail = tcp_sndbuf(sock->pcb);
+	if (!avail)
+		return 0;
+
+	flags = 0;
+	if (avail < size)
+		/* Partial write */
+		flags |= TCP_WRITE_FLAG_MORE;
+
+	size = no_os_min(avail, size);
+	err = tcp_write(sock->pcb, data, size, flags);
+	if (err == ERR_MEM)
+		/* Out of pbufs or segments until data is acknowledged */
+		return 0;
+	if (err != ERR_OK)
+		return err;
+	sock->queued += size;
+
+	ref = &sock->refs[(sock->ref_idx + sock->ref_cnt) %
+				NO_OS_LWIP_REF_QUEUE_SIZE];
+	ref->data = data;
+	ref->len = size;
+	ref->end = sock->queued;
+	ref->done = done;
+	ref->ctx = ctx;
+	sock->ref_cnt++;
 
 	if (!(flags & TCP_WRITE_FLAG_MORE)) {
 		/* Mark data as ready to be sent */
@@ -910,6 +1045,7 @@ struct network_interface lwip_socket_ops = {
 	.socket_bind = lwip_socket_bind,
 	.socket_listen = lwip_socket_listen,
 	.socket_accept = lwip_socket_accept,
+	.socket_send_ref = lwip_socket_send_ref,
 };
 
 /**
@@ -931,6 +1067,7 @@ static void lwip_config_if(struct lwip_network_desc *desc)
 	net->socket_bind = lwip_socket_bind;
 	net->socket_listen = lwip_socket_listen;
 	net->socket_accept = lwip_socket_accept;
+	net->socket_send_ref = lwip_socket_send_ref;
 
 	net->net = desc;
 }
@@ -48,12 +48,27 @@
 #define NO_OS_DOMAIN_NAME	"analog"
 #endif
 
+/* Maximum number of zero-copy sends waiting to be acknowledged per socket */
+#ifndef NO_OS_LWIP_REF_QUEUE_SIZE
+#define NO_OS_LWIP_REF_QUEUE_SIZE	8
+#endif
+
 #ifndef NO_OS_LWIP_INIT_ONETIME
 #define NO_OS_LWIP_INIT_ONETIME		0
 #endif
 
 struct lwip_network_desc;
 
+/* Data queued with socket_send_ref and not yet acknowledged */
+struct lwip_socket_ref {
+	const void *data;
+	uint32_t len;
+	/* Value of lwip_socket_desc.queued once data was queued */
+	uint32_t end;
+	void (*done)(void *ctx, const void *data, uint32_t len);
+	void *ctx;
+};
+
 struct lwip_socket_desc {
 	/* Unique identifier */
 	uint32_t id;
@@ -78,6 +93,16 @@ struct lwip_socket_desc {
 	uint32_t p_idx;
 	/* Reference to the parent network descriptor. */
 	struct lwip_network_desc *desc;
+	/* Bytes queued for sending since the connection was established */
+	uint32_t queued;
+	/* Bytes acknowledged by the remote since the connection was established */
+	uint32_t acked;
+	/* Zero-copy sends, in the order they were queued */
+	struct lwip_socket_ref refs[NO_OS_LWIP_REF_QUEUE_SIZE];
+	/* Index of the oldest entry in refs */
+	uint32_t ref_idx;
+	/* Number of entries in refs */
+	uint32_t ref_cnt;
 };
 
 struct lwip_network_desc {
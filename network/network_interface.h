@@ -204,6 +204,29 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Send data over a TCP socket without copying it. Optional.
+	 *
+	 * The data is referenced by the network stack until the remote host
+	 * acknowledges it or the connection is dropped. done is then called
+	 * with the queued part of data. Calls to done are made in the order
+	 * in which the data was queued.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param data - Buffer of data to send to the host
+	 * @param size - Size of the buffer in bytes
+	 * @param done - Called when data is no longer used
+	 * @param ctx - First parameter of done
+	 * @return
+	 *  - Number of queued bytes, it may be 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_send_ref)(void *net, uint32_t sock_id,
+				   const void *data, uint32_t size,
+				   void (*done)(void *ctx, const void *data,
+						uint32_t size),
+				   void *ctx);
 };
 
 #endif
@@ -368,6 +368,28 @@ int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 				      data, len);
 }
 
+/** @brief See \ref network_interface.socket_send_ref */
+int32_t socket_send_ref(struct tcp_socket_desc *desc, const void *data,
+			uint32_t len,
+			void (*done)(void *ctx, const void *data, uint32_t len),
+			void *ctx)
+{
+	if (!desc || !done)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	/* Data is encrypted into a separate buffer anyway */
+	if (desc->secure)
+		return -ENOSYS;
+#endif /* DISABLE_SECURE_SOCKET */
+
+	if (!desc->net->socket_send_ref)
+		return -ENOSYS;
+
+	return desc->net->socket_send_ref(desc->net->net, desc->id,
+					  data, len, done, ctx);
+}
+
 /** @brief See \ref network_interface.socket_recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 {
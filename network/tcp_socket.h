@@ -140,6 +140,12 @@ int32_t socket_disconnect(struct tcp_socket_desc *desc);
 int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 		    uint32_t len);
 
+/* Socket send without copying data. done is called when data is released */
+int32_t socket_send_ref(struct tcp_socket_desc *desc, const void *data,
+			uint32_t len,
+			void (*done)(void *ctx, const void *data, uint32_t len),
+			void *ctx);
+
 /* Socket recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len);
 
@@ -8,6 +8,8 @@ INCS += $(PROJECT)/src/examples/iio/iio_example.h
 INCS +=	$(DRIVERS)/adc/ad7616/iio_ad7616.h \
 		$(NO-OS)/iio/iio.h \
 		$(NO-OS)/iio/iiod.h \
+		$(NO-OS)/iio/iio_delta.h \
+		$(NO-OS)/iio/iio_filter.h \
 		$(NO-OS)/iio/iiod_private.h \
 		$(NO-OS)/iio/iio_types.h \
 		$(NO-OS)/iio/iio_app/iio_app.h
@@ -15,6 +17,8 @@ INCS +=	$(DRIVERS)/adc/ad7616/iio_ad7616.h \
 SRCS += $(DRIVERS)/adc/ad7616/iio_ad7616.c \
 		$(NO-OS)/iio/iio.c \
 		$(NO-OS)/iio/iiod.c \
+		$(NO-OS)/iio/iio_delta.c \
+		$(NO-OS)/iio/iio_filter.c \
 		$(NO-OS)/iio/iio_app/iio_app.c
 endif
 
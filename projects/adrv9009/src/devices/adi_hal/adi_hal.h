@@ -12,7 +12,9 @@
 /* include standard types and definitions */
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "no_os_util.h"
+#include "no_os_spi.h"
 
 #define u16 			uint16_t
 #define DIV_U64(x, y) no_os_div_u64(x, y)
@@ -24,6 +26,11 @@
  * Enums and structures
  *=======================================*/
 
+/* Size of the buffer holding the coalesced SPI transfers of an array access */
+#define HAL_SPI_STREAM_BUFFERSIZE	1024
+/* Maximum number of SPI transfers sent by one no_os_spi_transfer() call */
+#define HAL_SPI_STREAM_MAX_MSGS		32
+
 struct adi_hal {
 	struct no_os_gpio_desc	*gpio_adrv_resetb;
 	struct no_os_gpio_desc	*gpio_adrv_sysref_req;
@@ -33,6 +40,13 @@ struct adi_hal {
 	uint8_t			spi_adrv_csn;
 	void 			*extra_gpio;
 	uint8_t			gpio_adrv_resetb_num;
+	/* Set when the device accepts SPI streaming, snooped from CONFIG_B */
+	bool			spi_streaming;
+	/* Streaming address direction, snooped from CONFIG_A */
+	bool			spi_addr_ascending;
+	/* Coalesced register runs of ADIHAL_spiWriteBytes/ReadBytes */
+	uint8_t			*spi_buf;
+	struct no_os_spi_msg	*spi_msgs;
 };
 
 /**
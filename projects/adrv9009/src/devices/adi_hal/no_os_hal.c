@@ -32,12 +32,15 @@
 *******************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
 #include "adi_hal.h"
 #include "parameters.h"
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
 #ifndef ALTERA_PLATFORM
 #include "xilinx_spi.h"
 #include "xilinx_gpio.h"
@@ -46,6 +49,13 @@
 #include "altera_gpio.h"
 #endif
 
+#define ADIHAL_SPI_CONFIG_A		0x0000
+#define ADIHAL_SPI_CONFIG_B		0x0001
+#define ADIHAL_SPI_ADDR_ASCENSION	0x20
+#define ADIHAL_SPI_SINGLE_INSTRUCTION	0x80
+#define ADIHAL_SPI_READ			0x80
+#define ADIHAL_SPI_INSTR_LEN		2
+
 adiHalErr_t ADIHAL_setTimeout(void *devHalInfo, uint32_t halTimeout_ms)
 {
 	return ADIHAL_OK;
@@ -94,6 +104,16 @@ adiHalErr_t ADIHAL_openHw(void *devHalInfo, uint32_t halTimeout_ms)
 
 	status |= no_os_spi_init(&dev_hal_data->spi_adrv_desc, &spi_param);
 
+	/* Streaming is used once the device is configured for it */
+	dev_hal_data->spi_streaming = false;
+	dev_hal_data->spi_addr_ascending = false;
+	dev_hal_data->spi_buf = no_os_calloc(HAL_SPI_STREAM_BUFFERSIZE,
+					     sizeof(*dev_hal_data->spi_buf));
+	dev_hal_data->spi_msgs = no_os_calloc(HAL_SPI_STREAM_MAX_MSGS,
+					      sizeof(*dev_hal_data->spi_msgs));
+	if (!dev_hal_data->spi_buf || !dev_hal_data->spi_msgs)
+		status |= -ENOMEM;
+
 	status |= no_os_gpio_get(&dev_hal_data->gpio_adrv_sysref_req,
 				 &gpio_adrv_sysref_req_param);
 
@@ -114,6 +134,11 @@ adiHalErr_t ADIHAL_closeHw(void *devHalInfo)
 
 	status |= no_os_spi_remove(dev_hal_data->spi_adrv_desc);
 
+	no_os_free(dev_hal_data->spi_buf);
+	no_os_free(dev_hal_data->spi_msgs);
+	dev_hal_data->spi_buf = NULL;
+	dev_hal_data->spi_msgs = NULL;
+
 	if (status != 0)
 		return ADIHAL_ERR;
 	else
@@ -131,6 +156,10 @@ adiHalErr_t ADIHAL_resetHw(void *devHalInfo)
 	no_os_gpio_direction_output(devHalData->gpio_adrv_resetb, 1);
 	no_os_mdelay(10);
 
+	/* The SPI configuration is back to its default */
+	devHalData->spi_streaming = false;
+	devHalData->spi_addr_ascending = false;
+
 	return ADIHAL_OK;
 }
 
@@ -153,6 +182,140 @@ adiHalErr_t ADIHAL_sysrefReq(void *devHalInfo, sysrefReqMode_t mode)
 
 }
 
+/**
+ * @brief Track the SPI configuration written to the device, it tells if
+ * consecutive registers can be accessed by one streaming instruction.
+ * @param devHalData - HAL data of the device.
+ * @param addr - Register address.
+ * @param data - Written value.
+ */
+static void adi_hal_spi_snoop(struct adi_hal *devHalData, uint16_t addr,
+			      uint8_t data)
+{
+	if (addr == ADIHAL_SPI_CONFIG_A)
+		devHalData->spi_addr_ascending = !!(data & ADIHAL_SPI_ADDR_ASCENSION);
+	else if (addr == ADIHAL_SPI_CONFIG_B)
+		devHalData->spi_streaming = !(data & ADIHAL_SPI_SINGLE_INSTRUCTION);
+}
+
+/**
+ * @brief Get the number of registers, starting with addr[0], that can be
+ * accessed by one streaming instruction.
+ * @param devHalData - HAL data of the device.
+ * @param addr - Register addresses.
+ * @param count - Number of addresses.
+ * @return Length of the register run.
+ */
+static uint32_t adi_hal_spi_run(struct adi_hal *devHalData, uint16_t *addr,
+				uint32_t count)
+{
+	uint16_t step = devHalData->spi_addr_ascending ? 1 : -1;
+	uint32_t max = no_os_min(count, HAL_SPI_STREAM_BUFFERSIZE -
+				 ADIHAL_SPI_INSTR_LEN);
+	uint32_t run = 1;
+
+	/* A write to the SPI configuration changes how the next bytes are sent */
+	if (!devHalData->spi_streaming || addr[0] <= ADIHAL_SPI_CONFIG_B)
+		return 1;
+
+	while (run < max && addr[run] == (uint16_t)(addr[run - 1] + step) &&
+	       addr[run] > ADIHAL_SPI_CONFIG_B)
+		run++;
+
+	return run;
+}
+
+/**
+ * @brief Access an array of registers. Runs of consecutive registers are
+ * coalesced in one streaming instruction each and the instructions are sent
+ * by a few no_os_spi_transfer() calls.
+ * @param devHalData - HAL data of the device.
+ * @param addr - Register addresses.
+ * @param data - Values to write or read values.
+ * @param count - Number of registers.
+ * @param read - Set for reads.
+ * @return ADIHAL_OK in case of success, ADIHAL_SPI_FAIL otherwise.
+ */
+static adiHalErr_t adi_hal_spi_stream(struct adi_hal *devHalData,
+				      uint16_t *addr, uint8_t *data,
+				      uint32_t count, bool read)
+{
+	struct no_os_spi_msg *msgs = devHalData->spi_msgs;
+	uint8_t *buf = devHalData->spi_buf;
+	uint32_t nb_msgs = 0;
+	uint32_t first = 0;
+	uint32_t pos = 0;
+	uint32_t run;
+	uint32_t i = 0;
+	uint32_t j;
+	int32_t ret;
+
+	while (i < count) {
+		run = adi_hal_spi_run(devHalData, &addr[i], count - i);
+		if (pos + ADIHAL_SPI_INSTR_LEN + run > HAL_SPI_STREAM_BUFFERSIZE ||
+		    nb_msgs == HAL_SPI_STREAM_MAX_MSGS) {
+			ret = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs,
+						 nb_msgs);
+			if (ret)
+				return ADIHAL_SPI_FAIL;
+
+			for (j = 0; read && j < nb_msgs; j++) {
+				memcpy(&data[first],
+				       &msgs[j].rx_buff[ADIHAL_SPI_INSTR_LEN],
+				       msgs[j].bytes_number - ADIHAL_SPI_INSTR_LEN);
+				first += msgs[j].bytes_number - ADIHAL_SPI_INSTR_LEN;
+			}
+			nb_msgs = 0;
+			pos = 0;
+		}
+
+		buf[pos] = (addr[i] >> 8) & 0x7F;
+		if (read)
+			buf[pos] |= ADIHAL_SPI_READ;
+		buf[pos + 1] = addr[i] & 0xFF;
+		if (read)
+			memset(&buf[pos + ADIHAL_SPI_INSTR_LEN], 0, run);
+		else
+			memcpy(&buf[pos + ADIHAL_SPI_INSTR_LEN], &data[i], run);
+
+		msgs[nb_msgs].tx_buff = &buf[pos];
+		msgs[nb_msgs].rx_buff = &buf[pos];
+		msgs[nb_msgs].bytes_number = ADIHAL_SPI_INSTR_LEN + run;
+		msgs[nb_msgs].cs_change = 1;
+		nb_msgs++;
+		pos += ADIHAL_SPI_INSTR_LEN + run;
+
+		/* Next bytes are sent with the new configuration */
+		if (!read && addr[i] <= ADIHAL_SPI_CONFIG_B) {
+			ret = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs,
+						 nb_msgs);
+			if (ret)
+				return ADIHAL_SPI_FAIL;
+
+			adi_hal_spi_snoop(devHalData, addr[i], data[i]);
+			nb_msgs = 0;
+			pos = 0;
+		}
+
+		i += run;
+	}
+
+	if (!nb_msgs)
+		return ADIHAL_OK;
+
+	ret = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs, nb_msgs);
+	if (ret)
+		return ADIHAL_SPI_FAIL;
+
+	for (j = 0; read && j < nb_msgs; j++) {
+		memcpy(&data[first], &msgs[j].rx_buff[ADIHAL_SPI_INSTR_LEN],
+		       msgs[j].bytes_number - ADIHAL_SPI_INSTR_LEN);
+		first += msgs[j].bytes_number - ADIHAL_SPI_INSTR_LEN;
+	}
+
+	return ADIHAL_OK;
+}
+
 adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 				uint16_t addr, uint8_t data)
 {
@@ -167,23 +330,16 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 
 	if (status != 0)
 		return ADIHAL_SPI_FAIL;
-	else
-		return ADIHAL_OK;
+
+	adi_hal_spi_snoop(devHalData, addr, data);
+
+	return ADIHAL_OK;
 }
 
 adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 				 uint16_t *addr, uint8_t *data, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return adi_hal_spi_stream(devHalInfo, addr, data, count, false);
 }
 
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
@@ -210,16 +366,7 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return adi_hal_spi_stream(devHalInfo, addr, readdata, count, true);
 }
 
 adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
@@ -0,0 +1,107 @@
+CFLAGS += -DNO_OS_NETWORKING \
+	-DDISABLE_SECURE_SOCKET \
+	-DNO_OS_TRACE
+
+# Driver info messages would be interleaved with the JSON output
+CFLAGS += -DNO_OS_LOG_LEVEL=NO_OS_LOG_ERR
+
+LDFLAGS += -pthread
+
+LIB_FLAGS += -lm
+
+SRC_DIRS += $(PROJECT)/src
+
+SRCS += $(NO-OS)/util/no_os_alloc.c		\
+	$(NO-OS)/util/no_os_circular_buffer.c	\
+	$(NO-OS)/util/no_os_crc8.c		\
+	$(NO-OS)/util/no_os_crc16.c		\
+	$(NO-OS)/util/no_os_crc24.c		\
+	$(NO-OS)/util/no_os_fifo.c		\
+	$(NO-OS)/util/no_os_font_8x8.c		\
+	$(NO-OS)/util/no_os_lf256fifo.c		\
+	$(NO-OS)/util/no_os_list.c		\
+	$(NO-OS)/util/no_os_mutex.c		\
+	$(NO-OS)/util/no_os_pid.c		\
+	$(NO-OS)/util/no_os_trace.c		\
+	$(NO-OS)/util/no_os_util.c
+
+INCS += $(INCLUDE)/no_os_alloc.h		\
+	$(INCLUDE)/no_os_circular_buffer.h	\
+	$(INCLUDE)/no_os_crc8.h			\
+	$(INCLUDE)/no_os_crc16.h		\
+	$(INCLUDE)/no_os_crc24.h		\
+	$(INCLUDE)/no_os_error.h		\
+	$(INCLUDE)/no_os_fifo.h			\
+	$(INCLUDE)/no_os_gpio.h			\
+	$(INCLUDE)/no_os_i2c.h			\
+	$(INCLUDE)/no_os_irq.h			\
+	$(INCLUDE)/no_os_lf256fifo.h		\
+	$(INCLUDE)/no_os_list.h			\
+	$(INCLUDE)/no_os_mutex.h		\
+	$(INCLUDE)/no_os_pid.h			\
+	$(INCLUDE)/no_os_print_log.h	\
+	$(INCLUDE)/no_os_spi.h			\
+	$(INCLUDE)/no_os_trace.h		\
+	$(INCLUDE)/no_os_uart.h			\
+	$(INCLUDE)/no_os_util.h
+
+SRCS += $(NO-OS)/iio/iio.c			\
+	$(NO-OS)/iio/iiod.c			\
+	$(NO-OS)/iio/iio_delta.c			\
+	$(NO-OS)/iio/iio_filter.c			\
+	$(DRIVERS)/api/no_os_gpio.c		\
+	$(DRIVERS)/api/no_os_i2c.c		\
+	$(DRIVERS)/api/no_os_irq.c		\
+	$(DRIVERS)/api/no_os_spi.c		\
+	$(DRIVERS)/api/no_os_uart.c
+
+INCS += $(NO-OS)/iio/iio.h			\
+	$(NO-OS)/iio/iio_types.h		\
+	$(NO-OS)/iio/iiod.h			\
+	$(NO-OS)/iio/iio_delta.h			\
+	$(NO-OS)/iio/iio_filter.h			\
+	$(NO-OS)/iio/iiod_private.h
+
+SRCS += $(NO-OS)/network/linux_socket/linux_socket.c \
+	$(NO-OS)/network/tcp_socket.c
+
+INCS += $(NO-OS)/network/linux_socket/linux_socket.h \
+	$(NO-OS)/network/tcp_socket.h		\
+	$(NO-OS)/network/network_interface.h	\
+	$(NO-OS)/network/noos_mbedtls_config.h
+
+SRCS += $(DRIVERS)/platform/linux/linux_delay.c	\
+	$(DRIVERS)/platform/linux/linux_uart.c
+
+INCS += $(INCLUDE)/no_os_delay.h		\
+	$(DRIVERS)/platform/linux/linux_uart.h
+
+SRCS += $(DRIVERS)/adc/adc_demo/adc_demo.c	\
+	$(DRIVERS)/adc/adc_demo/iio_adc_demo.c
+
+INCS += $(DRIVERS)/adc/adc_demo/adc_demo.h	\
+	$(DRIVERS)/adc/adc_demo/iio_adc_demo.h
+
+SRCS += $(DRIVERS)/net/oa_tc6/oa_tc6.c
+
+INCS += $(DRIVERS)/net/oa_tc6/oa_tc6.h
+
+SRCS += $(DRIVERS)/accel/adxl355/adxl355.c	\
+	$(DRIVERS)/accel/adxl367/adxl367.c
+
+INCS += $(DRIVERS)/accel/adxl355/adxl355.h	\
+	$(DRIVERS)/accel/adxl367/adxl367.h
+
+SRCS += $(DRIVERS)/adc/ad7124/ad7124.c	\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.c	\
+	$(DRIVERS)/adc/ad7124/iio_ad7124.c
+
+INCS += $(DRIVERS)/adc/ad7124/ad7124.h	\
+	$(DRIVERS)/adc/ad7124/ad7124_regs.h	\
+	$(DRIVERS)/adc/ad7124/iio_ad7124.h
+
+SRCS += $(DRIVERS)/display/display.c	\
+	$(DRIVERS)/display/ssd_1306/ssd_1306.c
+
+INCS += $(DRIVERS)/display/display.h	\
+	$(DRIVERS)/display/ssd_1306/ssd_1306.h
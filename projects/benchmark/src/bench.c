@@ -0,0 +1,241 @@
+/***************************************************************************//**
+ *   @file   bench.c
+ *   @brief  Host-side microbenchmark harness for no-OS utilities.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/* Default minimum duration of a measurement */
+#define BENCH_DEFAULT_MIN_TIME_MS	200
+/* Upper bound for the number of operations of a single measurement */
+#define BENCH_MAX_OPS			(1u << 30)
+
+#ifndef NO_OS_ALLOC_BUILTIN
+static uint64_t bench_allocs;
+
+/*
+ * The weak no_os_malloc/no_os_calloc/no_os_free from util/no_os_alloc.c are
+ * overridden in order to count the allocations done by the measured code.
+ */
+void *no_os_malloc(size_t size)
+{
+	__atomic_add_fetch(&bench_allocs, 1, __ATOMIC_RELAXED);
+
+	return malloc(size);
+}
+
+void *no_os_calloc(size_t nitems, size_t size)
+{
+	__atomic_add_fetch(&bench_allocs, 1, __ATOMIC_RELAXED);
+
+	return calloc(nitems, size);
+}
+
+void no_os_free(void *ptr)
+{
+	free(ptr);
+}
+
+/**
+ * @brief Get the number of allocations done since program start.
+ * @return Allocation count.
+ */
+uint64_t bench_alloc_count(void)
+{
+	return __atomic_load_n(&bench_allocs, __ATOMIC_RELAXED);
+}
+#else
+/**
+ * @brief Get the number of allocations recorded by the built-in allocator.
+ * Always 0 unless NO_OS_ALLOC_STATS is enabled.
+ * @return Allocation count.
+ */
+uint64_t bench_alloc_count(void)
+{
+	struct no_os_alloc_stats stats[NO_OS_ALLOC_STATS_SITES];
+	uint64_t count = 0;
+	uint32_t i, nb;
+
+	nb = no_os_alloc_get_stats(stats, NO_OS_ARRAY_SIZE(stats));
+	for (i = 0; i < nb; i++)
+		count += stats[i].count;
+
+	return count;
+}
+#endif
+
+/**
+ * @brief Get a monotonic timestamp.
+ * @return Time in nanoseconds.
+ */
+uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint64_t bench_min_time_ns(void)
+{
+	const char *env = getenv("BENCH_MIN_TIME_MS");
+	unsigned long ms = BENCH_DEFAULT_MIN_TIME_MS;
+
+	if (env && strtoul(env, NULL, 10))
+		ms = strtoul(env, NULL, 10);
+
+	return (uint64_t)ms * 1000000ull;
+}
+
+static int bench_measure(const struct bench_case *bc, void *ctx, uint32_t ops,
+			 struct bench_result *res)
+{
+	uint64_t start, allocs;
+	int ret;
+
+	allocs = bench_alloc_count();
+	start = bench_now_ns();
+	ret = bc->run(ctx, ops);
+	res->ns = bench_now_ns() - start;
+	res->allocs = bench_alloc_count() - allocs;
+	res->ops = ops;
+
+	return ret;
+}
+
+static void bench_print(const struct bench_case *bc,
+			const struct bench_result *res)
+{
+	double ns_per_op = (double)res->ns / res->ops;
+	double mb_per_s = 0;
+
+	if (bc->bytes_per_op && res->ns)
+		mb_per_s = (double)bc->bytes_per_op * res->ops * 1000.0 / res->ns;
+
+	printf("{\"name\":\"%s\",\"ops\":%llu,\"ns_per_op\":%.2f,"
+	       "\"mb_per_s\":%.2f,\"allocs_per_op\":%.3f}\n",
+	       bc->name, (unsigned long long)res->ops, ns_per_op, mb_per_s,
+	       (double)res->allocs / res->ops);
+	fflush(stdout);
+}
+
+/**
+ * @brief Calibrate, run and print the result of a benchmark.
+ *
+ * The number of operations is doubled until a run takes a significant
+ * fraction of the minimum measurement time (BENCH_MIN_TIME_MS environment
+ * variable, 200ms by default) and then scaled to cover it.
+ *
+ * @param bc  - Benchmark description.
+ * @param res - Where to store the measurement. May be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int bench_run(const struct bench_case *bc, struct bench_result *res)
+{
+	struct bench_result lres;
+	uint64_t target, ops;
+	void *ctx;
+	int ret;
+
+	if (!bc || !bc->run)
+		return -EINVAL;
+
+	ctx = (void *)bc->arg;
+	if (bc->setup) {
+		ret = bc->setup(&ctx);
+		if (ret)
+			return ret;
+	}
+
+	target = bench_min_time_ns();
+	ops = 1;
+	do {
+		ret = bench_measure(bc, ctx, ops, &lres);
+		if (ret)
+			goto teardown;
+		if (lres.ns >= target / 8 || ops >= BENCH_MAX_OPS)
+			break;
+		ops *= 2;
+	} while (true);
+
+	if (lres.ns < target) {
+		ops = lres.ns ? ops * target / lres.ns : BENCH_MAX_OPS;
+		ops = no_os_min(ops, BENCH_MAX_OPS);
+		ret = bench_measure(bc, ctx, ops, &lres);
+		if (ret)
+			goto teardown;
+	}
+
+	bench_print(bc, &lres);
+	if (res)
+		*res = lres;
+
+teardown:
+	if (bc->teardown)
+		bc->teardown(ctx);
+
+	if (ret)
+		fprintf(stderr, "%s failed: %d\n", bc->name, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Run a table of benchmarks.
+ * @param cases    - Benchmark table.
+ * @param nb_cases - Number of entries in the table.
+ * @param filter   - Only names containing this string are run. NULL for all.
+ * @return 0 if all benchmarks succeeded, the last error otherwise.
+ */
+int bench_run_all(const struct bench_case *cases, uint32_t nb_cases,
+		  const char *filter)
+{
+	uint32_t i;
+	int ret = 0;
+	int err;
+
+	for (i = 0; i < nb_cases; i++) {
+		if (filter && !strstr(cases[i].name, filter))
+			continue;
+
+		err = bench_run(&cases[i], NULL);
+		if (err)
+			ret = err;
+	}
+
+	return ret;
+}
@@ -0,0 +1,104 @@
+/***************************************************************************//**
+ *   @file   bench.h
+ *   @brief  Host-side microbenchmark harness for no-OS utilities.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iio_types.h"
+
+/**
+ * @struct bench_case
+ * @brief Describes a single benchmark. One operation is whatever run() does
+ * for one iteration, the harness reports the cost of a single operation.
+ */
+struct bench_case {
+	/** Unique name, printed in the results */
+	const char *name;
+	/** Payload bytes processed by one operation. 0 if not meaningful */
+	uint32_t bytes_per_op;
+	/** Initial value of the context passed to setup() and run() */
+	const void *arg;
+	/** Optional. Allocate the benchmark context */
+	int (*setup)(void **ctx);
+	/** Execute nb_ops operations */
+	int (*run)(void *ctx, uint32_t nb_ops);
+	/** Optional. Free the benchmark context */
+	void (*teardown)(void *ctx);
+};
+
+/**
+ * @struct bench_result
+ * @brief Measurements of a benchmark run.
+ */
+struct bench_result {
+	/** Number of measured operations */
+	uint64_t ops;
+	/** Total measured time in nanoseconds */
+	uint64_t ns;
+	/** Number of no_os_malloc/no_os_calloc calls during the measurement */
+	uint64_t allocs;
+};
+
+/* Monotonic time in nanoseconds. */
+uint64_t bench_now_ns(void);
+/* Number of no_os_malloc/no_os_calloc calls since program start. */
+uint64_t bench_alloc_count(void);
+/* Run a benchmark and print its result. */
+int bench_run(const struct bench_case *bc, struct bench_result *res);
+/* Run every benchmark whose name contains filter (all if filter is NULL). */
+int bench_run_all(const struct bench_case *cases, uint32_t nb_cases,
+		  const char *filter);
+
+/* libc based iio_format_value/iio_parse_value, used as reference. */
+int iio_format_value_ref(char *buf, uint32_t len, enum iio_val fmt,
+			 int32_t size, int32_t *vals);
+int32_t iio_parse_value_ref(char *buf, enum iio_val fmt, int32_t *val,
+			    int32_t *val2);
+
+/* Benchmark tables, one per area. */
+extern const struct bench_case bench_util_cases[];
+extern const uint32_t bench_util_nb_cases;
+extern const struct bench_case bench_iio_cases[];
+extern const uint32_t bench_iio_nb_cases;
+extern const struct bench_case bench_net_cases[];
+extern const uint32_t bench_net_nb_cases;
+extern const struct bench_case bench_accel_cases[];
+extern const uint32_t bench_accel_nb_cases;
+extern const struct bench_case bench_spi_cases[];
+extern const uint32_t bench_spi_nb_cases;
+extern const struct bench_case bench_adc_cases[];
+extern const uint32_t bench_adc_nb_cases;
+extern const struct bench_case bench_display_cases[];
+extern const uint32_t bench_display_nb_cases;
+
+#endif /* __BENCH_H__ */
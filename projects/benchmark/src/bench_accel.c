@@ -0,0 +1,521 @@
+/***************************************************************************//**
+ *   @file   bench_accel.c
+ *   @brief  Benchmarks for the ADXL355 and ADXL367 FIFO readers on simulated
+ *           devices.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "adxl355.h"
+#include "adxl367.h"
+
+#define ADXL355_SIM_ENTRIES	96
+#define ADXL367_SIM_ENTRIES	510
+
+/**
+ * @struct accel_sim
+ * @brief Simulated accelerometer FIFO. Entry k of the stream holds the
+ * value k of axis k % 3, so a decoded scan must hold 3 consecutive values
+ * and consecutive scans must follow each other.
+ */
+struct accel_sim {
+	bool adxl367;
+	/* Index of the next entry of the stream */
+	uint32_t next;
+	/* Number of entries in the FIFO */
+	uint32_t entries;
+	/* Entries added to the FIFO before each FIFO_ENTRIES read, 0 if full */
+	const uint8_t *pattern;
+	uint32_t pattern_len;
+	uint32_t pattern_idx;
+};
+
+static struct accel_sim accel_sim;
+
+/* Entries added before each read, not a multiple of the scan size */
+static const uint8_t accel_sim_pattern[] = {
+	95, 7, 1, 2, 50, 64, 4, 96, 31
+};
+
+static void accel_sim_fill(struct accel_sim *sim, uint32_t max)
+{
+	if (!sim->pattern) {
+		sim->entries = max;
+		return;
+	}
+
+	sim->entries += sim->pattern[sim->pattern_idx++ % sim->pattern_len];
+	sim->entries = no_os_min(sim->entries, max);
+}
+
+static void adxl355_sim_xfer(struct accel_sim *sim, uint8_t *buf,
+			     uint32_t len)
+{
+	uint8_t addr = buf[0] >> 1;
+	uint32_t val;
+	uint32_t i;
+
+	if (buf[0] & ADXL355_SPI_READ)
+		memset(&buf[1], 0, len - 1);
+	else
+		return;
+
+	switch (addr) {
+	case ADXL355_ADDR(ADXL355_DEVID_AD):
+		buf[1] = GET_ADXL355_RESET_VAL(ADXL355_DEVID_AD);
+		break;
+	case ADXL355_ADDR(ADXL355_DEVID_MST):
+		buf[1] = GET_ADXL355_RESET_VAL(ADXL355_DEVID_MST);
+		break;
+	case ADXL355_ADDR(ADXL355_PARTID):
+		buf[1] = GET_ADXL355_RESET_VAL(ADXL355_PARTID);
+		break;
+	case ADXL355_ADDR(ADXL355_FIFO_ENTRIES):
+		accel_sim_fill(sim, ADXL355_SIM_ENTRIES);
+		buf[1] = sim->entries;
+		break;
+	case ADXL355_ADDR(ADXL355_FIFO_DATA):
+		for (i = 1; i + 3 <= len; i += 3) {
+			if (!sim->entries) {
+				/* Empty indicator */
+				buf[i + 2] = NO_OS_BIT(1);
+				continue;
+			}
+
+			val = (sim->next & 0xFFFFF) << 4;
+			if (sim->next % 3 == 0)
+				/* X-axis marker */
+				val |= NO_OS_BIT(0);
+			no_os_put_unaligned_be24(val, &buf[i]);
+			sim->next++;
+			sim->entries--;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void adxl367_sim_xfer(struct accel_sim *sim, uint8_t *buf,
+			     uint32_t len)
+{
+	uint16_t val;
+	uint32_t i;
+
+	switch (buf[0]) {
+	case ADXL367_READ_REG:
+		memset(&buf[2], 0, len - 2);
+		for (i = 2; i < len; i++) {
+			switch (buf[1] + i - 2) {
+			case ADXL367_REG_DEVID_AD:
+				buf[i] = ADXL367_DEVICE_AD;
+				break;
+			case ADXL367_REG_DEVID_MST:
+				buf[i] = ADXL367_DEVICE_MST;
+				break;
+			case ADXL367_REG_PARTID:
+				buf[i] = ADXL367_PART_ID;
+				break;
+			case ADXL367_REG_FIFO_ENTRIES_L:
+				accel_sim_fill(sim, ADXL367_SIM_ENTRIES);
+				buf[i] = sim->entries & 0xFF;
+				break;
+			case ADXL367_REG_FIFO_ENTRIES_H:
+				buf[i] = sim->entries >> 8;
+				break;
+			default:
+				break;
+			}
+		}
+		break;
+	case ADXL367_READ_FIFO:
+		for (i = 1; i + 2 <= len && sim->entries; i += 2) {
+			/* Channel ID and 14-bit value */
+			val = (sim->next % 3) << 14 | (sim->next & 0x3FFF);
+			no_os_put_unaligned_be16(val, &buf[i]);
+			sim->next++;
+			sim->entries--;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static int32_t accel_sim_spi_init(struct no_os_spi_desc **desc,
+				  const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int32_t accel_sim_spi_write_and_read(struct no_os_spi_desc *desc,
+		uint8_t *data, uint16_t bytes_number)
+{
+	struct accel_sim *sim = desc->extra;
+
+	if (sim->adxl367)
+		adxl367_sim_xfer(sim, data, bytes_number);
+	else
+		adxl355_sim_xfer(sim, data, bytes_number);
+
+	return 0;
+}
+
+static int32_t accel_sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops accel_sim_spi_ops = {
+	.init = accel_sim_spi_init,
+	.write_and_read = accel_sim_spi_write_and_read,
+	.remove = accel_sim_spi_remove,
+};
+
+static void accel_sim_reset(bool adxl367, uint32_t first, bool pattern)
+{
+	memset(&accel_sim, 0, sizeof(accel_sim));
+	accel_sim.adxl367 = adxl367;
+	accel_sim.next = first;
+	if (pattern) {
+		accel_sim.pattern = accel_sim_pattern;
+		accel_sim.pattern_len = NO_OS_ARRAY_SIZE(accel_sim_pattern);
+	}
+}
+
+/**
+ * @struct accel_bench
+ * @brief Context of the accelerometer benchmarks.
+ */
+struct accel_bench {
+	struct adxl355_dev *adxl355;
+	struct adxl367_dev *adxl367;
+	/* First value of the next scan, -1 before the first scan */
+	int64_t expected;
+	uint32_t raw[3][ADXL355_SIM_ENTRIES];
+	int16_t raw16[4][ADXL367_SIM_ENTRIES + 1];
+	int32_t scans[ADXL355_FIFO_MAX_SCANS * 3];
+	int16_t scans16[ADXL367_FIFO_MAX_ENTRIES];
+};
+
+static int adxl355_bench_setup(void **ctx, uint32_t first, bool pattern)
+{
+	struct adxl355_init_param ip = {
+		.comm_init.spi_init = {
+			.platform_ops = &accel_sim_spi_ops,
+			.extra = &accel_sim,
+		},
+		.comm_type = ADXL355_SPI_COMM,
+		.dev_type = ID_ADXL355,
+	};
+	struct accel_bench *bench;
+	int ret;
+
+	accel_sim_reset(false, first, pattern);
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	ret = adxl355_init(&bench->adxl355, ip);
+	if (ret) {
+		no_os_free(bench);
+		return ret;
+	}
+
+	bench->expected = -1;
+	*ctx = bench;
+
+	return 0;
+}
+
+static int adxl355_bench_setup_full(void **ctx)
+{
+	return adxl355_bench_setup(ctx, 0, false);
+}
+
+static int adxl355_bench_setup_misaligned(void **ctx)
+{
+	/* The first entry in the FIFO is a Y-axis sample */
+	return adxl355_bench_setup(ctx, 1, true);
+}
+
+static void adxl355_bench_teardown(void *ctx)
+{
+	struct accel_bench *bench = ctx;
+
+	adxl355_remove(bench->adxl355);
+	no_os_free(bench);
+}
+
+/* Check that scans are made of consecutive values and follow each other. */
+static int accel_bench_check(struct accel_bench *bench, int64_t x, int64_t y,
+			     int64_t z, uint32_t mask)
+{
+	if (((x + 1) & mask) != y || ((x + 2) & mask) != z)
+		return -EILSEQ;
+
+	if (bench->expected >= 0 && x != bench->expected)
+		return -EILSEQ;
+
+	bench->expected = (x + 3) & mask;
+
+	return 0;
+}
+
+static int adxl355_bench_raw(void *ctx, uint32_t nb_ops)
+{
+	struct accel_bench *bench = ctx;
+	uint8_t entries;
+	uint32_t i, j;
+	int ret;
+
+	for (i = 0; i < nb_ops; i++) {
+		ret = adxl355_get_raw_fifo_data(bench->adxl355, &entries,
+						bench->raw[0], bench->raw[1],
+						bench->raw[2]);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < entries / 3; j++) {
+			ret = accel_bench_check(bench, bench->raw[0][j],
+						bench->raw[1][j], bench->raw[2][j],
+						0xFFFFF);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int adxl355_bench_scans(void *ctx, uint32_t nb_ops)
+{
+	struct accel_bench *bench = ctx;
+	uint16_t nb_scans;
+	uint32_t i, j;
+	int32_t *scan;
+	int ret;
+
+	for (i = 0; i < nb_ops; i++) {
+		ret = adxl355_read_fifo_scans(bench->adxl355, bench->scans,
+					      ADXL355_FIFO_MAX_SCANS, &nb_scans);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < nb_scans; j++) {
+			scan = &bench->scans[j * 3];
+			ret = accel_bench_check(bench, scan[0] & 0xFFFFF,
+						scan[1] & 0xFFFFF, scan[2] & 0xFFFFF,
+						0xFFFFF);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int adxl367_bench_setup(void **ctx, uint32_t first, bool pattern)
+{
+	struct adxl367_init_param ip = {
+		.comm_type = ADXL367_SPI_COMM,
+		.spi_init = {
+			.platform_ops = &accel_sim_spi_ops,
+			.extra = &accel_sim,
+		},
+	};
+	struct accel_bench *bench;
+	int ret;
+
+	accel_sim_reset(true, first, pattern);
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	ret = adxl367_init(&bench->adxl367, ip);
+	if (ret)
+		goto free_bench;
+
+	ret = adxl367_fifo_setup(bench->adxl367, ADXL367_STREAM_MODE,
+				 ADXL367_FIFO_FORMAT_XYZ, 0x80);
+	if (ret)
+		goto remove;
+
+	bench->expected = -1;
+	*ctx = bench;
+
+	return 0;
+
+remove:
+	adxl367_remove(bench->adxl367);
+free_bench:
+	no_os_free(bench);
+
+	return ret;
+}
+
+static int adxl367_bench_setup_full(void **ctx)
+{
+	return adxl367_bench_setup(ctx, 0, false);
+}
+
+static int adxl367_bench_setup_misaligned(void **ctx)
+{
+	/* The first entry in the FIFO is a Y-axis sample */
+	return adxl367_bench_setup(ctx, 1, true);
+}
+
+static void adxl367_bench_teardown(void *ctx)
+{
+	struct accel_bench *bench = ctx;
+
+	adxl367_remove(bench->adxl367);
+	no_os_free(bench);
+}
+
+static int adxl367_bench_raw(void *ctx, uint32_t nb_ops)
+{
+	struct accel_bench *bench = ctx;
+	uint16_t entries;
+	uint32_t i, j;
+	int ret;
+
+	for (i = 0; i < nb_ops; i++) {
+		ret = adxl367_read_raw_fifo(bench->adxl367, bench->raw16[0],
+					    bench->raw16[1], bench->raw16[2],
+					    bench->raw16[3], &entries);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < entries / 3; j++) {
+			ret = accel_bench_check(bench,
+						bench->raw16[0][j] & 0x3FFF,
+						bench->raw16[1][j] & 0x3FFF,
+						bench->raw16[2][j] & 0x3FFF,
+						0x3FFF);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int adxl367_bench_scans(void *ctx, uint32_t nb_ops)
+{
+	struct accel_bench *bench = ctx;
+	uint16_t nb_scans;
+	uint32_t i, j;
+	int16_t *scan;
+	int ret;
+
+	for (i = 0; i < nb_ops; i++) {
+		ret = adxl367_read_fifo_scans(bench->adxl367, bench->scans16,
+					      ADXL367_FIFO_MAX_ENTRIES / 3,
+					      &nb_scans);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < nb_scans; j++) {
+			scan = &bench->scans16[j * 3];
+			ret = accel_bench_check(bench, scan[0] & 0x3FFF,
+						scan[1] & 0x3FFF, scan[2] & 0x3FFF,
+						0x3FFF);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+const struct bench_case bench_accel_cases[] = {
+	{
+		.name = "adxl355_fifo_raw_96",
+		.bytes_per_op = ADXL355_SIM_ENTRIES * 3,
+		.setup = adxl355_bench_setup_full,
+		.run = adxl355_bench_raw,
+		.teardown = adxl355_bench_teardown,
+	},
+	{
+		.name = "adxl355_fifo_raw_misaligned",
+		.setup = adxl355_bench_setup_misaligned,
+		.run = adxl355_bench_raw,
+		.teardown = adxl355_bench_teardown,
+	},
+	{
+		.name = "adxl355_fifo_scans_96",
+		.bytes_per_op = ADXL355_SIM_ENTRIES * 3,
+		.setup = adxl355_bench_setup_full,
+		.run = adxl355_bench_scans,
+		.teardown = adxl355_bench_teardown,
+	},
+	{
+		.name = "adxl355_fifo_scans_misaligned",
+		.setup = adxl355_bench_setup_misaligned,
+		.run = adxl355_bench_scans,
+		.teardown = adxl355_bench_teardown,
+	},
+	{
+		.name = "adxl367_fifo_raw_510",
+		.bytes_per_op = ADXL367_SIM_ENTRIES * 2,
+		.setup = adxl367_bench_setup_full,
+		.run = adxl367_bench_raw,
+		.teardown = adxl367_bench_teardown,
+	},
+	{
+		.name = "adxl367_fifo_scans_510",
+		.bytes_per_op = ADXL367_SIM_ENTRIES * 2,
+		.setup = adxl367_bench_setup_full,
+		.run = adxl367_bench_scans,
+		.teardown = adxl367_bench_teardown,
+	},
+	{
+		.name = "adxl367_fifo_scans_misaligned",
+		.setup = adxl367_bench_setup_misaligned,
+		.run = adxl367_bench_scans,
+		.teardown = adxl367_bench_teardown,
+	},
+};
+
+const uint32_t bench_accel_nb_cases = NO_OS_ARRAY_SIZE(bench_accel_cases);
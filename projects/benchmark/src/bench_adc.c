@@ -0,0 +1,528 @@
+/***************************************************************************//**
+ *   @file   bench_adc.c
+ *   @brief  Benchmarks for the AD7124 sample acquisition on a simulated device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "ad7124.h"
+#include "ad7124_regs.h"
+#include "iio_ad7124.h"
+
+/*
+ * Bus timing model: each transfer costs a chip select setup time plus the time
+ * needed to clock its bytes out at 5MHz. Conversions complete as soon as the
+ * previous result is read, so the SPI traffic generated by the driver is the
+ * bottleneck.
+ */
+#define AD7124_SIM_HZ		5000000
+#define AD7124_SIM_XFER_NS	1000
+
+#define AD7124_BENCH_CHANNELS	16
+#define AD7124_BENCH_SCANS	64
+
+/**
+ * @struct ad7124_sim
+ * @brief Simulated AD7124-8. The result of the n-th conversion of channel c
+ * is (n << 4) | c, so the channel of a sample can be checked.
+ */
+struct ad7124_sim {
+	uint32_t regs[AD7124_REG_NO];
+	bool cont_read;
+	/* Channel of the next conversion */
+	uint32_t next_ch;
+	/* Channel of the conversion in the data register */
+	uint32_t last_ch;
+	uint32_t conv;
+
+	/* Worker thread raising the DOUT/RDY interrupt */
+	pthread_t worker;
+	bool worker_started;
+	volatile bool stop;
+	pthread_mutex_t lock;
+	struct no_os_callback_desc *irq_cb;
+	volatile bool irq_enabled;
+};
+
+static struct ad7124_sim ad7124_sim;
+
+static void ad7124_sim_wait(uint32_t len)
+{
+	uint64_t end = bench_now_ns() + AD7124_SIM_XFER_NS +
+		       len * 8ull * 1000000000ull / AD7124_SIM_HZ;
+
+	while (bench_now_ns() < end)
+		;
+}
+
+/* Output the next conversion result and its status byte. */
+static void ad7124_sim_data(struct ad7124_sim *sim, uint8_t *buf,
+			    bool status)
+{
+	uint32_t ch = sim->next_ch;
+	uint32_t i;
+
+	for (i = 0; i < AD7124_BENCH_CHANNELS; i++, ch++) {
+		ch %= AD7124_BENCH_CHANNELS;
+		if (sim->regs[AD7124_Channel_0 + ch] & AD7124_CH_MAP_REG_CH_ENABLE)
+			break;
+	}
+
+	no_os_put_unaligned_be24((sim->conv++ << 4 | ch) & 0xFFFFFF, buf);
+	if (status)
+		buf[3] = AD7124_STATUS_REG_CH_ACTIVE(ch);
+
+	sim->last_ch = ch;
+	sim->next_ch = (ch + 1) % AD7124_BENCH_CHANNELS;
+}
+
+static void ad7124_sim_xfer(struct ad7124_sim *sim, uint8_t *buf,
+			    uint32_t len)
+{
+	uint8_t addr = AD7124_COMM_REG_RA(buf[0]);
+	uint32_t size;
+	uint32_t val;
+	uint32_t i;
+
+	ad7124_sim_wait(len);
+
+	if (sim->cont_read) {
+		if (buf[0] != (AD7124_COMM_REG_RD | AD7124_DATA_REG)) {
+			ad7124_sim_data(sim, buf, true);
+			return;
+		}
+
+		/* Read of the data register, leaves the continuous read mode */
+		sim->cont_read = false;
+		ad7124_sim_data(sim, &buf[1], true);
+		return;
+	}
+
+	/* Reset */
+	if (buf[0] == 0xFF || addr >= AD7124_REG_NO)
+		return;
+
+	size = ad7124_regs[addr].size;
+	if (!(buf[0] & AD7124_COMM_REG_RD)) {
+		val = 0;
+		for (i = 1; i <= size; i++)
+			val = val << 8 | buf[i];
+		sim->regs[addr] = val;
+		if (addr == AD7124_ADC_CTRL_REG)
+			sim->cont_read = val & AD7124_ADC_CTRL_REG_CONT_READ;
+		return;
+	}
+
+	switch (addr) {
+	case AD7124_DATA_REG:
+		ad7124_sim_data(sim, &buf[1], sim->regs[AD7124_ADC_CTRL_REG] &
+				AD7124_ADC_CTRL_REG_DATA_STATUS);
+		return;
+	case AD7124_STATUS_REG:
+		val = AD7124_STATUS_REG_CH_ACTIVE(sim->last_ch);
+		break;
+	case AD7124_ERR_REG:
+		val = 0;
+		break;
+	case AD7124_ID_REG:
+		val = AD7124_8_STD_ID;
+		break;
+	default:
+		val = sim->regs[addr];
+		break;
+	}
+
+	for (i = size; i > 0; i--) {
+		buf[i] = val & 0xFF;
+		val >>= 8;
+	}
+}
+
+static int32_t ad7124_sim_spi_init(struct no_os_spi_desc **desc,
+				   const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int32_t ad7124_sim_spi_write_and_read(struct no_os_spi_desc *desc,
+		uint8_t *data, uint16_t bytes_number)
+{
+	ad7124_sim_xfer(desc->extra, data, bytes_number);
+
+	return 0;
+}
+
+static int32_t ad7124_sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops ad7124_sim_spi_ops = {
+	.init = ad7124_sim_spi_init,
+	.write_and_read = ad7124_sim_spi_write_and_read,
+	.remove = ad7124_sim_spi_remove,
+};
+
+static int32_t ad7124_sim_gpio_get(struct no_os_gpio_desc **desc,
+				   const struct no_os_gpio_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->number = param->number;
+
+	return 0;
+}
+
+static int32_t ad7124_sim_gpio_remove(struct no_os_gpio_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static int32_t ad7124_sim_gpio_input(struct no_os_gpio_desc *desc)
+{
+	return 0;
+}
+
+/* A conversion is always ready */
+static int32_t ad7124_sim_gpio_get_value(struct no_os_gpio_desc *desc,
+		uint8_t *value)
+{
+	*value = NO_OS_GPIO_LOW;
+
+	return 0;
+}
+
+static const struct no_os_gpio_platform_ops ad7124_sim_gpio_ops = {
+	.gpio_ops_get = ad7124_sim_gpio_get,
+	.gpio_ops_get_optional = ad7124_sim_gpio_get,
+	.gpio_ops_remove = ad7124_sim_gpio_remove,
+	.gpio_ops_direction_input = ad7124_sim_gpio_input,
+	.gpio_ops_get_value = ad7124_sim_gpio_get_value,
+};
+
+static void *ad7124_sim_worker(void *arg)
+{
+	struct ad7124_sim *sim = arg;
+	bool fired;
+
+	while (!sim->stop) {
+		pthread_mutex_lock(&sim->lock);
+		fired = sim->irq_enabled && sim->cont_read && sim->irq_cb;
+		if (fired)
+			sim->irq_cb->callback(sim->irq_cb->ctx);
+		pthread_mutex_unlock(&sim->lock);
+
+		if (!fired)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/* The interrupt handler runs in the worker, which already holds the lock. */
+static void ad7124_sim_irq_set(struct ad7124_sim *sim, bool enabled)
+{
+	if (sim->worker_started && pthread_equal(pthread_self(), sim->worker)) {
+		sim->irq_enabled = enabled;
+		return;
+	}
+
+	pthread_mutex_lock(&sim->lock);
+	sim->irq_enabled = enabled;
+	pthread_mutex_unlock(&sim->lock);
+}
+
+static int ad7124_sim_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				    const struct no_os_irq_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int ad7124_sim_irq_register(struct no_os_irq_ctrl_desc *desc,
+				   uint32_t irq_id,
+				   struct no_os_callback_desc *cb)
+{
+	struct ad7124_sim *sim = desc->extra;
+
+	sim->irq_cb = cb;
+
+	return 0;
+}
+
+static int ad7124_sim_irq_unregister(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id,
+				     struct no_os_callback_desc *cb)
+{
+	struct ad7124_sim *sim = desc->extra;
+
+	ad7124_sim_irq_set(sim, false);
+	sim->irq_cb = NULL;
+
+	return 0;
+}
+
+static int ad7124_sim_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	ad7124_sim_irq_set(desc->extra, true);
+
+	return 0;
+}
+
+static int ad7124_sim_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				  uint32_t irq_id)
+{
+	ad7124_sim_irq_set(desc->extra, false);
+
+	return 0;
+}
+
+static int ad7124_sim_irq_trig(struct no_os_irq_ctrl_desc *desc,
+			       uint32_t irq_id,
+			       enum no_os_irq_trig_level trig)
+{
+	return 0;
+}
+
+static int ad7124_sim_irq_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_irq_platform_ops ad7124_sim_irq_ops = {
+	.init = ad7124_sim_irq_ctrl_init,
+	.register_callback = ad7124_sim_irq_register,
+	.unregister_callback = ad7124_sim_irq_unregister,
+	.trigger_level_set = ad7124_sim_irq_trig,
+	.enable = ad7124_sim_irq_enable,
+	.disable = ad7124_sim_irq_disable,
+	.remove = ad7124_sim_irq_remove,
+};
+
+/**
+ * @struct ad7124_bench
+ * @brief Context of the AD7124 benchmarks.
+ */
+struct ad7124_bench {
+	struct ad7124_dev *dev;
+	struct no_os_irq_ctrl_desc *irq;
+	struct ad7124_st_reg regs[AD7124_REG_NO];
+	int32_t scans[AD7124_BENCH_SCANS * AD7124_BENCH_CHANNELS];
+};
+
+static void ad7124_bench_stop_worker(struct ad7124_sim *sim)
+{
+	if (sim->worker_started) {
+		sim->stop = true;
+		pthread_join(sim->worker, NULL);
+		sim->worker_started = false;
+	}
+
+	pthread_mutex_destroy(&sim->lock);
+}
+
+static int ad7124_bench_setup(void **ctx, bool cont_read)
+{
+	struct no_os_spi_init_param spi_ip = {
+		.platform_ops = &ad7124_sim_spi_ops,
+		.extra = &ad7124_sim,
+	};
+	struct no_os_gpio_init_param gpio_ip = {
+		.number = 0,
+		.platform_ops = &ad7124_sim_gpio_ops,
+	};
+	struct no_os_irq_init_param irq_ip = {
+		.platform_ops = &ad7124_sim_irq_ops,
+		.extra = &ad7124_sim,
+	};
+	struct ad7124_init_param ip = {
+		.spi_init = &spi_ip,
+		.check_ready = 1,
+		.spi_rdy_poll_cnt = 1000,
+		.mode = AD7124_CONTINUOUS,
+		.active_device = ID_AD7124_8,
+		.power_mode = AD7124_HIGH_POWER,
+	};
+	struct ad7124_bench *bench;
+	uint32_t i;
+	int ret;
+
+	memset(&ad7124_sim, 0, sizeof(ad7124_sim));
+	pthread_mutex_init(&ad7124_sim.lock, NULL);
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	memcpy(bench->regs, ad7124_regs, sizeof(bench->regs));
+	for (i = 0; i < AD7124_REG_NO; i++)
+		ad7124_sim.regs[i] = ad7124_regs[i].value;
+	ip.regs = bench->regs;
+
+	for (i = 0; i < AD7124_BENCH_CHANNELS; i++) {
+		ip.chan_map[i].channel_enable = true;
+		ip.chan_map[i].ain.ainp = AD7124_AIN0 + i;
+		ip.chan_map[i].ain.ainm = AD7124_AVSS;
+	}
+
+	if (cont_read) {
+		ret = no_os_irq_ctrl_init(&bench->irq, &irq_ip);
+		if (ret)
+			goto free_bench;
+
+		ret = pthread_create(&ad7124_sim.worker, NULL, ad7124_sim_worker,
+				     &ad7124_sim);
+		if (ret) {
+			ret = -ret;
+			goto free_irq;
+		}
+		ad7124_sim.worker_started = true;
+
+		ip.gpio_rdy = &gpio_ip;
+		ip.irq_ctrl = bench->irq;
+	}
+
+	ret = ad7124_setup(&bench->dev, &ip);
+	if (ret)
+		goto stop_worker;
+
+	ret = iio_ad7124_device.pre_enable(bench->dev,
+					   NO_OS_GENMASK(AD7124_BENCH_CHANNELS - 1, 0));
+	if (ret)
+		goto remove_dev;
+
+	*ctx = bench;
+
+	return 0;
+
+remove_dev:
+	ad7124_remove(bench->dev);
+stop_worker:
+	ad7124_bench_stop_worker(&ad7124_sim);
+free_irq:
+	if (bench->irq)
+		no_os_irq_ctrl_remove(bench->irq);
+free_bench:
+	no_os_free(bench);
+
+	return ret;
+}
+
+static int ad7124_bench_setup_poll(void **ctx)
+{
+	return ad7124_bench_setup(ctx, false);
+}
+
+static int ad7124_bench_setup_cont_read(void **ctx)
+{
+	return ad7124_bench_setup(ctx, true);
+}
+
+static void ad7124_bench_teardown(void *ctx)
+{
+	struct ad7124_bench *bench = ctx;
+
+	iio_ad7124_device.post_disable(bench->dev);
+	ad7124_remove(bench->dev);
+	ad7124_bench_stop_worker(&ad7124_sim);
+	if (bench->irq)
+		no_os_irq_ctrl_remove(bench->irq);
+	no_os_free(bench);
+}
+
+/* Read 16 channel scans through the IIO device, checking each channel. */
+static int ad7124_bench_scans(void *ctx, uint32_t nb_ops)
+{
+	struct ad7124_bench *bench = ctx;
+	uint32_t nb;
+	uint32_t i;
+	int32_t ret;
+
+	while (nb_ops) {
+		nb = no_os_min(nb_ops, AD7124_BENCH_SCANS);
+		ret = iio_ad7124_device.read_dev(bench->dev, bench->scans, nb);
+		if (ret < 0)
+			return ret;
+
+		for (i = 0; i < nb * AD7124_BENCH_CHANNELS; i++)
+			if ((bench->scans[i] & 0xF) != i % AD7124_BENCH_CHANNELS)
+				return -EILSEQ;
+
+		nb_ops -= nb;
+	}
+
+	return 0;
+}
+
+const struct bench_case bench_adc_cases[] = {
+	{
+		.name = "ad7124_scan_16ch_poll",
+		.bytes_per_op = AD7124_BENCH_CHANNELS * sizeof(int32_t),
+		.setup = ad7124_bench_setup_poll,
+		.run = ad7124_bench_scans,
+		.teardown = ad7124_bench_teardown,
+	},
+	{
+		.name = "ad7124_scan_16ch_cont_read",
+		.bytes_per_op = AD7124_BENCH_CHANNELS * sizeof(int32_t),
+		.setup = ad7124_bench_setup_cont_read,
+		.run = ad7124_bench_scans,
+		.teardown = ad7124_bench_teardown,
+	},
+};
+
+const uint32_t bench_adc_nb_cases = NO_OS_ARRAY_SIZE(bench_adc_cases);
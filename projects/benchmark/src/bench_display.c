@@ -0,0 +1,375 @@
+/***************************************************************************//**
+ *   @file   bench_display.c
+ *   @brief  Benchmarks for the display core on a simulated SSD1306.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "display.h"
+#include "ssd_1306.h"
+
+/*
+ * Bus timing model: each transfer costs a chip select setup time plus the time
+ * needed to clock its bytes out at 8MHz.
+ */
+#define SSD1306_SIM_HZ		8000000
+#define SSD1306_SIM_XFER_NS	1000
+
+#define SSD1306_BENCH_COLS	16
+#define SSD1306_BENCH_ROWS	8
+
+/**
+ * @struct ssd1306_sim
+ * @brief Simulated SSD1306 in horizontal addressing mode. Only the data
+ * written to the display RAM is modeled, to check the output.
+ */
+struct ssd1306_sim {
+	uint8_t gdram[SSD1306_BENCH_ROWS][SSD1306_BENCH_COLS * 8];
+	uint8_t cmd[3];
+	uint32_t cmd_len;
+	uint8_t col_start, col_end, col;
+	uint8_t page_start, page_end, page;
+	/* Level of the D/C pin */
+	uint8_t dc;
+};
+
+static struct ssd1306_sim ssd1306_sim;
+
+static void ssd1306_sim_wait(uint32_t len)
+{
+	uint64_t end = bench_now_ns() + SSD1306_SIM_XFER_NS +
+		       len * 8ull * 1000000000ull / SSD1306_SIM_HZ;
+
+	while (bench_now_ns() < end)
+		;
+}
+
+static void ssd1306_sim_cmd(struct ssd1306_sim *sim, uint8_t byte)
+{
+	sim->cmd[sim->cmd_len++] = byte;
+
+	switch (sim->cmd[0]) {
+	/* Two byte commands */
+	case 0x20:
+	case 0x81:
+	case 0x8D:
+	case 0xA8:
+	case 0xD3:
+	case 0xD5:
+	case 0xDA:
+		if (sim->cmd_len < 2)
+			return;
+		break;
+	case 0x21:
+		if (sim->cmd_len < 3)
+			return;
+		sim->col_start = sim->col = sim->cmd[1];
+		sim->col_end = sim->cmd[2];
+		break;
+	case 0x22:
+		if (sim->cmd_len < 3)
+			return;
+		sim->page_start = sim->page = sim->cmd[1];
+		sim->page_end = sim->cmd[2];
+		break;
+	default:
+		break;
+	}
+
+	sim->cmd_len = 0;
+}
+
+static void ssd1306_sim_data(struct ssd1306_sim *sim, uint8_t byte)
+{
+	if (sim->page < SSD1306_BENCH_ROWS && sim->col < SSD1306_BENCH_COLS * 8)
+		sim->gdram[sim->page][sim->col] = byte;
+
+	if (sim->col++ < sim->col_end)
+		return;
+
+	sim->col = sim->col_start;
+	sim->page = sim->page < sim->page_end ? sim->page + 1 : sim->page_start;
+}
+
+static int32_t ssd1306_sim_spi_init(struct no_os_spi_desc **desc,
+				    const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int32_t ssd1306_sim_spi_write_and_read(struct no_os_spi_desc *desc,
+		uint8_t *data, uint16_t bytes_number)
+{
+	struct ssd1306_sim *sim = desc->extra;
+	uint16_t i;
+
+	ssd1306_sim_wait(bytes_number);
+
+	for (i = 0; i < bytes_number; i++) {
+		if (sim->dc)
+			ssd1306_sim_data(sim, data[i]);
+		else
+			ssd1306_sim_cmd(sim, data[i]);
+	}
+
+	return 0;
+}
+
+static int32_t ssd1306_sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops ssd1306_sim_spi_ops = {
+	.init = ssd1306_sim_spi_init,
+	.write_and_read = ssd1306_sim_spi_write_and_read,
+	.remove = ssd1306_sim_spi_remove,
+};
+
+static int32_t ssd1306_sim_gpio_get(struct no_os_gpio_desc **desc,
+				    const struct no_os_gpio_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->number = param->number;
+
+	return 0;
+}
+
+static int32_t ssd1306_sim_gpio_remove(struct no_os_gpio_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static int32_t ssd1306_sim_gpio_set_value(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	ssd1306_sim.dc = value;
+
+	return 0;
+}
+
+static const struct no_os_gpio_platform_ops ssd1306_sim_gpio_ops = {
+	.gpio_ops_get = ssd1306_sim_gpio_get,
+	.gpio_ops_remove = ssd1306_sim_gpio_remove,
+	.gpio_ops_set_value = ssd1306_sim_gpio_set_value,
+};
+
+/**
+ * @struct display_bench
+ * @brief Context of the display benchmarks.
+ */
+struct display_bench {
+	struct display_dev *dev;
+	struct no_os_spi_init_param spi_ip;
+	struct no_os_gpio_init_param dc_ip;
+	struct ssd_1306_extra extra;
+	/* Two screens of text, every character differs between them */
+	char screen[2][SSD1306_BENCH_ROWS * SSD1306_BENCH_COLS + 1];
+	uint32_t count;
+};
+
+static int display_bench_setup(void **ctx, bool framebuffer)
+{
+	struct display_init_param ip = {
+		.cols_nb = SSD1306_BENCH_COLS,
+		.rows_nb = SSD1306_BENCH_ROWS,
+		.controller_ops = &ssd1306_ops,
+		.framebuffer = framebuffer,
+	};
+	struct display_bench *bench;
+	uint32_t i;
+	int ret;
+
+	memset(&ssd1306_sim, 0, sizeof(ssd1306_sim));
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	bench->spi_ip.platform_ops = &ssd1306_sim_spi_ops;
+	bench->spi_ip.extra = &ssd1306_sim;
+	bench->dc_ip.platform_ops = &ssd1306_sim_gpio_ops;
+	bench->extra.spi_ip = &bench->spi_ip;
+	bench->extra.dc_pin_ip = &bench->dc_ip;
+	bench->extra.comm_type = SSD1306_SPI;
+	ip.extra = &bench->extra;
+
+	for (i = 0; i < SSD1306_BENCH_ROWS * SSD1306_BENCH_COLS; i++) {
+		bench->screen[0][i] = 'A' + i % 26;
+		bench->screen[1][i] = 'a' + i % 26;
+	}
+
+	ret = display_init(&bench->dev, &ip);
+	if (ret) {
+		no_os_free(bench);
+		return ret;
+	}
+
+	*ctx = bench;
+
+	return 0;
+}
+
+static int display_bench_setup_direct(void **ctx)
+{
+	return display_bench_setup(ctx, false);
+}
+
+static int display_bench_setup_fb(void **ctx)
+{
+	return display_bench_setup(ctx, true);
+}
+
+static void display_bench_teardown(void *ctx)
+{
+	struct display_bench *bench = ctx;
+
+	display_remove(bench->dev);
+	no_os_free(bench);
+}
+
+extern const uint8_t no_os_chr_8x8[128][8];
+
+/* Check that the simulated display RAM shows the screen from a row on. */
+static int display_bench_check(const char *screen, uint32_t row)
+{
+	uint32_t r, c;
+
+	for (r = row; r < SSD1306_BENCH_ROWS; r++)
+		for (c = 0; c < SSD1306_BENCH_COLS; c++)
+			if (memcmp(&ssd1306_sim.gdram[r][c * 8],
+				   no_os_chr_8x8[(uint8_t)screen[r * SSD1306_BENCH_COLS + c]],
+				   8))
+				return -EILSEQ;
+
+	return 0;
+}
+
+/* Redraw the whole screen, alternating between the two texts. */
+static int display_bench_screen(void *ctx, uint32_t nb_ops)
+{
+	struct display_bench *bench = ctx;
+	char *screen = NULL;
+	int32_t ret;
+
+	while (nb_ops--) {
+		screen = bench->screen[bench->count++ & 1];
+		ret = display_print_string(bench->dev, screen, 0, 0);
+		if (ret)
+			return ret;
+
+		if (bench->dev->fb) {
+			ret = display_flush(bench->dev);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return screen ? display_bench_check(screen, 0) : 0;
+}
+
+/* Update a 6 digit counter on the last row, the rest of the screen is kept. */
+static int display_bench_counter(void *ctx, uint32_t nb_ops)
+{
+	struct display_bench *bench = ctx;
+	char *screen = bench->screen[0];
+	char *counter = &screen[(SSD1306_BENCH_ROWS - 1) * SSD1306_BENCH_COLS];
+	uint32_t val;
+	int32_t ret;
+	int32_t i;
+
+	while (nb_ops--) {
+		val = ++bench->count;
+		for (i = 5; i >= 0; i--, val /= 10)
+			counter[i] = '0' + val % 10;
+
+		ret = display_print_string(bench->dev, counter,
+					   SSD1306_BENCH_ROWS - 1, 0);
+		if (ret)
+			return ret;
+
+		if (bench->dev->fb) {
+			ret = display_flush(bench->dev);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return display_bench_check(screen, SSD1306_BENCH_ROWS - 1);
+}
+
+const struct bench_case bench_display_cases[] = {
+	{
+		.name = "ssd1306_screen_direct",
+		.bytes_per_op = SSD1306_BENCH_ROWS * SSD1306_BENCH_COLS,
+		.setup = display_bench_setup_direct,
+		.run = display_bench_screen,
+		.teardown = display_bench_teardown,
+	},
+	{
+		.name = "ssd1306_screen_fb",
+		.bytes_per_op = SSD1306_BENCH_ROWS * SSD1306_BENCH_COLS,
+		.setup = display_bench_setup_fb,
+		.run = display_bench_screen,
+		.teardown = display_bench_teardown,
+	},
+	{
+		.name = "ssd1306_counter_direct",
+		.bytes_per_op = SSD1306_BENCH_COLS,
+		.setup = display_bench_setup_direct,
+		.run = display_bench_counter,
+		.teardown = display_bench_teardown,
+	},
+	{
+		.name = "ssd1306_counter_fb",
+		.bytes_per_op = SSD1306_BENCH_COLS,
+		.setup = display_bench_setup_fb,
+		.run = display_bench_counter,
+		.teardown = display_bench_teardown,
+	},
+};
+
+const uint32_t bench_display_nb_cases = NO_OS_ARRAY_SIZE(bench_display_cases);
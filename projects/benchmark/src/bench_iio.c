@@ -0,0 +1,1896 @@
+/***************************************************************************//**
+ *   @file   bench_iio.c
+ *   @brief  Benchmarks for the IIO core and IIOD protocol paths.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "bench.h"
+#include "iio.h"
+#include "iiod.h"
+#include "iiod_private.h"
+#include "iio_delta.h"
+#include "iio_filter.h"
+#include "iio_adc_demo.h"
+#include "linux_socket.h"
+#include "tcp_socket.h"
+#include "no_os_util.h"
+
+#define BENCH_IIOD_PORT		30431
+#define BENCH_READBUF_SIZE	4096
+/* Two 16 bit channels and the 32 bit sample counter of the adc_demo device */
+#define BENCH_READBUF_MASK	0x7
+#define BENCH_READBUF_SCAN_SIZE	8
+#define BENCH_READBUF_COUNT_POS	4
+#define BENCH_READBUF_SCANS	(BENCH_READBUF_SIZE / BENCH_READBUF_SCAN_SIZE)
+/* Encoded bytes asked by each READBUF of a compressed buffer */
+#define BENCH_READBUF_DELTA_CHUNK	1024
+/* Length of the slowly changing adc_demo data */
+#define BENCH_SLOW_LEN		1024
+
+/* 16 channels of 32 bit samples that drift by a few LSBs between scans */
+#define BENCH_DELTA_CHANNELS	16
+#define BENCH_DELTA_SCANS	256
+#define BENCH_DELTA_SCAN_SIZE	(BENCH_DELTA_CHANNELS * sizeof(uint32_t))
+#define BENCH_DELTA_SIZE	(BENCH_DELTA_SCANS * BENCH_DELTA_SCAN_SIZE)
+
+/* dac_demo like device: 16 channels of 16 bit samples */
+#define BENCH_SCAN_CHANNELS	16
+#define BENCH_SCAN_SCANS	256
+#define BENCH_SCAN_SIZE		(BENCH_SCAN_SCANS * BENCH_SCAN_CHANNELS * \
+				 sizeof(uint16_t))
+
+/* 8 signed 16 bit channels, oversampled */
+#define BENCH_FILTER_CHANNELS	8
+#define BENCH_FILTER_SCANS	4096
+#define BENCH_FILTER_SIZE	(BENCH_FILTER_SCANS * BENCH_FILTER_CHANNELS * \
+				 sizeof(int16_t))
+#define BENCH_FILTER_TAPS	16
+
+static volatile uint32_t bench_sink;
+
+/*
+ * iio_format_value / iio_parse_value
+ */
+struct bench_format_arg {
+	enum iio_val fmt;
+	int32_t size;
+	int32_t vals[16];
+};
+
+struct bench_parse_arg {
+	enum iio_val fmt;
+	const char *str;
+};
+
+static int format_run(void *ctx, uint32_t nb_ops)
+{
+	struct bench_format_arg *arg = ctx;
+	char buf[256];
+	int ret = 0;
+
+	while (nb_ops--) {
+		ret = iio_format_value(buf, sizeof(buf), arg->fmt, arg->size,
+				       arg->vals);
+		if (ret <= 0)
+			return -EINVAL;
+	}
+	bench_sink = buf[0];
+
+	return 0;
+}
+
+static int parse_run(void *ctx, uint32_t nb_ops)
+{
+	struct bench_parse_arg *arg = ctx;
+	uint32_t len = strlen(arg->str) + 1;
+	int32_t val = 0, val2 = 0;
+	char buf[64];
+	int ret;
+
+	while (nb_ops--) {
+		/* iio_parse_value tokenizes the input in place */
+		memcpy(buf, arg->str, len);
+		ret = iio_parse_value(buf, arg->fmt, &val, &val2);
+		if (ret < 0)
+			return ret;
+	}
+	bench_sink = val + val2;
+
+	return 0;
+}
+
+static int format_ref_run(void *ctx, uint32_t nb_ops)
+{
+	struct bench_format_arg *arg = ctx;
+	char buf[256];
+	int ret = 0;
+
+	while (nb_ops--) {
+		ret = iio_format_value_ref(buf, sizeof(buf), arg->fmt,
+					   arg->size, arg->vals);
+		if (ret <= 0)
+			return -EINVAL;
+	}
+	bench_sink = buf[0];
+
+	return 0;
+}
+
+static int parse_ref_run(void *ctx, uint32_t nb_ops)
+{
+	struct bench_parse_arg *arg = ctx;
+	uint32_t len = strlen(arg->str) + 1;
+	int32_t val = 0, val2 = 0;
+	char buf[64];
+	int ret;
+
+	while (nb_ops--) {
+		memcpy(buf, arg->str, len);
+		ret = iio_parse_value_ref(buf, arg->fmt, &val, &val2);
+		if (ret < 0)
+			return ret;
+	}
+	bench_sink = val + val2;
+
+	return 0;
+}
+
+static uint32_t bench_rand_state = 0x12345678;
+
+static uint32_t bench_rand(void)
+{
+	/* xorshift32 */
+	bench_rand_state ^= bench_rand_state << 13;
+	bench_rand_state ^= bench_rand_state >> 17;
+	bench_rand_state ^= bench_rand_state << 5;
+
+	return bench_rand_state;
+}
+
+/* Random value with a random number of significant bits */
+static int32_t bench_rand_val(void)
+{
+	return (int32_t)bench_rand() >> (bench_rand() % 32);
+}
+
+static const enum iio_val compare_fmts[] = {
+	IIO_VAL_INT, IIO_VAL_INT_PLUS_MICRO, IIO_VAL_INT_PLUS_NANO,
+	IIO_VAL_INT_PLUS_MICRO_DB, IIO_VAL_FRACTIONAL, IIO_VAL_FRACTIONAL_LOG2,
+	IIO_VAL_INT_MULTIPLE, IIO_VAL_CHAR,
+};
+
+/* Strings mixed into the parser input */
+static const char *const compare_parts[] = {
+	"", " ", "-", "+", ".", "..", "0", "00", "0x", "0X1f", "7", "09",
+	"123456789", "99999999999", "\n", " dB", "db", "b", "\t",
+};
+
+/*
+ * One operation formats and parses random values with both
+ * implementations and fails if any result differs.
+ */
+static int compare_run(void *ctx, uint32_t nb_ops)
+{
+	char buf[2][128], str[64];
+	int32_t vals[8], res[2][2];
+	enum iio_val fmt;
+	int ret[2];
+	uint32_t i, len;
+
+	while (nb_ops--) {
+		fmt = compare_fmts[bench_rand() % NO_OS_ARRAY_SIZE(compare_fmts)];
+		for (i = 0; i < NO_OS_ARRAY_SIZE(vals); i++)
+			vals[i] = bench_rand_val();
+		if (fmt == IIO_VAL_FRACTIONAL && !vals[1])
+			vals[1] = 1;
+		if (fmt == IIO_VAL_FRACTIONAL_LOG2)
+			vals[1] = bench_rand() % 32;
+		len = bench_rand() % 2 ? sizeof(buf[0]) : bench_rand() % 40;
+
+		memset(buf, 0xAA, sizeof(buf));
+		ret[0] = iio_format_value(buf[0], len, fmt,
+					  NO_OS_ARRAY_SIZE(vals), vals);
+		ret[1] = iio_format_value_ref(buf[1], len, fmt,
+					      NO_OS_ARRAY_SIZE(vals), vals);
+		if (ret[0] != ret[1] || memcmp(buf[0], buf[1], sizeof(buf[0]))) {
+			printf("format mismatch: fmt %d len %u\n", fmt, len);
+			return -EINVAL;
+		}
+
+		/* Parse either a formatted value or random parts */
+		if (fmt == IIO_VAL_INT_MULTIPLE || bench_rand() % 2) {
+			str[0] = '\0';
+			for (i = bench_rand() % 6; i; i--)
+				strcat(str, compare_parts[bench_rand() %
+							   NO_OS_ARRAY_SIZE(compare_parts)]);
+			if (fmt == IIO_VAL_INT_MULTIPLE)
+				fmt = IIO_VAL_INT_PLUS_MICRO;
+		} else {
+			iio_format_value(str, sizeof(str), fmt, 2, vals);
+		}
+		if (fmt == IIO_VAL_FRACTIONAL_LOG2)
+			fmt = IIO_VAL_FRACTIONAL;
+
+		/* The reference never returns when given 7 leading zeros */
+		if (strstr(str, "0000000"))
+			continue;
+
+		strcpy(buf[0], str);
+		strcpy(buf[1], str);
+		memset(res, 0, sizeof(res));
+		ret[0] = iio_parse_value(buf[0], fmt, &res[0][0], &res[0][1]);
+		ret[1] = iio_parse_value_ref(buf[1], fmt, &res[1][0], &res[1][1]);
+		if (ret[0] != ret[1] || memcmp(res[0], res[1], sizeof(res[0]))) {
+			printf("parse mismatch: fmt %d \"%s\"\n", fmt, str);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static const struct bench_format_arg format_int = {
+	.fmt = IIO_VAL_INT, .size = 1, .vals = { -123456 }
+};
+
+static const struct bench_format_arg format_micro = {
+	.fmt = IIO_VAL_INT_PLUS_MICRO, .size = 2, .vals = { 12, 345678 }
+};
+
+static const struct bench_format_arg format_nano = {
+	.fmt = IIO_VAL_INT_PLUS_NANO, .size = 2, .vals = { 0, 4096 }
+};
+
+static const struct bench_format_arg format_fractional = {
+	.fmt = IIO_VAL_FRACTIONAL, .size = 2, .vals = { 2500, 4096 }
+};
+
+static const struct bench_format_arg format_log2 = {
+	.fmt = IIO_VAL_FRACTIONAL_LOG2, .size = 2, .vals = { 2500, 16 }
+};
+
+static const struct bench_format_arg format_multiple = {
+	.fmt = IIO_VAL_INT_MULTIPLE, .size = 16,
+	.vals = {
+		1, -2, 30, -40, 500, -600, 7000, -8000,
+		90000, -100000, 1100000, -12000000, 0, 14, -15, 16
+	}
+};
+
+static const struct bench_parse_arg parse_int = {
+	.fmt = IIO_VAL_INT, .str = "-123456"
+};
+
+static const struct bench_parse_arg parse_micro = {
+	.fmt = IIO_VAL_INT_PLUS_MICRO, .str = "12.345678"
+};
+
+static const struct bench_parse_arg parse_nano = {
+	.fmt = IIO_VAL_INT_PLUS_NANO, .str = "0.000004096"
+};
+
+static const struct bench_parse_arg parse_fractional = {
+	.fmt = IIO_VAL_FRACTIONAL, .str = "-0.610351"
+};
+
+/*
+ * iiod_parse_line
+ */
+static int parse_line_run(void *ctx, uint32_t nb_ops)
+{
+	const char *line = ctx;
+	uint32_t len = strlen(line) + 1;
+	struct comand_desc res;
+	char buf[IIOD_PARSER_MAX_BUF_SIZE];
+	char *strtok_ctx;
+	int ret;
+
+	while (nb_ops--) {
+		/* The parser tokenizes the line in place */
+		memcpy(buf, line, len);
+		ret = iiod_parse_line(buf, &res, &strtok_ctx);
+		if (ret)
+			return ret;
+	}
+	bench_sink = res.cmd;
+
+	return 0;
+}
+
+/*
+ * iio_delta_encode / iio_delta_decode
+ */
+struct delta_ctx {
+	struct iio_delta enc;
+	struct iio_delta dec;
+	uint32_t raw[BENCH_DELTA_SCANS][BENCH_DELTA_CHANNELS];
+	uint32_t out[BENCH_DELTA_SCANS][BENCH_DELTA_CHANNELS];
+	uint8_t encoded[IIO_DELTA_MAX_ENCODED(BENCH_DELTA_SIZE)];
+	uint32_t encoded_len;
+};
+
+static int delta_setup(void **pctx)
+{
+	struct delta_ctx *ctx;
+	uint32_t nb_scans;
+	uint32_t i, j;
+	int32_t ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+
+	iio_delta_init(&ctx->enc);
+	for (j = 0; j < BENCH_DELTA_CHANNELS; j++)
+		iio_delta_add_channel(&ctx->enc, sizeof(uint32_t), false);
+	ctx->dec = ctx->enc;
+
+	/* Temperature like readings of a 24 bit converter */
+	srand(1);
+	for (j = 0; j < BENCH_DELTA_CHANNELS; j++)
+		ctx->raw[0][j] = 0x800000 + j * 0x1000;
+	for (i = 1; i < BENCH_DELTA_SCANS; i++)
+		for (j = 0; j < BENCH_DELTA_CHANNELS; j++)
+			ctx->raw[i][j] = ctx->raw[i - 1][j] + rand() % 9 - 4;
+
+	for (i = 0; i < BENCH_DELTA_SCANS; i++)
+		ctx->encoded_len += iio_delta_encode(&ctx->enc,
+						     (uint8_t *)ctx->raw[i],
+						     ctx->encoded + ctx->encoded_len);
+
+	/* The reference decoder must give back the samples */
+	nb_scans = BENCH_DELTA_SCANS;
+	ret = iio_delta_decode(&ctx->dec, ctx->encoded, ctx->encoded_len,
+			       (uint8_t *)ctx->out, &nb_scans);
+	if (ret != (int32_t)ctx->encoded_len || nb_scans != BENCH_DELTA_SCANS ||
+	    memcmp(ctx->raw, ctx->out, sizeof(ctx->raw))) {
+		free(ctx);
+		return -EIO;
+	}
+
+	*pctx = ctx;
+
+	return 0;
+}
+
+static void delta_teardown(void *ctx)
+{
+	free(ctx);
+}
+
+static int delta_encode_run(void *pctx, uint32_t nb_ops)
+{
+	struct delta_ctx *ctx = pctx;
+	uint32_t len = 0;
+	uint32_t i;
+
+	while (nb_ops--) {
+		iio_delta_reset(&ctx->enc);
+		len = 0;
+		for (i = 0; i < BENCH_DELTA_SCANS; i++)
+			len += iio_delta_encode(&ctx->enc,
+						(uint8_t *)ctx->raw[i],
+						ctx->encoded + len);
+	}
+	bench_sink = len;
+
+	return 0;
+}
+
+static int delta_decode_run(void *pctx, uint32_t nb_ops)
+{
+	struct delta_ctx *ctx = pctx;
+	uint32_t nb_scans;
+	int32_t ret;
+
+	while (nb_ops--) {
+		iio_delta_reset(&ctx->dec);
+		nb_scans = BENCH_DELTA_SCANS;
+		ret = iio_delta_decode(&ctx->dec, ctx->encoded, ctx->encoded_len,
+				       (uint8_t *)ctx->out, &nb_scans);
+		if (ret < 0)
+			return ret;
+	}
+	bench_sink = ctx->out[BENCH_DELTA_SCANS - 1][0];
+
+	return 0;
+}
+
+/*
+ * iio_scan_mux / iio_scan_demux against per scan copies
+ */
+struct scan_ctx {
+	struct iio_scan_layout layout;
+	uint16_t scans[BENCH_SCAN_SCANS][BENCH_SCAN_CHANNELS];
+	uint16_t planes[BENCH_SCAN_CHANNELS][BENCH_SCAN_SCANS];
+	void *plane_ptrs[BENCH_SCAN_CHANNELS];
+};
+
+static struct scan_type scan_u16 = {
+	.sign = 'u',
+	.realbits = 16,
+	.storagebits = 16,
+};
+
+static struct iio_channel scan_channels[BENCH_SCAN_CHANNELS];
+
+static int scan_setup(void **pctx)
+{
+	struct scan_ctx *ctx;
+	uint32_t i, j;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+
+	for (j = 0; j < BENCH_SCAN_CHANNELS; j++) {
+		scan_channels[j].scan_type = &scan_u16;
+		ctx->plane_ptrs[j] = ctx->planes[j];
+		for (i = 0; i < BENCH_SCAN_SCANS; i++)
+			ctx->scans[i][j] = i * BENCH_SCAN_CHANNELS + j;
+	}
+
+	ret = iio_scan_layout_init(&ctx->layout, scan_channels,
+				   NO_OS_GENMASK(BENCH_SCAN_CHANNELS - 1, 0));
+	if (ret || ctx->layout.bytes_per_scan != sizeof(ctx->scans[0])) {
+		free(ctx);
+		return ret ? ret : -EINVAL;
+	}
+
+	/* The demux must give back the samples the mux interleaves */
+	iio_scan_demux(&ctx->layout, ctx->scans, ctx->plane_ptrs, 0,
+		       BENCH_SCAN_SCANS);
+	for (j = 0; j < BENCH_SCAN_CHANNELS; j++)
+		for (i = 0; i < BENCH_SCAN_SCANS; i++)
+			if (ctx->planes[j][i] != i * BENCH_SCAN_CHANNELS + j)
+				goto error;
+
+	memset(ctx->scans, 0, sizeof(ctx->scans));
+	iio_scan_mux(&ctx->layout, (const void *const *)ctx->plane_ptrs, 0,
+		     ctx->scans, BENCH_SCAN_SCANS);
+	for (i = 0; i < BENCH_SCAN_SCANS; i++)
+		for (j = 0; j < BENCH_SCAN_CHANNELS; j++)
+			if (ctx->scans[i][j] != i * BENCH_SCAN_CHANNELS + j)
+				goto error;
+
+	*pctx = ctx;
+
+	return 0;
+
+error:
+	free(ctx);
+
+	return -EIO;
+}
+
+static void scan_teardown(void *ctx)
+{
+	free(ctx);
+}
+
+static int scan_demux_run(void *pctx, uint32_t nb_ops)
+{
+	struct scan_ctx *ctx = pctx;
+
+	while (nb_ops--)
+		iio_scan_demux(&ctx->layout, ctx->scans, ctx->plane_ptrs, 0,
+			       BENCH_SCAN_SCANS);
+	bench_sink = ctx->planes[BENCH_SCAN_CHANNELS - 1][0];
+
+	return 0;
+}
+
+/* Scan popped into a temporary, then split walking the channel mask */
+static int scan_demux_ref_run(void *pctx, uint32_t nb_ops)
+{
+	struct scan_ctx *ctx = pctx;
+	uint16_t data[BENCH_SCAN_CHANNELS];
+	uint32_t mask, ch, i, k;
+
+	while (nb_ops--) {
+		for (i = 0; i < BENCH_SCAN_SCANS; i++) {
+			memcpy(data, ctx->scans[i], sizeof(data));
+			mask = NO_OS_GENMASK(BENCH_SCAN_CHANNELS - 1, 0);
+			for (ch = 0, k = 0; mask; ch++, mask >>= 1)
+				if (mask & 1)
+					ctx->planes[ch][i] = data[k++];
+		}
+	}
+	bench_sink = ctx->planes[BENCH_SCAN_CHANNELS - 1][0];
+
+	return 0;
+}
+
+static int scan_mux_run(void *pctx, uint32_t nb_ops)
+{
+	struct scan_ctx *ctx = pctx;
+
+	while (nb_ops--)
+		iio_scan_mux(&ctx->layout, (const void *const *)ctx->plane_ptrs,
+			     0, ctx->scans, BENCH_SCAN_SCANS);
+	bench_sink = ctx->scans[BENCH_SCAN_SCANS - 1][0];
+
+	return 0;
+}
+
+/* Scan assembled in a temporary walking the channel mask, then pushed */
+static int scan_mux_ref_run(void *pctx, uint32_t nb_ops)
+{
+	struct scan_ctx *ctx = pctx;
+	uint16_t data[BENCH_SCAN_CHANNELS];
+	uint32_t mask, ch, i, k;
+
+	while (nb_ops--) {
+		for (i = 0; i < BENCH_SCAN_SCANS; i++) {
+			mask = NO_OS_GENMASK(BENCH_SCAN_CHANNELS - 1, 0);
+			for (ch = 0, k = 0; mask; ch++, mask >>= 1)
+				if (mask & 1)
+					data[k++] = ctx->planes[ch][i];
+			memcpy(ctx->scans[i], data, sizeof(data));
+		}
+	}
+	bench_sink = ctx->scans[BENCH_SCAN_SCANS - 1][0];
+
+	return 0;
+}
+
+/*
+ * iio_filter_process
+ */
+struct filter_ctx {
+	struct iio_filter *filter;
+	int16_t in[BENCH_FILTER_SCANS][BENCH_FILTER_CHANNELS];
+	int16_t out[BENCH_FILTER_SCANS][BENCH_FILTER_CHANNELS];
+};
+
+static int filter_setup(void **pctx)
+{
+	const struct iio_filter_cfg *cfg = *pctx;
+	struct filter_ctx *ctx;
+	uint32_t nb_out;
+	uint32_t i, j;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+
+	ctx->filter = calloc(1, IIO_FILTER_SIZE(BENCH_FILTER_CHANNELS));
+	if (!ctx->filter) {
+		ret = -ENOMEM;
+		goto free_ctx;
+	}
+
+	ret = iio_filter_init(ctx->filter, cfg, sizeof(ctx->in[0]),
+			      BENCH_FILTER_CHANNELS);
+	for (j = 0; j < BENCH_FILTER_CHANNELS && !ret; j++)
+		ret = iio_filter_add_channel(ctx->filter, j * sizeof(int16_t),
+					     sizeof(int16_t), 16, 0, true,
+					     false, true);
+	if (ret)
+		goto free_filter;
+
+	/* The filters have a unity gain: a constant comes out unchanged */
+	for (i = 0; i < BENCH_FILTER_SCANS; i++)
+		for (j = 0; j < BENCH_FILTER_CHANNELS; j++)
+			ctx->in[i][j] = 1000 * j - 4000;
+
+	nb_out = iio_filter_process(ctx->filter, (uint8_t *)ctx->in,
+				    BENCH_FILTER_SCANS, (uint8_t *)ctx->out);
+	if (nb_out != BENCH_FILTER_SCANS / cfg->decimation) {
+		ret = -EIO;
+		goto free_filter;
+	}
+	for (j = 0; j < BENCH_FILTER_CHANNELS; j++) {
+		if (ctx->out[nb_out - 1][j] != 1000 * (int32_t)j - 4000) {
+			ret = -EIO;
+			goto free_filter;
+		}
+	}
+
+	/* A few LSBs of noise for the runs */
+	srand(1);
+	for (i = 0; i < BENCH_FILTER_SCANS; i++)
+		for (j = 0; j < BENCH_FILTER_CHANNELS; j++)
+			ctx->in[i][j] += rand() % 7 - 3;
+	iio_filter_reset(ctx->filter);
+
+	*pctx = ctx;
+
+	return 0;
+
+free_filter:
+	free(ctx->filter);
+free_ctx:
+	free(ctx);
+
+	return ret;
+}
+
+static void filter_teardown(void *pctx)
+{
+	struct filter_ctx *ctx = pctx;
+
+	free(ctx->filter);
+	free(ctx);
+}
+
+static int filter_run(void *pctx, uint32_t nb_ops)
+{
+	struct filter_ctx *ctx = pctx;
+	uint32_t nb_out = 0;
+
+	while (nb_ops--)
+		nb_out = iio_filter_process(ctx->filter, (uint8_t *)ctx->in,
+					    BENCH_FILTER_SCANS,
+					    (uint8_t *)ctx->out);
+	bench_sink = ctx->out[nb_out - 1][0];
+
+	return 0;
+}
+
+static const struct iio_filter_cfg filter_ma16 = {
+	.type = IIO_FILTER_MOVING_AVERAGE,
+	.decimation = 16,
+};
+
+static const struct iio_filter_cfg filter_cic3_16 = {
+	.type = IIO_FILTER_CIC,
+	.decimation = 16,
+	.order = 3,
+};
+
+/* Boxcar of 16 taps: unity gain in Q15 */
+static const struct iio_filter_cfg filter_fir16_4 = {
+	.type = IIO_FILTER_FIR,
+	.decimation = 4,
+	.taps = {
+		2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+		2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+	},
+	.nb_taps = BENCH_FILTER_TAPS,
+};
+
+/*
+ * READBUF over a loopback TCP connection
+ */
+struct readbuf_arg {
+	/* Enable the delta_varint compression of the buffer */
+	bool compress;
+	/* Slowly changing samples instead of the adc_demo sine */
+	bool slow;
+	/* Simulated link rate in bytes per second, 0 for no limit */
+	uint32_t link_rate;
+	/* Decimation of an order 3 CIC filter on the voltage channels, 0 for
+	 * no filter */
+	uint32_t decimation;
+};
+
+struct readbuf_ctx {
+	struct adc_demo_desc *adc;
+	struct iio_desc *iio;
+	pthread_t server;
+	volatile bool stop;
+	int fd;
+	struct readbuf_arg arg;
+	/* Next expected value of the sample counter */
+	uint32_t count;
+	/* Decoder of the compressed buffer */
+	struct iio_delta delta;
+	/* Encoded bytes received and not decoded yet */
+	uint8_t enc[BENCH_READBUF_DELTA_CHUNK];
+	uint32_t enc_len;
+	uint32_t enc_idx;
+	char buf[BENCH_READBUF_SIZE];
+};
+
+static uint16_t readbuf_slow_data[TOTAL_ADC_CHANNELS][BENCH_SLOW_LEN];
+
+static void *readbuf_server(void *arg)
+{
+	struct readbuf_ctx *ctx = arg;
+
+	while (!ctx->stop)
+		iio_step(ctx->iio);
+
+	return NULL;
+}
+
+static int client_write(int fd, const char *str)
+{
+	uint32_t len = strlen(str);
+	ssize_t ret;
+
+	while (len) {
+		ret = send(fd, str, len, 0);
+		if (ret < 0)
+			return -errno;
+		str += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static int client_read(int fd, char *buf, uint32_t len)
+{
+	ssize_t ret;
+
+	while (len) {
+		ret = recv(fd, buf, len, 0);
+		if (ret < 0)
+			return -errno;
+		if (!ret)
+			return -ENOTCONN;
+		buf += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/* Read a '\n' terminated answer and return its integer value */
+static int client_read_line(int fd, char *buf, uint32_t len, int32_t *val)
+{
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < len - 1; i++) {
+		ret = client_read(fd, &buf[i], 1);
+		if (ret)
+			return ret;
+		if (buf[i] == '\n')
+			break;
+	}
+	buf[i] = '\0';
+
+	if (val)
+		*val = strtol(buf, NULL, 0);
+
+	return 0;
+}
+
+static int client_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(BENCH_IIOD_PORT),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	int one = 1;
+	int fd;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0)
+		return -errno;
+
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(fd);
+		return -errno;
+	}
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+	return fd;
+}
+
+/* Write a device buffer attribute and check the answer */
+static int client_write_buffer_attr(int fd, const char *attr, const char *val,
+				    char *buf, uint32_t len)
+{
+	int32_t res;
+	int ret;
+
+	snprintf(buf, len, "WRITE iio:device0 BUFFER %s %u\r\n", attr,
+		 (unsigned int)strlen(val));
+	ret = client_write(fd, buf);
+	if (ret)
+		return ret;
+	ret = client_write(fd, val);
+	if (ret)
+		return ret;
+	ret = client_read_line(fd, buf, len, &res);
+	if (ret)
+		return ret;
+
+	return res < 0 ? res : 0;
+}
+
+static int readbuf_setup(void **pctx)
+{
+	static const struct readbuf_arg no_arg;
+	const struct readbuf_arg *arg = *pctx ? *pctx : &no_arg;
+	struct adc_demo_init_param adc_ip = { 0 };
+	struct tcp_socket_init_param socket_ip = {
+		.net = &linux_net,
+	};
+	struct iio_device_init dev = {
+		.name = "adc_demo",
+		.dev_descriptor = &adc_demo_iio_descriptor,
+	};
+	struct iio_init_param iio_ip = {
+		.phy_type = USE_NETWORK,
+		.tcp_socket_init_param = &socket_ip,
+		.devs = &dev,
+		.nb_devs = 1,
+	};
+	struct readbuf_ctx *ctx;
+	char val_str[16];
+	char cmd[64];
+	uint32_t i, j;
+	int32_t val;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ctx->arg = *arg;
+
+	if (arg->slow) {
+		/* A few LSBs of noise around a slow ramp */
+		srand(1);
+		for (i = 0; i < TOTAL_ADC_CHANNELS; i++)
+			for (j = 0; j < BENCH_SLOW_LEN; j++)
+				readbuf_slow_data[i][j] = 0x4000 * (i + 1) + j / 16 +
+							  rand() % 7;
+		adc_ip.ext_buff = (uint16_t **)readbuf_slow_data;
+		adc_ip.ext_buff_len = BENCH_SLOW_LEN;
+	}
+
+	ret = adc_demo_init(&ctx->adc, &adc_ip);
+	if (ret)
+		goto free_ctx;
+
+	dev.dev = ctx->adc;
+	ret = iio_init(&ctx->iio, &iio_ip);
+	if (ret)
+		goto free_adc;
+
+	ret = pthread_create(&ctx->server, NULL, readbuf_server, ctx);
+	if (ret) {
+		ret = -ret;
+		goto free_iio;
+	}
+
+	ctx->fd = client_connect();
+	if (ctx->fd < 0) {
+		ret = ctx->fd;
+		goto stop_server;
+	}
+
+	if (arg->compress) {
+		ret = client_write_buffer_attr(ctx->fd, "compression",
+					       "delta_varint", cmd, sizeof(cmd));
+		if (ret)
+			goto close_fd;
+
+		/* Two 16 bit voltage channels and the 32 bit counter */
+		iio_delta_init(&ctx->delta);
+		iio_delta_add_channel(&ctx->delta, sizeof(uint16_t), false);
+		iio_delta_add_channel(&ctx->delta, sizeof(uint16_t), false);
+		iio_delta_add_channel(&ctx->delta, sizeof(uint32_t), false);
+	}
+
+	/* The counter keeps the last sample of each window */
+	ctx->count = arg->decimation ? arg->decimation - 1 : 0;
+	if (arg->decimation) {
+		snprintf(val_str, sizeof(val_str), "%u",
+			 (unsigned int)arg->decimation);
+		ret = client_write_buffer_attr(ctx->fd, "filter", "cic", cmd,
+					       sizeof(cmd));
+		if (!ret)
+			ret = client_write_buffer_attr(ctx->fd, "filter_order",
+						       "3", cmd, sizeof(cmd));
+		if (!ret)
+			ret = client_write_buffer_attr(ctx->fd, "filter_mask",
+						       "0x3", cmd, sizeof(cmd));
+		if (!ret)
+			ret = client_write_buffer_attr(ctx->fd, "decimation",
+						       val_str, cmd, sizeof(cmd));
+		if (ret)
+			goto close_fd;
+	}
+
+	sprintf(cmd, "OPEN iio:device0 %d %08x\r\n", BENCH_READBUF_SCANS,
+		BENCH_READBUF_MASK);
+	ret = client_write(ctx->fd, cmd);
+	if (ret)
+		goto close_fd;
+	ret = client_read_line(ctx->fd, cmd, sizeof(cmd), &val);
+	if (ret)
+		goto close_fd;
+	if (val) {
+		ret = val;
+		goto close_fd;
+	}
+
+	*pctx = ctx;
+
+	return 0;
+
+close_fd:
+	close(ctx->fd);
+stop_server:
+	/* Let the server drop the connection so the client ends in TIME_WAIT */
+	usleep(10000);
+	ctx->stop = true;
+	pthread_join(ctx->server, NULL);
+free_iio:
+	iio_remove(ctx->iio);
+free_adc:
+	adc_demo_remove(ctx->adc);
+free_ctx:
+	free(ctx);
+
+	return ret;
+}
+
+static void readbuf_teardown(void *pctx)
+{
+	struct readbuf_ctx *ctx = pctx;
+
+	client_write(ctx->fd, "CLOSE iio:device0\r\n");
+	client_read_line(ctx->fd, ctx->buf, sizeof(ctx->buf), NULL);
+	close(ctx->fd);
+	usleep(10000);
+	ctx->stop = true;
+	pthread_join(ctx->server, NULL);
+	iio_remove(ctx->iio);
+	adc_demo_remove(ctx->adc);
+	free(ctx);
+}
+
+/* Send READBUF and receive the answer header, return the number of bytes */
+static int readbuf_cmd(struct readbuf_ctx *ctx, uint32_t bytes)
+{
+	char cmd[64];
+	int32_t val;
+	int ret;
+
+	sprintf(cmd, "READBUF iio:device0 %u\r\n", (unsigned int)bytes);
+	ret = client_write(ctx->fd, cmd);
+	if (ret)
+		return ret;
+
+	/* Number of bytes that follow */
+	ret = client_read_line(ctx->fd, cmd, sizeof(cmd), &val);
+	if (ret)
+		return ret;
+	if (val != (int32_t)bytes)
+		return val < 0 ? val : -EIO;
+
+	/* Channel mask */
+	return client_read_line(ctx->fd, cmd, sizeof(cmd), NULL);
+}
+
+/* Receive BENCH_READBUF_SCANS scans of a compressed buffer */
+static int readbuf_delta(struct readbuf_ctx *ctx, uint32_t *wire_bytes)
+{
+	uint32_t needed = BENCH_READBUF_SCANS;
+	uint8_t *out = (uint8_t *)ctx->buf;
+	uint32_t nb_scans;
+	int32_t ret;
+
+	while (needed) {
+		if (ctx->enc_idx == ctx->enc_len) {
+			ret = readbuf_cmd(ctx, BENCH_READBUF_DELTA_CHUNK);
+			if (ret)
+				return ret;
+			ret = client_read(ctx->fd, (char *)ctx->enc,
+					  BENCH_READBUF_DELTA_CHUNK);
+			if (ret)
+				return ret;
+
+			ctx->enc_len = BENCH_READBUF_DELTA_CHUNK;
+			ctx->enc_idx = 0;
+			*wire_bytes += BENCH_READBUF_DELTA_CHUNK;
+		}
+
+		nb_scans = needed;
+		ret = iio_delta_decode(&ctx->delta, ctx->enc + ctx->enc_idx,
+				       ctx->enc_len - ctx->enc_idx, out,
+				       &nb_scans);
+		if (ret < 0)
+			return ret;
+
+		ctx->enc_idx += ret;
+		needed -= nb_scans;
+		out += nb_scans * BENCH_READBUF_SCAN_SIZE;
+	}
+
+	return 0;
+}
+
+static int readbuf_run(void *pctx, uint32_t nb_ops)
+{
+	struct readbuf_ctx *ctx = pctx;
+	struct timespec ts;
+	uint32_t step = no_os_max(ctx->arg.decimation, 1u);
+	uint32_t wire_bytes;
+	uint32_t count, i;
+	uint64_t start;
+	uint64_t end;
+	int ret;
+
+	while (nb_ops--) {
+		start = bench_now_ns();
+		wire_bytes = 0;
+		if (ctx->arg.compress) {
+			ret = readbuf_delta(ctx, &wire_bytes);
+			if (ret)
+				return ret;
+		} else {
+			ret = readbuf_cmd(ctx, BENCH_READBUF_SIZE);
+			if (ret)
+				return ret;
+			ret = client_read(ctx->fd, ctx->buf, BENCH_READBUF_SIZE);
+			if (ret)
+				return ret;
+			wire_bytes = BENCH_READBUF_SIZE;
+		}
+
+		/* The stream must be gap-free */
+		for (i = 0; i < BENCH_READBUF_SIZE; i += BENCH_READBUF_SCAN_SIZE) {
+			memcpy(&count, &ctx->buf[i + BENCH_READBUF_COUNT_POS],
+			       sizeof(count));
+			if (count != ctx->count)
+				return -EIO;
+			ctx->count += step;
+		}
+
+		/* The data can't arrive faster than the link carries it */
+		if (ctx->arg.link_rate) {
+			end = start + (uint64_t)wire_bytes * 1000000000 /
+			      ctx->arg.link_rate;
+			ts.tv_sec = end / 1000000000;
+			ts.tv_nsec = end % 1000000000;
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts,
+					NULL);
+		}
+	}
+
+	return 0;
+}
+
+static const struct readbuf_arg readbuf_delta_arg = {
+	.compress = true,
+	.slow = true,
+};
+
+/* About a 1 Mbaud UART */
+static const struct readbuf_arg readbuf_link_arg = {
+	.slow = true,
+	.link_rate = 100000,
+};
+
+static const struct readbuf_arg readbuf_link_cic_arg = {
+	.slow = true,
+	.link_rate = 100000,
+	.decimation = 16,
+};
+
+static const struct readbuf_arg readbuf_link_delta_arg = {
+	.compress = true,
+	.slow = true,
+	.link_rate = 100000,
+};
+
+/*
+ * Context xml generation and transfer
+ */
+struct xml_ctx {
+	struct adc_demo_desc *adc;
+	struct iio_desc *iio;
+	pthread_t server;
+	volatile bool stop;
+	int fd;
+	/* Ask XMLHASH and skip PRINT if the hash didn't change */
+	bool cached;
+	char hash[16];
+	char buf[8192];
+};
+
+static int xml_local_read(void *conn, uint8_t *buf, uint32_t len)
+{
+	return 0;
+}
+
+static int xml_local_write(void *conn, uint8_t *buf, uint32_t len)
+{
+	return len;
+}
+
+/* iio_init() and iio_remove() of the adc_demo context */
+static int xml_init_run(void *pctx, uint32_t nb_ops)
+{
+	static char local_buf[64];
+	struct iio_local_backend local = {
+		.local_backend_event_read = xml_local_read,
+		.local_backend_event_write = xml_local_write,
+		.local_backend_buff = local_buf,
+		.local_backend_buff_len = sizeof(local_buf),
+	};
+	struct iio_device_init dev = {
+		.name = "adc_demo",
+		.dev_descriptor = &adc_demo_iio_descriptor,
+	};
+	struct iio_init_param iio_ip = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &local,
+		.devs = &dev,
+		.nb_devs = 1,
+	};
+	struct xml_ctx *ctx = pctx;
+	struct iio_desc *iio;
+	uint32_t len;
+	int ret;
+
+	dev.dev = ctx->adc;
+	if (ctx->cached) {
+		ret = iio_get_xml(ctx->iio, &iio_ip.xml, &len, NULL);
+		if (ret)
+			return ret;
+		iio_ip.xml_len = len;
+	}
+
+	while (nb_ops--) {
+		ret = iio_init(&iio, &iio_ip);
+		if (ret)
+			return ret;
+		iio_remove(iio);
+	}
+
+	return 0;
+}
+
+static void *xml_server(void *arg)
+{
+	struct xml_ctx *ctx = arg;
+
+	while (!ctx->stop)
+		iio_step(ctx->iio);
+
+	return NULL;
+}
+
+static int xml_setup(void **pctx)
+{
+	struct tcp_socket_init_param socket_ip = {
+		.net = &linux_net,
+	};
+	struct iio_device_init dev = {
+		.name = "adc_demo",
+		.dev_descriptor = &adc_demo_iio_descriptor,
+	};
+	struct iio_init_param iio_ip = {
+		.phy_type = USE_NETWORK,
+		.tcp_socket_init_param = &socket_ip,
+		.devs = &dev,
+		.nb_devs = 1,
+	};
+	struct adc_demo_init_param adc_ip = { 0 };
+	const char *xml, *hash;
+	struct xml_ctx *ctx;
+	uint32_t len;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ctx->cached = *pctx != NULL;
+	ctx->fd = -1;
+
+	ret = adc_demo_init(&ctx->adc, &adc_ip);
+	if (ret)
+		goto free_ctx;
+
+	dev.dev = ctx->adc;
+	ret = iio_init(&ctx->iio, &iio_ip);
+	if (ret)
+		goto free_adc;
+
+	ret = iio_get_xml(ctx->iio, &xml, &len, &hash);
+	if (ret)
+		goto free_iio;
+	strcpy(ctx->hash, hash);
+
+	*pctx = ctx;
+
+	return 0;
+
+free_iio:
+	iio_remove(ctx->iio);
+free_adc:
+	adc_demo_remove(ctx->adc);
+free_ctx:
+	free(ctx);
+
+	return ret;
+}
+
+static int xml_connect_setup(void **pctx)
+{
+	struct xml_ctx *ctx;
+	int ret;
+
+	ret = xml_setup(pctx);
+	if (ret)
+		return ret;
+	ctx = *pctx;
+
+	ret = pthread_create(&ctx->server, NULL, xml_server, ctx);
+	if (ret) {
+		ret = -ret;
+		goto free_iio;
+	}
+
+	ctx->fd = client_connect();
+	if (ctx->fd < 0) {
+		ret = ctx->fd;
+		goto stop_server;
+	}
+
+	return 0;
+
+stop_server:
+	ctx->stop = true;
+	pthread_join(ctx->server, NULL);
+free_iio:
+	iio_remove(ctx->iio);
+	adc_demo_remove(ctx->adc);
+	free(ctx);
+
+	return ret;
+}
+
+static void xml_teardown(void *pctx)
+{
+	struct xml_ctx *ctx = pctx;
+
+	if (ctx->fd >= 0) {
+		close(ctx->fd);
+		usleep(10000);
+		ctx->stop = true;
+		pthread_join(ctx->server, NULL);
+	}
+	iio_remove(ctx->iio);
+	adc_demo_remove(ctx->adc);
+	free(ctx);
+}
+
+/* Send a command answered with a length and a payload, return the length */
+static int xml_cmd(struct xml_ctx *ctx, const char *cmd)
+{
+	int32_t val;
+	int ret;
+
+	ret = client_write(ctx->fd, cmd);
+	if (ret)
+		return ret;
+	ret = client_read_line(ctx->fd, ctx->buf, sizeof(ctx->buf), &val);
+	if (ret)
+		return ret;
+	if (val < 0)
+		return val;
+	if ((uint32_t)val >= sizeof(ctx->buf))
+		return -EFBIG;
+
+	/* The payload is followed by a '\n' */
+	ret = client_read(ctx->fd, ctx->buf, val + 1);
+	if (ret)
+		return ret;
+	ctx->buf[val] = '\0';
+
+	return val;
+}
+
+/* Get the context description as a client does when it connects */
+static int xml_connect_run(void *pctx, uint32_t nb_ops)
+{
+	struct xml_ctx *ctx = pctx;
+	struct timespec ts;
+	uint32_t wire_bytes;
+	uint64_t end;
+	int ret;
+
+	while (nb_ops--) {
+		end = bench_now_ns();
+		wire_bytes = 0;
+		if (ctx->cached) {
+			ret = xml_cmd(ctx, "XMLHASH\r\n");
+			if (ret < 0)
+				return ret;
+			wire_bytes += ret;
+			if (strcmp(ctx->buf, ctx->hash))
+				return -EILSEQ;
+		} else {
+			ret = xml_cmd(ctx, "PRINT\r\n");
+			if (ret < 0)
+				return ret;
+			wire_bytes += ret;
+			if (!strstr(ctx->buf, "</context>"))
+				return -EILSEQ;
+		}
+
+		/* The data can't arrive faster than the link carries it */
+		end += (uint64_t)wire_bytes * 1000000000 /
+		       readbuf_link_arg.link_rate;
+		ts.tv_sec = end / 1000000000;
+		ts.tv_nsec = end % 1000000000;
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+	}
+
+	return 0;
+}
+
+/*
+ * Two adc_demo devices sampled on the same trigger
+ */
+#define BENCH_TRIG_DEVS		2
+#define BENCH_TRIG_SCANS	256
+/* The adc_demo channels of BENCH_READBUF_MASK and the 64 bit timestamp */
+#define BENCH_TRIG_MASK		0xf
+#define BENCH_TRIG_SCAN_SIZE	16
+#define BENCH_TRIG_TS_POS	8
+#define BENCH_TRIG_SIZE		(BENCH_TRIG_SCANS * BENCH_TRIG_SCAN_SIZE)
+
+struct trig_ctx {
+	struct adc_demo_desc *adc[BENCH_TRIG_DEVS];
+	struct iio_desc *iio;
+	pthread_t server;
+	volatile bool stop;
+	int fd;
+	uint32_t trig_idx;
+	uint64_t timestamp;
+	char buf[BENCH_TRIG_DEVS][BENCH_TRIG_SIZE];
+};
+
+static struct iio_trigger trig_descriptor = {
+	.is_synchronous = false,
+};
+
+static void *trig_server(void *arg)
+{
+	struct trig_ctx *ctx = arg;
+
+	while (!ctx->stop)
+		iio_step(ctx->iio);
+
+	return NULL;
+}
+
+/* Send a command answered with a single integer */
+static int trig_cmd(struct trig_ctx *ctx, const char *cmd, int32_t *val)
+{
+	char line[64];
+	int ret;
+
+	ret = client_write(ctx->fd, cmd);
+	if (ret)
+		return ret;
+
+	return client_read_line(ctx->fd, line, sizeof(line), val);
+}
+
+static int trig_setup(void **pctx)
+{
+	struct adc_demo_init_param adc_ip = { 0 };
+	struct tcp_socket_init_param socket_ip = {
+		.net = &linux_net,
+	};
+	struct iio_device_init devs[BENCH_TRIG_DEVS];
+	struct iio_trigger_init trig = {
+		.name = "bench-trig",
+		.descriptor = &trig_descriptor,
+	};
+	struct iio_init_param iio_ip = {
+		.phy_type = USE_NETWORK,
+		.tcp_socket_init_param = &socket_ip,
+		.devs = devs,
+		.nb_devs = BENCH_TRIG_DEVS,
+		.trigs = &trig,
+		.nb_trigs = 1,
+	};
+	struct trig_ctx *ctx;
+	char cmd[64];
+	int32_t val;
+	uint32_t i;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+
+	memset(devs, 0, sizeof(devs));
+	for (i = 0; i < BENCH_TRIG_DEVS; i++) {
+		ret = adc_demo_init(&ctx->adc[i], &adc_ip);
+		if (ret)
+			goto free_adc;
+
+		devs[i].name = "adc_demo";
+		devs[i].dev = ctx->adc[i];
+		devs[i].dev_descriptor = &adc_demo_iio_descriptor;
+		devs[i].trigger_id = "trigger0";
+	}
+
+	ret = iio_init(&ctx->iio, &iio_ip);
+	if (ret)
+		goto free_adc;
+
+	ret = iio_get_trigger_idx(ctx->iio, "bench-trig", &ctx->trig_idx);
+	if (ret)
+		goto free_iio;
+
+	ret = pthread_create(&ctx->server, NULL, trig_server, ctx);
+	if (ret) {
+		ret = -ret;
+		goto free_iio;
+	}
+
+	ctx->fd = client_connect();
+	if (ctx->fd < 0) {
+		ret = ctx->fd;
+		goto stop_server;
+	}
+
+	for (i = 0; i < BENCH_TRIG_DEVS; i++) {
+		sprintf(cmd, "OPEN iio:device%u %d %08x\r\n", (unsigned int)i,
+			BENCH_TRIG_SCANS, BENCH_TRIG_MASK);
+		ret = trig_cmd(ctx, cmd, &val);
+		if (ret)
+			goto close_fd;
+		if (val) {
+			ret = val;
+			goto close_fd;
+		}
+	}
+
+	*pctx = ctx;
+
+	return 0;
+
+close_fd:
+	close(ctx->fd);
+stop_server:
+	usleep(10000);
+	ctx->stop = true;
+	pthread_join(ctx->server, NULL);
+free_iio:
+	iio_remove(ctx->iio);
+free_adc:
+	for (i = 0; i < BENCH_TRIG_DEVS; i++)
+		if (ctx->adc[i])
+			adc_demo_remove(ctx->adc[i]);
+	free(ctx);
+
+	return ret;
+}
+
+static void trig_teardown(void *pctx)
+{
+	struct trig_ctx *ctx = pctx;
+	char cmd[64];
+	uint32_t i;
+
+	for (i = 0; i < BENCH_TRIG_DEVS; i++) {
+		sprintf(cmd, "CLOSE iio:device%u\r\n", (unsigned int)i);
+		trig_cmd(ctx, cmd, NULL);
+	}
+	close(ctx->fd);
+	usleep(10000);
+	ctx->stop = true;
+	pthread_join(ctx->server, NULL);
+	iio_remove(ctx->iio);
+	for (i = 0; i < BENCH_TRIG_DEVS; i++)
+		adc_demo_remove(ctx->adc[i]);
+	free(ctx);
+}
+
+/* Read a buffer attribute of a device as an integer */
+static int trig_read_attr(struct trig_ctx *ctx, uint32_t dev,
+			  const char *attr, int32_t *val)
+{
+	char cmd[64];
+	int32_t len;
+	int ret;
+
+	sprintf(cmd, "READ iio:device%u BUFFER %s\r\n", (unsigned int)dev,
+		attr);
+	ret = trig_cmd(ctx, cmd, &len);
+	if (ret)
+		return ret;
+	if (len < 0)
+		return len;
+	if (len >= (int32_t)sizeof(cmd))
+		return -EFBIG;
+
+	/* The value is followed by a '\n' */
+	ret = client_read(ctx->fd, cmd, len + 1);
+	if (ret)
+		return ret;
+	cmd[len] = '\0';
+	*val = strtol(cmd, NULL, 0);
+
+	return 0;
+}
+
+/* Trigger a burst of scans and read them back from both devices */
+static int trig_run(void *pctx, uint32_t nb_ops)
+{
+	struct trig_ctx *ctx = pctx;
+	uint32_t count[BENCH_TRIG_DEVS];
+	uint64_t ts[BENCH_TRIG_DEVS];
+	uint64_t prev_ts = 0;
+	int32_t seq[BENCH_TRIG_DEVS];
+	int32_t lost;
+	char cmd[64];
+	int32_t val;
+	uint32_t i, j;
+	int ret;
+
+	while (nb_ops--) {
+		for (i = 0; i < BENCH_TRIG_SCANS; i++) {
+			ret = iio_process_trigger(ctx->iio, ctx->trig_idx,
+						  ++ctx->timestamp);
+			if (ret)
+				return ret;
+		}
+
+		for (i = 0; i < BENCH_TRIG_DEVS; i++) {
+			sprintf(cmd, "READBUF iio:device%u %d\r\n",
+				(unsigned int)i, BENCH_TRIG_SIZE);
+			ret = trig_cmd(ctx, cmd, &val);
+			if (ret)
+				return ret;
+			if (val != BENCH_TRIG_SIZE)
+				return val < 0 ? val : -EIO;
+
+			/* Channel mask */
+			ret = client_read_line(ctx->fd, cmd, sizeof(cmd), NULL);
+			if (ret)
+				return ret;
+			ret = client_read(ctx->fd, ctx->buf[i], BENCH_TRIG_SIZE);
+			if (ret)
+				return ret;
+		}
+
+		/*
+		 * The scans of both devices come from the same events and are
+		 * stamped with the event timestamps. Events pending when more
+		 * come may share the timestamp of a later one.
+		 */
+		for (i = 0; i < BENCH_TRIG_SIZE; i += BENCH_TRIG_SCAN_SIZE) {
+			for (j = 0; j < BENCH_TRIG_DEVS; j++) {
+				memcpy(&count[j],
+				       &ctx->buf[j][i + BENCH_READBUF_COUNT_POS],
+				       sizeof(count[j]));
+				memcpy(&ts[j], &ctx->buf[j][i + BENCH_TRIG_TS_POS],
+				       sizeof(ts[j]));
+			}
+			if (count[0] != count[1] || ts[0] != ts[1] ||
+			    ts[0] < prev_ts || ts[0] > ctx->timestamp)
+				return -EIO;
+			prev_ts = ts[0];
+		}
+		if (prev_ts != ctx->timestamp)
+			return -EIO;
+	}
+
+	for (i = 0; i < BENCH_TRIG_DEVS; i++) {
+		ret = trig_read_attr(ctx, i, "scan_gaps", &lost);
+		if (ret)
+			return ret;
+		if (lost)
+			return -EIO;
+		ret = trig_read_attr(ctx, i, "overruns", &lost);
+		if (ret)
+			return ret;
+		if (lost)
+			return -EIO;
+		ret = trig_read_attr(ctx, i, "scan_sequence", &seq[i]);
+		if (ret)
+			return ret;
+	}
+
+	return seq[0] == seq[1] ? 0 : -EIO;
+}
+
+static const bool xml_cached = true;
+
+const struct bench_case bench_iio_cases[] = {
+	{
+		.name = "iio_format_int",
+		.arg = &format_int,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_int_ref",
+		.arg = &format_int,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_format_int_plus_micro",
+		.arg = &format_micro,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_int_plus_micro_ref",
+		.arg = &format_micro,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_format_int_plus_nano",
+		.arg = &format_nano,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_int_plus_nano_ref",
+		.arg = &format_nano,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_format_fractional",
+		.arg = &format_fractional,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_fractional_ref",
+		.arg = &format_fractional,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_format_fractional_log2",
+		.arg = &format_log2,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_fractional_log2_ref",
+		.arg = &format_log2,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_format_int_multiple_16",
+		.arg = &format_multiple,
+		.run = format_run,
+	},
+	{
+		.name = "iio_format_int_multiple_16_ref",
+		.arg = &format_multiple,
+		.run = format_ref_run,
+	},
+	{
+		.name = "iio_parse_int",
+		.arg = &parse_int,
+		.run = parse_run,
+	},
+	{
+		.name = "iio_parse_int_ref",
+		.arg = &parse_int,
+		.run = parse_ref_run,
+	},
+	{
+		.name = "iio_parse_int_plus_micro",
+		.arg = &parse_micro,
+		.run = parse_run,
+	},
+	{
+		.name = "iio_parse_int_plus_micro_ref",
+		.arg = &parse_micro,
+		.run = parse_ref_run,
+	},
+	{
+		.name = "iio_parse_int_plus_nano",
+		.arg = &parse_nano,
+		.run = parse_run,
+	},
+	{
+		.name = "iio_parse_int_plus_nano_ref",
+		.arg = &parse_nano,
+		.run = parse_ref_run,
+	},
+	{
+		.name = "iio_parse_fractional",
+		.arg = &parse_fractional,
+		.run = parse_run,
+	},
+	{
+		.name = "iio_parse_fractional_ref",
+		.arg = &parse_fractional,
+		.run = parse_ref_run,
+	},
+	{
+		.name = "iio_value_ref_compare",
+		.run = compare_run,
+	},
+	{
+		.name = "iiod_parse_line_readbuf",
+		.arg = "READBUF iio:device0 4096\r\n",
+		.run = parse_line_run,
+	},
+	{
+		.name = "iiod_parse_line_read_attr",
+		.arg = "READ iio:device0 INPUT voltage0 sampling_frequency\r\n",
+		.run = parse_line_run,
+	},
+	{
+		.name = "iiod_parse_line_write_attr",
+		.arg = "WRITE iio:device0 INPUT voltage0 raw 6\r\n",
+		.run = parse_line_run,
+	},
+	{
+		.name = "iiod_readbuf_loopback_4k",
+		.bytes_per_op = BENCH_READBUF_SIZE,
+		.setup = readbuf_setup,
+		.run = readbuf_run,
+		.teardown = readbuf_teardown,
+	},
+	{
+		.name = "iiod_readbuf_loopback_4k_delta",
+		.bytes_per_op = BENCH_READBUF_SIZE,
+		.arg = &readbuf_delta_arg,
+		.setup = readbuf_setup,
+		.run = readbuf_run,
+		.teardown = readbuf_teardown,
+	},
+	{
+		.name = "iiod_readbuf_100kBps_4k",
+		.bytes_per_op = BENCH_READBUF_SIZE,
+		.arg = &readbuf_link_arg,
+		.setup = readbuf_setup,
+		.run = readbuf_run,
+		.teardown = readbuf_teardown,
+	},
+	{
+		.name = "iiod_readbuf_100kBps_4k_delta",
+		.bytes_per_op = BENCH_READBUF_SIZE,
+		.arg = &readbuf_link_delta_arg,
+		.setup = readbuf_setup,
+		.run = readbuf_run,
+		.teardown = readbuf_teardown,
+	},
+	{
+		.name = "iiod_readbuf_100kBps_4k_cic16",
+		.bytes_per_op = 16 * BENCH_READBUF_SIZE,
+		.arg = &readbuf_link_cic_arg,
+		.setup = readbuf_setup,
+		.run = readbuf_run,
+		.teardown = readbuf_teardown,
+	},
+	{
+		.name = "iio_init_xml_generated",
+		.setup = xml_setup,
+		.run = xml_init_run,
+		.teardown = xml_teardown,
+	},
+	{
+		.name = "iio_init_xml_precomputed",
+		.arg = &xml_cached,
+		.setup = xml_setup,
+		.run = xml_init_run,
+		.teardown = xml_teardown,
+	},
+	{
+		.name = "iiod_connect_100kBps_print",
+		.setup = xml_connect_setup,
+		.run = xml_connect_run,
+		.teardown = xml_teardown,
+	},
+	{
+		.name = "iiod_connect_100kBps_xmlhash",
+		.arg = &xml_cached,
+		.setup = xml_connect_setup,
+		.run = xml_connect_run,
+		.teardown = xml_teardown,
+	},
+	{
+		.name = "iio_trigger_shared_2dev",
+		.bytes_per_op = BENCH_TRIG_DEVS * BENCH_TRIG_SIZE,
+		.setup = trig_setup,
+		.run = trig_run,
+		.teardown = trig_teardown,
+	},
+	{
+		.name = "iio_delta_encode_16ch",
+		.bytes_per_op = BENCH_DELTA_SIZE,
+		.setup = delta_setup,
+		.run = delta_encode_run,
+		.teardown = delta_teardown,
+	},
+	{
+		.name = "iio_delta_decode_16ch",
+		.bytes_per_op = BENCH_DELTA_SIZE,
+		.setup = delta_setup,
+		.run = delta_decode_run,
+		.teardown = delta_teardown,
+	},
+	{
+		.name = "iio_scan_demux_16ch_u16",
+		.bytes_per_op = BENCH_SCAN_SIZE,
+		.setup = scan_setup,
+		.run = scan_demux_run,
+		.teardown = scan_teardown,
+	},
+	{
+		.name = "iio_scan_demux_16ch_u16_ref",
+		.bytes_per_op = BENCH_SCAN_SIZE,
+		.setup = scan_setup,
+		.run = scan_demux_ref_run,
+		.teardown = scan_teardown,
+	},
+	{
+		.name = "iio_scan_mux_16ch_u16",
+		.bytes_per_op = BENCH_SCAN_SIZE,
+		.setup = scan_setup,
+		.run = scan_mux_run,
+		.teardown = scan_teardown,
+	},
+	{
+		.name = "iio_scan_mux_16ch_u16_ref",
+		.bytes_per_op = BENCH_SCAN_SIZE,
+		.setup = scan_setup,
+		.run = scan_mux_ref_run,
+		.teardown = scan_teardown,
+	},
+	{
+		.name = "iio_filter_moving_average_dec16_8ch",
+		.bytes_per_op = BENCH_FILTER_SIZE,
+		.arg = &filter_ma16,
+		.setup = filter_setup,
+		.run = filter_run,
+		.teardown = filter_teardown,
+	},
+	{
+		.name = "iio_filter_cic3_dec16_8ch",
+		.bytes_per_op = BENCH_FILTER_SIZE,
+		.arg = &filter_cic3_16,
+		.setup = filter_setup,
+		.run = filter_run,
+		.teardown = filter_teardown,
+	},
+	{
+		.name = "iio_filter_fir16_dec4_8ch",
+		.bytes_per_op = BENCH_FILTER_SIZE,
+		.arg = &filter_fir16_4,
+		.setup = filter_setup,
+		.run = filter_run,
+		.teardown = filter_teardown,
+	},
+};
+
+const uint32_t bench_iio_nb_cases = NO_OS_ARRAY_SIZE(bench_iio_cases);
@@ -0,0 +1,189 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "no_os_util.h"
+
+/*
+ * Copies of iio_format_value/iio_parse_value as implemented with libc
+ * formatting, used as a baseline and to check that the results are identical.
+ */
+
+static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
+			       int32_t *_fract_scale, bool scale_db)
+{
+	char *p;
+
+	p = strtok(buf, ".");
+	if (p == NULL)
+		return -EINVAL;
+
+	*integer = strtol(p, NULL, 0);
+
+	if (scale_db) {
+		p = strtok(NULL, "db");
+		if (p == NULL)
+			p = strtok(NULL, " db");
+	} else
+		p = strtok(NULL, "\n");
+
+	if (p == NULL)
+		return -EINVAL;
+
+	*_fract = strtol(p, NULL, 10);
+
+	/* Handle leading zeroes */
+	while (*p++ == '0' && *_fract > 0)
+		*_fract_scale *= 10;
+
+	/* Handle values between -1 and 0 */
+	if (*integer == 0 && buf[0] == '-')
+		*_fract *= -1;
+
+	return 0;
+}
+
+static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
+{
+	int32_t temp;
+	int32_t mult = 1;
+
+	if (fract < 0) {
+		mult = -1;
+		fract = -fract;
+	}
+
+	/* Divide to nearest subunit-scale if fract part is more than subunit */
+	while (fract >= subunits)
+		fract = NO_OS_DIV_ROUND_CLOSEST(fract, 10);
+
+	temp = fract;
+
+	while ((subunits != 0) || (temp != 0)) {
+		temp /= 10;
+		subunits /= 10;
+		if (!temp)
+			break;
+		if (subunits <= 1)
+			fract /= 10;
+	}
+
+	return fract * subunits * mult;
+}
+
+int32_t iio_parse_value_ref(char *buf, enum iio_val fmt, int32_t *val,
+			    int32_t *val2)
+{
+	int32_t ret = 0;
+	int32_t integer, _fract = 0, _fract_scale = 1;
+	char ch;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		integer = strtol(buf, NULL, 0);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		ret = __iio_str_parse(buf, &integer, &_fract,
+				      &_fract_scale, true);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract, 1000000 / _fract_scale);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO:
+		ret = __iio_str_parse(buf, &integer, &_fract,
+				      &_fract_scale, false);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract, 1000000 / _fract_scale);
+		break;
+	case IIO_VAL_INT_PLUS_NANO:
+		ret = __iio_str_parse(buf, &integer, &_fract,
+				      &_fract_scale, false);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract,
+					      1000000000 / _fract_scale);
+		break;
+	case IIO_VAL_FRACTIONAL:
+		ret = __iio_str_parse(buf, &integer, &_fract,
+				      &_fract_scale, false);
+		if (ret < 0)
+			return ret;
+		break;
+	case IIO_VAL_CHAR:
+		if (sscanf(buf, "%c", &ch) != 1)
+			return -EINVAL;
+		integer = ch;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (val)
+		*val = integer;
+	if (val2)
+		*val2 = _fract;
+
+	return ret;
+}
+
+int iio_format_value_ref(char *buf, uint32_t len, enum iio_val fmt,
+			 int32_t size, int32_t *vals)
+{
+	int64_t tmp;
+	int32_t integer, fractional;
+	bool dB = false;
+	int32_t i = 0;
+	uint32_t l = 0;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		return snprintf(buf, len, "%"PRIi32"", vals[0]);
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		dB = true;
+	/* intentional fall through */
+	case IIO_VAL_INT_PLUS_MICRO:
+		return snprintf(buf, len, "%s%"PRIi32".%06"PRIu32"%s",
+				vals[1] < 0 ? "-" : "", vals[0],
+				(uint32_t)vals[1], dB ? " dB" : "");
+	case IIO_VAL_INT_PLUS_NANO:
+		return snprintf(buf, len, "%s%"PRIi32".%09"PRIu32"",
+				vals[1] < 0 ? "-" : "", vals[0],
+				(uint32_t)vals[1]);
+	case IIO_VAL_FRACTIONAL:
+		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+		fractional = vals[1];
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_FRACTIONAL_LOG2:
+		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
+
+		if (integer == 0 && fractional < 0)
+			return snprintf(buf, len, "-0.%09u", abs(fractional));
+
+		return snprintf(buf, len, "%"PRIi32".%09u", integer,
+				abs(fractional));
+	case IIO_VAL_INT_MULTIPLE: {
+		while (i < size) {
+			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
+			if (l >= len)
+				break;
+			i++;
+		}
+		return l;
+	}
+	case IIO_VAL_CHAR:
+		return snprintf(buf, len, "%c", (char)vals[0]);
+	default:
+		return 0;
+	}
+}
@@ -0,0 +1,770 @@
+/***************************************************************************//**
+ *   @file   bench_net.c
+ *   @brief  Benchmarks for the OA TC6 MAC-PHY driver on a simulated device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_irq.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "oa_tc6.h"
+
+/*
+ * Bus timing model of the simulated MAC-PHY. Each transfer costs the time
+ * needed to clock its bytes out, plus a fixed setup time and the CS
+ * deassertion time of each message. The benchmark busy waits for that
+ * amount, so ns_per_op reflects the SPI traffic generated by the driver.
+ */
+#define OA_SIM_SPI_HZ		25000000
+#define OA_SIM_XFER_NS		2000
+#define OA_SIM_CS_NS		200
+
+#define OA_SIM_CHUNKS		31
+#define OA_SIM_RX_FRAMES	8
+#define OA_SIM_FRAME_LEN	1536
+/* Frames received back to back, must fit in the OA TC6 RX buffers */
+#define OA_SIM_BURST		4
+
+/* Number of oa_tc6_thread() calls after which a frame is considered lost */
+#define OA_SIM_MAX_POLLS	16
+
+/**
+ * @struct oa_sim
+ * @brief Simulated OA TC6 MAC-PHY. Frames written by the host are checked
+ * and discarded, the frames injected with oa_sim_inject() are read by the
+ * host.
+ */
+struct oa_sim {
+	/* Frames waiting in the RX FIFO */
+	uint8_t rx_frames[OA_SIM_RX_FRAMES][OA_SIM_FRAME_LEN];
+	uint32_t rx_len[OA_SIM_RX_FRAMES];
+	uint32_t rx_head;
+	uint32_t rx_count;
+	/* Bytes of the head frame already sent to the host */
+	uint32_t rx_offset;
+
+	/* Frame being written by the host */
+	uint8_t tx_frame[OA_SIM_FRAME_LEN];
+	uint32_t tx_len;
+	uint32_t tx_frames;
+	uint32_t tx_errors;
+
+	uint32_t config0;
+
+	struct no_os_callback_desc *irq_cb;
+	bool irq_asserted;
+};
+
+static struct oa_sim oa_sim;
+
+static void oa_sim_wait(uint64_t ns)
+{
+	uint64_t end = bench_now_ns() + ns;
+
+	while (bench_now_ns() < end)
+		;
+}
+
+static uint32_t oa_sim_parity(uint32_t val)
+{
+	uint32_t p = 1;
+
+	while (val) {
+		p ^= val & 0x1;
+		val >>= 1;
+	}
+
+	return p;
+}
+
+static uint32_t oa_sim_rx_chunks(struct oa_sim *sim)
+{
+	uint32_t chunks = 0;
+	uint32_t i;
+
+	for (i = 0; i < sim->rx_count; i++)
+		chunks += NO_OS_DIV_ROUND_UP(sim->rx_len[(sim->rx_head + i) %
+					     OA_SIM_RX_FRAMES], OA_CHUNK_SIZE);
+
+	chunks -= sim->rx_offset / OA_CHUNK_SIZE;
+
+	return no_os_min(chunks, OA_SIM_CHUNKS);
+}
+
+static uint32_t oa_sim_tx_credit(struct oa_sim *sim)
+{
+	/* Completed frames leave on the wire right away */
+	return OA_SIM_CHUNKS - no_os_min(NO_OS_DIV_ROUND_UP(sim->tx_len,
+					 OA_CHUNK_SIZE), OA_SIM_CHUNKS);
+}
+
+/* A frame arrives from the wire. */
+static int oa_sim_inject(struct oa_sim *sim, const uint8_t *data, uint32_t len)
+{
+	uint32_t idx;
+
+	if (sim->rx_count == OA_SIM_RX_FRAMES)
+		return -ENOBUFS;
+
+	idx = (sim->rx_head + sim->rx_count) % OA_SIM_RX_FRAMES;
+	memcpy(sim->rx_frames[idx], data, len);
+	sim->rx_len[idx] = len;
+	sim->rx_count++;
+
+	if (sim->irq_cb && !sim->irq_asserted) {
+		sim->irq_asserted = true;
+		sim->irq_cb->callback(sim->irq_cb->ctx);
+	}
+
+	return 0;
+}
+
+static void oa_sim_ctrl(struct oa_sim *sim, uint8_t *tx, uint8_t *rx,
+			uint32_t len)
+{
+	uint32_t header;
+	uint32_t addr;
+	uint32_t val = 0;
+
+	header = no_os_get_unaligned_be32(tx);
+	addr = no_os_field_get(OA_CTRL_ADDR_MMS_MASK, header);
+
+	if (header & OA_CTRL_WNR_MASK) {
+		val = no_os_get_unaligned_be32(&tx[OA_HEADER_LEN]);
+		if (addr == OA_TC6_CONFIG0_REG)
+			sim->config0 = val;
+	} else if (addr == OA_TC6_BUFST_REG) {
+		val = no_os_field_prep(OA_TC6_BUFSTS_TXC_MASK, oa_sim_tx_credit(sim)) |
+		      no_os_field_prep(OA_TC6_BUFSTS_RCA_MASK, oa_sim_rx_chunks(sim));
+	} else if (addr == OA_TC6_CONFIG0_REG) {
+		val = sim->config0;
+	}
+
+	memset(rx, 0, len);
+	if (len >= 2 * OA_HEADER_LEN + OA_REG_LEN) {
+		no_os_put_unaligned_be32(header, &rx[OA_HEADER_LEN]);
+		no_os_put_unaligned_be32(val, &rx[2 * OA_HEADER_LEN]);
+	}
+}
+
+static void oa_sim_tx_chunk(struct oa_sim *sim, uint32_t header, uint8_t *data)
+{
+	uint32_t len = OA_CHUNK_SIZE;
+
+	if (!(header & OA_DATA_HEADER_DV_MASK))
+		return;
+
+	if (header & OA_DATA_HEADER_SV_MASK)
+		sim->tx_len = 0;
+
+	if (header & OA_DATA_HEADER_EV_MASK)
+		len = no_os_field_get(OA_DATA_HEADER_EBO_MASK, header) + 1;
+
+	if (sim->tx_len + len > OA_SIM_FRAME_LEN) {
+		sim->tx_errors++;
+		sim->tx_len = 0;
+		return;
+	}
+
+	memcpy(&sim->tx_frame[sim->tx_len], data, len);
+	sim->tx_len += len;
+
+	if (header & OA_DATA_HEADER_EV_MASK) {
+		sim->tx_frames++;
+		sim->tx_len = 0;
+	}
+}
+
+static uint32_t oa_sim_rx_chunk(struct oa_sim *sim, uint32_t header,
+				uint8_t *data)
+{
+	uint32_t footer = 0;
+	uint32_t frame_len;
+	uint32_t len;
+
+	if (!(header & OA_DATA_HEADER_NORX_MASK) && sim->rx_count) {
+		frame_len = sim->rx_len[sim->rx_head];
+		len = no_os_min(frame_len - sim->rx_offset, OA_CHUNK_SIZE);
+		memcpy(data, &sim->rx_frames[sim->rx_head][sim->rx_offset], len);
+
+		footer |= OA_DATA_FOOTER_DV_MASK;
+		if (!sim->rx_offset)
+			footer |= OA_DATA_FOOTER_SV_MASK;
+
+		sim->rx_offset += len;
+		if (sim->rx_offset == frame_len) {
+			footer |= OA_DATA_FOOTER_EV_MASK;
+			footer |= no_os_field_prep(OA_DATA_FOOTER_EBO_MASK, len - 1);
+			sim->rx_head = (sim->rx_head + 1) % OA_SIM_RX_FRAMES;
+			sim->rx_count--;
+			sim->rx_offset = 0;
+		}
+	} else {
+		memset(data, 0, OA_CHUNK_SIZE);
+	}
+
+	footer |= OA_DATA_FOOTER_SYNC_MASK;
+	footer |= no_os_field_prep(OA_DATA_FOOTER_RCA_MASK, oa_sim_rx_chunks(sim));
+	footer |= no_os_field_prep(OA_DATA_FOOTER_TXC_MASK, oa_sim_tx_credit(sim));
+	footer |= oa_sim_parity(footer);
+
+	return footer;
+}
+
+static void oa_sim_data(struct oa_sim *sim, uint8_t *tx, uint8_t *rx,
+			uint32_t len)
+{
+	uint8_t chunk[OA_CHUNK_SIZE + OA_HEADER_LEN];
+	uint32_t footer;
+	uint32_t header;
+	uint32_t i;
+
+	for (i = 0; i + sizeof(chunk) <= len; i += sizeof(chunk)) {
+		/* tx and rx may be the same buffer */
+		memcpy(chunk, &tx[i], sizeof(chunk));
+		header = no_os_get_unaligned_be32(chunk);
+
+		oa_sim_tx_chunk(sim, header, &chunk[OA_HEADER_LEN]);
+		footer = oa_sim_rx_chunk(sim, header, &rx[i]);
+		no_os_put_unaligned_be32(footer, &rx[i + OA_CHUNK_SIZE]);
+	}
+
+	/* The footer was read, IRQn is deasserted */
+	sim->irq_asserted = false;
+}
+
+static int32_t oa_sim_spi_init(struct no_os_spi_desc **desc,
+			       const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int32_t oa_sim_spi_transfer(struct no_os_spi_desc *desc,
+				   struct no_os_spi_msg *msgs, uint32_t len)
+{
+	static uint8_t zeros[OA_SPI_BUFF_LEN];
+	static uint8_t discard[OA_SPI_BUFF_LEN];
+	struct oa_sim *sim = desc->extra;
+	uint64_t bytes = 0;
+	uint8_t *tx;
+	uint8_t *rx;
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (msgs[i].bytes_number > OA_SPI_BUFF_LEN)
+			return -EINVAL;
+
+		tx = msgs[i].tx_buff ? msgs[i].tx_buff : zeros;
+		rx = msgs[i].rx_buff ? msgs[i].rx_buff : discard;
+
+		if (no_os_get_unaligned_be32(tx) & OA_DATA_HEADER_DNC_MASK)
+			oa_sim_data(sim, tx, rx, msgs[i].bytes_number);
+		else
+			oa_sim_ctrl(sim, tx, rx, msgs[i].bytes_number);
+
+		bytes += msgs[i].bytes_number;
+	}
+
+	oa_sim_wait(bytes * 8 * 1000000000ULL / OA_SIM_SPI_HZ +
+		    OA_SIM_XFER_NS + len * OA_SIM_CS_NS);
+
+	return 0;
+}
+
+static int32_t oa_sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops oa_sim_spi_ops = {
+	.init = oa_sim_spi_init,
+	.transfer = oa_sim_spi_transfer,
+	.remove = oa_sim_spi_remove,
+};
+
+static int oa_sim_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				const struct no_os_irq_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int oa_sim_irq_register(struct no_os_irq_ctrl_desc *desc,
+			       uint32_t irq_id,
+			       struct no_os_callback_desc *cb)
+{
+	struct oa_sim *sim = desc->extra;
+
+	sim->irq_cb = cb;
+
+	return 0;
+}
+
+static int oa_sim_irq_unregister(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id,
+				 struct no_os_callback_desc *cb)
+{
+	struct oa_sim *sim = desc->extra;
+
+	sim->irq_cb = NULL;
+
+	return 0;
+}
+
+static int oa_sim_irq_nop(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	return 0;
+}
+
+static int oa_sim_irq_trig(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			   enum no_os_irq_trig_level trig)
+{
+	return 0;
+}
+
+static int oa_sim_irq_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_irq_platform_ops oa_sim_irq_ops = {
+	.init = oa_sim_irq_ctrl_init,
+	.register_callback = oa_sim_irq_register,
+	.unregister_callback = oa_sim_irq_unregister,
+	.trigger_level_set = oa_sim_irq_trig,
+	.enable = oa_sim_irq_nop,
+	.disable = oa_sim_irq_nop,
+	.remove = oa_sim_irq_remove,
+};
+
+/**
+ * @struct oa_bench
+ * @brief Context of the OA TC6 benchmarks.
+ */
+struct oa_bench {
+	struct oa_tc6_desc *oa;
+	struct no_os_spi_desc *spi;
+	struct no_os_irq_ctrl_desc *irq;
+	uint8_t frame[OA_SIM_FRAME_LEN];
+	uint32_t seq;
+};
+
+static int oa_bench_setup(void **ctx, bool irq)
+{
+	struct no_os_spi_init_param spi_ip = {
+		.max_speed_hz = OA_SIM_SPI_HZ,
+		.platform_ops = &oa_sim_spi_ops,
+		.extra = &oa_sim,
+	};
+	struct no_os_irq_init_param irq_ip = {
+		.platform_ops = &oa_sim_irq_ops,
+		.extra = &oa_sim,
+	};
+	struct oa_tc6_init_param oa_ip = {0};
+	struct oa_bench *bench;
+	int ret;
+
+	memset(&oa_sim, 0, sizeof(oa_sim));
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	ret = no_os_spi_init(&bench->spi, &spi_ip);
+	if (ret)
+		goto free_bench;
+
+	if (irq) {
+		ret = no_os_irq_ctrl_init(&bench->irq, &irq_ip);
+		if (ret)
+			goto free_spi;
+	}
+
+	oa_ip.comm_desc = bench->spi;
+	oa_ip.irq_ctrl = bench->irq;
+	ret = oa_tc6_init(&bench->oa, &oa_ip);
+	if (ret)
+		goto free_irq;
+
+	*ctx = bench;
+
+	return 0;
+
+free_irq:
+	if (bench->irq)
+		no_os_irq_ctrl_remove(bench->irq);
+free_spi:
+	no_os_spi_remove(bench->spi);
+free_bench:
+	no_os_free(bench);
+
+	return ret;
+}
+
+static int oa_bench_setup_poll(void **ctx)
+{
+	return oa_bench_setup(ctx, false);
+}
+
+static int oa_bench_setup_irq(void **ctx)
+{
+	return oa_bench_setup(ctx, true);
+}
+
+static void oa_bench_teardown(void *ctx)
+{
+	struct oa_bench *bench = ctx;
+
+	oa_tc6_remove(bench->oa);
+	if (bench->irq)
+		no_os_irq_ctrl_remove(bench->irq);
+	no_os_spi_remove(bench->spi);
+	no_os_free(bench);
+}
+
+static void oa_bench_fill(struct oa_bench *bench, uint8_t *data, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		data[i] = (uint8_t)(bench->seq + i);
+	no_os_put_unaligned_be32(bench->seq, data);
+	bench->seq++;
+}
+
+/* Queue a frame for transmission, without running the OA TC6 thread. */
+static int oa_bench_queue_tx(struct oa_bench *bench, uint32_t len)
+{
+	struct oa_tc6_frame_buffer *frame;
+	int ret;
+
+	ret = oa_tc6_get_tx_frame(bench->oa, &frame);
+	if (ret)
+		return ret;
+
+	oa_bench_fill(bench, frame->data, len);
+	frame->len = len;
+
+	return oa_tc6_put_tx_frame(bench->oa, frame);
+}
+
+/* Run the OA TC6 thread until a frame is received and check it. */
+static int oa_bench_wait_rx(struct oa_bench *bench, uint32_t len)
+{
+	struct oa_tc6_frame_buffer *frame;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < OA_SIM_MAX_POLLS; i++) {
+		ret = oa_tc6_get_rx_frame(bench->oa, &frame);
+		if (!ret)
+			break;
+
+		ret = oa_tc6_thread(bench->oa);
+		if (ret)
+			return ret;
+	}
+	if (i == OA_SIM_MAX_POLLS)
+		return -ETIMEDOUT;
+
+	if (frame->len != len || memcmp(frame->data, bench->frame, len))
+		ret = -EBADMSG;
+
+	oa_tc6_put_rx_frame(bench->oa, frame);
+
+	return ret;
+}
+
+static int oa_bench_rx(void *ctx, uint32_t nb_ops, uint32_t len)
+{
+	struct oa_bench *bench = ctx;
+	int ret;
+
+	while (nb_ops--) {
+		oa_bench_fill(bench, bench->frame, len);
+		ret = oa_sim_inject(&oa_sim, bench->frame, len);
+		if (ret)
+			return ret;
+
+		ret = oa_bench_wait_rx(bench, len);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int oa_bench_tx(void *ctx, uint32_t nb_ops, uint32_t len)
+{
+	struct oa_bench *bench = ctx;
+	uint32_t i;
+	int ret;
+
+	while (nb_ops--) {
+		ret = oa_bench_queue_tx(bench, len);
+		if (ret)
+			return ret;
+
+		for (i = 0; i < OA_SIM_MAX_POLLS; i++) {
+			ret = oa_tc6_thread(bench->oa);
+			if (ret)
+				return ret;
+
+			if (oa_sim.tx_frames == bench->seq)
+				break;
+		}
+		if (i == OA_SIM_MAX_POLLS || oa_sim.tx_errors)
+			return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/* One frame in each direction, the driver may combine them. */
+static int oa_bench_duplex(void *ctx, uint32_t nb_ops, uint32_t len)
+{
+	struct oa_bench *bench = ctx;
+	int ret;
+
+	while (nb_ops--) {
+		ret = oa_bench_queue_tx(bench, len);
+		if (ret)
+			return ret;
+
+		oa_bench_fill(bench, bench->frame, len);
+		ret = oa_sim_inject(&oa_sim, bench->frame, len);
+		if (ret)
+			return ret;
+
+		ret = oa_bench_wait_rx(bench, len);
+		if (ret)
+			return ret;
+
+		if (oa_sim.tx_errors)
+			return -EBADMSG;
+	}
+
+	/* The last TX frame might still be queued */
+	ret = oa_tc6_thread(bench->oa);
+	if (ret)
+		return ret;
+
+	return oa_sim.tx_frames == bench->seq / 2 ? 0 : -ETIMEDOUT;
+}
+
+/*
+ * Frames arrive back to back, one operation receives all of them. The RX
+ * buffers are not handed out in arrival order, so the frames only differ in
+ * their first 4 bytes.
+ */
+static int oa_bench_rx_burst(void *ctx, uint32_t nb_ops, uint32_t len)
+{
+	struct oa_tc6_frame_buffer *frame;
+	struct oa_bench *bench = ctx;
+	uint32_t received;
+	uint32_t polls;
+	uint32_t seq;
+	uint32_t i;
+	int ret;
+
+	while (nb_ops--) {
+		oa_bench_fill(bench, bench->frame, len);
+		seq = bench->seq - 1;
+
+		for (i = 0; i < OA_SIM_BURST; i++) {
+			no_os_put_unaligned_be32(seq + i, bench->frame);
+			ret = oa_sim_inject(&oa_sim, bench->frame, len);
+			if (ret)
+				return ret;
+		}
+		bench->seq += OA_SIM_BURST - 1;
+
+		received = 0;
+		for (polls = 0; received != NO_OS_GENMASK(OA_SIM_BURST - 1, 0);
+		     polls++) {
+			if (polls == OA_SIM_MAX_POLLS)
+				return -ETIMEDOUT;
+
+			ret = oa_tc6_thread(bench->oa);
+			if (ret)
+				return ret;
+
+			while (!oa_tc6_get_rx_frame(bench->oa, &frame)) {
+				i = no_os_get_unaligned_be32(frame->data) - seq;
+				if (frame->len != len || i >= OA_SIM_BURST ||
+				    memcmp(&frame->data[4], &bench->frame[4], len - 4))
+					ret = -EBADMSG;
+				else
+					received |= NO_OS_BIT(i);
+				oa_tc6_put_rx_frame(bench->oa, frame);
+				if (ret)
+					return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Cost of calling the OA TC6 thread when there is nothing to be done. */
+static int oa_bench_idle(void *ctx, uint32_t nb_ops)
+{
+	struct oa_bench *bench = ctx;
+	int ret;
+
+	while (nb_ops--) {
+		ret = oa_tc6_thread(bench->oa);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int oa_bench_rx_64(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_rx(ctx, nb_ops, 64);
+}
+
+static int oa_bench_rx_1514(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_rx(ctx, nb_ops, 1514);
+}
+
+static int oa_bench_tx_64(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_tx(ctx, nb_ops, 64);
+}
+
+static int oa_bench_tx_1514(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_tx(ctx, nb_ops, 1514);
+}
+
+static int oa_bench_rx_burst_1514(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_rx_burst(ctx, nb_ops, 1514);
+}
+
+static int oa_bench_duplex_1514(void *ctx, uint32_t nb_ops)
+{
+	return oa_bench_duplex(ctx, nb_ops, 1514);
+}
+
+const struct bench_case bench_net_cases[] = {
+	{
+		.name = "oa_tc6_idle_poll",
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_idle,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_idle_irq",
+		.setup = oa_bench_setup_irq,
+		.run = oa_bench_idle,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_rx_64_poll",
+		.bytes_per_op = 64,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_rx_64,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_rx_1514_poll",
+		.bytes_per_op = 1514,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_rx_1514,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_rx_1514_irq",
+		.bytes_per_op = 1514,
+		.setup = oa_bench_setup_irq,
+		.run = oa_bench_rx_1514,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_rx_burst_1514_poll",
+		.bytes_per_op = OA_SIM_BURST * 1514,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_rx_burst_1514,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_tx_64_poll",
+		.bytes_per_op = 64,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_tx_64,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_tx_1514_poll",
+		.bytes_per_op = 1514,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_tx_1514,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_duplex_1514_poll",
+		.bytes_per_op = 2 * 1514,
+		.setup = oa_bench_setup_poll,
+		.run = oa_bench_duplex_1514,
+		.teardown = oa_bench_teardown,
+	},
+	{
+		.name = "oa_tc6_duplex_1514_irq",
+		.bytes_per_op = 2 * 1514,
+		.setup = oa_bench_setup_irq,
+		.run = oa_bench_duplex_1514,
+		.teardown = oa_bench_teardown,
+	},
+};
+
+const uint32_t bench_net_nb_cases = NO_OS_ARRAY_SIZE(bench_net_cases);
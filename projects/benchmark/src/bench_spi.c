@@ -0,0 +1,720 @@
+/***************************************************************************//**
+ *   @file   bench_spi.c
+ *   @brief  Benchmarks for the no_os_spi transaction queue on a mock SPI bus.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_spi.h"
+#include "no_os_trace.h"
+#include "no_os_util.h"
+
+/*
+ * Bus timing model of the mock SPI backend. Each transfer costs a fixed setup
+ * time plus the time needed to clock its bytes out. The synchronous backend
+ * busy waits for that amount, as a polled SPI controller would. The
+ * asynchronous one sleeps in its worker thread, as a DMA or kernel driver
+ * would, so the CPU can do something else meanwhile.
+ */
+#define SPI_MOCK_HZ		10000000
+#define SPI_MOCK_XFER_NS	2000
+
+/* Devices sharing the bus */
+#define SPI_BENCH_DEVS		4
+#define SPI_BENCH_LEN		256
+/* Processing of the received data by the driver */
+#define SPI_BENCH_WORK_NS	150000
+
+/* Transfers starting with this byte fail */
+#define SPI_MOCK_FAIL		0xFF
+
+/**
+ * @struct spi_mock
+ * @brief Mock SPI bus. The received data is a copy of the transmitted data.
+ */
+struct spi_mock {
+	/* 0 if the transfers take no time */
+	uint32_t hz;
+	pthread_t worker;
+	bool worker_started;
+	bool stop;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	/* Pending asynchronous transfer */
+	struct no_os_spi_msg *msgs;
+	uint32_t len;
+	void (*callback)(void *, int32_t);
+	void *ctx;
+};
+
+static struct spi_mock spi_mock;
+
+static uint64_t spi_mock_xfer_ns(struct spi_mock *mock,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint64_t ns = 0;
+	uint32_t i;
+
+	if (!mock->hz)
+		return 0;
+
+	for (i = 0; i < len; i++)
+		ns += SPI_MOCK_XFER_NS + msgs[i].bytes_number * 8ull *
+		      1000000000ull / mock->hz;
+
+	return ns;
+}
+
+static int32_t spi_mock_loopback(struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (msgs[i].tx_buff && msgs[i].tx_buff[0] == SPI_MOCK_FAIL)
+			return -EIO;
+
+		if (msgs[i].rx_buff && msgs[i].tx_buff &&
+		    msgs[i].rx_buff != msgs[i].tx_buff)
+			memcpy(msgs[i].rx_buff, msgs[i].tx_buff,
+			       msgs[i].bytes_number);
+	}
+
+	return 0;
+}
+
+static int32_t spi_mock_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param)
+{
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->device_id = param->device_id;
+	(*desc)->chip_select = param->chip_select;
+	(*desc)->extra = param->extra;
+
+	return 0;
+}
+
+static int32_t spi_mock_transfer(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint64_t end = bench_now_ns() + spi_mock_xfer_ns(desc->extra, msgs, len);
+
+	while (bench_now_ns() < end)
+		;
+
+	return spi_mock_loopback(msgs, len);
+}
+
+static void *spi_mock_worker(void *arg)
+{
+	struct spi_mock *mock = arg;
+	void (*callback)(void *, int32_t);
+	struct no_os_spi_msg *msgs;
+	struct timespec ts;
+	uint64_t end;
+	uint32_t len;
+	int32_t ret;
+	void *ctx;
+
+	prctl(PR_SET_TIMERSLACK, 1);
+
+	pthread_mutex_lock(&mock->lock);
+	while (true) {
+		while (!mock->msgs && !mock->stop)
+			pthread_cond_wait(&mock->cond, &mock->lock);
+
+		if (!mock->msgs)
+			break;
+
+		msgs = mock->msgs;
+		len = mock->len;
+		callback = mock->callback;
+		ctx = mock->ctx;
+		pthread_mutex_unlock(&mock->lock);
+
+		end = bench_now_ns() + spi_mock_xfer_ns(mock, msgs, len);
+		ts.tv_sec = end / 1000000000;
+		ts.tv_nsec = end % 1000000000;
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+		ret = spi_mock_loopback(msgs, len);
+
+		pthread_mutex_lock(&mock->lock);
+		mock->msgs = NULL;
+		pthread_mutex_unlock(&mock->lock);
+
+		callback(ctx, ret);
+
+		pthread_mutex_lock(&mock->lock);
+	}
+	pthread_mutex_unlock(&mock->lock);
+
+	return NULL;
+}
+
+static int32_t spi_mock_transfer_async(struct no_os_spi_desc *desc,
+				       struct no_os_spi_msg *msgs, uint32_t len,
+				       void (*callback)(void *, int32_t),
+				       void *ctx)
+{
+	struct spi_mock *mock = desc->extra;
+	int32_t ret = 0;
+
+	pthread_mutex_lock(&mock->lock);
+	if (mock->msgs) {
+		ret = -EBUSY;
+	} else {
+		mock->msgs = msgs;
+		mock->len = len;
+		mock->callback = callback;
+		mock->ctx = ctx;
+		pthread_cond_signal(&mock->cond);
+	}
+	pthread_mutex_unlock(&mock->lock);
+
+	return ret;
+}
+
+static int32_t spi_mock_remove(struct no_os_spi_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops spi_mock_ops = {
+	.init = spi_mock_init,
+	.transfer = spi_mock_transfer,
+	.remove = spi_mock_remove,
+};
+
+static const struct no_os_spi_platform_ops spi_mock_async_ops = {
+	.init = spi_mock_init,
+	.transfer = spi_mock_transfer,
+	.transfer_async = spi_mock_transfer_async,
+	.remove = spi_mock_remove,
+};
+
+static int spi_mock_start(struct spi_mock *mock, uint32_t hz, bool async)
+{
+	int ret;
+
+	memset(mock, 0, sizeof(*mock));
+	mock->hz = hz;
+	pthread_mutex_init(&mock->lock, NULL);
+	pthread_cond_init(&mock->cond, NULL);
+
+	if (!async)
+		return 0;
+
+	ret = pthread_create(&mock->worker, NULL, spi_mock_worker, mock);
+	if (ret)
+		return -ret;
+
+	mock->worker_started = true;
+
+	return 0;
+}
+
+static void spi_mock_stop(struct spi_mock *mock)
+{
+	if (mock->worker_started) {
+		pthread_mutex_lock(&mock->lock);
+		mock->stop = true;
+		pthread_cond_signal(&mock->cond);
+		pthread_mutex_unlock(&mock->lock);
+		pthread_join(mock->worker, NULL);
+	}
+
+	pthread_cond_destroy(&mock->cond);
+	pthread_mutex_destroy(&mock->lock);
+}
+
+/**
+ * @struct spi_bench_cfg
+ * @brief Parameters of a SPI benchmark, passed through bench_case.arg.
+ */
+struct spi_bench_cfg {
+	bool async;
+	uint32_t hz;
+	uint32_t len;
+	uint32_t work_ns;
+};
+
+/**
+ * @struct spi_bench
+ * @brief Context of the SPI benchmarks. Each device keeps one transaction
+ * in the queue.
+ */
+struct spi_bench {
+	const struct spi_bench_cfg *cfg;
+	struct no_os_spi_desc *dev[SPI_BENCH_DEVS];
+	struct no_os_spi_xfer xfer[SPI_BENCH_DEVS];
+	struct no_os_spi_msg msg[SPI_BENCH_DEVS];
+	uint8_t tx[SPI_BENCH_DEVS][SPI_BENCH_LEN];
+	uint8_t rx[SPI_BENCH_DEVS][SPI_BENCH_LEN];
+	atomic_bool done[SPI_BENCH_DEVS];
+	int32_t status[SPI_BENCH_DEVS];
+	/* Completion order of the transactions */
+	uint32_t order[SPI_BENCH_DEVS];
+	int32_t order_status[SPI_BENCH_DEVS];
+	uint32_t nb_order;
+};
+
+static void spi_bench_done(struct no_os_spi_xfer *xfer, int32_t ret)
+{
+	struct spi_bench *bench = xfer->ctx;
+	uint32_t i = xfer - bench->xfer;
+
+	bench->status[i] = ret;
+	atomic_store(&bench->done[i], true);
+}
+
+static int spi_bench_setup(void **ctx)
+{
+	const struct spi_bench_cfg *cfg = *ctx;
+	struct no_os_spi_init_param ip = {
+		.device_id = 0,
+		.max_speed_hz = SPI_MOCK_HZ,
+		.platform_ops = cfg->async ? &spi_mock_async_ops : &spi_mock_ops,
+		.extra = &spi_mock,
+	};
+	struct spi_bench *bench;
+	uint32_t i, j;
+	int ret;
+
+	ret = spi_mock_start(&spi_mock, cfg->hz, cfg->async);
+	if (ret)
+		return ret;
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench) {
+		ret = -ENOMEM;
+		goto stop;
+	}
+
+	bench->cfg = cfg;
+	for (i = 0; i < SPI_BENCH_DEVS; i++) {
+		ip.chip_select = i;
+		ret = no_os_spi_init(&bench->dev[i], &ip);
+		if (ret)
+			goto remove;
+
+		for (j = 0; j < cfg->len; j++)
+			bench->tx[i][j] = i + j;
+
+		bench->msg[i].tx_buff = bench->tx[i];
+		bench->msg[i].rx_buff = bench->rx[i];
+		bench->msg[i].bytes_number = cfg->len;
+		bench->xfer[i].desc = bench->dev[i];
+		bench->xfer[i].msgs = &bench->msg[i];
+		bench->xfer[i].len = 1;
+		bench->xfer[i].callback = spi_bench_done;
+		bench->xfer[i].ctx = bench;
+	}
+
+	*ctx = bench;
+
+	return 0;
+
+remove:
+	while (i--)
+		no_os_spi_remove(bench->dev[i]);
+	no_os_free(bench);
+stop:
+	spi_mock_stop(&spi_mock);
+
+	return ret;
+}
+
+static void spi_bench_teardown(void *ctx)
+{
+	struct spi_bench *bench = ctx;
+	uint32_t i;
+
+	for (i = 0; i < SPI_BENCH_DEVS; i++)
+		no_os_spi_remove(bench->dev[i]);
+
+	spi_mock_stop(&spi_mock);
+	no_os_free(bench);
+}
+
+/* What a driver does with the received data, takes work_ns. */
+static int spi_bench_process(struct spi_bench *bench, uint32_t dev)
+{
+	uint64_t end = bench_now_ns() + bench->cfg->work_ns;
+
+	if (memcmp(bench->rx[dev], bench->tx[dev], bench->cfg->len))
+		return -EILSEQ;
+
+	memset(bench->rx[dev], 0, bench->cfg->len);
+
+	while (bench_now_ns() < end)
+		;
+
+	return 0;
+}
+
+/* Each device in turn, with blocking no_os_spi_transfer() calls. */
+static int spi_bench_transfer(void *ctx, uint32_t nb_ops)
+{
+	struct spi_bench *bench = ctx;
+	uint32_t dev;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < nb_ops; i++) {
+		dev = i % SPI_BENCH_DEVS;
+
+		ret = no_os_spi_transfer(bench->dev[dev], &bench->msg[dev], 1);
+		if (ret)
+			return ret;
+
+		ret = spi_bench_process(bench, dev);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Each device keeps a transaction in the queue and processes the result
+ * of the previous one while the others are transferred.
+ */
+static int spi_bench_queue(void *ctx, uint32_t nb_ops)
+{
+	struct spi_bench *bench = ctx;
+	uint32_t dev;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < nb_ops && i < SPI_BENCH_DEVS; i++) {
+		atomic_store(&bench->done[i], false);
+		ret = no_os_spi_queue_submit(&bench->xfer[i]);
+		if (ret)
+			return ret;
+	}
+
+	for (i = 0; i < nb_ops; i++) {
+		dev = i % SPI_BENCH_DEVS;
+
+		while (!atomic_load(&bench->done[dev]))
+			;
+
+		if (bench->status[dev])
+			return bench->status[dev];
+
+		ret = spi_bench_process(bench, dev);
+		if (ret)
+			return ret;
+
+		if (i + SPI_BENCH_DEVS >= nb_ops)
+			continue;
+
+		atomic_store(&bench->done[dev], false);
+		ret = no_os_spi_queue_submit(&bench->xfer[dev]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static void spi_bench_order_done(struct no_os_spi_xfer *xfer, int32_t ret)
+{
+	struct spi_bench *bench = xfer->ctx;
+	uint32_t i = xfer - bench->xfer;
+
+	bench->order[bench->nb_order] = i;
+	bench->order_status[bench->nb_order] = ret;
+	bench->nb_order++;
+}
+
+/* The first transaction keeps the bus busy while the others are queued. */
+static void spi_bench_order_gate(struct no_os_spi_xfer *xfer, int32_t ret)
+{
+	struct spi_bench *bench = xfer->ctx;
+
+	spi_bench_order_done(xfer, ret);
+
+	no_os_spi_queue_submit(&bench->xfer[1]);
+	if (!bench->xfer[3].chain)
+		no_os_spi_queue_submit(&bench->xfer[2]);
+	no_os_spi_queue_submit(&bench->xfer[3]);
+}
+
+/*
+ * Check the start order: priority first, submission order for the same
+ * priority, chained transactions right after their parent. A failed
+ * transaction cancels its chain.
+ */
+static int spi_bench_order(void *ctx, uint32_t nb_ops)
+{
+	/* 3 has the highest priority, 1 and 2 the same one */
+	static const uint32_t order[3][SPI_BENCH_DEVS] = {
+		{0, 3, 1, 2},
+		/* 2 is chained after 3 */
+		{0, 3, 2, 1},
+		/* 2 is chained after 3, which fails */
+		{0, 3, 2, 1},
+	};
+	static const int32_t status[3][SPI_BENCH_DEVS] = {
+		{0, 0, 0, 0},
+		{0, 0, 0, 0},
+		{0, -EIO, -ECANCELED, 0},
+	};
+	struct spi_bench *bench = ctx;
+	uint32_t mode;
+	uint32_t i, j;
+	int ret;
+
+	for (i = 0; i < SPI_BENCH_DEVS; i++)
+		bench->xfer[i].callback = spi_bench_order_done;
+	bench->xfer[0].callback = spi_bench_order_gate;
+	bench->xfer[1].priority = 2;
+	bench->xfer[2].priority = 2;
+	bench->xfer[3].priority = 3;
+
+	for (i = 0; i < nb_ops; i++) {
+		mode = i % 3;
+		bench->xfer[3].chain = mode ? &bench->xfer[2] : NULL;
+		bench->tx[3][0] = mode == 2 ? SPI_MOCK_FAIL : 3;
+		bench->nb_order = 0;
+
+		ret = no_os_spi_queue_submit(&bench->xfer[0]);
+		if (ret)
+			return ret;
+
+		if (bench->nb_order != SPI_BENCH_DEVS)
+			return -EILSEQ;
+
+		for (j = 0; j < SPI_BENCH_DEVS; j++)
+			if (bench->order[j] != order[mode][j] ||
+			    bench->order_status[j] != status[mode][j])
+				return -EILSEQ;
+	}
+
+	return 0;
+}
+
+/* Tracing is started before the devices are added and stopped after. */
+static int spi_bench_trace_setup(void **ctx)
+{
+	int ret;
+
+	ret = no_os_trace_start(bench_now_ns);
+	if (ret)
+		return ret;
+
+	ret = spi_bench_setup(ctx);
+	if (ret)
+		no_os_trace_stop();
+
+	return ret;
+}
+
+static void spi_bench_trace_teardown(void *ctx)
+{
+	spi_bench_teardown(ctx);
+	no_os_trace_stop();
+}
+
+/* Sum the trace counters of the bench devices. */
+static int spi_bench_trace_stats(struct no_os_trace_stats *total)
+{
+	struct no_os_trace_stats stats;
+	uint32_t i, j;
+
+	memset(total, 0, sizeof(*total));
+	for (i = 0; !no_os_trace_get_stats(i, &stats); i++) {
+		if (stats.bus != NO_OS_TRACE_SPI || stats.bus_id != 0 ||
+		    stats.dev >= SPI_BENCH_DEVS)
+			return -EILSEQ;
+
+		total->count += stats.count;
+		total->errors += stats.errors;
+		total->bytes += stats.bytes;
+		for (j = 0; j < NO_OS_TRACE_HIST_BUCKETS; j++)
+			total->hist[j] += stats.hist[j];
+	}
+
+	return i == SPI_BENCH_DEVS ? 0 : -EILSEQ;
+}
+
+/*
+ * Blocking transfers with tracing on. Fails if an access is missing from the
+ * device counters, the histogram or the event ring.
+ */
+static int spi_bench_transfer_traced(void *ctx, uint32_t nb_ops)
+{
+	struct spi_bench *bench = ctx;
+	struct no_os_trace_stats before, after;
+	struct no_os_trace_event ev[16];
+	uint32_t nb_ev, lost, hist;
+	uint32_t i;
+	int ret;
+
+	/* The counters are created on the first access */
+	if (nb_ops < SPI_BENCH_DEVS)
+		return spi_bench_transfer(ctx, nb_ops);
+
+	ret = spi_bench_transfer(ctx, SPI_BENCH_DEVS);
+	if (ret)
+		return ret;
+	nb_ops -= SPI_BENCH_DEVS;
+
+	ret = spi_bench_trace_stats(&before);
+	if (ret)
+		return ret;
+	/* Drop the events of the previous rounds */
+	while (no_os_trace_read_events(ev, NO_OS_ARRAY_SIZE(ev), &lost))
+		;
+
+	ret = spi_bench_transfer(ctx, nb_ops);
+	if (ret)
+		return ret;
+
+	ret = spi_bench_trace_stats(&after);
+	if (ret)
+		return ret;
+
+	for (i = 0, hist = 0; i < NO_OS_TRACE_HIST_BUCKETS; i++)
+		hist += after.hist[i] - before.hist[i];
+	if (after.count - before.count != nb_ops || hist != nb_ops ||
+	    after.bytes - before.bytes != nb_ops * bench->cfg->len ||
+	    after.errors != before.errors)
+		return -EILSEQ;
+
+	/* The oldest events kept, the first one of the run went to device 0 */
+	nb_ev = no_os_trace_read_events(ev, NO_OS_ARRAY_SIZE(ev), &lost);
+	if (nb_ev != no_os_min(nb_ops, NO_OS_ARRAY_SIZE(ev)) ||
+	    lost != (nb_ops > NO_OS_TRACE_EVENTS ? nb_ops - NO_OS_TRACE_EVENTS : 0))
+		return -EILSEQ;
+	for (i = 0; i < nb_ev; i++)
+		if (ev[i].bus != NO_OS_TRACE_SPI ||
+		    ev[i].op != NO_OS_TRACE_TRANSFER ||
+		    ev[i].dev != (lost + i) % SPI_BENCH_DEVS ||
+		    ev[i].bytes != bench->cfg->len || ev[i].ret)
+			return -EILSEQ;
+
+	return 0;
+}
+
+/* Bus time of a transfer is about 1.5x the processing time. */
+static const struct spi_bench_cfg spi_bench_sync = {
+	.hz = SPI_MOCK_HZ,
+	.len = SPI_BENCH_LEN,
+	.work_ns = SPI_BENCH_WORK_NS,
+};
+
+static const struct spi_bench_cfg spi_bench_async = {
+	.async = true,
+	.hz = SPI_MOCK_HZ,
+	.len = SPI_BENCH_LEN,
+	.work_ns = SPI_BENCH_WORK_NS,
+};
+
+/* Transfers and processing take no time, only the API overhead remains. */
+static const struct spi_bench_cfg spi_bench_overhead = {
+	.len = 4,
+};
+
+const struct bench_case bench_spi_cases[] = {
+	{
+		.name = "spi_transfer_4dev",
+		.bytes_per_op = SPI_BENCH_LEN,
+		.arg = &spi_bench_sync,
+		.setup = spi_bench_setup,
+		.run = spi_bench_transfer,
+		.teardown = spi_bench_teardown,
+	},
+	{
+		.name = "spi_queue_sync_4dev",
+		.bytes_per_op = SPI_BENCH_LEN,
+		.arg = &spi_bench_sync,
+		.setup = spi_bench_setup,
+		.run = spi_bench_queue,
+		.teardown = spi_bench_teardown,
+	},
+	{
+		.name = "spi_queue_async_4dev",
+		.bytes_per_op = SPI_BENCH_LEN,
+		.arg = &spi_bench_async,
+		.setup = spi_bench_setup,
+		.run = spi_bench_queue,
+		.teardown = spi_bench_teardown,
+	},
+	{
+		.name = "spi_transfer_overhead",
+		.arg = &spi_bench_overhead,
+		.setup = spi_bench_setup,
+		.run = spi_bench_transfer,
+		.teardown = spi_bench_teardown,
+	},
+	{
+		.name = "spi_transfer_overhead_traced",
+		.arg = &spi_bench_overhead,
+		.setup = spi_bench_trace_setup,
+		.run = spi_bench_transfer_traced,
+		.teardown = spi_bench_trace_teardown,
+	},
+	{
+		.name = "spi_transfer_4dev_traced",
+		.bytes_per_op = SPI_BENCH_LEN,
+		.arg = &spi_bench_sync,
+		.setup = spi_bench_trace_setup,
+		.run = spi_bench_transfer_traced,
+		.teardown = spi_bench_trace_teardown,
+	},
+	{
+		.name = "spi_queue_overhead",
+		.arg = &spi_bench_overhead,
+		.setup = spi_bench_setup,
+		.run = spi_bench_queue,
+		.teardown = spi_bench_teardown,
+	},
+	{
+		.name = "spi_queue_order",
+		.arg = &spi_bench_overhead,
+		.setup = spi_bench_setup,
+		.run = spi_bench_order,
+		.teardown = spi_bench_teardown,
+	},
+};
+
+const uint32_t bench_spi_nb_cases = NO_OS_ARRAY_SIZE(bench_spi_cases);
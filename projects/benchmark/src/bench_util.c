@@ -0,0 +1,1177 @@
+/***************************************************************************//**
+ *   @file   bench_util.c
+ *   @brief  Benchmarks for the no-OS utility library.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bench.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_crc8.h"
+#include "no_os_crc16.h"
+#include "no_os_crc24.h"
+#include "no_os_error.h"
+#include "no_os_fifo.h"
+#include "no_os_irq.h"
+#include "no_os_lf256fifo.h"
+#include "no_os_list.h"
+#include "no_os_pid.h"
+#include "no_os_util.h"
+
+#define BENCH_CB_SIZE		16384
+#define BENCH_DATA_SIZE		4096
+#define BENCH_LIST_SIZE		64
+#define BENCH_IRQ_SOURCES	16
+#define BENCH_PID_LOOPS		64
+/* Chunk moved by each SPSC write, read or DMA transfer */
+#define BENCH_SPSC_CHUNK	256
+/* Updates after which the PID loops must have settled */
+#define BENCH_PID_SETTLE	2000
+
+/* Prevents the compiler from removing computations with unused results */
+static volatile uint32_t bench_sink;
+
+static uint8_t bench_data[BENCH_DATA_SIZE];
+
+static void bench_fill_data(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < BENCH_DATA_SIZE; i++)
+		bench_data[i] = (uint8_t)(i * 31 + 7);
+}
+
+/*
+ * no_os_circular_buffer
+ */
+static int cb_setup(void **ctx)
+{
+	struct no_os_circular_buffer *cb;
+	int ret;
+
+	ret = no_os_cb_init(&cb, BENCH_CB_SIZE);
+	if (ret)
+		return ret;
+
+	bench_fill_data();
+	*ctx = cb;
+
+	return 0;
+}
+
+static void cb_teardown(void *ctx)
+{
+	no_os_cb_remove(ctx);
+}
+
+static int cb_write_read(void *ctx, uint32_t nb_ops, uint32_t len)
+{
+	static uint8_t out[BENCH_DATA_SIZE];
+	int ret;
+
+	while (nb_ops--) {
+		ret = no_os_cb_write(ctx, bench_data, len);
+		if (ret)
+			return ret;
+		ret = no_os_cb_read(ctx, out, len);
+		if (ret)
+			return ret;
+	}
+	bench_sink = out[0];
+
+	return 0;
+}
+
+static int cb_run_64(void *ctx, uint32_t nb_ops)
+{
+	return cb_write_read(ctx, nb_ops, 64);
+}
+
+static int cb_run_4k(void *ctx, uint32_t nb_ops)
+{
+	return cb_write_read(ctx, nb_ops, BENCH_DATA_SIZE);
+}
+
+static int cb_run_async_4k(void *ctx, uint32_t nb_ops)
+{
+	uint32_t size;
+	void *buf;
+	int ret;
+
+	while (nb_ops--) {
+		ret = no_os_cb_prepare_async_write(ctx, BENCH_DATA_SIZE, &buf,
+						   &size);
+		if (ret)
+			return ret;
+		ret = no_os_cb_end_async_write(ctx);
+		if (ret)
+			return ret;
+		ret = no_os_cb_prepare_async_read(ctx, BENCH_DATA_SIZE, &buf,
+						  &size);
+		if (ret)
+			return ret;
+		ret = no_os_cb_end_async_read(ctx);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * no_os_circular_buffer in SPSC mode, written by a producer thread while the
+ * benchmark thread reads it. The data is a 32 bit counter, so a lost, doubled
+ * or torn chunk makes the benchmark fail.
+ */
+struct cb_spsc_ctx {
+	struct no_os_circular_buffer cb;
+	int8_t buff[BENCH_CB_SIZE];
+	pthread_t producer;
+	volatile bool stop;
+	/* Write two DMA ping-pong blocks at once instead of no_os_cb_write */
+	bool dma;
+	/* Next counter value expected by the reader */
+	uint32_t count;
+};
+
+/* Fill a chunk with the next counter values */
+static void cb_spsc_fill(uint32_t *data, uint32_t size, uint32_t *count)
+{
+	uint32_t i;
+
+	for (i = 0; i < size / sizeof(*data); i++)
+		data[i] = (*count)++;
+}
+
+static void *cb_spsc_producer(void *arg)
+{
+	struct cb_spsc_ctx *ctx = arg;
+	uint32_t chunk[BENCH_SPSC_CHUNK / sizeof(uint32_t)];
+	uint32_t size, used;
+	void *block[2];
+	uint32_t count = 0;
+	uint32_t i, n;
+
+	while (!ctx->stop) {
+		no_os_cb_size(&ctx->cb, &used);
+		if (BENCH_CB_SIZE - used < 2 * BENCH_SPSC_CHUNK) {
+			sched_yield();
+			continue;
+		}
+
+		if (!ctx->dma) {
+			cb_spsc_fill(chunk, sizeof(chunk), &count);
+			if (no_os_cb_write(&ctx->cb, chunk, sizeof(chunk)))
+				return NULL;
+			continue;
+		}
+
+		/* Both blocks are outstanding before the first one completes */
+		for (n = 0; n < 2; n++) {
+			if (no_os_cb_prepare_async_write(&ctx->cb,
+							 BENCH_SPSC_CHUNK,
+							 &block[n], &size))
+				return NULL;
+			/* BENCH_CB_SIZE is a multiple of the chunk */
+			if (size != BENCH_SPSC_CHUNK)
+				return NULL;
+		}
+		for (i = 0; i < n; i++) {
+			cb_spsc_fill(block[i], BENCH_SPSC_CHUNK, &count);
+			no_os_cb_end_async_write(&ctx->cb);
+		}
+	}
+
+	return NULL;
+}
+
+static int cb_spsc_setup(void **pctx)
+{
+	struct cb_spsc_ctx *ctx;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ctx->dma = *pctx != NULL;
+
+	ret = no_os_cb_cfg_spsc(&ctx->cb, ctx->buff, sizeof(ctx->buff));
+	if (ret)
+		goto free_ctx;
+
+	ret = pthread_create(&ctx->producer, NULL, cb_spsc_producer, ctx);
+	if (ret) {
+		ret = -ret;
+		goto free_ctx;
+	}
+
+	*pctx = ctx;
+
+	return 0;
+
+free_ctx:
+	free(ctx);
+
+	return ret;
+}
+
+static void cb_spsc_teardown(void *pctx)
+{
+	struct cb_spsc_ctx *ctx = pctx;
+
+	ctx->stop = true;
+	pthread_join(ctx->producer, NULL);
+	free(ctx);
+}
+
+/* Check that a chunk continues the counter sequence */
+static int cb_spsc_check(struct cb_spsc_ctx *ctx, const uint32_t *data,
+			 uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i < size / sizeof(*data); i++)
+		if (data[i] != ctx->count++)
+			return -EIO;
+
+	return 0;
+}
+
+/* Read BENCH_DATA_SIZE bytes per operation with no_os_cb_read */
+static int cb_spsc_read_run(void *pctx, uint32_t nb_ops)
+{
+	struct cb_spsc_ctx *ctx = pctx;
+	uint32_t chunk[BENCH_SPSC_CHUNK / sizeof(uint32_t)];
+	uint32_t done;
+	int ret;
+
+	while (nb_ops--) {
+		for (done = 0; done < BENCH_DATA_SIZE; done += sizeof(chunk)) {
+			while ((ret = no_os_cb_read(&ctx->cb, chunk,
+						    sizeof(chunk))) == -EAGAIN)
+				sched_yield();
+			if (ret)
+				return ret;
+
+			ret = cb_spsc_check(ctx, chunk, sizeof(chunk));
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Read BENCH_DATA_SIZE bytes per operation in place */
+static int cb_spsc_async_read_run(void *pctx, uint32_t nb_ops)
+{
+	struct cb_spsc_ctx *ctx = pctx;
+	struct no_os_cb_stats stats;
+	uint32_t done, size;
+	void *buf;
+	int ret;
+
+	while (nb_ops--) {
+		for (done = 0; done < BENCH_DATA_SIZE; done += size) {
+			while ((ret = no_os_cb_prepare_async_read(&ctx->cb,
+					BENCH_DATA_SIZE - done, &buf,
+					&size)) == -EAGAIN)
+				sched_yield();
+			if (ret)
+				return ret;
+
+			ret = cb_spsc_check(ctx, buf, size);
+			if (ret)
+				return ret;
+
+			ret = no_os_cb_end_async_read(&ctx->cb);
+			if (ret)
+				return ret;
+		}
+	}
+
+	/* The producer only writes when there is room */
+	no_os_cb_get_stats(&ctx->cb, &stats);
+	if (stats.overruns || stats.high_watermark > BENCH_CB_SIZE)
+		return -EIO;
+
+	return 0;
+}
+
+static const bool cb_spsc_dma = true;
+
+/*
+ * lf256fifo
+ */
+static int lf256fifo_setup(void **ctx)
+{
+	return lf256fifo_init((struct lf256fifo **)ctx);
+}
+
+static void lf256fifo_teardown(void *ctx)
+{
+	lf256fifo_remove(ctx);
+	no_os_free(ctx);
+}
+
+static int lf256fifo_run(void *ctx, uint32_t nb_ops)
+{
+	uint8_t c = 0;
+
+	while (nb_ops--) {
+		if (lf256fifo_write(ctx, (uint8_t)nb_ops))
+			return -ENOSPC;
+		if (lf256fifo_read(ctx, &c))
+			return -EAGAIN;
+	}
+	bench_sink = c;
+
+	return 0;
+}
+
+/*
+ * no_os_fifo
+ */
+static int fifo_run(void *ctx, uint32_t nb_ops)
+{
+	struct no_os_fifo_element *fifo = NULL;
+	int ret;
+
+	while (nb_ops--) {
+		ret = no_os_fifo_insert(&fifo, (char *)bench_data, 64);
+		if (ret)
+			return ret;
+		fifo = no_os_fifo_remove(fifo);
+	}
+
+	return 0;
+}
+
+/*
+ * no_os_list
+ */
+static int32_t bench_list_cmp(void *data1, void *data2)
+{
+	uintptr_t a = (uintptr_t)data1;
+	uintptr_t b = (uintptr_t)data2;
+
+	return (a > b) - (a < b);
+}
+
+static int list_setup_ext(void **ctx, enum no_os_adapter_type type,
+			  enum no_os_list_storage storage)
+{
+	struct no_os_list_init_param param = {
+		.type = type,
+		.comparator = bench_list_cmp,
+		.storage = storage,
+	};
+	struct no_os_list_desc *list;
+	uintptr_t i;
+	int ret;
+
+	ret = no_os_list_init_ext(&list, &param);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < BENCH_LIST_SIZE; i++) {
+		ret = list->push(list, (void *)((i * 37) % BENCH_LIST_SIZE));
+		if (ret) {
+			no_os_list_remove(list);
+			return ret;
+		}
+	}
+
+	*ctx = list;
+
+	return 0;
+}
+
+static int list_queue_setup(void **ctx)
+{
+	return list_setup_ext(ctx, NO_OS_LIST_QUEUE, NO_OS_LIST_STORAGE_NODES);
+}
+
+static int list_priority_setup(void **ctx)
+{
+	return list_setup_ext(ctx, NO_OS_LIST_PRIORITY_LIST,
+			      NO_OS_LIST_STORAGE_NODES);
+}
+
+static int list_array_queue_setup(void **ctx)
+{
+	return list_setup_ext(ctx, NO_OS_LIST_QUEUE, NO_OS_LIST_STORAGE_ARRAY);
+}
+
+static int list_array_priority_setup(void **ctx)
+{
+	return list_setup_ext(ctx, NO_OS_LIST_PRIORITY_LIST,
+			      NO_OS_LIST_STORAGE_ARRAY);
+}
+
+static int list_heap_setup(void **ctx)
+{
+	return list_setup_ext(ctx, NO_OS_LIST_PRIORITY_HEAP,
+			      NO_OS_LIST_STORAGE_ARRAY);
+}
+
+static void list_teardown(void *ctx)
+{
+	struct no_os_list_desc *list = ctx;
+	void *data;
+
+	while (!list->pop(list, &data))
+		;
+	no_os_list_remove(list);
+}
+
+static int list_push_pop_run(void *ctx, uint32_t nb_ops)
+{
+	struct no_os_list_desc *list = ctx;
+	void *data;
+	int ret;
+
+	while (nb_ops--) {
+		ret = list->push(list, (void *)(uintptr_t)(nb_ops %
+				 BENCH_LIST_SIZE));
+		if (ret)
+			return ret;
+		ret = list->pop(list, &data);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int list_read_idx_run(void *ctx, uint32_t nb_ops)
+{
+	void *data = NULL;
+	int ret;
+
+	while (nb_ops--) {
+		ret = no_os_list_read_idx(ctx, &data, BENCH_LIST_SIZE / 2);
+		if (ret)
+			return ret;
+	}
+	bench_sink = (uintptr_t)data;
+
+	return 0;
+}
+
+/* Elements of the intrusive list, each one embeds its list element */
+struct bench_list_item {
+	uint32_t value;
+	struct no_os_list_elem node;
+};
+
+static struct bench_list_item bench_list_items[BENCH_LIST_SIZE + 1];
+/* Item not in the list, an item can't be in the list twice */
+static void *bench_list_spare;
+
+static int list_intrusive_setup(void **ctx)
+{
+	struct no_os_list_init_param param = {
+		.type = NO_OS_LIST_QUEUE,
+		.storage = NO_OS_LIST_STORAGE_INTRUSIVE,
+		.node_offset = offsetof(struct bench_list_item, node),
+	};
+	struct no_os_list_desc *list;
+	uint32_t i;
+	int ret;
+
+	ret = no_os_list_init_ext(&list, &param);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < BENCH_LIST_SIZE; i++) {
+		bench_list_items[i].value = i;
+		ret = list->push(list, &bench_list_items[i]);
+		if (ret) {
+			no_os_list_remove(list);
+			return ret;
+		}
+	}
+
+	bench_list_spare = &bench_list_items[BENCH_LIST_SIZE];
+	*ctx = list;
+
+	return 0;
+}
+
+/* The spare item is pushed, then the oldest one is popped and reused */
+static int list_intrusive_push_pop_run(void *ctx, uint32_t nb_ops)
+{
+	struct no_os_list_desc *list = ctx;
+	int ret;
+
+	while (nb_ops--) {
+		ret = list->push(list, bench_list_spare);
+		if (ret)
+			return ret;
+		ret = list->pop(list, &bench_list_spare);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * no_os_malloc/no_os_free, the size is passed through bench_case.arg
+ */
+static int alloc_free_run(void *ctx, uint32_t nb_ops)
+{
+	size_t size = (uintptr_t)ctx;
+	void *ptr;
+
+	while (nb_ops--) {
+		ptr = no_os_malloc(size);
+		if (!ptr)
+			return -ENOMEM;
+		bench_sink = (uintptr_t)ptr;
+		no_os_free(ptr);
+	}
+
+	return 0;
+}
+
+/* Allocate 16 blocks of different sizes before freeing them */
+static int alloc_free_mixed_run(void *ctx, uint32_t nb_ops)
+{
+	void *ptr[16];
+	uint32_t i;
+
+	while (nb_ops--) {
+		for (i = 0; i < NO_OS_ARRAY_SIZE(ptr); i++) {
+			ptr[i] = no_os_malloc(8 << (i % 8));
+			if (!ptr[i])
+				return -ENOMEM;
+		}
+		for (i = 0; i < NO_OS_ARRAY_SIZE(ptr); i++)
+			no_os_free(ptr[i]);
+	}
+
+	return 0;
+}
+
+static uint8_t bench_arena_buf[BENCH_DATA_SIZE];
+
+static int arena_alloc_run(void *ctx, uint32_t nb_ops)
+{
+	struct no_os_arena arena;
+	int ret;
+
+	ret = no_os_arena_init(&arena, bench_arena_buf,
+			       sizeof(bench_arena_buf));
+	if (ret)
+		return ret;
+
+	while (nb_ops--) {
+		if (!no_os_arena_alloc(&arena, 64))
+			no_os_arena_reset(&arena);
+	}
+	bench_sink = arena.used;
+
+	return 0;
+}
+
+/*
+ * Interrupt callback dispatch: an interrupt storm over BENCH_IRQ_SOURCES
+ * sources spread over 3 events, the source of each interrupt is random.
+ */
+struct bench_irq_action {
+	void *handle;
+	void (*callback)(void *context);
+	void *ctx;
+};
+
+/* Stand-ins for the platform peripheral handles (UART, TIM, DMA...) */
+static uint32_t bench_irq_handles[BENCH_IRQ_SOURCES][32];
+static struct no_os_list_desc *bench_irq_lists[NO_OS_EVT_DMA_TX_COMPLETE + 1];
+static uint32_t bench_irq_count;
+
+static const enum no_os_irq_event bench_irq_events[] = {
+	NO_OS_EVT_UART_RX_COMPLETE,
+	NO_OS_EVT_TIM_ELAPSED,
+	NO_OS_EVT_DMA_RX_COMPLETE,
+};
+
+static void bench_irq_callback(void *ctx)
+{
+	bench_irq_count += (uintptr_t)ctx;
+}
+
+static enum no_os_irq_event bench_irq_event(uint32_t src)
+{
+	return bench_irq_events[src % NO_OS_ARRAY_SIZE(bench_irq_events)];
+}
+
+/* Pseudo-random interrupt source */
+static uint32_t bench_irq_next(uint32_t *seed)
+{
+	*seed = *seed * 1664525 + 1013904223;
+
+	return (*seed >> 16) % BENCH_IRQ_SOURCES;
+}
+
+static int irq_table_setup(void **ctx)
+{
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < BENCH_IRQ_SOURCES; i++) {
+		ret = no_os_irq_action_set(bench_irq_event(i),
+					   bench_irq_handles[i],
+					   bench_irq_callback,
+					   (void *)(uintptr_t)1);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static void irq_table_teardown(void *ctx)
+{
+	uint32_t i;
+
+	for (i = 0; i < BENCH_IRQ_SOURCES; i++)
+		no_os_irq_action_clear(bench_irq_event(i),
+				       bench_irq_handles[i]);
+}
+
+static int irq_table_run(void *ctx, uint32_t nb_ops)
+{
+	uint32_t seed = 1;
+	uint32_t src;
+	int ret;
+
+	while (nb_ops--) {
+		src = bench_irq_next(&seed);
+		ret = no_os_irq_action_dispatch(bench_irq_event(src),
+						bench_irq_handles[src]);
+		if (ret)
+			return ret;
+	}
+	bench_sink = bench_irq_count;
+
+	return 0;
+}
+
+static int32_t bench_irq_action_cmp(void *data1, void *data2)
+{
+	uintptr_t a = (uintptr_t)((struct bench_irq_action *)data1)->handle;
+	uintptr_t b = (uintptr_t)((struct bench_irq_action *)data2)->handle;
+
+	return (a > b) - (a < b);
+}
+
+static void irq_list_teardown(void *ctx)
+{
+	struct bench_irq_action *a;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(bench_irq_lists); i++) {
+		if (!bench_irq_lists[i])
+			continue;
+		while (!no_os_list_get_first(bench_irq_lists[i], (void **)&a))
+			no_os_free(a);
+		no_os_list_remove(bench_irq_lists[i]);
+		bench_irq_lists[i] = NULL;
+	}
+}
+
+/* Per event action lists, as the platform interrupt handlers used to do */
+static int irq_list_setup(void **ctx)
+{
+	struct no_os_list_desc **list;
+	struct bench_irq_action *a;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < BENCH_IRQ_SOURCES; i++) {
+		list = &bench_irq_lists[bench_irq_event(i)];
+		if (!*list) {
+			ret = no_os_list_init(list, NO_OS_LIST_PRIORITY_LIST,
+					      bench_irq_action_cmp);
+			if (ret)
+				goto error;
+		}
+
+		a = no_os_calloc(1, sizeof(*a));
+		if (!a) {
+			ret = -ENOMEM;
+			goto error;
+		}
+		a->handle = bench_irq_handles[i];
+		a->callback = bench_irq_callback;
+		a->ctx = (void *)(uintptr_t)1;
+
+		ret = no_os_list_add_last(*list, a);
+		if (ret) {
+			no_os_free(a);
+			goto error;
+		}
+	}
+
+	return 0;
+error:
+	irq_list_teardown(NULL);
+
+	return ret;
+}
+
+static int irq_list_run(void *ctx, uint32_t nb_ops)
+{
+	struct bench_irq_action key;
+	struct bench_irq_action *a;
+	uint32_t seed = 1;
+	uint32_t src;
+	int ret;
+
+	while (nb_ops--) {
+		src = bench_irq_next(&seed);
+		key.handle = bench_irq_handles[src];
+		ret = no_os_list_read_find(bench_irq_lists[bench_irq_event(src)],
+					   (void **)&a, &key);
+		if (ret)
+			return ret;
+		a->callback(a->ctx);
+	}
+	bench_sink = bench_irq_count;
+
+	return 0;
+}
+
+/*
+ * CRC
+ */
+NO_OS_DECLARE_CRC8_TABLE(bench_crc8_table);
+NO_OS_DECLARE_CRC16_TABLE(bench_crc16_table);
+NO_OS_DECLARE_CRC24_TABLE(bench_crc24_table);
+
+static int crc_setup(void **ctx)
+{
+	no_os_crc8_populate_msb(bench_crc8_table, 0x07);
+	no_os_crc16_populate_msb(bench_crc16_table, 0x8005);
+	no_os_crc24_populate_msb(bench_crc24_table, 0x864CFB);
+	bench_fill_data();
+
+	return 0;
+}
+
+static int crc8_run(void *ctx, uint32_t nb_ops)
+{
+	uint8_t crc = 0;
+
+	while (nb_ops--)
+		crc = no_os_crc8(bench_crc8_table, bench_data, BENCH_DATA_SIZE,
+				 crc);
+	bench_sink = crc;
+
+	return 0;
+}
+
+static int crc16_run(void *ctx, uint32_t nb_ops)
+{
+	uint16_t crc = 0;
+
+	while (nb_ops--)
+		crc = no_os_crc16(bench_crc16_table, bench_data,
+				  BENCH_DATA_SIZE, crc);
+	bench_sink = crc;
+
+	return 0;
+}
+
+static int crc24_run(void *ctx, uint32_t nb_ops)
+{
+	uint32_t crc = 0;
+
+	while (nb_ops--)
+		crc = no_os_crc24(bench_crc24_table, bench_data,
+				  BENCH_DATA_SIZE, crc);
+	bench_sink = crc;
+
+	return 0;
+}
+
+/**
+ * @struct pid_bench
+ * @brief Context of the PID benchmarks. Each loop controls a first order
+ * plant, pv += (output - pv) / 8. The no_os_pid_control() output moves
+ * against the error, so its plant is inverted.
+ */
+struct pid_bench {
+	struct no_os_pid *pid[BENCH_PID_LOOPS];
+	struct no_os_pid_bank *bank;
+	int32_t sp[BENCH_PID_LOOPS];
+	int32_t pv[BENCH_PID_LOOPS];
+	int32_t out[BENCH_PID_LOOPS];
+};
+
+static void pid_teardown(void *ctx)
+{
+	struct pid_bench *bench = ctx;
+	uint32_t i;
+
+	for (i = 0; i < BENCH_PID_LOOPS; i++)
+		no_os_pid_remove(bench->pid[i]);
+
+	no_os_pid_bank_remove(bench->bank);
+	no_os_free(bench);
+}
+
+static int pid_setup_ext(void **ctx, enum no_os_pid_anti_windup anti_windup)
+{
+	struct no_os_pid_config config = {
+		.Kp = 500000,
+		.Ki = 50000,
+		.Kd = 100000,
+		.i_clip = {.low = -1000000, .high = 1000000},
+		.output_clip = {.low = -100000, .high = 100000},
+	};
+	struct no_os_pid_bank_config bank_config = {
+		.nb_loops = BENCH_PID_LOOPS,
+		.q = 16,
+		.anti_windup = anti_windup,
+	};
+	/* The same gains, in Q16 */
+	struct no_os_pid_loop_config loop_config = {
+		.Kp = 32768,
+		.Ki = 3277,
+		.Kd = 6554,
+		.d_alpha = 16384,
+		.i_clip = {.low = -100000, .high = 100000},
+		.output_clip = {.low = -100000, .high = 100000},
+	};
+	struct pid_bench *bench;
+	uint32_t i;
+	int ret;
+
+	bench = no_os_calloc(1, sizeof(*bench));
+	if (!bench)
+		return -ENOMEM;
+
+	ret = no_os_pid_bank_init(&bench->bank, &bank_config);
+	if (ret)
+		goto free;
+
+	for (i = 0; i < BENCH_PID_LOOPS; i++) {
+		bench->sp[i] = 1000 + 37 * i;
+
+		ret = no_os_pid_init(&bench->pid[i], config);
+		if (ret)
+			goto free;
+
+		ret = no_os_pid_bank_set(bench->bank, i, &loop_config);
+		if (ret)
+			goto free;
+	}
+
+	*ctx = bench;
+
+	return 0;
+
+free:
+	pid_teardown(bench);
+
+	return ret;
+}
+
+static int pid_setup(void **ctx)
+{
+	return pid_setup_ext(ctx, NO_OS_PID_ANTI_WINDUP_CLAMP);
+}
+
+static int pid_conditional_setup(void **ctx)
+{
+	return pid_setup_ext(ctx, NO_OS_PID_ANTI_WINDUP_CONDITIONAL);
+}
+
+/* One op updates all the loops, one no_os_pid_control() call per loop. */
+static int pid_control_run(void *ctx, uint32_t nb_ops)
+{
+	struct pid_bench *bench = ctx;
+	int output;
+	uint32_t i;
+	int ret;
+
+	while (nb_ops--) {
+		for (i = 0; i < BENCH_PID_LOOPS; i++) {
+			ret = no_os_pid_control(bench->pid[i], bench->sp[i],
+						bench->pv[i], &output);
+			if (ret)
+				return ret;
+
+			bench->pv[i] += (-output - bench->pv[i]) / 8;
+		}
+	}
+
+	return 0;
+}
+
+static int pid_bank_step(struct pid_bench *bench)
+{
+	uint32_t i;
+	int ret;
+
+	ret = no_os_pid_bank_update(bench->bank, bench->sp, bench->pv,
+				    bench->out);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < BENCH_PID_LOOPS; i++)
+		bench->pv[i] += (bench->out[i] - bench->pv[i]) / 8;
+
+	return 0;
+}
+
+/* One op updates all the loops with a single no_os_pid_bank_update() call. */
+static int pid_bank_run(void *ctx, uint32_t nb_ops)
+{
+	int ret;
+
+	while (nb_ops--) {
+		ret = pid_bank_step(ctx);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Step response, fails if a loop didn't settle on its set-point. */
+static int pid_bank_settle_run(void *ctx, uint32_t nb_ops)
+{
+	struct pid_bench *bench = ctx;
+	uint32_t i;
+	int ret;
+
+	while (nb_ops--) {
+		no_os_pid_bank_reset(bench->bank);
+		memset(bench->pv, 0, sizeof(bench->pv));
+
+		for (i = 0; i < BENCH_PID_SETTLE; i++) {
+			ret = pid_bank_step(bench);
+			if (ret)
+				return ret;
+		}
+
+		for (i = 0; i < BENCH_PID_LOOPS; i++)
+			if (abs(bench->sp[i] - bench->pv[i]) > 8)
+				return -EILSEQ;
+	}
+
+	return 0;
+}
+
+const struct bench_case bench_util_cases[] = {
+	{
+		.name = "cb_write_read_64",
+		.bytes_per_op = 64,
+		.setup = cb_setup,
+		.run = cb_run_64,
+		.teardown = cb_teardown,
+	},
+	{
+		.name = "cb_write_read_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = cb_setup,
+		.run = cb_run_4k,
+		.teardown = cb_teardown,
+	},
+	{
+		.name = "cb_async_block_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = cb_setup,
+		.run = cb_run_async_4k,
+		.teardown = cb_teardown,
+	},
+	{
+		.name = "cb_spsc_thread_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = cb_spsc_setup,
+		.run = cb_spsc_read_run,
+		.teardown = cb_spsc_teardown,
+	},
+	{
+		.name = "cb_spsc_thread_dma_pingpong_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.arg = &cb_spsc_dma,
+		.setup = cb_spsc_setup,
+		.run = cb_spsc_async_read_run,
+		.teardown = cb_spsc_teardown,
+	},
+	{
+		.name = "lf256fifo_write_read",
+		.bytes_per_op = 1,
+		.setup = lf256fifo_setup,
+		.run = lf256fifo_run,
+		.teardown = lf256fifo_teardown,
+	},
+	{
+		.name = "fifo_insert_remove_64",
+		.bytes_per_op = 64,
+		.run = fifo_run,
+	},
+	{
+		.name = "list_queue_push_pop",
+		.setup = list_queue_setup,
+		.run = list_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_priority_push_pop_64",
+		.setup = list_priority_setup,
+		.run = list_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_read_idx_64",
+		.setup = list_queue_setup,
+		.run = list_read_idx_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_array_queue_push_pop",
+		.setup = list_array_queue_setup,
+		.run = list_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_array_priority_push_pop_64",
+		.setup = list_array_priority_setup,
+		.run = list_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_array_read_idx_64",
+		.setup = list_array_queue_setup,
+		.run = list_read_idx_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_heap_push_pop_64",
+		.setup = list_heap_setup,
+		.run = list_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "list_intrusive_queue_push_pop",
+		.setup = list_intrusive_setup,
+		.run = list_intrusive_push_pop_run,
+		.teardown = list_teardown,
+	},
+	{
+		.name = "malloc_free_64",
+		.arg = (void *)64,
+		.run = alloc_free_run,
+	},
+	{
+		.name = "malloc_free_1k",
+		.arg = (void *)1024,
+		.run = alloc_free_run,
+	},
+	{
+		.name = "malloc_free_mixed_16",
+		.run = alloc_free_mixed_run,
+	},
+	{
+		.name = "arena_alloc_64",
+		.run = arena_alloc_run,
+	},
+	{
+		.name = "irq_dispatch_table_16",
+		.setup = irq_table_setup,
+		.run = irq_table_run,
+		.teardown = irq_table_teardown,
+	},
+	{
+		.name = "irq_dispatch_list_16",
+		.setup = irq_list_setup,
+		.run = irq_list_run,
+		.teardown = irq_list_teardown,
+	},
+	{
+		.name = "crc8_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = crc_setup,
+		.run = crc8_run,
+	},
+	{
+		.name = "crc16_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = crc_setup,
+		.run = crc16_run,
+	},
+	{
+		.name = "crc24_4k",
+		.bytes_per_op = BENCH_DATA_SIZE,
+		.setup = crc_setup,
+		.run = crc24_run,
+	},
+	{
+		.name = "pid_control_64",
+		.setup = pid_setup,
+		.run = pid_control_run,
+		.teardown = pid_teardown,
+	},
+	{
+		.name = "pid_bank_64",
+		.setup = pid_setup,
+		.run = pid_bank_run,
+		.teardown = pid_teardown,
+	},
+	{
+		.name = "pid_bank_64_conditional",
+		.setup = pid_conditional_setup,
+		.run = pid_bank_run,
+		.teardown = pid_teardown,
+	},
+	{
+		.name = "pid_bank_settle",
+		.setup = pid_setup,
+		.run = pid_bank_settle_run,
+		.teardown = pid_teardown,
+	},
+	{
+		.name = "pid_bank_settle_conditional",
+		.setup = pid_conditional_setup,
+		.run = pid_bank_settle_run,
+		.teardown = pid_teardown,
+	},
+};
+
+const uint32_t bench_util_nb_cases = NO_OS_ARRAY_SIZE(bench_util_cases);
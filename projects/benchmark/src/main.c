@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ *   @file   main.c
+ *   @brief  Entry point of the no-OS host benchmark suite.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <stdio.h>
+#include "bench.h"
+
+/***************************************************************************//**
+ * @brief Run the benchmarks and print one JSON object per line on stdout.
+ *
+ * @param argc - Number of arguments.
+ * @param argv - argv[1], if present, selects the benchmarks whose name
+ *               contains it.
+ *
+ * @return 0 if all selected benchmarks succeeded, negative value otherwise.
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+	const char *filter = argc > 1 ? argv[1] : NULL;
+	int ret = 0;
+	int err;
+
+	err = bench_run_all(bench_util_cases, bench_util_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_iio_cases, bench_iio_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_net_cases, bench_net_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_accel_cases, bench_accel_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_spi_cases, bench_spi_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_adc_cases, bench_adc_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	err = bench_run_all(bench_display_cases, bench_display_nb_cases, filter);
+	if (err)
+		ret = err;
+
+	return ret;
+}
@@ -19,5 +19,6 @@ INCS += $(INCLUDE)/no_os_gpio.h \
         $(INCLUDE)/no_os_delay.h \
         $(INCLUDE)/no_os_alloc.h \
         $(INCLUDE)/no_os_mutex.h \
+        $(INCLUDE)/no_os_util.h \
         $(DRIVERS)/platform/xilinx/$(PLATFORM)_gpio.h \
 	$(DRIVERS)/platform/xilinx/$(PLATFORM)_spi.h
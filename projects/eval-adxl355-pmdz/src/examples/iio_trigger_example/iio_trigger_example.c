@@ -87,7 +87,7 @@ int example_main()
 {
 	int ret;
 	struct adxl355_iio_dev *adxl355_iio_desc;
-	struct adxl355_iio_dev_init_param adxl355_iio_ip;
+	struct adxl355_iio_dev_init_param adxl355_iio_ip = {0};
 	struct iio_data_buffer accel_buff = {
 		.buff = (void *)iio_data_buffer,
 		.size = DATA_BUFFER_SIZE * 3 * sizeof(int)
@@ -5,6 +5,16 @@ SRCS += $(PROJECT)/src/examples/iio_example/iio_example.c
 INCS += $(PROJECT)/src/examples/iio_example/iio_example.h
 endif
 
+ifeq (y,$(strip $(IIO_TRIGGER_EXAMPLE)))
+IIOD=y
+CFLAGS += -DIIO_TRIGGER_EXAMPLE
+SRCS += $(PROJECT)/src/examples/iio_trigger_example/iio_trigger_example.c \
+	$(NO-OS)/iio/iio_trigger.c \
+	$(DRIVERS)/accel/adxl367/iio_adxl367_trig.c
+INCS += $(PROJECT)/src/examples/iio_trigger_example/iio_trigger_example.h \
+	$(NO-OS)/iio/iio_trigger.h
+endif
+
 ifeq (y,$(strip $(DUMMY_EXAMPLE)))
 CFLAGS += -DDUMMY_EXAMPLE
 SRCS += $(PROJECT)/src/examples/dummy/dummy_example.c
@@ -0,0 +1,150 @@
+/***************************************************************************//**
+ *   @file   iio_trigger_example.c
+ *   @brief  Implementation of IIO trigger example for eval-adxl367z project.
+ *   @author Andrei Porumb (andrei.porumb@analog.com)
+********************************************************************************
+ * Copyright 2022(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "iio_trigger_example.h"
+#include "iio_adxl367.h"
+#include "iio_trigger.h"
+#include "common_data.h"
+#include "no_os_util.h"
+
+#define DATA_BUFFER_SIZE 400
+
+/* FIFO sample sets collected before the watermark interrupt fires on INT1. */
+#define ADXL367_FIFO_WATERMARK	32
+
+#define ADXL367_GPIO_TRIG_NAME	"adxl367-dev0"
+
+uint8_t iio_data_buffer[DATA_BUFFER_SIZE * 4 * sizeof(int16_t)];
+
+struct no_os_irq_init_param intc_ip = {
+	.irq_ctrl_id = INTC_DEVICE_ID,
+	.platform_ops = INTC_OPS,
+	.extra = INTC_EXTRA,
+};
+
+/* GPIO trigger */
+struct no_os_irq_init_param gpio_irq_ip = {
+	.irq_ctrl_id = GPIO_IRQ_ID,
+	.platform_ops = GPIO_IRQ_OPS,
+	.extra = GPIO_IRQ_EXTRA,
+};
+
+struct iio_hw_trig_init_param adxl367_gpio_trig_ip = {
+	.irq_id = ADXL367_GPIO_TRIG_IRQ_ID,
+	.irq_trig_lvl = NO_OS_IRQ_EDGE_RISING,
+	.cb_info = {
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+		.handle = ADXL367_GPIO_CB_HANDLE,
+	},
+	.name = ADXL367_GPIO_TRIG_NAME,
+};
+
+/***************************************************************************//**
+ * @brief IIO trigger example main execution.
+ *
+ * @return ret - Result of the example execution. If working correctly, will
+ *               execute continuously function iio_app_run and will not return.
+*******************************************************************************/
+int iio_trigger_example_main()
+{
+	int ret;
+	struct adxl367_iio_dev *adxl367_iio_desc;
+	struct adxl367_iio_init_param adxl367_iio_ip = {0};
+	struct iio_data_buffer accel_buff = {
+		.buff = (void *)iio_data_buffer,
+		.size = DATA_BUFFER_SIZE * 4 * sizeof(int16_t)
+	};
+	struct no_os_irq_ctrl_desc *intc_desc;
+	struct no_os_irq_ctrl_desc *gpio_irq_desc;
+	struct iio_hw_trig *adxl367_trig_desc;
+	struct iio_app_desc *app;
+	struct iio_app_init_param app_init_param = { 0 };
+
+	adxl367_iio_ip.adxl367_initial_param = &init_param;
+	adxl367_iio_ip.fifo_watermark = ADXL367_FIFO_WATERMARK;
+	ret = adxl367_iio_init(&adxl367_iio_desc, &adxl367_iio_ip);
+	if (ret)
+		return ret;
+
+	/* Initialize the parent interrupt controller */
+	ret = no_os_irq_ctrl_init(&intc_desc, &intc_ip);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_global_enable(intc_desc);
+	if (ret)
+		return ret;
+
+	/* Initialize the GPIO interrupt controller */
+	gpio_irq_extra_ip.parent_desc = intc_desc;
+	ret = no_os_irq_ctrl_init(&gpio_irq_desc, &gpio_irq_ip);
+	if (ret)
+		return ret;
+
+	adxl367_gpio_trig_ip.irq_ctrl = gpio_irq_desc;
+
+	/* Initialize hardware trigger */
+	ret = iio_hw_trig_init(&adxl367_trig_desc, &adxl367_gpio_trig_ip);
+	if (ret)
+		return ret;
+
+	struct iio_app_device iio_devices[] = {
+		{
+			.name = "adxl367",
+			.dev = adxl367_iio_desc,
+			.dev_descriptor = adxl367_iio_desc->iio_dev,
+			.read_buff = &accel_buff,
+		}
+	};
+
+	struct iio_trigger_init trigs[] = {
+		IIO_APP_TRIGGER(ADXL367_GPIO_TRIG_NAME, adxl367_trig_desc,
+				&adxl367_iio_trig_desc)
+	};
+
+	app_init_param.devices = iio_devices;
+	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(iio_devices);
+	app_init_param.uart_init_params = uart_ip;
+	app_init_param.trigs = trigs;
+	app_init_param.nb_trigs = NO_OS_ARRAY_SIZE(trigs);
+	app_init_param.irq_desc = intc_desc;
+
+	ret = iio_app_init(&app, app_init_param);
+	if (ret)
+		return ret;
+
+	adxl367_trig_desc->iio_desc = app->iio_desc;
+
+	return iio_app_run(app);
+}
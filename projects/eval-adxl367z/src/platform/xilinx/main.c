@@ -38,6 +38,10 @@
 #include "iio_example.h"
 #endif
 
+#ifdef IIO_TRIGGER_EXAMPLE
+#include "iio_trigger_example.h"
+#endif
+
 #ifdef DUMMY_EXAMPLE
 #include "dummy_example.h"
 #endif
@@ -62,6 +66,12 @@ int main()
 		goto error;
 #endif
 
+#ifdef IIO_TRIGGER_EXAMPLE
+	ret = iio_trigger_example_main();
+	if (ret < 0)
+		goto error;
+#endif
+
 #ifdef DUMMY_EXAMPLE
 	ret = dummy_example_main();
 	if (ret < 0)
@@ -73,7 +83,7 @@ int main()
 	/* Disable the data cache. */
 	Xil_ICacheDisable();
 
-#if (IIO_EXAMPLE+DUMMY_EXAMPLE != 1)
+#if (IIO_EXAMPLE+IIO_TRIGGER_EXAMPLE+DUMMY_EXAMPLE != 1)
 #error Selected example projects cannot be enabled at the same time. \
 Please enable only one example and rebuild the project.
 #endif
@@ -37,3 +37,21 @@ struct xil_spi_init_param spi_extra = {
 	.type = SPI_PS,
 	.flags = 0U
 };
+
+#ifdef IIO_SUPPORT
+struct xil_uart_init_param uart_extra_ip = {
+	.type = UART_PS,
+	.irq_id = UART_IRQ_ID
+};
+#endif
+
+#ifdef IIO_TRIGGER_EXAMPLE
+struct xil_irq_init_param intc_extra_ip = {
+	.type = IRQ_PS,
+};
+
+/* The parent interrupt controller is filled in at runtime. */
+struct xil_gpio_irq_init_param gpio_irq_extra_ip = {
+	.gpio_device_id = GPIO_DEVICE_ID,
+};
+#endif
@@ -41,10 +41,37 @@
 #define SPI_OPS 	&xil_spi_ops
 
 #ifdef IIO_SUPPORT
+#include "xilinx_uart.h"
+
 #define INTC_DEVICE_ID 	XPAR_SCUGIC_SINGLE_DEVICE_ID
 #define UART_IRQ_ID     XPAR_XUARTPS_1_INTR
 #define UART_DEVICE_ID      XPAR_XUARTPS_0_DEVICE_ID
 #define UART_BAUDRATE  115200
+#define UART_EXTRA	&uart_extra_ip
+#define UART_OPS	&xil_uart_ops
+
+extern struct xil_uart_init_param uart_extra_ip;
+#endif
+
+#ifdef IIO_TRIGGER_EXAMPLE
+#include "xilinx_irq.h"
+#include "xilinx_gpio_irq.h"
+
+#define INTC_OPS	&xil_irq_ops
+#define INTC_EXTRA	&intc_extra_ip
+
+#define GPIO_DEVICE_ID	XPAR_PS7_GPIO_0_DEVICE_ID
+#define GPIO_IRQ_ID	XPAR_XGPIOPS_0_INTR
+#define GPIO_IRQ_OPS	&xil_gpio_irq_ops
+#define GPIO_IRQ_EXTRA	&gpio_irq_extra_ip
+#define GPIO_OFFSET	54U
+
+/* EMIO GPIO wired to the ADXL367 INT1 pin */
+#define ADXL367_GPIO_TRIG_IRQ_ID	(GPIO_OFFSET + 32U)
+#define ADXL367_GPIO_CB_HANDLE		NULL /* Not used for xilinx platform */
+
+extern struct xil_irq_init_param intc_extra_ip;
+extern struct xil_gpio_irq_init_param gpio_irq_extra_ip;
 #endif
 
 extern struct xil_spi_init_param spi_extra;
@@ -5,10 +5,17 @@ SRCS += $(PLATFORM_DRIVERS)/xilinx_spi.c \
 INCS +=	$(PLATFORM_DRIVERS)/$(PLATFORM)_spi.h \
 	$(PLATFORM_DRIVERS)/xilinx_i2c.h
 
-ifeq (y,$(strip $(IIO_EXAMPLE)))
+ifneq (,$(filter y,$(strip $(IIO_EXAMPLE)) $(strip $(IIO_TRIGGER_EXAMPLE))))
 
 INCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.h
 
 SRCS += $(PLATFORM_DRIVERS)/xilinx_irq.c
 endif
+
+ifeq (y,$(strip $(IIO_TRIGGER_EXAMPLE)))
+
+INCS += $(PLATFORM_DRIVERS)/$(PLATFORM)_gpio_irq.h
+
+SRCS += $(PLATFORM_DRIVERS)/xilinx_gpio_irq.c
+endif
@@ -53,6 +53,7 @@ struct adc_demo_init_param adc_init_par = {
 	.ext_buff_len = SAMPLES_PER_CHANNEL,
 	.ext_buff = (uint16_t **)loopback_buffs,
 	.dev_global_attr = 3333,
+	.sample_rate = ADC_DEMO_SAMPLE_RATE,
 	.dev_ch_attr = {
 		1111, 1112, 1113, 1114, 1115, 1116, 1117, 1118,
 		1119, 1120,	1121, 1122, 1123, 1124, 1125, 1126
@@ -46,6 +46,11 @@ extern struct no_os_uart_init_param iio_demo_uart_ip;
 
 #define DEMO_CHANNELS no_os_max(TOTAL_ADC_CHANNELS, TOTAL_DAC_CHANNELS)
 
+/* Sample rate of the adc_demo data. 0 to generate it as fast as requested */
+#ifndef ADC_DEMO_SAMPLE_RATE
+#define ADC_DEMO_SAMPLE_RATE	0
+#endif
+
 #ifdef ENABLE_LOOPBACK
 #define SAMPLES_PER_CHANNEL	SAMPLES_PER_CHANNEL_PLATFORM
 #else //ENABLE_LOOPBACK
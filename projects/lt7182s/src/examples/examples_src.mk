@@ -17,12 +17,16 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c	\
 	$(DRIVERS)/power/lt7182s/iio_lt7182s.c	\
 	$(NO-OS)/iio/iio.c	\
 	$(NO-OS)/iio/iiod.c	\
+	$(NO-OS)/iio/iio_delta.c	\
+	$(NO-OS)/iio/iio_filter.c	\
 	$(NO-OS)/util/no_os_fifo.c
 
 INCS += $(NO-OS)/iio/iio_app/iio_app.h	\
 	$(DRIVERS)/power/lt7182s/iio_lt7182s.h	\
 	$(NO-OS)/iio/iio.h	\
 	$(NO-OS)/iio/iiod.h	\
+	$(NO-OS)/iio/iio_delta.h	\
+	$(NO-OS)/iio/iio_filter.h	\
 	$(NO-OS)/iio/iio_types.h	\
 	$(NO-OS)/include/no_os_fifo.h
 endif
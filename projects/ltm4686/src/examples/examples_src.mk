@@ -18,5 +18,7 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c	\
 	$(DRIVERS)/power/ltm4686/iio_ltm4686.c	\
 	$(NO-OS)/iio/iio.c \
 	$(NO-OS)/iio/iiod.c \
+	$(NO-OS)/iio/iio_delta.c \
+	$(NO-OS)/iio/iio_filter.c \
 	$(NO-OS)/util/no_os_fifo.c
 endif
@@ -3972,6 +3972,230 @@ void test_adis_read_burst_data_6(void)
 	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
 }
 
+/**
+ * @brief Test adis_read_burst_data_fifo with invalid number of samples.
+ */
+void test_adis_read_burst_data_fifo_1(void)
+{
+	device_alloc.info = adis_chip_info;
+	struct adis_burst_data data;
+	uint32_t nb_samples = 0;
+
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+
+	retval = adis_read_burst_data_fifo(&device_alloc, &data, &nb_samples,
+					   device_alloc.burst32, device_alloc.burst_sel, true);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with more samples than allocated.
+ */
+void test_adis_read_burst_data_fifo_2(void)
+{
+	device_alloc.info = adis_chip_info;
+	struct adis_burst_data data[4];
+	uint32_t nb_samples = 4;
+
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+	device_alloc.fifo_max_reads = 3;
+
+	retval = adis_read_burst_data_fifo(&device_alloc, data, &nb_samples,
+					   device_alloc.burst32, device_alloc.burst_sel, true);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with invalid spi transfer.
+ */
+void test_adis_read_burst_data_fifo_3(void)
+{
+	device_alloc.info = adis_chip_info;
+	static struct no_os_spi_msg msgs[4];
+	static uint8_t frames[4 * 64];
+	struct adis_burst_data data[4];
+	uint32_t nb_samples = 4;
+
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+
+	no_os_free_Ignore();
+	no_os_calloc_IgnoreAndReturn(msgs);
+	no_os_calloc_IgnoreAndReturn(frames);
+	retval = adis_fifo_buffers_alloc(&device_alloc, nb_samples);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_EQUAL_PTR(msgs, device_alloc.fifo_msgs);
+	TEST_ASSERT_EQUAL_PTR(frames, device_alloc.fifo_frames);
+
+	no_os_spi_transfer_IgnoreAndReturn(-1);
+	retval = adis_read_burst_data_fifo(&device_alloc, data, &nb_samples,
+					   device_alloc.burst32, device_alloc.burst_sel, true);
+	TEST_ASSERT_EQUAL_INT(-1, retval);
+}
+
+/**
+ * @brief Test adis_fifo_buffers_alloc with unsuccessful memory allocation.
+ */
+void test_adis_read_burst_data_fifo_4(void)
+{
+	device_alloc.info = adis_chip_info;
+
+	no_os_free_Ignore();
+	no_os_calloc_IgnoreAndReturn(NULL);
+	retval = adis_fifo_buffers_alloc(&device_alloc, 4);
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, retval);
+	TEST_ASSERT_EQUAL_UINT32(0, device_alloc.fifo_max_reads);
+}
+
+/* ADIS1657X 16-bit FIFO burst frame, including the command bytes */
+#define TEST_ADIS_FIFO_FRAME_SIZE	22
+#define TEST_ADIS_FIFO_CNTR_OFFSET	18
+#define TEST_ADIS_FIFO_CHECKSUM_OFFSET	20
+/* Data-sheet stall time between two burst reads, in us */
+#define TEST_ADIS_FIFO_STALL_TIME	10
+
+/* Data counter of the frame with an invalid checksum, 0 if none. */
+static uint16_t test_adis_fifo_bad_cntr;
+
+/**
+ * @brief no_os_get_unaligned_be16 callback, decoding the value.
+ */
+static uint16_t test_adis_get_unaligned_be16(uint8_t *buf, int cmock_num_calls)
+{
+	return (buf[0] << 8) | buf[1];
+}
+
+/**
+ * @brief Fill in a 16-bit FIFO burst frame with the given data counter.
+ */
+static void test_adis_fifo_frame(uint8_t *frame, uint16_t data_cntr)
+{
+	uint16_t checksum = 0;
+	uint8_t i;
+
+	for (i = ADIS_READ_BURST_DATA_CMD_SIZE; i < TEST_ADIS_FIFO_CNTR_OFFSET; i++)
+		frame[i] = i;
+	frame[TEST_ADIS_FIFO_CNTR_OFFSET] = data_cntr >> 8;
+	frame[TEST_ADIS_FIFO_CNTR_OFFSET + 1] = data_cntr;
+
+	/* The diagnosis data is not part of the checksum. */
+	for (i = 4; i < TEST_ADIS_FIFO_CHECKSUM_OFFSET; i++)
+		checksum += frame[i];
+	if (data_cntr == test_adis_fifo_bad_cntr)
+		checksum++;
+
+	frame[TEST_ADIS_FIFO_CHECKSUM_OFFSET] = checksum >> 8;
+	frame[TEST_ADIS_FIFO_CHECKSUM_OFFSET + 1] = checksum;
+}
+
+/**
+ * @brief no_os_spi_transfer callback for a FIFO read. Checks the messages and
+ * returns frames with consecutive data counters, starting from 1.
+ */
+static int32_t test_adis_fifo_transfer(struct no_os_spi_desc *desc,
+				       struct no_os_spi_msg *msgs, uint32_t len,
+				       int cmock_num_calls)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_UINT32(3, len);
+	TEST_ASSERT_EQUAL_PTR(device_alloc.fifo_msgs, msgs);
+
+	for (i = 0; i < len; i++) {
+		/* One frame per message, in order */
+		TEST_ASSERT_EQUAL_PTR(&device_alloc.fifo_frames[i * TEST_ADIS_FIFO_FRAME_SIZE],
+				      msgs[i].tx_buff);
+		TEST_ASSERT_EQUAL_PTR(msgs[i].tx_buff, msgs[i].rx_buff);
+		TEST_ASSERT_EQUAL_UINT32(TEST_ADIS_FIFO_FRAME_SIZE, msgs[i].bytes_number);
+		TEST_ASSERT_EQUAL_UINT8(1, msgs[i].cs_change);
+		TEST_ASSERT_EQUAL_UINT32(TEST_ADIS_FIFO_STALL_TIME, msgs[i].cs_change_delay);
+
+		/* All the reads pop the FIFO, except the last one */
+		if (i == len - 1)
+			TEST_ASSERT_EQUAL_HEX(0x00, msgs[i].tx_buff[0]);
+		else
+			TEST_ASSERT_EQUAL_HEX(ADIS_READ_BURST_DATA_CMD_MSB, msgs[i].tx_buff[0]);
+		TEST_ASSERT_EQUAL_HEX(ADIS_READ_BURST_DATA_CMD_LSB, msgs[i].tx_buff[1]);
+
+		test_adis_fifo_frame(msgs[i].rx_buff, i + 1);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with successful reading.
+ */
+void test_adis_read_burst_data_fifo_5(void)
+{
+	device_alloc.info = adis_chip_info;
+	static struct no_os_spi_msg msgs[3];
+	static uint8_t frames[3 * 64];
+	struct adis_burst_data data[3];
+	uint32_t nb_samples = 3;
+	uint32_t i;
+
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+	test_adis_fifo_bad_cntr = 0;
+
+	no_os_free_Ignore();
+	no_os_calloc_IgnoreAndReturn(msgs);
+	no_os_calloc_IgnoreAndReturn(frames);
+	retval = adis_fifo_buffers_alloc(&device_alloc, nb_samples);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+
+	no_os_spi_transfer_StubWithCallback(test_adis_fifo_transfer);
+	no_os_get_unaligned_be16_StubWithCallback(test_adis_get_unaligned_be16);
+	no_os_field_get_IgnoreAndReturn(0);
+	retval = adis_read_burst_data_fifo(&device_alloc, data, &nb_samples,
+					   device_alloc.burst32, device_alloc.burst_sel, true);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_EQUAL_UINT32(3, nb_samples);
+	TEST_ASSERT_FALSE(device_alloc.diag_flags.checksum_err);
+	for (i = 0; i < nb_samples; i++)
+		TEST_ASSERT_EQUAL_UINT16(i + 1, data[i].data_cntr_lsb);
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with a frame failing the checksum. The
+ * frame is dropped, leaving a gap in the data counters of the returned samples
+ * which is accounted as a lost sample.
+ */
+void test_adis_read_burst_data_fifo_6(void)
+{
+	device_alloc.info = adis_chip_info;
+	static struct no_os_spi_msg msgs[3];
+	static uint8_t frames[3 * 64];
+	struct adis_burst_data data[3];
+	uint32_t nb_samples = 3;
+
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+	test_adis_fifo_bad_cntr = 2;
+
+	no_os_free_Ignore();
+	no_os_calloc_IgnoreAndReturn(msgs);
+	no_os_calloc_IgnoreAndReturn(frames);
+	retval = adis_fifo_buffers_alloc(&device_alloc, nb_samples);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+
+	no_os_spi_transfer_StubWithCallback(test_adis_fifo_transfer);
+	no_os_get_unaligned_be16_StubWithCallback(test_adis_get_unaligned_be16);
+	no_os_field_get_IgnoreAndReturn(0);
+	retval = adis_read_burst_data_fifo(&device_alloc, data, &nb_samples,
+					   device_alloc.burst32, device_alloc.burst_sel, true);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_samples);
+	TEST_ASSERT_TRUE(device_alloc.diag_flags.checksum_err);
+	TEST_ASSERT_EQUAL_UINT16(1, data[0].data_cntr_lsb);
+	TEST_ASSERT_EQUAL_UINT16(3, data[1].data_cntr_lsb);
+	/* One sample lost between the two valid ones */
+	TEST_ASSERT_EQUAL_UINT16(1, data[1].data_cntr_lsb - data[0].data_cntr_lsb - 1);
+}
+
 /**
  * @brief Test adis_update_ext_clk_freq with unsuccessful SPI read for
  * sync mode.
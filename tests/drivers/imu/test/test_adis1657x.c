@@ -797,6 +797,16 @@ void test_adis1657x_read_burst_data(void)
 	test_adis_read_burst_data_6();
 }
 
+void test_adis1657x_read_burst_data_fifo(void)
+{
+	test_adis_read_burst_data_fifo_1();
+	test_adis_read_burst_data_fifo_2();
+	test_adis_read_burst_data_fifo_3();
+	test_adis_read_burst_data_fifo_4();
+	test_adis_read_burst_data_fifo_5();
+	test_adis_read_burst_data_fifo_6();
+}
+
 void test_adis1657x_update_ext_clk_freq(void)
 {
 	test_adis_update_ext_clk_freq_1();
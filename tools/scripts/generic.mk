@@ -179,6 +179,15 @@ ifeq (y,$(strip $(DISABLE_SECURE_SOCKET)))
 CFLAGS += -DDISABLE_SECURE_SOCKET
 endif
 
+# Built-in allocator backend for no_os_malloc/no_os_calloc/no_os_free
+ifeq (pool,$(strip $(NO_OS_ALLOC)))
+CFLAGS += -DNO_OS_ALLOC_POOL
+endif
+
+ifeq (y,$(strip $(NO_OS_ALLOC_STATS)))
+CFLAGS += -DNO_OS_ALLOC_STATS
+endif
+
 # Mbed also has an INC_DIRS variable, so this needs to be NO_OS_INC_DIRS
 NO_OS_INC_DIRS := $(patsubst %/,%,$(NO_OS_INC_DIRS))
 SRC_DIRS := $(patsubst %/,%,$(SRC_DIRS))
@@ -1,5 +1,7 @@
 SRCS += $(NO-OS)/iio/iio.c
 SRCS += $(NO-OS)/iio/iiod.c
+SRCS += $(NO-OS)/iio/iio_delta.c
+SRCS += $(NO-OS)/iio/iio_filter.c
 SRCS += $(NO-OS)/iio/iio_trigger.c
 SRCS += $(NO-OS)/iio/iio_app/iio_app.c
 
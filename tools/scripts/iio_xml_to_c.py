@@ -0,0 +1,54 @@
+#!/bin/python
+
+import argparse
+import subprocess
+
+description_help='''Convert an IIO context xml to a C source file
+The generated file defines the arrays to set in iio_init_param.xml and
+iio_init_param.xml_zstd, so the xml is stored in flash and not generated
+at runtime. The xml can be obtained with iio_get_xml() or with the libiio
+iio_genxml tool connected to the running application.
+Examples:\n
+	>python iio_xml_to_c.py context.xml iio_ctx_xml.c
+	>python iio_xml_to_c.py --zstd context.xml iio_ctx_xml.c
+'''
+
+def parse_input():
+	parser = argparse.ArgumentParser(description=description_help,\
+				formatter_class=argparse.RawTextHelpFormatter)
+	parser.add_argument('xml', help="Path to the context xml")
+	parser.add_argument('output', help="Path of the C file to generate")
+	parser.add_argument('--name', default='iio_ctx_xml',
+			    help="Name of the generated arrays")
+	parser.add_argument('--zstd', action='store_true',
+			    help="Also generate a zstd compressed copy, needs the zstd tool")
+	return parser.parse_args()
+
+def c_array(data):
+	lines = []
+	for i in range(0, len(data), 12):
+		lines.append('\t' + ' '.join('0x%02x,' % b for b in data[i:i + 12]))
+	return '\n'.join(lines)
+
+def main():
+	args = parse_input()
+
+	with open(args.xml, 'rb') as f:
+		xml = f.read().strip()
+
+	out = '/* Generated by iio_xml_to_c.py from %s, do not edit */\n' % args.xml
+	out += '#include <stdint.h>\n\n'
+	out += 'const char %s[] = {\n%s\n\t0x00\n};\n' % (args.name, c_array(xml))
+	out += 'const uint32_t %s_len = %d;\n' % (args.name, len(xml))
+
+	if args.zstd:
+		zstd = subprocess.run(['zstd', '-19', '-c', '-q'], input=xml,
+				      stdout=subprocess.PIPE, check=True).stdout
+		out += '\nconst uint8_t %s_zstd[] = {\n%s\n};\n' % (args.name,
+								c_array(zstd))
+		out += 'const uint32_t %s_zstd_len = %d;\n' % (args.name, len(zstd))
+
+	with open(args.output, 'w') as f:
+		f.write(out)
+
+main()
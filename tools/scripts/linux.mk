@@ -8,6 +8,12 @@ PROJECT_BUILD = $(BUILD_DIR)/app
 CFLAGS +=  -g3 \
 		-DLINUX_PLATFORM \
 
+# linux_spi.c runs the asynchronous transfers in a worker thread, so the
+# peripheral locks need the pthread mutex instead of the no-op default one
+LDFLAGS += -pthread
+SRCS += $(NO-OS)/drivers/platform/linux/linux_mutex.c
+INCS += $(NO-OS)/include/no_os_mutex.h
+
 $(PLATFORM)_project:
 	$(call mk_dir, $(BUILD_DIR)) $(HIDE)
 
@@ -31,7 +31,304 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <string.h>
+#include <errno.h>
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+
+#ifdef NO_OS_ALLOC_BUILTIN
+#include "no_os_mutex.h"
+
+/* Alignment of the memory returned by the built-in backend */
+#define NO_OS_ALLOC_ALIGN	(2 * sizeof(void *))
+
+/* Values of no_os_alloc_hdr.class which are not a pool index */
+#define NO_OS_ALLOC_CLASS_LIBC	0xFFFE
+#define NO_OS_ALLOC_CLASS_ARENA	0xFFFF
+/* Value of no_os_alloc_hdr.site when the call site is not tracked */
+#define NO_OS_ALLOC_NO_SITE	0xFFFF
+
+/* Header placed in front of each block handed out by the built-in backend */
+struct no_os_alloc_hdr {
+	/* Pool index or NO_OS_ALLOC_CLASS_* */
+	uint16_t class;
+	/* Index in the statistics table or NO_OS_ALLOC_NO_SITE */
+	uint16_t site;
+	/* Requested size */
+	uint32_t size;
+};
+
+#define NO_OS_ALLOC_HDR_SIZE \
+	no_os_align(sizeof(struct no_os_alloc_hdr), NO_OS_ALLOC_ALIGN)
+
+static void *alloc_mutex;
+static struct no_os_arena *alloc_arena;
+
+#ifdef NO_OS_ALLOC_POOL
+/* Payload sizes of the pools */
+static const uint32_t pool_sizes[] = {
+	16, 32, 64, 128, 256, 512, 1024, 2048
+};
+
+/* Free list of each pool. The next pointer is stored in the payload */
+static void *pool_free[NO_OS_ARRAY_SIZE(pool_sizes)];
+
+static uint8_t pool_heap[NO_OS_ALLOC_POOL_HEAP_SIZE]
+__attribute__((aligned(2 * sizeof(void *))));
+/* Number of heap bytes carved into pool blocks */
+static size_t pool_heap_used;
+#endif
+
+#ifdef NO_OS_ALLOC_STATS
+static struct no_os_alloc_stats alloc_stats[NO_OS_ALLOC_STATS_SITES];
+static uint32_t alloc_nb_sites;
+#endif
+
+/**
+ * @brief Take the allocator lock, creating it on first use. The mutex is
+ * 	  published with a compare-and-swap, if two threads race on the first
+ * 	  allocation the one that loses removes its own mutex.
+ * @return None.
+ */
+static void no_os_alloc_lock(void)
+{
+	void *mutex = __atomic_load_n(&alloc_mutex, __ATOMIC_ACQUIRE);
+	void *expected = NULL;
+
+	if (!mutex) {
+		no_os_mutex_init(&mutex);
+		if (!__atomic_compare_exchange_n(&alloc_mutex, &expected, mutex,
+						 false, __ATOMIC_ACQ_REL,
+						 __ATOMIC_ACQUIRE)) {
+			no_os_mutex_remove(mutex);
+			mutex = expected;
+		}
+	}
+	no_os_mutex_lock(mutex);
+}
+
+/**
+ * @brief Release the allocator lock.
+ * @return None.
+ */
+static void no_os_alloc_unlock(void)
+{
+	no_os_mutex_unlock(alloc_mutex);
+}
+
+#ifdef NO_OS_ALLOC_POOL
+/**
+ * @brief Get a block from the smallest pool that fits size.
+ * @param size - Requested size, in bytes.
+ * @return Pointer to the block header, or NULL if no pool can serve it.
+ */
+static struct no_os_alloc_hdr *no_os_alloc_pool_get(size_t size)
+{
+	struct no_os_alloc_hdr *hdr;
+	size_t block_size;
+	uint16_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(pool_sizes); i++)
+		if (size <= pool_sizes[i])
+			break;
+	if (i == NO_OS_ARRAY_SIZE(pool_sizes))
+		return NULL;
+
+	if (pool_free[i]) {
+		hdr = pool_free[i];
+		pool_free[i] = *(void **)((uint8_t *)hdr + NO_OS_ALLOC_HDR_SIZE);
+	} else {
+		block_size = NO_OS_ALLOC_HDR_SIZE + pool_sizes[i];
+		if (pool_heap_used + block_size > sizeof(pool_heap))
+			return NULL;
+		hdr = (struct no_os_alloc_hdr *)&pool_heap[pool_heap_used];
+		pool_heap_used += block_size;
+	}
+	hdr->class = i;
+
+	return hdr;
+}
+
+/**
+ * @brief Give a block back to its pool.
+ * @param hdr - Header of the block.
+ * @return None.
+ */
+static void no_os_alloc_pool_put(struct no_os_alloc_hdr *hdr)
+{
+	*(void **)((uint8_t *)hdr + NO_OS_ALLOC_HDR_SIZE) = pool_free[hdr->class];
+	pool_free[hdr->class] = hdr;
+}
+#endif
+
+#ifdef NO_OS_ALLOC_STATS
+/**
+ * @brief Account an allocation to its call site.
+ * @param site - Return address of the no_os_malloc/no_os_calloc call.
+ * @param size - Requested size, in bytes.
+ * @return Index of the call site, or NO_OS_ALLOC_NO_SITE if the table is full.
+ */
+static uint16_t no_os_alloc_stats_add(void *site, uint32_t size)
+{
+	struct no_os_alloc_stats *st;
+	uint32_t i;
+
+	for (i = 0; i < alloc_nb_sites; i++)
+		if (alloc_stats[i].site == site)
+			break;
+	if (i == alloc_nb_sites) {
+		if (alloc_nb_sites == NO_OS_ALLOC_STATS_SITES)
+			return NO_OS_ALLOC_NO_SITE;
+		alloc_nb_sites++;
+		alloc_stats[i].site = site;
+	}
+
+	st = &alloc_stats[i];
+	st->count++;
+	st->bytes += size;
+	st->in_use += size;
+	if (st->in_use > st->peak)
+		st->peak = st->in_use;
+
+	return i;
+}
+#endif
+
+/**
+ * @brief Allocate a block with the built-in backend.
+ * @param size - Size of the memory block, in bytes.
+ * @param site - Return address of the no_os_malloc/no_os_calloc call.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+static void *no_os_alloc_builtin(size_t size, void *site)
+{
+	struct no_os_alloc_hdr *hdr = NULL;
+
+	if (size > UINT32_MAX - NO_OS_ALLOC_HDR_SIZE)
+		return NULL;
+
+	no_os_alloc_lock();
+	if (alloc_arena) {
+		hdr = no_os_arena_alloc(alloc_arena, NO_OS_ALLOC_HDR_SIZE + size);
+		if (hdr)
+			hdr->class = NO_OS_ALLOC_CLASS_ARENA;
+	}
+#ifdef NO_OS_ALLOC_POOL
+	if (!hdr)
+		hdr = no_os_alloc_pool_get(size);
+	if (!hdr && NO_OS_ALLOC_POOL_LIBC_FALLBACK) {
+#else
+	if (!hdr) {
+#endif
+		hdr = malloc(NO_OS_ALLOC_HDR_SIZE + size);
+		if (hdr)
+			hdr->class = NO_OS_ALLOC_CLASS_LIBC;
+	}
+	if (!hdr) {
+		no_os_alloc_unlock();
+		return NULL;
+	}
+
+	hdr->size = size;
+#ifdef NO_OS_ALLOC_STATS
+	hdr->site = no_os_alloc_stats_add(site, size);
+#else
+	hdr->site = NO_OS_ALLOC_NO_SITE;
+#endif
+	no_os_alloc_unlock();
+
+	return (uint8_t *)hdr + NO_OS_ALLOC_HDR_SIZE;
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_malloc(size_t size)
+{
+	return no_os_alloc_builtin(size, __builtin_return_address(0));
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it, set memory to 0.
+ * @param nitems - Number of elements to be allocated.
+ * @param size - Size of elements.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_calloc(size_t nitems, size_t size)
+{
+	void *ptr;
+
+	if (size && nitems > SIZE_MAX / size)
+		return NULL;
+
+	ptr = no_os_alloc_builtin(nitems * size, __builtin_return_address(0));
+	if (ptr)
+		memset(ptr, 0, nitems * size);
+
+	return ptr;
+}
+
+/**
+ * @brief Deallocate memory previously allocated by a call to no_os_calloc
+ * 		  or no_os_malloc.
+ * @param ptr - Pointer to a memory block previously allocated by a call
+ * 		  to no_os_calloc or no_os_malloc.
+ * @return None.
+ */
+__attribute__((weak)) void no_os_free(void *ptr)
+{
+	struct no_os_alloc_hdr *hdr;
+
+	if (!ptr)
+		return;
+
+	hdr = (struct no_os_alloc_hdr *)((uint8_t *)ptr - NO_OS_ALLOC_HDR_SIZE);
+
+#ifndef NO_OS_ALLOC_STATS
+	/* Nothing shared to update, the allocator lock is not needed */
+	if (hdr->class == NO_OS_ALLOC_CLASS_LIBC) {
+		free(hdr);
+		return;
+	}
+	if (hdr->class == NO_OS_ALLOC_CLASS_ARENA)
+		return;
+#endif
+
+	no_os_alloc_lock();
+#ifdef NO_OS_ALLOC_STATS
+	if (hdr->site != NO_OS_ALLOC_NO_SITE)
+		alloc_stats[hdr->site].in_use -= hdr->size;
+#endif
+#ifdef NO_OS_ALLOC_POOL
+	if (hdr->class != NO_OS_ALLOC_CLASS_LIBC &&
+	    hdr->class != NO_OS_ALLOC_CLASS_ARENA)
+		no_os_alloc_pool_put(hdr);
+#endif
+	no_os_alloc_unlock();
+
+	if (hdr->class == NO_OS_ALLOC_CLASS_LIBC)
+		free(hdr);
+}
+
+/**
+ * @brief Serve no_os_malloc/no_os_calloc from an arena. no_os_free is a no-op
+ * 	  for the memory obtained this way, it is given back by resetting the
+ * 	  arena. When the arena is full, the other backends are used.
+ * @param arena - Arena to allocate from, or NULL to stop using it.
+ * @return 0 in case of success.
+ */
+int no_os_alloc_set_arena(struct no_os_arena *arena)
+{
+	no_os_alloc_lock();
+	alloc_arena = arena;
+	no_os_alloc_unlock();
+
+	return 0;
+}
+
+#else
 
 /**
  * @brief Allocate memory and return a pointer to it.
@@ -65,3 +362,130 @@ __attribute__((weak)) void no_os_free(void *ptr)
 {
 	free(ptr);
 }
+
+/**
+ * @brief Serve no_os_malloc/no_os_calloc from an arena.
+ * @param arena - Arena to allocate from, or NULL to stop using it.
+ * @return -ENOSYS, the built-in allocator backend is not enabled.
+ */
+int no_os_alloc_set_arena(struct no_os_arena *arena)
+{
+	return arena ? -ENOSYS : 0;
+}
+
+#endif /* NO_OS_ALLOC_BUILTIN */
+
+#ifdef NO_OS_ALLOC_STATS
+/**
+ * @brief Copy the allocation statistics of the tracked call sites.
+ * @param stats - Array to fill.
+ * @param max - Number of elements of stats.
+ * @return Number of elements filled.
+ */
+uint32_t no_os_alloc_get_stats(struct no_os_alloc_stats *stats, uint32_t max)
+{
+	uint32_t nb;
+
+	if (!stats)
+		return 0;
+
+	no_os_alloc_lock();
+	nb = no_os_min(max, alloc_nb_sites);
+	memcpy(stats, alloc_stats, nb * sizeof(*stats));
+	no_os_alloc_unlock();
+
+	return nb;
+}
+
+/**
+ * @brief Clear the allocation statistics. The bytes currently in use are kept
+ * 	  so that the following frees are accounted correctly.
+ * @return None.
+ */
+void no_os_alloc_reset_stats(void)
+{
+	uint32_t i;
+
+	no_os_alloc_lock();
+	for (i = 0; i < alloc_nb_sites; i++) {
+		alloc_stats[i].count = 0;
+		alloc_stats[i].bytes = 0;
+		alloc_stats[i].peak = alloc_stats[i].in_use;
+	}
+	no_os_alloc_unlock();
+}
+
+#else
+
+/**
+ * @brief Copy the allocation statistics of the tracked call sites.
+ * @param stats - Array to fill.
+ * @param max - Number of elements of stats.
+ * @return 0, NO_OS_ALLOC_STATS is not enabled.
+ */
+uint32_t no_os_alloc_get_stats(struct no_os_alloc_stats *stats, uint32_t max)
+{
+	return 0;
+}
+
+/**
+ * @brief Clear the allocation statistics.
+ * @return None.
+ */
+void no_os_alloc_reset_stats(void)
+{
+}
+
+#endif /* NO_OS_ALLOC_STATS */
+
+/**
+ * @brief Initialize an arena over a memory region.
+ * @param arena - Arena to initialize.
+ * @param buf - Memory region.
+ * @param size - Size of the memory region, in bytes.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_arena_init(struct no_os_arena *arena, void *buf, size_t size)
+{
+	if (!arena || !buf || !size)
+		return -EINVAL;
+
+	arena->buf = buf;
+	arena->size = size;
+	arena->used = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate memory from an arena. The returned memory is aligned to
+ * 	  twice the size of a pointer, relative to the start of the region.
+ * @param arena - Arena to allocate from.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the arena is full.
+ */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size)
+{
+	size_t start;
+
+	if (!arena || !arena->buf)
+		return NULL;
+
+	start = no_os_align(arena->used, 2 * sizeof(void *));
+	if (start > arena->size || size > arena->size - start)
+		return NULL;
+	arena->used = start + size;
+
+	return arena->buf + start;
+}
+
+/**
+ * @brief Give back all the memory allocated from an arena.
+ * @param arena - Arena to reset.
+ * @return None.
+ */
+void no_os_arena_reset(struct no_os_arena *arena)
+{
+	if (arena)
+		arena->used = 0;
+}
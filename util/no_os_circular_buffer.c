@@ -40,6 +40,11 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
+/* Index positions shared between the writer and the reader in SPSC mode */
+#define NO_OS_CB_LOAD_ACQUIRE(ptr)	__atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define NO_OS_CB_STORE_RELEASE(ptr, val) \
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 		     uint32_t size)
 {
@@ -53,14 +58,48 @@ int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 	return 0;
 }
 
+/**
+ * @brief Configure a circular buffer for one writer and one reader running
+ * concurrently, without memory allocation.
+ *
+ * The reader and the writer each only store their own position, published
+ * with release semantics once the data is copied, so no critical section is
+ * needed. Writes that don't fit in the free space are refused instead of
+ * overwriting unread data, and up to NO_OS_CB_ASYNC_WRITES asynchronous
+ * writes (for example DMA ping-pong transfers) may be outstanding. They are
+ * completed in the order they were prepared.
+ *
+ * @param desc - Circular buffer reference
+ * @param buff - Buffer memory
+ * @param size - Buffer size
+ * @return
+ *  - 0 - No errors
+ *  - -EINVAL - Wrong parameters used
+ */
+int32_t no_os_cb_cfg_spsc(struct no_os_circular_buffer *desc, int8_t *buff,
+			  uint32_t size)
+{
+	int32_t ret;
+
+	/* Positions go up to 2 * size */
+	if (size > UINT32_MAX / 2)
+		return -EINVAL;
+
+	ret = no_os_cb_cfg(desc, buff, size);
+	if (ret)
+		return ret;
+
+	desc->spsc = true;
+
+	return 0;
+}
+
 /**
  * @brief Create circular buffer structure.
  *
- * @note Circular buffer implementation is thread safe for one write
- * and one reader.
- * If multiple writer or multiple readers access the circular buffer then
- * function that updates the structure should be called inside a critical
- * critical section.
+ * @note Unless configured with no_os_cb_cfg_spsc, the functions updating
+ * the structure should be called inside a critical section if the writer
+ * and the reader may run concurrently.
  *
  * @param desc - Where to store the circular buffer reference
  * @param buff_size - Buffer size
@@ -110,6 +149,181 @@ int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
 	return 0;
 }
 
+/* Move a SPSC position by n bytes */
+static inline uint32_t no_os_cb_spsc_advance(struct no_os_circular_buffer *desc,
+		uint32_t pos, uint32_t n)
+{
+	pos += n;
+	if (pos >= 2 * desc->size)
+		pos -= 2 * desc->size;
+
+	return pos;
+}
+
+/* Bytes between two SPSC positions */
+static inline uint32_t no_os_cb_spsc_dist(struct no_os_circular_buffer *desc,
+		uint32_t from, uint32_t to)
+{
+	return to >= from ? to - from : to + 2 * desc->size - from;
+}
+
+/* Index in the buffer of a SPSC position */
+static inline uint32_t no_os_cb_spsc_idx(struct no_os_circular_buffer *desc,
+		uint32_t pos)
+{
+	return pos >= desc->size ? pos - desc->size : pos;
+}
+
+/* Writer side: publish n more bytes and update the high watermark */
+static void no_os_cb_spsc_commit(struct no_os_circular_buffer *desc,
+				 uint32_t n)
+{
+	uint32_t pos = no_os_cb_spsc_advance(desc, desc->write.pos, n);
+	uint32_t used;
+
+	NO_OS_CB_STORE_RELEASE(&desc->write.pos, pos);
+
+	used = no_os_cb_spsc_dist(desc, NO_OS_CB_LOAD_ACQUIRE(&desc->read.pos),
+				  pos);
+	if (used > desc->stats.high_watermark)
+		desc->stats.high_watermark = used;
+}
+
+/* Copy size bytes at position pos, wrapping at the end of the buffer */
+static void no_os_cb_spsc_copy(struct no_os_circular_buffer *desc,
+			       uint32_t pos, void *data, uint32_t size,
+			       bool is_read)
+{
+	uint32_t idx = no_os_cb_spsc_idx(desc, pos);
+	uint32_t first = no_os_min(size, desc->size - idx);
+
+	if (is_read) {
+		memcpy(data, desc->buff + idx, first);
+		memcpy((uint8_t *)data + first, desc->buff, size - first);
+	} else {
+		memcpy(desc->buff + idx, data, first);
+		memcpy(desc->buff, (uint8_t *)data + first, size - first);
+	}
+}
+
+/* no_os_cb_write/read in SPSC mode, the whole data or nothing is copied */
+static int32_t no_os_cb_spsc_operation(struct no_os_circular_buffer *desc,
+				       void *data, uint32_t size, bool is_read)
+{
+	uint32_t wpos, rpos;
+
+	if (is_read) {
+		if (desc->read.async_started)
+			return -EBUSY;
+
+		wpos = NO_OS_CB_LOAD_ACQUIRE(&desc->write.pos);
+		rpos = desc->read.pos;
+		if (size > no_os_cb_spsc_dist(desc, rpos, wpos))
+			return -EAGAIN;
+
+		no_os_cb_spsc_copy(desc, rpos, data, size, true);
+		/* The data is copied before the space is given back */
+		NO_OS_CB_STORE_RELEASE(&desc->read.pos,
+				       no_os_cb_spsc_advance(desc, rpos, size));
+
+		return 0;
+	}
+
+	if (desc->async_nb)
+		return -EBUSY;
+
+	rpos = NO_OS_CB_LOAD_ACQUIRE(&desc->read.pos);
+	wpos = desc->write.pos;
+	if (size > desc->size - no_os_cb_spsc_dist(desc, rpos, wpos)) {
+		desc->stats.overruns++;
+		desc->stats.overrun_bytes += size;
+		return -ENOSPC;
+	}
+
+	no_os_cb_spsc_copy(desc, wpos, data, size, false);
+	no_os_cb_spsc_commit(desc, size);
+	desc->reserve_pos = desc->write.pos;
+
+	return 0;
+}
+
+/* no_os_cb_prepare_async_write/read in SPSC mode */
+static int32_t no_os_cb_spsc_prepare_async(struct no_os_circular_buffer *desc,
+		uint32_t size, void **buff, uint32_t *size_available,
+		bool is_read)
+{
+	uint32_t wpos, rpos, pos;
+	uint32_t avail;
+
+	if (is_read) {
+		if (desc->read.async_started)
+			return -EBUSY;
+
+		wpos = NO_OS_CB_LOAD_ACQUIRE(&desc->write.pos);
+		pos = desc->read.pos;
+		avail = no_os_cb_spsc_dist(desc, pos, wpos);
+	} else {
+		if (desc->async_nb == NO_OS_CB_ASYNC_WRITES)
+			return -EBUSY;
+
+		rpos = NO_OS_CB_LOAD_ACQUIRE(&desc->read.pos);
+		pos = desc->reserve_pos;
+		avail = desc->size - no_os_cb_spsc_dist(desc, rpos, pos);
+	}
+	if (!avail)
+		return is_read ? -EAGAIN : -ENOSPC;
+
+	/* Contiguous space only */
+	size = no_os_min(size, avail);
+	size = no_os_min(size, desc->size - no_os_cb_spsc_idx(desc, pos));
+
+	*buff = desc->buff + no_os_cb_spsc_idx(desc, pos);
+	*size_available = size;
+
+	if (is_read) {
+		desc->read.async_size = size;
+		desc->read.async_started = true;
+	} else {
+		desc->async_sizes[(desc->async_first + desc->async_nb) %
+				  NO_OS_CB_ASYNC_WRITES] = size;
+		desc->async_nb++;
+		desc->reserve_pos = no_os_cb_spsc_advance(desc, pos, size);
+	}
+
+	return 0;
+}
+
+/* no_os_cb_end_async_write/read in SPSC mode */
+static int32_t no_os_cb_spsc_end_async(struct no_os_circular_buffer *desc,
+				       bool is_read)
+{
+	uint32_t size;
+
+	if (is_read) {
+		if (!desc->read.async_started)
+			return -1;
+
+		NO_OS_CB_STORE_RELEASE(&desc->read.pos,
+				       no_os_cb_spsc_advance(desc, desc->read.pos,
+						       desc->read.async_size));
+		desc->read.async_size = 0;
+		desc->read.async_started = false;
+
+		return 0;
+	}
+
+	if (!desc->async_nb)
+		return -1;
+
+	/* The oldest write is the one completed */
+	size = desc->async_sizes[desc->async_first];
+	desc->async_first = (desc->async_first + 1) % NO_OS_CB_ASYNC_WRITES;
+	desc->async_nb--;
+	no_os_cb_spsc_commit(desc, size);
+
+	return 0;
+}
+
 /**
  * @brief Get the number of elements in the buffer.
  * @param desc - Circular buffer reference
@@ -126,6 +340,13 @@ int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
 	if (!desc || !size)
 		return -EINVAL;
 
+	if (desc->spsc) {
+		*size = no_os_cb_spsc_dist(desc,
+					   NO_OS_CB_LOAD_ACQUIRE(&desc->read.pos),
+					   NO_OS_CB_LOAD_ACQUIRE(&desc->write.pos));
+		return 0;
+	}
+
 	if (desc->write.spin_count > desc->read.spin_count)
 		nb_spins = desc->write.spin_count - desc->read.spin_count;
 	else
@@ -164,6 +385,10 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 	if (!desc || !buff || !raw_size_available)
 		return -EINVAL;
 
+	if (desc->spsc)
+		return no_os_cb_spsc_prepare_async(desc, requested_size, buff,
+						   raw_size_available, is_read);
+
 	ret = 0;
 	/* Select if read or write index will be updated */
 	ptr = is_read ? &desc->read : &desc->write;
@@ -218,6 +443,9 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	if (!desc)
 		return -EINVAL;
 
+	if (desc->spsc)
+		return no_os_cb_spsc_end_async(desc, is_read);
+
 	/* Select if read or write index will be updated */
 	ptr = is_read ? &desc->read : &desc->write;
 
@@ -238,6 +466,26 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	return 0;
 }
 
+/* Update the statistics before size bytes are written, not in SPSC mode */
+static void no_os_cb_write_stats(struct no_os_circular_buffer *desc,
+				 uint32_t size)
+{
+	uint32_t used;
+
+	no_os_cb_size(desc, &used);
+	if (used + size > desc->size) {
+		desc->stats.overruns++;
+		desc->stats.overrun_bytes += no_os_min(used + size - desc->size,
+						       desc->size);
+		used = desc->size;
+	} else {
+		used += size;
+	}
+
+	if (used > desc->stats.high_watermark)
+		desc->stats.high_watermark = used;
+}
+
 /*
  * Functionality described at cb_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
@@ -255,6 +503,12 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
 	if (!desc || !data || !size)
 		return -EINVAL;
 
+	if (desc->spsc)
+		return no_os_cb_spsc_operation(desc, data, size, is_read);
+
+	if (!is_read)
+		no_os_cb_write_stats(desc, size);
+
 	sticky_overrun = 0;
 	i = 0;
 	while (i < size) {
@@ -296,10 +550,13 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
  * @param size_to_write - Number of bytes needed to write to the buffer.
  * @param write_buff - Address where to store the buffer where to write to.
  * @param size_avilable - no_os_min(size_to_write, size until end of allocated buffer)
+ *                        and, in SPSC mode, free space
  * @return
  *  - 0   - No errors
  *  - -EINVAL   - Wrong parameters used
- *  - -EBUSY    - Asynchronous transaction already started
+ *  - -EBUSY    - Asynchronous transaction already started, or
+ *                NO_OS_CB_ASYNC_WRITES outstanding in SPSC mode
+ *  - -ENOSPC   - SPSC mode: the buffer is full
  */
 int32_t no_os_cb_prepare_async_write(struct no_os_circular_buffer *desc,
 				     uint32_t size_to_write,
@@ -339,6 +596,8 @@ int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
  * \defgroup end_async_group End Ashyncronous functions
  * @brief End asynchronous transaction.
  *
+ * In SPSC mode, the oldest outstanding asynchronous write is completed.
+ *
  * @param desc - Circular buffer reference
  * @return
  *  - 0   - No errors
@@ -348,6 +607,9 @@ int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
  */
 int32_t no_os_cb_end_async_write(struct no_os_circular_buffer *desc)
 {
+	if (desc && !desc->spsc && desc->write.async_started)
+		no_os_cb_write_stats(desc, desc->write.async_size);
+
 	return no_os_cb_end_async_operation(desc, 0);
 }
 
@@ -366,6 +628,8 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
  * @return
  *  - 0 - No errors
  *  - -EINVAL      - Wrong parameters used
+ *  - -ENOSPC      - SPSC mode: not enough free space, nothing written
+ *  - -EBUSY       - SPSC mode: asynchronous writes are outstanding
  */
 int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
 		       uint32_t size)
@@ -382,9 +646,51 @@ int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
  *  - 0   - No errors
  *  - -EINVAL   - Wrong parameters used
  *  - -NO_OS_EOVERRUN - An overrun occurred and some data have been overwritten
+ *  - -EAGAIN   - SPSC mode: less than size bytes available, nothing read
  */
 int32_t no_os_cb_read(struct no_os_circular_buffer *desc, void *data,
 		      uint32_t size)
 {
 	return no_os_cb_operation(desc, data, size, 1);
 }
+
+/**
+ * @brief Get the buffer statistics.
+ *
+ * The statistics are updated by the writer. In SPSC mode they may be read
+ * from the reader side, the values being the ones of a recent write.
+ *
+ * @param desc - Circular buffer reference
+ * @param stats - Where to store the statistics
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used
+ */
+int32_t no_os_cb_get_stats(struct no_os_circular_buffer *desc,
+			   struct no_os_cb_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the buffer statistics. Should be called from the writer side
+ * or while no write is in progress.
+ * @param desc - Circular buffer reference
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used
+ */
+int32_t no_os_cb_reset_stats(struct no_os_circular_buffer *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	memset(&desc->stats, 0, sizeof(desc->stats));
+
+	return 0;
+}
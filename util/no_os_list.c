@@ -36,18 +36,8 @@
 #include "no_os_alloc.h"
 #include <stdlib.h>
 
-/**
- * @struct no_os_list_elem
- * @brief Format of each element of the list
- */
-struct no_os_list_elem {
-	/** User data */
-	void			*data;
-	/** Reference to previous element */
-	struct no_os_list_elem	*prev;
-	/** Reference to next element */
-	struct no_os_list_elem	*next;
-};
+/* Default number of elements of the array storage */
+#define NO_OS_LIST_ARRAY_CAPACITY	8
 
 /**
  * @struct list_iterator
@@ -58,6 +48,8 @@ struct no_os_iterator {
 	struct _list_desc	*list;
 	/** Current element reference */
 	struct no_os_list_elem	*elem;
+	/** Current index, for NO_OS_LIST_STORAGE_ARRAY */
+	uint32_t		idx;
 };
 
 /**
@@ -77,6 +69,18 @@ struct _list_desc {
 	uint32_t		nb_iterators;
 	/** Internal list iterator */
 	struct no_os_iterator		l_it;
+	/** Storage of the elements */
+	enum no_os_list_storage	storage;
+	/** Offset of the embedded element for NO_OS_LIST_STORAGE_INTRUSIVE */
+	uint32_t		node_offset;
+	/** References for NO_OS_LIST_STORAGE_ARRAY */
+	void			**array;
+	/** Size of array, power of 2 */
+	uint32_t		capacity;
+	/** Index in array of the first element */
+	uint32_t		head;
+	/** Elements are ordered as a binary heap */
+	bool			heap;
 };
 
 /** @brief Default function used to compare element in the list ( \ref f_cmp) */
@@ -87,20 +91,29 @@ static int32_t no_os_default_comparator(void *data1, void *data2)
 
 /**
  * @brief Creates a new list elements an configure its value
+ * @param list - List reference
  * @param data - To set list_elem.data
  * @param prev - To set list_elem.prev
  * @param next - To set list_elem.next
  * @return Address of the new element or NULL if allocation fails.
  */
-static inline struct no_os_list_elem *create_element(void *data,
+static inline struct no_os_list_elem *create_element(struct _list_desc *list,
+		void *data,
 		struct no_os_list_elem *prev,
 		struct no_os_list_elem *next)
 {
 	struct no_os_list_elem *elem;
 
-	elem = (struct no_os_list_elem *)no_os_calloc(1, sizeof(*elem));
-	if (!elem)
-		return NULL;
+	if (list->storage == NO_OS_LIST_STORAGE_INTRUSIVE) {
+		if (!data)
+			return NULL;
+		elem = (struct no_os_list_elem *)((uint8_t *)data +
+						  list->node_offset);
+	} else {
+		elem = (struct no_os_list_elem *)no_os_calloc(1, sizeof(*elem));
+		if (!elem)
+			return NULL;
+	}
 	elem->data = data;
 	elem->prev = prev;
 	elem->next = next;
@@ -108,6 +121,298 @@ static inline struct no_os_list_elem *create_element(void *data,
 	return (elem);
 }
 
+/**
+ * @brief Release an element removed from the list
+ * @param list - List reference
+ * @param elem - Element to release
+ */
+static inline void release_element(struct _list_desc *list,
+				   struct no_os_list_elem *elem)
+{
+	if (list->storage != NO_OS_LIST_STORAGE_INTRUSIVE)
+		no_os_free(elem);
+}
+
+/**
+ * @brief Check if the list uses the array storage
+ * @param list - List reference
+ * @return true if the elements are stored in an array
+ */
+static inline bool no_os_list_is_array(struct _list_desc *list)
+{
+	return list->storage == NO_OS_LIST_STORAGE_ARRAY;
+}
+
+/**
+ * @brief Get the array slot of an element
+ * @param list - List reference
+ * @param idx - Index of the element in the list
+ * @return Address of the slot
+ */
+static inline void **no_os_array_slot(struct _list_desc *list, uint32_t idx)
+{
+	return &list->array[(list->head + idx) & (list->capacity - 1)];
+}
+
+/**
+ * @brief Double the size of the array, the elements are moved at its start
+ * @param list - List reference
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_grow(struct _list_desc *list)
+{
+	void		**array;
+	uint32_t	i;
+
+	array = (void **)no_os_calloc(list->capacity * 2, sizeof(*array));
+	if (!array)
+		return -1;
+
+	for (i = 0; i < list->nb_elements; i++)
+		array[i] = *no_os_array_slot(list, i);
+
+	no_os_free(list->array);
+	list->array = array;
+	list->capacity *= 2;
+	list->head = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Move an element of the heap towards the root until its parent is
+ * lower. The heap always starts at index 0 of the array.
+ * @param list - List reference
+ * @param idx - Index of the element
+ */
+static void no_os_heap_sift_up(struct _list_desc *list, uint32_t idx)
+{
+	void		*data = list->array[idx];
+	uint32_t	parent;
+
+	while (idx) {
+		parent = (idx - 1) / 2;
+		if (list->comparator(list->array[parent], data) <= 0)
+			break;
+		list->array[idx] = list->array[parent];
+		idx = parent;
+	}
+	list->array[idx] = data;
+}
+
+/**
+ * @brief Move an element of the heap towards the leaves until its children
+ * are bigger.
+ * @param list - List reference
+ * @param idx - Index of the element
+ */
+static void no_os_heap_sift_down(struct _list_desc *list, uint32_t idx)
+{
+	void		*data = list->array[idx];
+	uint32_t	child;
+
+	while ((child = 2 * idx + 1) < list->nb_elements) {
+		if (child + 1 < list->nb_elements &&
+		    list->comparator(list->array[child + 1],
+				     list->array[child]) < 0)
+			child++;
+		if (list->comparator(data, list->array[child]) <= 0)
+			break;
+		list->array[idx] = list->array[child];
+		idx = child;
+	}
+	list->array[idx] = data;
+}
+
+/**
+ * @brief Restore the heap order after the element at idx was changed
+ * @param list - List reference
+ * @param idx - Index of the element
+ */
+static void no_os_heap_fix(struct _list_desc *list, uint32_t idx)
+{
+	if (idx && list->comparator(list->array[idx],
+				    list->array[(idx - 1) / 2]) < 0)
+		no_os_heap_sift_up(list, idx);
+	else
+		no_os_heap_sift_down(list, idx);
+}
+
+/**
+ * @brief Insert an element in the array storage. The shorter side of the
+ * array is moved to make room for it.
+ * @param list - List reference
+ * @param data - Data to insert
+ * @param idx - Index of the new element. Ignored for heaps.
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_insert(struct _list_desc *list, void *data,
+				  uint32_t idx)
+{
+	uint32_t i;
+
+	if (idx > list->nb_elements)
+		return -1;
+
+	if (list->nb_elements == list->capacity && no_os_array_grow(list))
+		return -1;
+
+	if (list->heap) {
+		list->array[list->nb_elements++] = data;
+		no_os_heap_sift_up(list, list->nb_elements - 1);
+
+		return 0;
+	}
+
+	if (idx < list->nb_elements / 2) {
+		list->head = (list->head - 1) & (list->capacity - 1);
+		for (i = 0; i < idx; i++)
+			*no_os_array_slot(list, i) = *no_os_array_slot(list, i + 1);
+	} else {
+		for (i = list->nb_elements; i > idx; i--)
+			*no_os_array_slot(list, i) = *no_os_array_slot(list, i - 1);
+	}
+	*no_os_array_slot(list, idx) = data;
+	list->nb_elements++;
+
+	return 0;
+}
+
+/**
+ * @brief Remove an element from the array storage.
+ * @param list - List reference
+ * @param data - Content of the removed element
+ * @param idx - Index of the element
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_delete(struct _list_desc *list, void **data,
+				  uint32_t idx)
+{
+	uint32_t i;
+
+	if (idx >= list->nb_elements)
+		return -1;
+
+	*data = *no_os_array_slot(list, idx);
+	list->nb_elements--;
+
+	if (list->heap) {
+		if (idx != list->nb_elements) {
+			list->array[idx] = list->array[list->nb_elements];
+			no_os_heap_fix(list, idx);
+		}
+
+		return 0;
+	}
+
+	if (idx < list->nb_elements / 2) {
+		for (i = idx; i > 0; i--)
+			*no_os_array_slot(list, i) = *no_os_array_slot(list, i - 1);
+		list->head = (list->head + 1) & (list->capacity - 1);
+	} else {
+		for (i = idx; i < list->nb_elements; i++)
+			*no_os_array_slot(list, i) = *no_os_array_slot(list, i + 1);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Replace an element of the array storage.
+ * @param list - List reference
+ * @param new_data - New data
+ * @param idx - Index of the element
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_edit(struct _list_desc *list, void *new_data,
+				uint32_t idx)
+{
+	if (idx >= list->nb_elements)
+		return -1;
+
+	*no_os_array_slot(list, idx) = new_data;
+	if (list->heap)
+		no_os_heap_fix(list, idx);
+
+	return 0;
+}
+
+/**
+ * @brief Read an element of the array storage.
+ * @param list - List reference
+ * @param data - Content of the element
+ * @param idx - Index of the element
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_read(struct _list_desc *list, void **data,
+				uint32_t idx)
+{
+	if (idx >= list->nb_elements)
+		return -1;
+
+	*data = *no_os_array_slot(list, idx);
+
+	return 0;
+}
+
+/**
+ * @brief Find the first element of the array storage matching cmp_data.
+ * @param list - List reference
+ * @param cmp_data - Data to be found
+ * @param idx - Index of the element
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t no_os_array_find(struct _list_desc *list, void *cmp_data,
+				uint32_t *idx)
+{
+	uint32_t i;
+
+	for (i = 0; i < list->nb_elements; i++) {
+		if (0 == list->comparator(*no_os_array_slot(list, i), cmp_data)) {
+			*idx = i;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/** @brief Read the biggest element of a heap. Refer to \ref f_read */
+static int32_t no_os_heap_read_max(struct no_os_list_desc *list_desc,
+				   void **data)
+{
+	struct _list_desc	*list;
+	uint32_t		i;
+
+	if (!list_desc || !data)
+		return -1;
+
+	*data = NULL;
+	list = list_desc->priv_desc;
+	if (!list->nb_elements)
+		return -1;
+
+	/* The biggest element is one of the leaves */
+	*data = list->array[list->nb_elements / 2];
+	for (i = list->nb_elements / 2 + 1; i < list->nb_elements; i++)
+		if (list->comparator(list->array[i], *data) > 0)
+			*data = list->array[i];
+
+	return 0;
+}
+
 /**
  * @brief Updates the necesary link on the list elements to add or remove one
  * @param prev - Low element
@@ -158,6 +463,13 @@ static inline void no_os_set_adapter(struct no_os_list_desc *ad,
 				     enum no_os_adapter_type type)
 {
 	switch (type) {
+	case NO_OS_LIST_PRIORITY_HEAP:
+		ad->push = no_os_list_add_last;
+		ad->pop = no_os_list_get_first;
+		ad->top_next = no_os_list_read_first;
+		ad->back = no_os_heap_read_max;
+		ad->swap = no_os_list_edit_first;
+		break;
 	case NO_OS_LIST_PRIORITY_LIST:
 		ad->push = no_os_list_add_find;
 		ad->pop = no_os_list_get_first;
@@ -197,12 +509,36 @@ static inline void no_os_set_adapter(struct no_os_list_desc *ad,
 int32_t no_os_list_init(struct no_os_list_desc **list_desc,
 			enum no_os_adapter_type type,
 			f_cmp comparator)
+{
+	struct no_os_list_init_param param = {
+		.type = type,
+		.comparator = comparator,
+		.storage = type == NO_OS_LIST_PRIORITY_HEAP ?
+		NO_OS_LIST_STORAGE_ARRAY : NO_OS_LIST_STORAGE_NODES,
+	};
+
+	return no_os_list_init_ext(list_desc, &param);
+}
+
+/**
+ * @brief Create a new empty list with the specified storage
+ * @param list_desc - Where to store the reference of the new created list
+ * @param param - Type of adapter, comparator and storage of the list.
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+int32_t no_os_list_init_ext(struct no_os_list_desc **list_desc,
+			    const struct no_os_list_init_param *param)
 {
 	struct no_os_list_desc	*l_desc;
 	struct _list_desc	*list;
+	uint32_t		capacity;
 
-
-	if (!list_desc)
+	if (!list_desc || !param)
+		return -1;
+	if (param->type == NO_OS_LIST_PRIORITY_HEAP &&
+	    param->storage != NO_OS_LIST_STORAGE_ARRAY)
 		return -1;
 	l_desc = (struct no_os_list_desc *)no_os_calloc(1, sizeof(*l_desc));
 	if (!l_desc)
@@ -213,12 +549,31 @@ int32_t no_os_list_init(struct no_os_list_desc **list_desc,
 		return -1;
 	}
 
+	if (param->storage == NO_OS_LIST_STORAGE_ARRAY) {
+		capacity = NO_OS_LIST_ARRAY_CAPACITY;
+		while (capacity < param->capacity)
+			capacity <<= 1;
+
+		list->array = (void **)no_os_calloc(capacity,
+						    sizeof(*list->array));
+		if (!list->array) {
+			no_os_free(list);
+			no_os_free(l_desc);
+			return -1;
+		}
+		list->capacity = capacity;
+	}
+
 	*list_desc = l_desc;
 	l_desc->priv_desc = list;
-	list->comparator = comparator ? comparator : no_os_default_comparator;
+	list->comparator = param->comparator ? param->comparator :
+			   no_os_default_comparator;
+	list->storage = param->storage;
+	list->node_offset = param->node_offset;
+	list->heap = param->type == NO_OS_LIST_PRIORITY_HEAP;
 
 	/* Configure wrapper */
-	no_os_set_adapter(l_desc, type);
+	no_os_set_adapter(l_desc, param->type);
 	list->l_it.list = list;
 
 	return 0;
@@ -247,8 +602,11 @@ int32_t no_os_list_remove(struct no_os_list_desc *list_desc)
 		return -1;
 
 	/* Remove all the elements */
-	while (0 == no_os_list_get_first(list_desc, &data))
-		;
+	if (list->storage == NO_OS_LIST_STORAGE_ARRAY)
+		no_os_free(list->array);
+	else
+		while (0 == no_os_list_get_first(list_desc, &data))
+			;
 	no_os_free(list_desc->priv_desc);
 	no_os_free(list_desc);
 
@@ -289,10 +647,12 @@ int32_t no_os_list_add_first(struct no_os_list_desc *list_desc, void *data)
 		return -1;
 
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_insert(list, data, 0);
 
 	prev = NULL;
 	next = list->first;
-	elem = create_element(data, prev, next);
+	elem = create_element(list, data, prev, next);
 	if (!elem)
 		return -1;
 
@@ -316,10 +676,12 @@ int32_t no_os_list_add_last(struct no_os_list_desc *list_desc, void *data)
 	if (!list_desc)
 		return -1;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_insert(list, data, list->nb_elements);
 
 	prev = list->last;
 	next = NULL;
-	elem = create_element(data, prev, next);
+	elem = create_element(list, data, prev, next);
 	if (!elem)
 		return -1;
 
@@ -341,6 +703,8 @@ int32_t no_os_list_add_idx(struct no_os_list_desc *list_desc, void *data,
 	if (!list_desc)
 		return -1;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_insert(list, data, idx);
 
 	/* If there are no elements the creation of an iterator will fail */
 	if (list->nb_elements == 0 || idx == 0)
@@ -360,11 +724,19 @@ int32_t no_os_list_add_find(struct no_os_list_desc *list_desc, void *data)
 {
 	struct no_os_list_elem	*elem;
 	struct _list_desc	*list;
+	uint32_t		i;
 
 	if (!list_desc)
 		return -1;
 	list = list_desc->priv_desc;
 
+	if (no_os_list_is_array(list)) {
+		for (i = 0; i < list->nb_elements; i++)
+			if (0 < list->comparator(*no_os_array_slot(list, i), data))
+				break;
+
+		return no_os_array_insert(list, data, i);
+	}
 
 	/* Based on place iterator */
 	elem = list->first;
@@ -392,6 +764,9 @@ int32_t no_os_list_edit_first(struct no_os_list_desc *list_desc, void *new_data)
 		return -1;
 
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_edit(list, new_data, 0);
+
 	list->first->data = new_data;
 
 	return 0;
@@ -406,6 +781,9 @@ int32_t no_os_list_edit_last(struct no_os_list_desc *list_desc, void *new_data)
 		return -1;
 
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_edit(list, new_data, list->nb_elements - 1);
+
 	list->last->data = new_data;
 
 	return 0;
@@ -420,6 +798,8 @@ int32_t no_os_list_edit_idx(struct no_os_list_desc *list_desc, void *new_data,
 	if (!list_desc)
 		return -1;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_edit(list, new_data, idx);
 
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_move(&(list->l_it), idx))
@@ -433,10 +813,17 @@ int32_t no_os_list_edit_find(struct no_os_list_desc *list_desc, void *new_data,
 			     void *cmp_data)
 {
 	struct _list_desc	*list;
+	uint32_t		idx;
 
 	if (!list_desc)
 		return -1;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list)) {
+		if (0 != no_os_array_find(list, cmp_data, &idx))
+			return -1;
+
+		return no_os_array_edit(list, new_data, idx);
+	}
 
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_find(&(list->l_it), cmp_data))
@@ -455,6 +842,8 @@ int32_t no_os_list_read_first(struct no_os_list_desc *list_desc, void **data)
 
 	*data = NULL;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_read(list, data, 0);
 	if (!list->first)
 		return -1;
 
@@ -473,6 +862,8 @@ int32_t no_os_list_read_last(struct no_os_list_desc *list_desc, void **data)
 
 	*data = NULL;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_read(list, data, list->nb_elements - 1);
 	if (!list->last)
 		return -1;
 
@@ -498,6 +889,9 @@ int32_t no_os_list_read_idx(struct no_os_list_desc *list_desc, void **data,
 	if (idx >= list->nb_elements)
 		return -1;
 
+	if (no_os_list_is_array(list))
+		return no_os_array_read(list, data, idx);
+
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_move(&(list->l_it), idx))
 		return -1;
@@ -510,6 +904,7 @@ int32_t no_os_list_read_find(struct no_os_list_desc *list_desc, void **data,
 			     void *cmp_data)
 {
 	struct _list_desc	*list;
+	uint32_t		idx;
 
 	if (!list_desc || !data)
 		return -1;
@@ -520,6 +915,13 @@ int32_t no_os_list_read_find(struct no_os_list_desc *list_desc, void **data,
 		return -1;
 
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list)) {
+		if (0 != no_os_array_find(list, cmp_data, &idx))
+			return -1;
+
+		return no_os_array_read(list, data, idx);
+	}
+
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_find(&(list->l_it), cmp_data))
 		return -1;
@@ -543,6 +945,9 @@ int32_t no_os_list_get_first(struct no_os_list_desc *list_desc, void **data)
 	if (!list->nb_elements)
 		return -1;
 
+	if (no_os_list_is_array(list))
+		return no_os_array_delete(list, data, 0);
+
 	elem = list->first;
 	prev = elem->prev;
 	next = elem->next;
@@ -552,7 +957,7 @@ int32_t no_os_list_get_first(struct no_os_list_desc *list_desc, void **data)
 	list->nb_elements--;
 
 	*data = elem->data;
-	no_os_free(elem);
+	release_element(list, elem);
 
 	return 0;
 }
@@ -573,6 +978,9 @@ int32_t no_os_list_get_last(struct no_os_list_desc *list_desc, void **data)
 	if (!list->nb_elements)
 		return -1;
 
+	if (no_os_list_is_array(list))
+		return no_os_array_delete(list, data, list->nb_elements - 1);
+
 	elem = list->last;
 	prev = elem->prev;
 	next = elem->next;
@@ -582,7 +990,7 @@ int32_t no_os_list_get_last(struct no_os_list_desc *list_desc, void **data)
 	list->nb_elements--;
 
 	*data = elem->data;
-	no_os_free(elem);
+	release_element(list, elem);
 
 	return 0;
 }
@@ -598,6 +1006,9 @@ int32_t no_os_list_get_idx(struct no_os_list_desc *list_desc, void **data,
 
 	*data = NULL;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list))
+		return no_os_array_delete(list, data, idx);
+
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_move(&(list->l_it), idx))
 		return -1;
@@ -613,12 +1024,20 @@ int32_t no_os_list_get_find(struct no_os_list_desc *list_desc, void **data,
 			    void *cmp_data)
 {
 	struct _list_desc	*list;
+	uint32_t		idx;
 
 	if (!list_desc || !data)
 		return -1;
 
 	*data = NULL;
 	list = list_desc->priv_desc;
+	if (no_os_list_is_array(list)) {
+		if (0 != no_os_array_find(list, cmp_data, &idx))
+			return -1;
+
+		return no_os_array_delete(list, data, idx);
+	}
+
 	list->l_it.elem = list->first;
 	if (0 != no_os_iterator_find(&(list->l_it), cmp_data))
 		return -1;
@@ -651,6 +1070,7 @@ int32_t no_os_iterator_init(struct no_os_iterator **iter,
 	it->list = list_desc->priv_desc;
 	it->list->nb_iterators++;
 	it->elem = start ? it->list->first : it->list->last;
+	it->idx = start ? 0 : it->list->nb_elements - 1;
 	*iter = it;
 
 	return 0;
@@ -697,6 +1117,15 @@ int32_t no_os_iterator_move(struct no_os_iterator *iter, int32_t steps)
 	if (!it)
 		return -1;
 
+	if (no_os_list_is_array(it->list)) {
+		if ((steps < 0 && (uint32_t)abs(steps) > it->idx) ||
+		    (steps > 0 && it->idx + steps >= it->list->nb_elements))
+			return -1;
+		it->idx += steps;
+
+		return 0;
+	}
+
 	steps = abs(steps);
 	elem = it->elem;
 	while (steps > 0 && elem) {
@@ -729,6 +1158,15 @@ int32_t no_os_iterator_move_to_idx(struct no_os_iterator *iter, int32_t idx)
 		return -1;
 
 	idx = abs(idx);
+	if (no_os_list_is_array(iter->list)) {
+		if ((uint32_t)idx >= iter->list->nb_elements)
+			return -1;
+		iter->idx = dir > 0 ? (uint32_t)idx :
+			    iter->list->nb_elements - 1 - idx;
+
+		return 0;
+	}
+
 	elem = dir > 0 ? iter->list->first : iter->list->last;
 	while (idx > 0 && elem) {
 		elem = dir > 0 ? elem->next : elem->prev;
@@ -758,6 +1196,9 @@ int32_t no_os_iterator_find(struct no_os_iterator *iter, void *cmp_data)
 	if (!it)
 		return -1;
 
+	if (no_os_list_is_array(it->list))
+		return no_os_array_find(it->list, cmp_data, &it->idx);
+
 	elem = it->list->first;
 	while (elem) {
 		if (0 == it->list->comparator(elem->data, cmp_data)) {
@@ -780,6 +1221,9 @@ int32_t no_os_iterator_edit(struct no_os_iterator *iter, void *new_data)
 	if (!it)
 		return -1;
 
+	if (no_os_list_is_array(it->list))
+		return no_os_array_edit(it->list, new_data, it->idx);
+
 	it->elem->data = new_data;
 
 	return 0;
@@ -796,10 +1240,23 @@ int32_t no_os_iterator_get(struct no_os_iterator *iter, void **data)
 	struct no_os_iterator		*it = iter;
 	struct no_os_list_elem	*next;
 
+	if (it && data && no_os_list_is_array(it->list)) {
+		if (no_os_array_delete(it->list, data, it->idx))
+			return -1;
+		if (it->idx == it->list->nb_elements)
+			it->idx--;
+
+		return 0;
+	}
 
 	if (!it || !it->elem || !data)
 		return -1;
 
+	if (it->elem == it->list->last)
+		next = it->elem->prev;
+	else
+		next = it->elem->next;
+
 	no_os_update_links(it->elem->prev, NULL, it->elem->next);
 	if (it->elem == it->list->first)
 		no_os_update_desc(it->list, it->elem->next, it->list->last);
@@ -808,11 +1265,7 @@ int32_t no_os_iterator_get(struct no_os_iterator *iter, void **data)
 	it->list->nb_elements--;
 
 	*data = it->elem->data;
-	if (it->elem == it->list->last)
-		next = it->elem->prev;
-	else
-		next = it->elem->next;
-	no_os_free(it->elem);
+	release_element(it->list, it->elem);
 	it->elem = next;
 
 	return 0;
@@ -825,6 +1278,9 @@ int32_t no_os_iterator_read(struct no_os_iterator *iter, void **data)
 {
 	struct no_os_iterator *it = iter;
 
+	if (it && data && no_os_list_is_array(it->list))
+		return no_os_array_read(it->list, data, it->idx);
+
 	if (!it || !it->elem || !data)
 		return -1;
 
@@ -850,6 +1306,21 @@ int32_t no_os_iterator_insert(struct no_os_iterator *iter, void *data,
 	if (!it)
 		return -1;
 
+	if (no_os_list_is_array(it->list)) {
+		if (it->idx >= it->list->nb_elements)
+			return no_os_array_insert(it->list, data,
+						  it->list->nb_elements);
+		if (after)
+			return no_os_array_insert(it->list, data, it->idx + 1);
+		if (no_os_array_insert(it->list, data, it->idx))
+			return -1;
+		/* Keep the iterator on the same element */
+		if (!it->list->heap)
+			it->idx++;
+
+		return 0;
+	}
+
 	list_desc.priv_desc = iter->list;
 	if (after && it->elem == it->list->last)
 		return no_os_list_add_last(&list_desc, data);
@@ -857,9 +1328,9 @@ int32_t no_os_iterator_insert(struct no_os_iterator *iter, void *data,
 		return no_os_list_add_first(&list_desc, data);
 
 	if (after)
-		elem = create_element(data, it->elem, it->elem->next);
+		elem = create_element(it->list, data, it->elem, it->elem->next);
 	else
-		elem = create_element(data, it->elem->prev, it->elem);
+		elem = create_element(it->list, data, it->elem->prev, it->elem);
 	if (!elem)
 		return -1;
 
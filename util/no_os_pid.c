@@ -31,9 +31,11 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include <stdbool.h>
 #include "no_os_pid.h"
 #include "no_os_alloc.h"
 #include "no_os_print_log.h"
+#include "no_os_util.h"
 
 struct no_os_pid {
 	int iacc; // integral accumulator
@@ -42,6 +44,31 @@ struct no_os_pid {
 	struct no_os_pid_config config; // copy of the user-provided configuration
 };
 
+/*
+ * Bank of fixed-point PID loops. Each parameter and state variable is stored
+ * in its own array (structure of arrays), so that the update loop has no
+ * per-loop branches and the compiler can vectorize it.
+ */
+struct no_os_pid_bank {
+	uint32_t nb_loops;
+	uint8_t q; // number of fractional bits of the gains
+	enum no_os_pid_anti_windup anti_windup;
+	int32_t *Kp;
+	int32_t *Ki;
+	int32_t *Kd;
+	int32_t *d_alpha; // derivative filter coefficient
+	int32_t *i_low; // integral component limits, Q format
+	int32_t *i_high;
+	int32_t *out_low; // output limits
+	int32_t *out_high;
+	int32_t *iacc; // integral component, Q format
+	int32_t *err; // error of the previous update
+	int32_t *d; // filtered derivative component, Q format
+};
+
+/* Number of int32_t arrays in struct no_os_pid_bank */
+#define NO_OS_PID_BANK_ARRAYS	11
+
 /**
  * @brief Initialize a PID controller with given configuration
  * @param pid - Double pointer to a PID descriptor that the function allocates
@@ -200,3 +227,253 @@ int no_os_pid_remove(struct no_os_pid *pid)
 
 	return 0;
 }
+
+/**
+ * @brief Set the parameters of a loop of a PID bank to pass-through values:
+ * no gain, no filtering and no limits.
+ * @param bank - PID bank descriptor
+ * @param loop - Index of the loop
+ */
+static void no_os_pid_bank_default(struct no_os_pid_bank *bank, uint32_t loop)
+{
+	bank->Kp[loop] = 0;
+	bank->Ki[loop] = 0;
+	bank->Kd[loop] = 0;
+	bank->d_alpha[loop] = 1 << bank->q;
+	bank->i_low[loop] = INT32_MIN;
+	bank->i_high[loop] = INT32_MAX;
+	bank->out_low[loop] = INT32_MIN;
+	bank->out_high[loop] = INT32_MAX;
+}
+
+/**
+ * @brief Initialize a bank of independent fixed-point PID loops, updated
+ * together by no_os_pid_bank_update(). The loops have no gain until they are
+ * configured with no_os_pid_bank_set().
+ * @param bank - Double pointer to a PID bank descriptor that the function
+ * allocates
+ * @param config - PID bank configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_bank_config *config)
+{
+	struct no_os_pid_bank *b;
+	int32_t *arrays;
+	uint32_t i;
+
+	if (!bank || !config || !config->nb_loops || config->q > 30)
+		return -EINVAL;
+
+	if (config->anti_windup != NO_OS_PID_ANTI_WINDUP_CLAMP &&
+	    config->anti_windup != NO_OS_PID_ANTI_WINDUP_CONDITIONAL)
+		return -EINVAL;
+
+	b = no_os_calloc(1, sizeof(*b) + NO_OS_PID_BANK_ARRAYS *
+			 config->nb_loops * sizeof(int32_t));
+	if (!b)
+		return -ENOMEM;
+
+	b->nb_loops = config->nb_loops;
+	b->q = config->q ? config->q : NO_OS_PID_Q_DEFAULT;
+	b->anti_windup = config->anti_windup;
+
+	arrays = (int32_t *)(b + 1);
+	b->Kp = arrays;
+	b->Ki = b->Kp + b->nb_loops;
+	b->Kd = b->Ki + b->nb_loops;
+	b->d_alpha = b->Kd + b->nb_loops;
+	b->i_low = b->d_alpha + b->nb_loops;
+	b->i_high = b->i_low + b->nb_loops;
+	b->out_low = b->i_high + b->nb_loops;
+	b->out_high = b->out_low + b->nb_loops;
+	b->iacc = b->out_high + b->nb_loops;
+	b->err = b->iacc + b->nb_loops;
+	b->d = b->err + b->nb_loops;
+
+	for (i = 0; i < b->nb_loops; i++)
+		no_os_pid_bank_default(b, i);
+
+	*bank = b;
+
+	return 0;
+}
+
+/**
+ * @brief Configure a loop of a PID bank. The state of the loop is kept.
+ * @param bank - PID bank descriptor created with no_os_pid_bank_init()
+ * @param loop - Index of the loop
+ * @param config - Loop configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_set(struct no_os_pid_bank *bank, uint32_t loop,
+		       const struct no_os_pid_loop_config *config)
+{
+	const struct no_os_pid_range *i_clip;
+	const struct no_os_pid_range *output_clip;
+
+	if (!bank || !config || loop >= bank->nb_loops)
+		return -EINVAL;
+
+	if (config->d_alpha < 0 || config->d_alpha > (1 << bank->q))
+		return -EINVAL;
+
+	i_clip = &config->i_clip;
+	output_clip = &config->output_clip;
+
+	no_os_pid_bank_default(bank, loop);
+
+	bank->Kp[loop] = config->Kp;
+	bank->Ki[loop] = config->Ki;
+	bank->Kd[loop] = config->Kd;
+	if (config->d_alpha)
+		bank->d_alpha[loop] = config->d_alpha;
+
+	// the limits are enabled only if high > low, as for no_os_pid_config
+	if (i_clip->high > i_clip->low) {
+		bank->i_low[loop] = no_os_clamp((int64_t)i_clip->low << bank->q,
+						INT32_MIN, INT32_MAX);
+		bank->i_high[loop] = no_os_clamp((int64_t)i_clip->high << bank->q,
+						 INT32_MIN, INT32_MAX);
+	}
+
+	if (output_clip->high > output_clip->low) {
+		bank->out_low[loop] = output_clip->low;
+		bank->out_high[loop] = output_clip->high;
+	}
+
+	bank->iacc[loop] = no_os_clamp(bank->iacc[loop], bank->i_low[loop],
+				       bank->i_high[loop]);
+
+	return 0;
+}
+
+/**
+ * @brief Update all the loops of a PID bank with a new set of samples.
+ *
+ * For each loop, with err = SP - PV:
+ *   I += Ki * err, clipped to i_clip
+ *   D += d_alpha * (Kd * (err - previous err) - D)
+ *   output = (Kp * err + I + D) >> q, clipped to output_clip
+ * SP - PV must fit in 31 bits.
+ * @param bank - PID bank descriptor created with no_os_pid_bank_init()
+ * @param SP - Set-points, one per loop
+ * @param PV - Process variables, one per loop
+ * @param output - The outputs of the PID control, one per loop
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_update(struct no_os_pid_bank *bank, const int32_t *SP,
+			  const int32_t *PV, int32_t *output)
+{
+	// local copies, so the compiler knows the arrays don't alias
+	const int32_t *restrict Kp;
+	const int32_t *restrict Ki;
+	const int32_t *restrict Kd;
+	const int32_t *restrict d_alpha;
+	const int32_t *restrict i_low;
+	const int32_t *restrict i_high;
+	const int32_t *restrict out_low;
+	const int32_t *restrict out_high;
+	int32_t *restrict iacc;
+	int32_t *restrict prev;
+	int32_t *restrict dacc;
+	uint32_t nb_loops;
+	bool conditional;
+	int64_t i;
+	int64_t d;
+	int64_t u;
+	int32_t out;
+	int32_t err;
+	uint32_t n;
+	uint8_t q;
+
+	if (!bank || !SP || !PV || !output)
+		return -EINVAL;
+
+	Kp = bank->Kp;
+	Ki = bank->Ki;
+	Kd = bank->Kd;
+	d_alpha = bank->d_alpha;
+	i_low = bank->i_low;
+	i_high = bank->i_high;
+	out_low = bank->out_low;
+	out_high = bank->out_high;
+	iacc = bank->iacc;
+	prev = bank->err;
+	dacc = bank->d;
+	nb_loops = bank->nb_loops;
+	conditional = bank->anti_windup == NO_OS_PID_ANTI_WINDUP_CONDITIONAL;
+	q = bank->q;
+
+	for (n = 0; n < nb_loops; n++) {
+		err = SP[n] - PV[n];
+
+		i = iacc[n] + (int64_t)Ki[n] * err;
+		i = no_os_clamp(i, i_low[n], i_high[n]);
+
+		d = (int64_t)Kd[n] * (err - prev[n]);
+		d = no_os_clamp(d, INT32_MIN, INT32_MAX);
+		d = dacc[n] + ((d_alpha[n] * (d - dacc[n])) >> q);
+
+		u = ((int64_t)Kp[n] * err + i + d) >> q;
+		out = no_os_clamp(u, out_low[n], out_high[n]);
+
+		// don't integrate further into saturation, without a branch
+		i = (conditional & (u != out) & ((u > out) == (err > 0))) ? iacc[n] : i;
+
+		iacc[n] = i;
+		prev[n] = err;
+		dacc[n] = d;
+		output[n] = out;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Reset the state of all the loops of a PID bank. The configuration
+ * is kept.
+ * @param bank - PID bank descriptor created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank)
+{
+	uint32_t n;
+
+	if (!bank)
+		return -EINVAL;
+
+	for (n = 0; n < bank->nb_loops; n++) {
+		bank->iacc[n] = no_os_clamp(0, bank->i_low[n], bank->i_high[n]);
+		bank->err[n] = 0;
+		bank->d[n] = 0;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief De-initialize a PID bank by freeing the allocated memory
+ * @param bank - PID bank descriptor created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank)
+{
+	if (!bank)
+		return -EINVAL;
+
+	no_os_free(bank);
+
+	return 0;
+}
@@ -0,0 +1,386 @@
+/***************************************************************************//**
+ *   @file   no_os_trace.c
+ *   @brief  Bus access tracing and latency histograms.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "no_os_trace.h"
+#include "no_os_error.h"
+
+#define NO_OS_TRACE_LOAD(ptr)		__atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define NO_OS_TRACE_LOAD_ACQUIRE(ptr)	__atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define NO_OS_TRACE_STORE_RELEASE(ptr, val) \
+	__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define NO_OS_TRACE_ADD(ptr, val)	__atomic_fetch_add(ptr, val, __ATOMIC_RELAXED)
+
+#if NO_OS_TRACE_EVENTS & (NO_OS_TRACE_EVENTS - 1)
+#error "NO_OS_TRACE_EVENTS must be a power of 2"
+#endif
+
+/* States of a device counters slot */
+enum no_os_trace_slot {
+	NO_OS_TRACE_SLOT_FREE,
+	NO_OS_TRACE_SLOT_CLAIMED,
+	NO_OS_TRACE_SLOT_READY,
+};
+
+static uint64_t (*no_os_trace_clock)(void);
+/* Set between no_os_trace_start() and no_os_trace_stop() */
+static bool no_os_trace_enabled;
+static struct no_os_trace_event no_os_trace_ring[NO_OS_TRACE_EVENTS];
+/* Number of events recorded, the next event goes at head % size */
+static uint32_t no_os_trace_head;
+/* Next event to read, only used by the consumer */
+static uint32_t no_os_trace_tail;
+static struct no_os_trace_stats no_os_trace_stats[NO_OS_TRACE_DEVICES];
+static uint8_t no_os_trace_slots[NO_OS_TRACE_DEVICES];
+/* Accesses not counted because every slot is used by another device */
+static uint32_t no_os_trace_untracked;
+
+static const char *const no_os_trace_bus_names[] = {
+	[NO_OS_TRACE_SPI] = "spi",
+	[NO_OS_TRACE_I2C] = "i2c",
+	[NO_OS_TRACE_AXI] = "axi",
+};
+
+/**
+ * @brief Clear the recorded events and counters.
+ *
+ * Accesses recorded while the counters are cleared may be partially lost, so
+ * this is best called with tracing stopped.
+ */
+void no_os_trace_reset(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_TRACE_DEVICES; i++)
+		NO_OS_TRACE_STORE_RELEASE(&no_os_trace_slots[i],
+					  NO_OS_TRACE_SLOT_CLAIMED);
+	memset(no_os_trace_stats, 0, sizeof(no_os_trace_stats));
+	for (i = 0; i < NO_OS_TRACE_DEVICES; i++)
+		NO_OS_TRACE_STORE_RELEASE(&no_os_trace_slots[i],
+					  NO_OS_TRACE_SLOT_FREE);
+
+	NO_OS_TRACE_STORE_RELEASE(&no_os_trace_untracked, 0);
+	no_os_trace_tail = NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_head);
+}
+
+/**
+ * @brief Clear the recorded events and counters and start tracing.
+ * @param clock_ns - Monotonic clock in ns, called before and after each
+ * 		     access. It must not use a traced bus.
+ * @return 0 in case of success, -EINVAL if no clock is given.
+ */
+int no_os_trace_start(uint64_t (*clock_ns)(void))
+{
+	if (!clock_ns)
+		return -EINVAL;
+
+	no_os_trace_stop();
+	no_os_trace_reset();
+	NO_OS_TRACE_STORE_RELEASE(&no_os_trace_clock, clock_ns);
+	NO_OS_TRACE_STORE_RELEASE(&no_os_trace_enabled, true);
+
+	return 0;
+}
+
+/**
+ * @brief Stop tracing, keeping what was recorded.
+ */
+void no_os_trace_stop(void)
+{
+	NO_OS_TRACE_STORE_RELEASE(&no_os_trace_enabled, false);
+}
+
+/**
+ * @brief Read the trace clock.
+ * @return The clock value in ns, 0 when tracing is stopped.
+ */
+uint64_t no_os_trace_now(void)
+{
+	uint64_t start;
+
+	return no_os_trace_begin(&start) ? start : 0;
+}
+
+/**
+ * @brief Read the trace clock before an access. Unlike no_os_trace_now(),
+ * 	  a clock reading 0 is told apart from tracing being stopped.
+ * @param start - Filled with the clock value in ns.
+ * @return true if tracing is started, the access should then be recorded.
+ */
+bool no_os_trace_begin(uint64_t *start)
+{
+	if (!NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_enabled))
+		return false;
+
+	*start = NO_OS_TRACE_LOAD(&no_os_trace_clock)();
+
+	return true;
+}
+
+/* Find the counters of a device, claiming a free slot the first time. */
+static struct no_os_trace_stats *no_os_trace_find(uint8_t bus, uint8_t bus_id,
+		uint32_t dev)
+{
+	struct no_os_trace_stats *stats;
+	uint8_t state;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_TRACE_DEVICES; i++) {
+		stats = &no_os_trace_stats[i];
+		state = NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_slots[i]);
+		if (state == NO_OS_TRACE_SLOT_FREE) {
+			if (!__atomic_compare_exchange_n(&no_os_trace_slots[i],
+							 &state,
+							 NO_OS_TRACE_SLOT_CLAIMED,
+							 false, __ATOMIC_ACQUIRE,
+							 __ATOMIC_ACQUIRE))
+				continue;
+			stats->bus = bus;
+			stats->bus_id = bus_id;
+			stats->dev = dev;
+			NO_OS_TRACE_STORE_RELEASE(&no_os_trace_slots[i],
+						  NO_OS_TRACE_SLOT_READY);
+			return stats;
+		}
+		/* Slots being claimed are skipped, a race only splits counts */
+		if (state == NO_OS_TRACE_SLOT_READY && stats->dev == dev &&
+		    stats->bus == bus && stats->bus_id == bus_id)
+			return stats;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Record an access in the event ring and in the device counters.
+ * @param start - Start time from no_os_trace_begin(). Nothing is recorded if
+ * 		  tracing was stopped since.
+ * @param bus - Bus type.
+ * @param bus_id - Bus number.
+ * @param dev - Device on the bus.
+ * @param op - Accessor.
+ * @param bytes - Number of bytes transferred.
+ * @param ret - Value returned by the accessor.
+ */
+void no_os_trace_record(uint64_t start, enum no_os_trace_bus bus,
+			uint32_t bus_id, uint32_t dev, enum no_os_trace_op op,
+			uint32_t bytes, int32_t ret)
+{
+	uint64_t (*clock_ns)(void);
+	struct no_os_trace_stats *stats;
+	struct no_os_trace_event *ev;
+	uint32_t duration, max, us;
+	uint64_t elapsed;
+	uint32_t bucket;
+	uint32_t seq;
+
+	if (!NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_enabled))
+		return;
+
+	clock_ns = NO_OS_TRACE_LOAD(&no_os_trace_clock);
+	elapsed = clock_ns() - start;
+	duration = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+
+	/*
+	 * Claim a ring entry. seq is cleared first so a reader copying the
+	 * entry while it is written sees it changed and drops it.
+	 */
+	seq = NO_OS_TRACE_ADD(&no_os_trace_head, 1);
+	ev = &no_os_trace_ring[seq & (NO_OS_TRACE_EVENTS - 1)];
+	__atomic_store_n(&ev->seq, 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	ev->start_ns = start;
+	ev->duration_ns = duration;
+	ev->dev = dev;
+	ev->bytes = bytes;
+	ev->ret = ret;
+	ev->bus = bus;
+	ev->bus_id = bus_id;
+	ev->op = op;
+	NO_OS_TRACE_STORE_RELEASE(&ev->seq, seq + 1);
+
+	stats = no_os_trace_find(bus, bus_id, dev);
+	if (!stats) {
+		NO_OS_TRACE_ADD(&no_os_trace_untracked, 1);
+		return;
+	}
+
+	us = duration / 1000;
+	bucket = us ? 32 - __builtin_clz(us) : 0;
+	if (bucket >= NO_OS_TRACE_HIST_BUCKETS)
+		bucket = NO_OS_TRACE_HIST_BUCKETS - 1;
+
+	NO_OS_TRACE_ADD(&stats->count, 1);
+	if (ret < 0)
+		NO_OS_TRACE_ADD(&stats->errors, 1);
+	NO_OS_TRACE_ADD(&stats->bytes, bytes);
+	NO_OS_TRACE_ADD(&stats->time_us, us);
+	NO_OS_TRACE_ADD(&stats->hist[bucket], 1);
+
+	max = NO_OS_TRACE_LOAD(&stats->max_ns);
+	while (duration > max &&
+	       !__atomic_compare_exchange_n(&stats->max_ns, &max, duration,
+					    true, __ATOMIC_RELAXED,
+					    __ATOMIC_RELAXED))
+		;
+}
+
+/**
+ * @brief Read the events recorded since the previous call, oldest first.
+ *
+ * Only one consumer may read the events.
+ *
+ * @param events - Where to copy the events.
+ * @param max - Maximum number of events to copy.
+ * @param lost - Set to the number of events overwritten or being written
+ * 		 before they could be read. May be NULL.
+ * @return The number of events copied.
+ */
+uint32_t no_os_trace_read_events(struct no_os_trace_event *events,
+				 uint32_t max, uint32_t *lost)
+{
+	struct no_os_trace_event *ev;
+	uint32_t head, tail, seq;
+	uint32_t missed = 0;
+	uint32_t n = 0;
+
+	head = NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_head);
+	tail = no_os_trace_tail;
+	if (head - tail > NO_OS_TRACE_EVENTS) {
+		missed = head - tail - NO_OS_TRACE_EVENTS;
+		tail = head - NO_OS_TRACE_EVENTS;
+	}
+
+	for (; tail != head && n < max; tail++) {
+		ev = &no_os_trace_ring[tail & (NO_OS_TRACE_EVENTS - 1)];
+		seq = NO_OS_TRACE_LOAD_ACQUIRE(&ev->seq);
+		events[n] = *ev;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (seq != tail + 1 || NO_OS_TRACE_LOAD(&ev->seq) != seq) {
+			missed++;
+			continue;
+		}
+		n++;
+	}
+
+	no_os_trace_tail = tail;
+	if (lost)
+		*lost = missed;
+
+	return n;
+}
+
+/**
+ * @brief Get a copy of the counters of a device.
+ * @param idx - Index of the device, from 0 in the order they were first seen.
+ * @param stats - Where to copy the counters.
+ * @return 0 in case of success, -ENOENT if no device has this index.
+ */
+int no_os_trace_get_stats(uint32_t idx, struct no_os_trace_stats *stats)
+{
+	struct no_os_trace_stats *src;
+	uint32_t i;
+
+	if (idx >= NO_OS_TRACE_DEVICES ||
+	    NO_OS_TRACE_LOAD_ACQUIRE(&no_os_trace_slots[idx]) !=
+	    NO_OS_TRACE_SLOT_READY)
+		return -ENOENT;
+
+	src = &no_os_trace_stats[idx];
+	stats->bus = src->bus;
+	stats->bus_id = src->bus_id;
+	stats->dev = src->dev;
+	stats->count = NO_OS_TRACE_LOAD(&src->count);
+	stats->errors = NO_OS_TRACE_LOAD(&src->errors);
+	stats->bytes = NO_OS_TRACE_LOAD(&src->bytes);
+	stats->time_us = NO_OS_TRACE_LOAD(&src->time_us);
+	stats->max_ns = NO_OS_TRACE_LOAD(&src->max_ns);
+	for (i = 0; i < NO_OS_TRACE_HIST_BUCKETS; i++)
+		stats->hist[i] = NO_OS_TRACE_LOAD(&src->hist[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Print the counters of all devices as text.
+ *
+ * One line per device:
+ * "<bus><bus_id> 0x<dev> count <n> err <n> bytes <n> total_us <n> max_ns <n>
+ * hist <n> ... <n>", the histogram having NO_OS_TRACE_HIST_BUCKETS log2 us
+ * buckets. A last line gives the number of accesses of devices that did not
+ * fit in the table.
+ *
+ * @param buf - Output buffer.
+ * @param len - Size of buf.
+ * @return The length of the text, -ENOBUFS if buf is too small.
+ */
+int no_os_trace_dump(char *buf, uint32_t len)
+{
+	struct no_os_trace_stats stats;
+	uint32_t i, j;
+	uint32_t pos = 0;
+	int ret;
+
+#define NO_OS_TRACE_PRINT(...) do { \
+	ret = snprintf(buf + pos, len - pos, __VA_ARGS__); \
+	if (ret < 0 || (uint32_t)ret >= len - pos) \
+		return -ENOBUFS; \
+	pos += ret; \
+} while (0)
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	for (i = 0; i < NO_OS_TRACE_DEVICES; i++) {
+		if (no_os_trace_get_stats(i, &stats))
+			continue;
+		NO_OS_TRACE_PRINT("%s%u 0x%lx count %lu err %lu bytes %lu "
+				  "total_us %lu max_ns %lu hist",
+				  no_os_trace_bus_names[stats.bus],
+				  stats.bus_id, (unsigned long)stats.dev,
+				  (unsigned long)stats.count,
+				  (unsigned long)stats.errors,
+				  (unsigned long)stats.bytes,
+				  (unsigned long)stats.time_us,
+				  (unsigned long)stats.max_ns);
+		for (j = 0; j < NO_OS_TRACE_HIST_BUCKETS; j++)
+			NO_OS_TRACE_PRINT(" %lu", (unsigned long)stats.hist[j]);
+		NO_OS_TRACE_PRINT("\n");
+	}
+	NO_OS_TRACE_PRINT("untracked %lu\n",
+			  (unsigned long)NO_OS_TRACE_LOAD(&no_os_trace_untracked));
+
+#undef NO_OS_TRACE_PRINT
+
+	return pos;
+}